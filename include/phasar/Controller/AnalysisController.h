@@ -13,17 +13,21 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "boost/filesystem.hpp"
 
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMBasedPointsToAnalysis.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
 #include "phasar/Utils/EnumFlags.h"
 #include "phasar/Utils/SoundnessFlag.h"
 
@@ -45,6 +49,8 @@ enum class AnalysisControllerEmitterOptions : uint32_t {
   EmitPTAAsText = (1 << 11),
   EmitPTAAsDot = (1 << 12),
   EmitPTAAsJson = (1 << 13),
+  ExportAsJson = (1 << 14),
+  ExportAsSarif = (1 << 15),
 };
 
 class AnalysisController {
@@ -62,6 +68,9 @@ private:
   std::string ProjectID;
   std::string OutDirectory;
   boost::filesystem::path ResultDirectory;
+  std::vector<std::string> Queries;
+  // the IR files the module-wise analysis strategy loads unit by unit
+  std::vector<std::string> IRFiles;
   [[maybe_unused]] SoundnessFlag SF;
 
   ///
@@ -81,10 +90,74 @@ private:
 
   void emitRequestedHelperAnalysisResults();
 
-  template <typename T> void emitRequestedDataFlowResults(T &WPA) {
+  ///
+  /// \brief Resolves the statement and (optional) fact IDs of the queries
+  /// given to the demand-driven analysis strategy; the fact is nullptr for
+  /// queries without a fact.
+  ///
+  std::vector<std::pair<const llvm::Instruction *, const llvm::Value *>>
+  getDemandDrivenQueries();
+
+  template <typename T> void executeDemandDrivenAnalysis(T &DDA) {
+    using d_t = typename T::d_t;
+    for (const auto &[Stmt, Fact] : getDemandDrivenQueries()) {
+      if constexpr (std::is_same_v<d_t, const llvm::Value *>) {
+        if (Fact) {
+          DDA.addQuery(Stmt, Fact);
+          continue;
+        }
+      }
+      DDA.addQuery(Stmt);
+    }
+    DDA.solve();
+    if (!ResultDirectory.empty()) {
+      std::ofstream OFS(ResultDirectory.string() + "/psr-query-results.txt");
+      DDA.emitQueryResults(OFS);
+    } else {
+      DDA.emitQueryResults(std::cout);
+    }
+    emitRequestedDataFlowResults(DDA);
+    DDA.releaseAllHelperAnalyses();
+  }
+
+  ///
+  /// \brief Whether the IFDS analysis ProblemTy can be solved by the
+  /// NativeIFDSSolver, which does not support all solver options; prints a
+  /// note naming the unsupported option otherwise.
+  ///
+  template <typename ProblemTy> bool useNativeIFDSSolver();
+
+  ///
+  /// \brief Runs the demand-driven IFDS analysis ProblemTy constructed from
+  /// Args, using IFDSSolver where NativeIFDSSolver is unsupported.
+  ///
+  template <typename ProblemTy, typename... ArgTys>
+  void executeDemandDrivenIFDSAnalysis(ArgTys &&... Args);
+
+  ///
+  /// \brief Runs the whole-program IFDS analysis ProblemTy constructed from
+  /// Args, using IFDSSolver where NativeIFDSSolver is unsupported.
+  ///
+  template <typename ProblemTy, typename... ArgTys>
+  void executeWholeProgramIFDSAnalysis(ArgTys &&... Args);
+
+  template <typename T> void executeModuleWiseAnalysis(T &MWA) {
+    MWA.solve([this](const ModuleWiseUnit &Unit, ProjectIRDB & /*IRDB*/,
+                     typename T::SolverTy &Solver) {
+      if (ResultDirectory.empty()) {
+        std::cout << "Results of unit '" << Unit.Name << "':\n";
+      }
+      emitRequestedDataFlowResults(Solver, "psr-" + Unit.Name);
+    });
+  }
+
+  template <typename T>
+  void emitRequestedDataFlowResults(T &WPA,
+                                    const std::string &FilePrefix = "psr") {
     if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTextReport) {
       if (!ResultDirectory.empty()) {
-        std::ofstream OFS(ResultDirectory.string() + "/psr-report.txt");
+        std::ofstream OFS(ResultDirectory.string() + "/" + FilePrefix +
+                          "-report.txt");
         WPA.emitTextReport(OFS);
       } else {
         WPA.emitTextReport(std::cout);
@@ -93,7 +166,8 @@ private:
     if (EmitterOptions &
         AnalysisControllerEmitterOptions::EmitGraphicalReport) {
       if (!ResultDirectory.empty()) {
-        std::ofstream OFS(ResultDirectory.string() + "/psr-report.html");
+        std::ofstream OFS(ResultDirectory.string() + "/" + FilePrefix +
+                          "-report.html");
         WPA.emitGraphicalReport(OFS);
       } else {
         WPA.emitGraphicalReport(std::cout);
@@ -101,12 +175,31 @@ private:
     }
     if (EmitterOptions & AnalysisControllerEmitterOptions::EmitRawResults) {
       if (!ResultDirectory.empty()) {
-        std::ofstream OFS(ResultDirectory.string() + "/psr-raw-results.txt");
+        std::ofstream OFS(ResultDirectory.string() + "/" + FilePrefix +
+                          "-raw-results.txt");
         WPA.dumpResults(OFS);
       } else {
         WPA.dumpResults(std::cout);
       }
     }
+    if (EmitterOptions & AnalysisControllerEmitterOptions::ExportAsJson) {
+      if (!ResultDirectory.empty()) {
+        std::ofstream OFS(ResultDirectory.string() + "/" + FilePrefix +
+                          "-results.json");
+        WPA.exportResults(IOFormat::JSON, OFS);
+      } else {
+        WPA.exportResults(IOFormat::JSON, std::cout);
+      }
+    }
+    if (EmitterOptions & AnalysisControllerEmitterOptions::ExportAsSarif) {
+      if (!ResultDirectory.empty()) {
+        std::ofstream OFS(ResultDirectory.string() + "/" + FilePrefix +
+                          "-results.sarif");
+        WPA.exportResults(IOFormat::SARIF, OFS);
+      } else {
+        WPA.exportResults(IOFormat::SARIF, std::cout);
+      }
+    }
     if (EmitterOptions & AnalysisControllerEmitterOptions::EmitESGAsDot) {
       std::cout << "Front-end support for 'EmitESGAsDot' to be implemented\n";
     }
@@ -121,7 +214,9 @@ public:
                      AnalysisStrategy Strategy,
                      AnalysisControllerEmitterOptions EmitterOptions,
                      const std::string &ProjectID = "default-phasar-project",
-                     const std::string &OutDirectory = "");
+                     const std::string &OutDirectory = "",
+                     std::vector<std::string> Queries = {},
+                     std::vector<std::string> IRFiles = {});
 
   ~AnalysisController() = default;
 
@@ -10,9 +10,316 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+#include "phasar/Utils/Logger.h"
+
 namespace psr {
 
-class DemandDrivenAnalysis {};
+/**
+ * Answers point queries of the form "which facts hold at statement N?" or
+ * "does fact D hold at statement N?" for IFDS/IDE problems without solving
+ * the problem for the whole program.
+ *
+ * First, the statements that may reach one of the queried statements in the
+ * interprocedural control-flow graph are collected by a backward traversal
+ * starting at the queries: intra-procedural predecessors, the callers of a
+ * function's start point and the exits of the callees whose results flow into
+ * a return site. Only these statements can contribute to the results at the
+ * queried statements. The solver is then run forward from the problem's seeds
+ * while being restricted to these statements, see
+ * IDESolver::restrictToStatements().
+ *
+ * The results for every statement within the explored part of the program are
+ * complete. Querying a statement outside of it extends the explored part on
+ * demand by re-running the solver for all queries made so far.
+ */
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class DemandDrivenAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using f_t = typename Solver::f_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  ProblemDescription ProblemDesc;
+  std::unique_ptr<Solver> DataFlowSolver;
+  // the queries in the order they have been made, a query without a fact asks
+  // for all facts holding at the statement
+  std::vector<std::pair<n_t, std::optional<d_t>>> Queries;
+  std::set<n_t> QueryStmts;
+  // the statements explored by the last run of the solver
+  std::set<n_t> RelevantStmts;
+
+  std::set<n_t> computeRelevantStatements() const {
+    std::set<n_t> Relevant;
+    std::vector<n_t> Worklist(QueryStmts.begin(), QueryStmts.end());
+    auto Visit = [&Relevant, &Worklist](n_t Stmt) {
+      if (!Relevant.count(Stmt)) {
+        Worklist.push_back(Stmt);
+      }
+    };
+    while (!Worklist.empty()) {
+      n_t Stmt = Worklist.back();
+      Worklist.pop_back();
+      if (!Relevant.insert(Stmt).second) {
+        continue;
+      }
+      if (CallGraph->isStartPoint(Stmt)) {
+        for (n_t CallSite :
+             CallGraph->getCallersOf(CallGraph->getFunctionOf(Stmt))) {
+          Visit(CallSite);
+        }
+      }
+      for (n_t Pred : CallGraph->getPredsOf(Stmt)) {
+        Visit(Pred);
+        if (CallGraph->isCallStmt(Pred)) {
+          // Stmt is a return site, the callees' results flow into it
+          for (f_t Callee : CallGraph->getCalleesOfCallAt(Pred)) {
+            for (n_t Exit : CallGraph->getExitPointsOf(Callee)) {
+              Visit(Exit);
+            }
+          }
+        }
+      }
+    }
+    return Relevant;
+  }
+
+  void ensureExplored(n_t Stmt) {
+    if (!DataFlowSolver || !RelevantStmts.count(Stmt)) {
+      QueryStmts.insert(Stmt);
+      solve();
+    }
+  }
+
+public:
+  DemandDrivenAnalysis(ProjectIRDB &IRDB,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), EntryPoints) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  DemandDrivenAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *Config, EntryPoints) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  DemandDrivenAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *this->Config, EntryPoints) {}
+
+  /**
+   * Asks for all facts that hold at the given statement.
+   */
+  void addQuery(n_t Stmt) {
+    Queries.emplace_back(Stmt, std::nullopt);
+    QueryStmts.insert(Stmt);
+  }
+
+  /**
+   * Asks whether the given fact holds at the given statement.
+   */
+  void addQuery(n_t Stmt, d_t Fact) {
+    Queries.emplace_back(Stmt, Fact);
+    QueryStmts.insert(Stmt);
+  }
+
+  /**
+   * Solves the problem for the statements that may reach one of the queries.
+   */
+  void solve() {
+    RelevantStmts = computeRelevantStatements();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Demand-driven analysis explores " << RelevantStmts.size()
+                  << " statements for " << QueryStmts.size()
+                  << " queried statements");
+    // the solvers cannot be re-run, a fresh one explores the extended part of
+    // the program
+    DataFlowSolver = std::make_unique<Solver>(ProblemDesc);
+    DataFlowSolver->restrictToStatements(RelevantStmts);
+    DataFlowSolver->solve();
+  }
+
+  void operator()() { solve(); }
+
+  /**
+   * Checks whether the given fact holds at the given statement. The problem
+   * is solved (again) if the statement has not been explored yet.
+   */
+  bool holds(n_t Stmt, d_t Fact) {
+    ensureExplored(Stmt);
+    return DataFlowSolver->resultsAt(Stmt).count(Fact);
+  }
+
+  /**
+   * Returns the facts that hold at the given statement along with their
+   * values. The problem is solved (again) if the statement has not been
+   * explored yet.
+   */
+  auto resultsAt(n_t Stmt) {
+    ensureExplored(Stmt);
+    return DataFlowSolver->resultsAt(Stmt, true);
+  }
+
+  /**
+   * Returns the statements explored by the last run of the solver.
+   */
+  [[nodiscard]] const std::set<n_t> &getRelevantStatements() const {
+    return RelevantStmts;
+  }
+
+  /**
+   * Answers all queries made using addQuery().
+   */
+  void emitQueryResults(std::ostream &OS = std::cout) {
+    for (const auto &[Stmt, Fact] : Queries) {
+      OS << "N: " << ProblemDesc.NtoString(Stmt) << '\n';
+      if (Fact) {
+        OS << "\tD: " << ProblemDesc.DtoString(*Fact)
+           << (holds(Stmt, *Fact) ? " holds" : " does not hold") << '\n';
+        continue;
+      }
+      for (const auto &[D, L] : resultsAt(Stmt)) {
+        OS << "\tD: " << ProblemDesc.DtoString(D);
+        if constexpr (!std::is_same_v<std::decay_t<decltype(L)>,
+                                      BinaryDomain>) {
+          OS << " | V: " << ProblemDesc.LtoString(L);
+        }
+        OS << '\n';
+      }
+    }
+  }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    if (DataFlowSolver) {
+      DataFlowSolver->dumpResults(OS);
+    }
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    if (DataFlowSolver) {
+      DataFlowSolver->emitTextReport(OS);
+    }
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    if (DataFlowSolver) {
+      DataFlowSolver->emitGraphicalReport(OS);
+    }
+  }
+
+  void exportResults(IOFormat Format, std::ostream &OS = std::cout) {
+    if (DataFlowSolver) {
+      DataFlowSolver->exportResults(Format, OS);
+    }
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseCallGraph();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
@@ -10,9 +10,238 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+#include "phasar/Utils/Logger.h"
+
 namespace psr {
 
-class IncrementalUpdateAnalysis {};
+/**
+ * Re-analyzes a program after it has changed by re-using the state of the
+ * previous run of the analysis, which is persisted in the solver's checkpoint
+ * file, see IFDSIDESolverConfig::setCheckpointFile().
+ *
+ * The functions of the current IR are compared to the ones the state has been
+ * computed for by their hashes. The jump functions and end summaries of the
+ * changed functions and of their transitive callers are dropped, all others
+ * are retained; the solver then only re-constructs the dropped part of the
+ * exploded super-graph, see IDESolver::updateFromCheckpoint(). Afterwards,
+ * the state of the current run is persisted for the next one. If there is no
+ * usable state, the whole program is analyzed.
+ */
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class IncrementalUpdateAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using f_t = typename Solver::f_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  ProblemDescription ProblemDesc;
+  Solver DataFlowSolver;
+  // the functions re-analyzed by solve(), unset if there was no usable state
+  std::optional<std::set<f_t>> InvalidatedFunctions;
+
+public:
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), EntryPoints),
+        DataFlowSolver(ProblemDesc) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *this->Config, EntryPoints),
+        DataFlowSolver(ProblemDesc) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *this->Config, EntryPoints),
+        DataFlowSolver(ProblemDesc) {}
+
+  /**
+   * Analyzes the program, re-using the persisted state of the previous run if
+   * there is one, and persists the state of this run.
+   */
+  void solve() {
+    auto &SolverConfig = ProblemDesc.getIFDSIDESolverConfig();
+    const std::string StateFile = SolverConfig.checkpointFile();
+    if (StateFile.empty()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "No checkpoint file has been specified, analyze the "
+                       "whole program without persisting its state");
+      DataFlowSolver.solve();
+      return;
+    }
+    // the state is restored by updateFromCheckpoint() instead
+    SolverConfig.setResumeFromCheckpoint(false);
+    if (SolverConfig.lowMemory()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Persisting the state requires all jump functions, "
+                       "ignore the requested low-memory mode");
+      SolverConfig.setLowMemory(false);
+    }
+    InvalidatedFunctions = DataFlowSolver.updateFromCheckpoint(StateFile);
+    if (InvalidatedFunctions) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Re-analyze " << InvalidatedFunctions->size()
+                    << " functions affected by changes since the last run");
+    } else {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "No usable state in '" << StateFile
+                    << "', analyze the whole program");
+    }
+    DataFlowSolver.solve();
+    if (!DataFlowSolver.saveCheckpoint(StateFile)) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Cannot persist the state to '" << StateFile << "'");
+    }
+  }
+
+  void operator()() { solve(); }
+
+  /**
+   * Sets the file the state is persisted in, which defaults to the solver's
+   * checkpoint file, see IFDSIDESolverConfig::setCheckpointFile().
+   */
+  void setStateFile(std::string File) {
+    ProblemDesc.getIFDSIDESolverConfig().setCheckpointFile(std::move(File));
+  }
+
+  auto resultsAt(n_t Stmt, bool StripZero = false) {
+    return DataFlowSolver.resultsAt(Stmt, StripZero);
+  }
+
+  /**
+   * Returns the functions that have been re-analyzed by solve() because they
+   * or their callees have changed since the last run, or std::nullopt if the
+   * whole program has been analyzed.
+   */
+  [[nodiscard]] const std::optional<std::set<f_t>> &
+  getInvalidatedFunctions() const {
+    return InvalidatedFunctions;
+  }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    DataFlowSolver.dumpResults(OS);
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    DataFlowSolver.emitTextReport(OS);
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    DataFlowSolver.emitGraphicalReport(OS);
+  }
+
+  void exportResults(IOFormat Format, std::ostream &OS = std::cout) {
+    DataFlowSolver.exportResults(Format, OS);
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseCallGraph();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
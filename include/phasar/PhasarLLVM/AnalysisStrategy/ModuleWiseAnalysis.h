@@ -10,9 +10,289 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "boost/filesystem/operations.hpp"
+#include "boost/filesystem/path.hpp"
+
+#include "phasar/Config/Configuration.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/Utils/Logger.h"
+
 namespace psr {
 
-class ModuleWiseAnalysis {};
+/**
+ * A set of IR modules that are analyzed together by ModuleWiseAnalysis.
+ * Modules that depend on each other cyclically form a single unit.
+ */
+struct ModuleWiseUnit {
+  // the IR files of the unit's modules
+  std::vector<std::string> IRFiles;
+  // the indices of all units the unit depends on, directly or transitively
+  std::set<size_t> Dependencies;
+  // the functions with external linkage that are defined by the unit
+  std::set<std::string> ExportedFunctions;
+  // an identifier that is unique among the units of a program and stable
+  // across runs as long as the unit consists of the same IR files
+  std::string Name;
+};
+
+/**
+ * Scans the given IR files for the functions and global variables they
+ * define and use and groups them into units in dependency order: a module
+ * depends on every module that defines a function or global variable it only
+ * declares. Each unit is preceded by the units it depends on. Modules are
+ * only loaded one at a time and function bodies are not materialized where
+ * the IR format allows it.
+ */
+std::vector<ModuleWiseUnit>
+getModuleWiseUnits(const std::vector<std::string> &IRFiles);
+
+/**
+ * Loads the IR a unit is analyzed on: its own modules, linked into a single
+ * module, and the definitions of the functions they transitively use from
+ * the modules of the units they depend on. The callees' bodies are needed to
+ * apply their summaries and to compute the values inside of them. The
+ * modules of the dependencies are loaded one unit at a time.
+ */
+std::unique_ptr<ProjectIRDB>
+loadModuleWiseUnitIR(const ModuleWiseUnit &Unit,
+                     const std::vector<ModuleWiseUnit> &Units);
+
+/**
+ * Analyzes a program one unit of modules at a time, see getModuleWiseUnits(),
+ * starting with the modules that do not depend on others. The state of the
+ * IDE solver of each unit, i.e. the procedure summaries of the functions it
+ * analyzed, is persisted in the summary directory and re-used when the units
+ * that depend on it are analyzed, as well as when the unit itself is analyzed
+ * again after parts of the program have changed, see
+ * IDESolver::updateFromCheckpoint(). A change in one module therefore only
+ * requires the functions that are affected by it to be re-analyzed.
+ *
+ * A unit is analyzed starting at the given entry points it defines or, if it
+ * does not define any of them, at all functions it exports. Only the unit's
+ * own modules and the functions it transitively calls are loaded, see
+ * loadModuleWiseUnitIR(); the summaries of the callees are restored from the
+ * checkpoints of the units they belong to. A callee is only entered for
+ * contexts its own unit has not computed summaries for. The results of a
+ * unit cover its own functions and its callees as if the program had been
+ * analyzed as a whole from the unit's entry points.
+ */
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class ModuleWiseAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using SolverTy = Solver;
+  /**
+   * Is called after each unit has been analyzed with the unit, the IR the
+   * unit has been analyzed on and the solver that holds its results.
+   */
+  using UnitHandlerTy =
+      std::function<void(const ModuleWiseUnit &, ProjectIRDB &, Solver &)>;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  std::vector<std::string> IRFiles;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  std::string SummaryDirectory;
+  // the number of units that have been analyzed by the last call to solve()
+  size_t NumAnalyzedUnits = 0;
+
+  std::set<std::string> getEntryPoints(const ModuleWiseUnit &Unit,
+                                       const ProjectIRDB &IRDB) const {
+    std::set<std::string> UnitEntryPoints;
+    for (const auto &EntryPoint : EntryPoints) {
+      if (Unit.ExportedFunctions.count(EntryPoint)) {
+        UnitEntryPoints.insert(EntryPoint);
+      }
+    }
+    if (UnitEntryPoints.empty()) {
+      UnitEntryPoints = Unit.ExportedFunctions;
+    }
+    // entry points that are only declared by the unit are not analyzed
+    for (auto It = UnitEntryPoints.begin(); It != UnitEntryPoints.end();) {
+      if (IRDB.getFunctionDefinition(*It)) {
+        ++It;
+      } else {
+        It = UnitEntryPoints.erase(It);
+      }
+    }
+    return UnitEntryPoints;
+  }
+
+  std::unique_ptr<ProblemDescription>
+  makeProblem(ProjectIRDB &IRDB, TypeHierarchyTy &TH,
+              CallGraphAnalysisTy &ICF, PointerAnalysisTy &PT,
+              const std::set<std::string> &UnitEntryPoints) {
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      return std::make_unique<ProblemDescription>(&IRDB, &TH, &ICF, &PT,
+                                                  UnitEntryPoints);
+    } else {
+      return std::make_unique<ProblemDescription>(&IRDB, &TH, &ICF, &PT,
+                                                  *Config, UnitEntryPoints);
+    }
+  }
+
+  void solveUnit(const ModuleWiseUnit &Unit,
+                 const std::vector<ModuleWiseUnit> &Units,
+                 const boost::filesystem::path &Directory,
+                 const UnitHandlerTy &Handler) {
+    auto IRDBPtr = loadModuleWiseUnitIR(Unit, Units);
+    ProjectIRDB &IRDB = *IRDBPtr;
+    auto UnitEntryPoints = getEntryPoints(Unit, IRDB);
+    if (UnitEntryPoints.empty()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Unit '" << Unit.Name
+                    << "' does not define any entry points, skip it");
+      return;
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Analyze unit '" << Unit.Name << "' of "
+                  << Unit.IRFiles.size() << " modules, which depends on "
+                  << Unit.Dependencies.size() << " units");
+    TypeHierarchyTy TH(IRDB);
+    PointerAnalysisTy PT(IRDB);
+    CallGraphAnalysisTy ICF(IRDB, CallGraphAnalysisType::OTF, UnitEntryPoints,
+                            &TH, &PT);
+    auto Problem = makeProblem(IRDB, TH, ICF, PT, UnitEntryPoints);
+    auto &SolverConfig = Problem->getIFDSIDESolverConfig();
+    const std::string SummaryFile =
+        (Directory / (Unit.Name + ".ckpt")).string();
+    SolverConfig.setCheckpointFile(SummaryFile);
+    // the summaries are restored by updateFromCheckpoint() instead
+    SolverConfig.setResumeFromCheckpoint(false);
+    if (SolverConfig.lowMemory()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Persisting the summaries requires all jump functions, "
+                       "ignore the requested low-memory mode");
+      SolverConfig.setLowMemory(false);
+    }
+    Solver DataFlowSolver(*Problem);
+    // the summaries of the dependencies come first and take precedence over
+    // the unit's own ones of the previous run, which are dropped for the
+    // functions whose callees' summaries have changed since
+    std::vector<std::string> SummaryFiles;
+    for (size_t Dependency : Unit.Dependencies) {
+      SummaryFiles.push_back(
+          (Directory / (Units[Dependency].Name + ".ckpt")).string());
+    }
+    SummaryFiles.push_back(SummaryFile);
+    for (const auto &File : SummaryFiles) {
+      if (!boost::filesystem::exists(File)) {
+        continue;
+      }
+      if (auto Invalidated = DataFlowSolver.updateFromCheckpoint(
+              File, /*External*/ File != SummaryFile)) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << "Re-use the summaries of '" << File << "', "
+                      << Invalidated->size() << " functions are invalidated");
+      } else {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                      << "Cannot re-use the summaries of '" << File << "'");
+      }
+    }
+    DataFlowSolver.solve();
+    if (!DataFlowSolver.saveCheckpoint(SummaryFile)) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Cannot persist the summaries of unit '" << Unit.Name
+                    << "' to '" << SummaryFile << "'");
+    }
+    ++NumAnalyzedUnits;
+    if (Handler) {
+      Handler(Unit, IRDB, DataFlowSolver);
+    }
+  }
+
+  static std::string getDefaultSummaryDirectory() {
+    if (PhasarConfig::VariablesMap().count("summary-dir")) {
+      return PhasarConfig::VariablesMap()["summary-dir"].as<std::string>();
+    }
+    return "";
+  }
+
+public:
+  ModuleWiseAnalysis(std::vector<std::string> IRFiles,
+                     std::set<std::string> EntryPoints = {})
+      : IRFiles(std::move(IRFiles)), EntryPoints(std::move(EntryPoints)),
+        SummaryDirectory(getDefaultSummaryDirectory()) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ModuleWiseAnalysis(std::vector<std::string> IRFiles, ConfigurationTy *Config,
+                     std::set<std::string> EntryPoints = {})
+      : IRFiles(std::move(IRFiles)), EntryPoints(std::move(EntryPoints)),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        SummaryDirectory(getDefaultSummaryDirectory()) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ModuleWiseAnalysis(std::vector<std::string> IRFiles, std::string ConfigPath,
+                     std::set<std::string> EntryPoints = {})
+      : IRFiles(std::move(IRFiles)), EntryPoints(std::move(EntryPoints)),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath), SummaryDirectory(getDefaultSummaryDirectory()) {
+  }
+
+  /**
+   * Analyzes all units in dependency order and calls Handler for each of
+   * them. If no summary directory has been specified, the summaries are only
+   * re-used within this run.
+   */
+  void solve(const UnitHandlerTy &Handler = {}) {
+    NumAnalyzedUnits = 0;
+    const bool Persistent = !SummaryDirectory.empty();
+    const boost::filesystem::path Directory =
+        Persistent ? boost::filesystem::path(SummaryDirectory)
+                   : boost::filesystem::temp_directory_path() /
+                         boost::filesystem::unique_path("phasar-%%%%-%%%%");
+    boost::filesystem::create_directories(Directory);
+    auto Units = getModuleWiseUnits(IRFiles);
+    for (const auto &Unit : Units) {
+      solveUnit(Unit, Units, Directory, Handler);
+    }
+    if (!Persistent) {
+      boost::filesystem::remove_all(Directory);
+    }
+  }
+
+  void operator()() { solve(); }
+
+  /**
+   * Sets the directory the units' summaries are persisted in, which defaults
+   * to the one given by '--summary-dir'.
+   */
+  void setSummaryDirectory(std::string Directory) {
+    SummaryDirectory = std::move(Directory);
+  }
+
+  [[nodiscard]] size_t getNumAnalyzedUnits() const { return NumAnalyzedUnits; }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
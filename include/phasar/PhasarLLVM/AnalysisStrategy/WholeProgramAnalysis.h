@@ -19,6 +19,7 @@
 
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
 
 namespace psr {
 
@@ -139,6 +140,10 @@ public:
     DataFlowSolver.emitGraphicalReport(OS);
   }
 
+  void exportResults(IOFormat Format, std::ostream &OS = std::cout) {
+    DataFlowSolver.exportResults(Format, OS);
+  }
+
   void emitESG(std::ostream &OS = std::cout) {
     // if (std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>) {
     //   DataFlowSolver.emitESGAsDot(OS);
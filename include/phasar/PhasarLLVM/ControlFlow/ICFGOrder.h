@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_CONTROLFLOW_ICFGORDER_H_
+#define PHASAR_PHASARLLVM_CONTROLFLOW_ICFGORDER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
+
+namespace psr {
+
+/**
+ * An order of the statements of an inter-procedural control-flow graph in
+ * which data-flow solvers converge with few revisits. Functions are ordered
+ * by the strongly connected components of the call graph, callees first,
+ * such that summaries are complete before they are applied in their
+ * callers; within a function, statements are ordered in reverse post-order,
+ * such that a statement is visited after its predecessors except along back
+ * edges.
+ */
+template <typename N, typename F> class ICFGOrder {
+public:
+  explicit ICFGOrder(const ICFG<N, F> &ICF) {
+    for (F Fun : ICF.getAllFunctions()) {
+      if (!SCCRanks.count(Fun)) {
+        computeSCCRanks(ICF, Fun);
+      }
+    }
+    for (const auto &Entry : SCCRanks) {
+      computeReversePostOrder(ICF, Entry.first);
+    }
+  }
+
+  /**
+   * Returns the rank of the call-graph SCC of the given function: callees
+   * have smaller ranks than their callers, mutually recursive functions
+   * share a rank.
+   */
+  [[nodiscard]] size_t getSCCRank(F Fun) const {
+    auto Search = SCCRanks.find(Fun);
+    return Search != SCCRanks.end() ? Search->second : Unknown;
+  }
+
+  /**
+   * Returns the index of the given statement in the reverse post-order of
+   * its function.
+   */
+  [[nodiscard]] size_t getRPOIndex(N Stmt) const {
+    auto Search = RPOIndices.find(Stmt);
+    return Search != RPOIndices.end() ? Search->second.second : Unknown;
+  }
+
+  /**
+   * Returns the priority of the given statement, smaller priorities come
+   * first. Statements that are unknown to the call graph come last.
+   */
+  [[nodiscard]] uint64_t getPriority(N Stmt) const {
+    auto Search = RPOIndices.find(Stmt);
+    if (Search == RPOIndices.end()) {
+      return std::numeric_limits<uint64_t>::max();
+    }
+    return (static_cast<uint64_t>(Search->second.first) << 32) |
+           static_cast<uint32_t>(Search->second.second);
+  }
+
+  [[nodiscard]] size_t getNumSCCs() const { return NumSCCs; }
+
+  static constexpr size_t Unknown = std::numeric_limits<size_t>::max();
+
+private:
+  // Tarjan's algorithm, which finds every SCC after the ones it calls
+  void computeSCCRanks(const ICFG<N, F> &ICF, F Root) {
+    std::unordered_map<F, std::pair<size_t, size_t>> IndexAndLowLink;
+    std::vector<F> Stack;
+    std::set<F> OnStack;
+    std::function<void(F)> Visit = [&](F Fun) {
+      const size_t Index = IndexAndLowLink.size();
+      IndexAndLowLink[Fun] = {Index, Index};
+      Stack.push_back(Fun);
+      OnStack.insert(Fun);
+      std::set<F> Callees;
+      for (N CallSite : ICF.getCallsFromWithin(Fun)) {
+        for (F Callee : ICF.getCalleesOfCallAt(CallSite)) {
+          Callees.insert(Callee);
+        }
+      }
+      for (F Callee : Callees) {
+        if (SCCRanks.count(Callee)) {
+          // ranked while visiting a previous root
+          continue;
+        }
+        if (!IndexAndLowLink.count(Callee)) {
+          Visit(Callee);
+          IndexAndLowLink[Fun].second = std::min(
+              IndexAndLowLink[Fun].second, IndexAndLowLink[Callee].second);
+        } else if (OnStack.count(Callee)) {
+          IndexAndLowLink[Fun].second = std::min(
+              IndexAndLowLink[Fun].second, IndexAndLowLink[Callee].first);
+        }
+      }
+      if (IndexAndLowLink[Fun].second != Index) {
+        return;
+      }
+      F Member;
+      do {
+        Member = Stack.back();
+        Stack.pop_back();
+        OnStack.erase(Member);
+        SCCRanks[Member] = NumSCCs;
+      } while (Member != Fun);
+      ++NumSCCs;
+    };
+    Visit(Root);
+  }
+
+  void computeReversePostOrder(const ICFG<N, F> &ICF, F Fun) {
+    const size_t Rank = SCCRanks[Fun];
+    std::vector<N> PostOrder;
+    std::set<N> Visited;
+    // the statements whose successors are still to be visited
+    std::vector<std::pair<N, std::vector<N>>> Stack;
+    for (N Start : ICF.getStartPointsOf(Fun)) {
+      if (!Visited.insert(Start).second) {
+        continue;
+      }
+      Stack.emplace_back(Start, ICF.getSuccsOf(Start));
+      while (!Stack.empty()) {
+        auto &Succs = Stack.back().second;
+        if (Succs.empty()) {
+          PostOrder.push_back(Stack.back().first);
+          Stack.pop_back();
+          continue;
+        }
+        N Succ = Succs.back();
+        Succs.pop_back();
+        if (Visited.insert(Succ).second) {
+          Stack.emplace_back(Succ, ICF.getSuccsOf(Succ));
+        }
+      }
+    }
+    for (size_t Idx = 0; Idx < PostOrder.size(); ++Idx) {
+      RPOIndices[PostOrder[Idx]] = {Rank, PostOrder.size() - 1 - Idx};
+    }
+  }
+
+  std::unordered_map<F, size_t> SCCRanks;
+  // maps each statement to the rank of its function and its index in the
+  // reverse post-order of its function
+  std::unordered_map<N, std::pair<size_t, size_t>> RPOIndices;
+  size_t NumSCCs = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_CHECKPOINTIO_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_CHECKPOINTIO_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace llvm {
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/**
+ * Returns the ID that identifies V in a solver checkpoint. IDs only depend on
+ * the structure of the function or global variable a value belongs to, such
+ * that they remain stable if other functions change: functions and global
+ * variables are identified by their names, arguments and instructions by their
+ * function's name and their position within the function. An empty string is
+ * returned for all other values, including the zero value, they cannot be
+ * checkpointed.
+ */
+std::string getCheckpointId(const llvm::Value *V);
+
+/**
+ * Writes the primitives a solver checkpoint consists of in a compact binary
+ * format: integers are encoded using a variable number of bytes and each LLVM
+ * value's ID is written only once, subsequent occurrences of the value refer
+ * to the first one.
+ */
+class CheckpointWriter {
+public:
+  explicit CheckpointWriter(std::ostream &OS);
+
+  void writeInt(uint64_t Val);
+
+  void writeSignedInt(int64_t Val);
+
+  void writeString(llvm::StringRef Str);
+
+  /**
+   * Writes V's ID, see getCheckpointId(). Returns false if V cannot be
+   * checkpointed.
+   */
+  [[nodiscard]] bool writeValue(const llvm::Value *V);
+
+  [[nodiscard]] bool good() const;
+
+private:
+  std::ostream &OS;
+  llvm::DenseMap<const llvm::Value *, uint64_t> ValueIndices;
+  // the positions of the instructions of all functions that have been written
+  // so far, see getCheckpointId()
+  llvm::DenseMap<const llvm::Value *, uint64_t> InstructionNumbers;
+
+  std::string getId(const llvm::Value *V);
+};
+
+/**
+ * Reads the primitives written by a CheckpointWriter. LLVM values are re-bound
+ * to the values of the given ProjectIRDB by their IDs. Reading stops at the
+ * first error; all subsequent reads return default values and good() returns
+ * false.
+ *
+ * If AllowUnknownValues is set, an ID that does not identify a value of the
+ * ProjectIRDB is not an error; readValue() returns nullptr instead. This is
+ * used to read checkpoints that have been written for a previous version of
+ * the IR.
+ */
+class CheckpointReader {
+public:
+  CheckpointReader(std::istream &IS, const ProjectIRDB &IRDB,
+                   bool AllowUnknownValues = false);
+
+  uint64_t readInt();
+
+  int64_t readSignedInt();
+
+  std::string readString();
+
+  /**
+   * Reads a value's ID and returns the corresponding value of the
+   * ProjectIRDB, or nullptr if there is no such value. Values whose IDs are
+   * ambiguous, e.g. functions of the same name in different modules, are
+   * unknown.
+   */
+  const llvm::Value *readValue();
+
+  [[nodiscard]] bool good() const;
+
+  [[nodiscard]] bool allowsUnknownValues() const { return AllowUnknownValues; }
+
+  /**
+   * Marks the checkpoint as corrupt, e.g. if it contains unexpected data.
+   */
+  void fail();
+
+  /**
+   * Forgets the values read so far and clears the error state, such that
+   * another checkpoint can be read from the stream, e.g. after its contents
+   * have been replaced. This avoids indexing the ProjectIRDB's values for
+   * every small checkpoint that is read.
+   */
+  void reset();
+
+private:
+  std::istream &IS;
+  llvm::StringMap<const llvm::Value *> ValuesById;
+  std::vector<const llvm::Value *> Values;
+  bool AllowUnknownValues;
+  bool Failed = false;
+};
+
+} // namespace psr
+
+#endif
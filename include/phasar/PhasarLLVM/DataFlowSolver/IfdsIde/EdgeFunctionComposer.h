@@ -54,6 +54,10 @@ public:
 
   ~EdgeFunctionComposer() override = default;
 
+  [[nodiscard]] EdgeFunctionPtrType getFirst() const { return F; }
+
+  [[nodiscard]] EdgeFunctionPtrType getSecond() const { return G; }
+
   /**
    * Target value computation is implemented as
    *     G(F(source))
@@ -89,6 +93,12 @@ public:
     return false;
   }
 
+  // Composers with equal components are equal_to each other regardless of
+  // their dynamic type; hence, the type is not hashed.
+  [[nodiscard]] size_t hash() const override {
+    return F->hash() * 31 + G->hash();
+  }
+
   void print(std::ostream &OS, bool isForDebug = false) const override {
     OS << "COMP[ " << F.get()->str() << " , " << G.get()->str()
        << " ] (EF:" << EFComposer_Id << ')';
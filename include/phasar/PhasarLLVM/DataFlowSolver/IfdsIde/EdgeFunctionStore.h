@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONSTORE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONSTORE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+namespace psr {
+
+//
+// EdgeFunctionStore interns edge functions such that edge functions that are
+// equal_to each other share a single object. Interned edge functions can thus
+// be compared using pointer equality. Edge functions are bucketed by
+// EdgeFunction::hash().
+//
+// Additionally, the results of composing and joining interned edge functions
+// are memoized in bounded, direct-mapped caches: a cached result is evicted
+// by any other pair of edge functions that maps to the same slot.
+//
+// In contrast to EdgeFunctionSingletonFactory, the store is owned by a single
+// solver and holds on to all edge functions it has seen until it is cleared;
+// no cleaner thread is required.
+//
+template <typename L> class EdgeFunctionStore {
+public:
+  using EdgeFunctionType = EdgeFunction<L>;
+  using EdgeFunctionPtrType = typename EdgeFunctionType::EdgeFunctionPtrType;
+
+  static constexpr size_t DefaultMemoCapacity = 1U << 16U;
+
+  explicit EdgeFunctionStore(size_t MemoCapacity = DefaultMemoCapacity)
+      : ComposeMemo(roundToPowerOfTwo(MemoCapacity)),
+        JoinMemo(roundToPowerOfTwo(MemoCapacity)) {}
+
+  EdgeFunctionStore(const EdgeFunctionStore &) = delete;
+  EdgeFunctionStore &operator=(const EdgeFunctionStore &) = delete;
+  EdgeFunctionStore(EdgeFunctionStore &&) = delete;
+  EdgeFunctionStore &operator=(EdgeFunctionStore &&) = delete;
+  ~EdgeFunctionStore() = default;
+
+  // Returns the canonical edge function that is equal_to F.
+  EdgeFunctionPtrType intern(const EdgeFunctionPtrType &F) {
+    auto Lock = lockIfConcurrent();
+    return internImpl(F);
+  }
+
+  // Returns the interned result of F->composeWith(G).
+  EdgeFunctionPtrType compose(const EdgeFunctionPtrType &F,
+                              const EdgeFunctionPtrType &G) {
+    return memoized(ComposeMemo, F, G, ComposeHits, ComposeMisses,
+                    [](const EdgeFunctionPtrType &F,
+                       const EdgeFunctionPtrType &G) {
+                      return F->composeWith(G);
+                    });
+  }
+
+  // Returns the interned result of F->joinWith(G).
+  EdgeFunctionPtrType join(const EdgeFunctionPtrType &F,
+                           const EdgeFunctionPtrType &G) {
+    return memoized(JoinMemo, F, G, JoinHits, JoinMisses,
+                    [](const EdgeFunctionPtrType &F,
+                       const EdgeFunctionPtrType &G) {
+                      return F->joinWith(G);
+                    });
+  }
+
+  // Checks whether F and G are equal_to each other. Interned edge functions
+  // that are equal are identical, hence, equal_to is only called for
+  // different objects, e.g. if an edge function's hash() is inconsistent with
+  // its equal_to().
+  static bool equal(const EdgeFunctionPtrType &F,
+                    const EdgeFunctionPtrType &G) {
+    return F == G || F->equal_to(G);
+  }
+
+  // Returns the number of distinct (canonical) edge functions.
+  [[nodiscard]] size_t size() const { return NumCanonical; }
+
+  [[nodiscard]] size_t getComposeHits() const { return ComposeHits; }
+  [[nodiscard]] size_t getComposeMisses() const { return ComposeMisses; }
+  [[nodiscard]] size_t getJoinHits() const { return JoinHits; }
+  [[nodiscard]] size_t getJoinMisses() const { return JoinMisses; }
+
+  // Releases all edge functions held by the store.
+  void clear() {
+    auto Lock = lockIfConcurrent();
+    Buckets.clear();
+    Canonical.clear();
+    std::fill(ComposeMemo.begin(), ComposeMemo.end(), MemoEntry{});
+    std::fill(JoinMemo.begin(), JoinMemo.end(), MemoEntry{});
+    NumCanonical = ComposeHits = ComposeMisses = JoinHits = JoinMisses = 0;
+  }
+
+  // Guards the store by a mutex such that it can be shared by concurrently
+  // running threads. Edge functions are composed and joined outside of the
+  // lock.
+  void setConcurrent(bool Set = true) { Concurrent = Set; }
+
+private:
+  struct MemoEntry {
+    const EdgeFunctionType *F = nullptr;
+    const EdgeFunctionType *G = nullptr;
+    EdgeFunctionPtrType Result;
+  };
+
+  // maps hash values to the canonical edge functions with that hash
+  std::unordered_map<size_t, llvm::SmallVector<EdgeFunctionPtrType, 1>>
+      Buckets;
+  // maps every edge function object that has been interned to its canonical
+  // representative; holds on to the object such that its address cannot be
+  // reused for another edge function
+  llvm::DenseMap<const EdgeFunctionType *,
+                 std::pair<EdgeFunctionPtrType, EdgeFunctionPtrType>>
+      Canonical;
+  std::vector<MemoEntry> ComposeMemo;
+  std::vector<MemoEntry> JoinMemo;
+  size_t NumCanonical = 0;
+  size_t ComposeHits = 0;
+  size_t ComposeMisses = 0;
+  size_t JoinHits = 0;
+  size_t JoinMisses = 0;
+  std::mutex StoreMutex;
+  bool Concurrent = false;
+
+  static size_t roundToPowerOfTwo(size_t N) {
+    size_t P = 1;
+    while (P < N) {
+      P <<= 1U;
+    }
+    return P;
+  }
+
+  std::unique_lock<std::mutex> lockIfConcurrent() {
+    return Concurrent ? std::unique_lock<std::mutex>(StoreMutex)
+                      : std::unique_lock<std::mutex>();
+  }
+
+  EdgeFunctionPtrType internImpl(const EdgeFunctionPtrType &F) {
+    if (auto Search = Canonical.find(F.get()); Search != Canonical.end()) {
+      return Search->second.second;
+    }
+    EdgeFunctionPtrType C = canonicalize(F);
+    Canonical.try_emplace(F.get(), F, C);
+    return C;
+  }
+
+  // Returns the canonical edge function that is equal_to F, F itself becomes
+  // the canonical one if there is none yet.
+  EdgeFunctionPtrType canonicalize(const EdgeFunctionPtrType &F) {
+    auto &Bucket = Buckets[F->hash()];
+    for (const auto &C : Bucket) {
+      if (C == F || C->equal_to(F)) {
+        return C;
+      }
+    }
+    ++NumCanonical;
+    Bucket.push_back(F);
+    Canonical.try_emplace(F.get(), F, F);
+    return F;
+  }
+
+  template <typename OpTy>
+  EdgeFunctionPtrType memoized(std::vector<MemoEntry> &Memo,
+                               const EdgeFunctionPtrType &F,
+                               const EdgeFunctionPtrType &G, size_t &Hits,
+                               size_t &Misses, OpTy Op) {
+    EdgeFunctionPtrType CF;
+    EdgeFunctionPtrType CG;
+    size_t Slot;
+    {
+      auto Lock = lockIfConcurrent();
+      CF = internImpl(F);
+      CG = internImpl(G);
+      Slot = llvm::DenseMapInfo<std::pair<const EdgeFunctionType *,
+                                          const EdgeFunctionType *>>::
+                 getHashValue({CF.get(), CG.get()}) &
+             (Memo.size() - 1);
+      const MemoEntry &Entry = Memo[Slot];
+      if (Entry.F == CF.get() && Entry.G == CG.get()) {
+        ++Hits;
+        return Entry.Result;
+      }
+      ++Misses;
+    }
+    EdgeFunctionPtrType Result = Op(CF, CG);
+    auto Lock = lockIfConcurrent();
+    // new results are not recorded as aliases, duplicates are thus released
+    if (auto Search = Canonical.find(Result.get()); Search != Canonical.end()) {
+      Result = Search->second.second;
+    } else {
+      Result = canonicalize(Result);
+    }
+    Memo[Slot] = MemoEntry{CF.get(), CG.get(), Result};
+    return Result;
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -30,6 +30,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <typeinfo>
 #include <utility>
 
 namespace psr {
@@ -80,6 +81,17 @@ public:
 
   virtual bool equal_to(EdgeFunctionPtrType OtherFunction) const = 0;
 
+  //
+  // This function computes a hash of the edge function that is used to intern
+  // edge functions (see EdgeFunctionStore). Edge functions that are equal_to
+  // each other should have the same hash, otherwise they are not shared. The
+  // default implementation only hashes the dynamic type; edge functions that
+  // carry data should override it to avoid collisions.
+  //
+  [[nodiscard]] virtual size_t hash() const {
+    return typeid(*this).hash_code();
+  }
+
   virtual void print(std::ostream &OS, bool IsForDebug = false) const {
     OS << "EdgeFunction";
   }
@@ -13,27 +13,44 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFact.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
-#include "phasar/Utils/EquivalenceClassMap.h"
+#include "phasar/Utils/Interner.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/ShardedCache.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 
 #include <algorithm>
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
-#include <tuple>
+#include <shared_mutex>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace psr {
 template <typename KeyT> class DefaultMapKeyCompressor {
 public:
   using KeyType = KeyT;
-  using CompressedType = KeyT;
+  using CompressedType = uint32_t;
+
+  [[nodiscard]] inline CompressedType getCompressedID(const KeyT &Key) {
+    return Ids.getOrInsert(Key);
+  }
+
+  [[nodiscard]] inline std::optional<CompressedType>
+  lookupCompressedID(const KeyT &Key) const {
+    return Ids.lookup(Key);
+  }
 
-  [[nodiscard]] inline CompressedType getCompressedID(KeyT Key) { return Key; }
+private:
+  Interner<KeyT, CompressedType> Ids;
 };
 
 template <typename... Ts> class MapKeyCompressorCombinator : public Ts... {
@@ -54,15 +71,63 @@ public:
     return Search->getSecond();
   }
 
+  [[nodiscard]] inline std::optional<CompressedType>
+  lookupCompressedID(KeyType Key) const {
+    auto Search = Map.find(Key);
+    if (Search == Map.end()) {
+      return std::nullopt;
+    }
+    return Search->getSecond();
+  }
+
 private:
   llvm::DenseMap<KeyType, CompressedType> Map{};
 };
 
+/// Compresses sets of compressed IDs, e.g. the callees of a call site, given
+/// as sorted vectors; equal sets are assigned the same ID.
+class IDSetKeyCompressor {
+public:
+  using KeyType = std::vector<uint32_t>;
+  using CompressedType = uint32_t;
+
+  [[nodiscard]] inline CompressedType getCompressedID(const KeyType &Key) {
+    return Map.try_emplace(Key, Map.size() + 1).first->second;
+  }
+
+  [[nodiscard]] inline std::optional<CompressedType>
+  lookupCompressedID(const KeyType &Key) const {
+    auto Search = Map.find(Key);
+    if (Search == Map.end()) {
+      return std::nullopt;
+    }
+    return Search->second;
+  }
+
+private:
+  struct KeyHash {
+    size_t operator()(const KeyType &Key) const {
+      return llvm::hash_combine_range(Key.begin(), Key.end());
+    }
+  };
+
+  std::unordered_map<KeyType, CompressedType, KeyHash> Map{};
+};
+
 /**
  * This class caches flow and edge functions to avoid their reconstruction.
  * When a flow or edge function must be applied to multiple times, a cached
  * version is used if existend, otherwise a new one is created and inserted
  * into the cache.
+ *
+ * The statements, facts and functions a flow or edge function is queried for
+ * are compressed into 32-bit IDs, see LLVMMapKeyCompressor, and the caches
+ * are hash maps keyed on combinations of these IDs. If the cache is shared by
+ * multiple solver threads, the caches are sharded, see ShardedCache, such
+ * that cached functions are looked up concurrently; the problem's flow and
+ * edge function factories are still called mutually exclusive. The hits,
+ * misses and sizes of the caches are exported to PAMM by
+ * exportStatistics().
  */
 template <typename AnalysisDomainTy,
           typename Container = std::set<typename AnalysisDomainTy::d_t>>
@@ -76,61 +141,53 @@ class FlowEdgeFunctionCache {
   using f_t = typename AnalysisDomainTy::f_t;
   using t_t = typename AnalysisDomainTy::t_t;
 
-  using DTKeyCompressorType = std::conditional_t<
-      std::is_base_of_v<llvm::Value, std::remove_pointer_t<d_t>>,
-      LLVMMapKeyCompressor, DefaultMapKeyCompressor<d_t>>;
-  using NTKeyCompressorType = std::conditional_t<
-      std::is_base_of_v<llvm::Value, std::remove_pointer_t<n_t>>,
-      LLVMMapKeyCompressor, DefaultMapKeyCompressor<n_t>>;
-
-  using MapKeyCompressorType = std::conditional_t<
-      std::is_same_v<NTKeyCompressorType, DTKeyCompressorType>,
-      NTKeyCompressorType,
-      MapKeyCompressorCombinator<NTKeyCompressorType, DTKeyCompressorType>>;
+  template <typename T>
+  using KeyCompressorType = std::conditional_t<
+      std::is_base_of_v<llvm::Value,
+                        std::remove_cv_t<std::remove_pointer_t<T>>>,
+      LLVMMapKeyCompressor, DefaultMapKeyCompressor<T>>;
 
 private:
-  MapKeyCompressorType KeyCompressor;
+  // the keys of the caches, made up of the IDs of up to six statements,
+  // facts or functions, see combineIds()
+  using Key2 = uint64_t;
+  using Key4 = std::pair<uint64_t, uint64_t>;
+  using Key6 = std::pair<Key4, uint64_t>;
 
-  using EdgeFuncInstKey = uint64_t;
-  using EdgeFuncNodeKey = std::conditional_t<
-      std::is_base_of_v<llvm::Value, std::remove_pointer_t<d_t>>, uint64_t,
-      std::pair<d_t, d_t>>;
-  using InnerEdgeFunctionMapType =
-      EquivalenceClassMap<EdgeFuncNodeKey, EdgeFunctionPtrType>;
+  KeyCompressorType<n_t> NodeCompressor;
+  KeyCompressorType<d_t> FactCompressor;
+  KeyCompressorType<f_t> FunctionCompressor;
+  IDSetKeyCompressor CalleesCompressor;
 
   IDETabulationProblem<AnalysisDomainTy, Container> &problem;
   // Auto add zero
   bool autoAddZero;
   d_t zeroValue;
 
-  struct NormalEdgeFlowData {
-    NormalEdgeFlowData(FlowFunctionPtrType Val)
-        : FlowFuncPtr(std::move(Val)), EdgeFunctionMap{} {}
-    NormalEdgeFlowData(InnerEdgeFunctionMapType Map)
-        : FlowFuncPtr(nullptr), EdgeFunctionMap{std::move(Map)} {}
-
-    FlowFunctionPtrType FlowFuncPtr;
-    InnerEdgeFunctionMapType EdgeFunctionMap;
-  };
-
-  // Caches for the flow/edge functions
-  std::map<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
-
   // Caches for the flow functions
-  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
-      ReturnFlowFunctionCache;
-  std::map<std::tuple<n_t, n_t, std::set<f_t>>, FlowFunctionPtrType>
-      CallToRetFlowFunctionCache;
+  ShardedCache<Key2, FlowFunctionPtrType> NormalFlowFunctionCache;
+  ShardedCache<Key2, FlowFunctionPtrType> CallFlowFunctionCache;
+  ShardedCache<Key4, FlowFunctionPtrType> ReturnFlowFunctionCache;
+  ShardedCache<Key4, FlowFunctionPtrType> CallToRetFlowFunctionCache;
   // Caches for the edge functions
-  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunctionPtrType>
-      CallEdgeFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      ReturnEdgeFunctionCache;
-  std::map<EdgeFuncInstKey, InnerEdgeFunctionMapType>
-      CallToRetEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      SummaryEdgeFunctionCache;
+  ShardedCache<Key4, EdgeFunctionPtrType> NormalEdgeFunctionCache;
+  ShardedCache<Key4, EdgeFunctionPtrType> CallEdgeFunctionCache;
+  ShardedCache<Key6, EdgeFunctionPtrType> ReturnEdgeFunctionCache;
+  ShardedCache<Key6, EdgeFunctionPtrType> CallToRetEdgeFunctionCache;
+  ShardedCache<Key4, EdgeFunctionPtrType> SummaryEdgeFunctionCache;
+
+  // Guards the problem's flow and edge function factories if the cache is
+  // shared by multiple solver threads
+  std::mutex FactoryMutex;
+  // Guards the key compressors if the cache is shared by multiple solver
+  // threads; compressed IDs are mostly looked up rather than inserted
+  std::shared_mutex CompressorMutex;
+  bool Concurrent = false;
+
+  std::unique_lock<std::mutex> lockIfConcurrent() {
+    return Concurrent ? std::unique_lock<std::mutex>(FactoryMutex)
+                      : std::unique_lock<std::mutex>();
+  }
 
 public:
   // Ctor allows access to the IDEProblem in order to get access to flow and
@@ -141,120 +198,62 @@ public:
         autoAddZero(problem.getIFDSIDESolverConfig().autoAddZero()),
         zeroValue(problem.getZeroValue()) {
     PAMM_GET_INSTANCE;
-    REG_COUNTER("Normal-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Normal-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the call flow functions
-    REG_COUNTER("Call-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Call-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for return flow functions
-    REG_COUNTER("Return-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Return-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the call to return flow functions
-    REG_COUNTER("CallToRet-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("CallToRet-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the summary flow functions
-    // REG_COUNTER("Summary-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    // REG_COUNTER("Summary-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the normal edge functions
-    REG_COUNTER("Normal-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Normal-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the call edge functions
-    REG_COUNTER("Call-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Call-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the return edge functions
-    REG_COUNTER("Return-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Return-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the call to return edge functions
-    REG_COUNTER("CallToRet-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("CallToRet-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
-    // Counters for the summary edge functions
-    REG_COUNTER("Summary-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Summary-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    forEachCache([&](const std::string &Name, auto &) {
+      REG_COUNTER(Name + " Construction", 0, PAMM_SEVERITY_LEVEL::Core);
+      REG_COUNTER(Name + " Cache Hit", 0, PAMM_SEVERITY_LEVEL::Core);
+      REG_COUNTER(Name + " Cache Size", 0, PAMM_SEVERITY_LEVEL::Core);
+    });
   }
 
   ~FlowEdgeFunctionCache() = default;
 
-  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = default;
-  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = default;
-
-  FlowEdgeFunctionCache(FlowEdgeFunctionCache &&FEFC) noexcept = default;
-  FlowEdgeFunctionCache &
-  operator=(FlowEdgeFunctionCache &&FEFC) noexcept = default;
+  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = delete;
+  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = delete;
+
+  FlowEdgeFunctionCache(FlowEdgeFunctionCache &&FEFC) = delete;
+  FlowEdgeFunctionCache &operator=(FlowEdgeFunctionCache &&FEFC) = delete;
+
+  /**
+   * Makes all queries thread-safe such that the cache can be shared by
+   * multiple threads. Cached functions are then looked up concurrently, flow
+   * and edge functions are constructed mutually exclusive, the functions
+   * themselves are applied concurrently.
+   */
+  void setConcurrent(bool Set = true) {
+    Concurrent = Set;
+    forEachCache([Set](const std::string &, auto &Cache) {
+      Cache.setConcurrent(Set);
+    });
+  }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Normal flow function factory call";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Curr Inst : " << problem.NtoString(curr);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Succ Inst : " << problem.NtoString(succ));
-    auto Key = createEdgeFunctionInstKey(curr, succ);
-    auto SearchNormalFlowFunction = NormalFunctionCache.find(Key);
-    if (SearchNormalFlowFunction != NormalFunctionCache.end()) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function fetched from cache";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      INC_COUNTER("Normal-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      if (SearchNormalFlowFunction->second.FlowFuncPtr != nullptr) {
-        return SearchNormalFlowFunction->second.FlowFuncPtr;
-      } else {
-        auto ff =
-            (autoAddZero)
-                ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
-                      problem.getNormalFlowFunction(curr, succ), zeroValue)
-                : problem.getNormalFlowFunction(curr, succ);
-        SearchNormalFlowFunction->second.FlowFuncPtr = ff;
-        return ff;
-      }
-    } else {
-      INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
-                          problem.getNormalFlowFunction(curr, succ), zeroValue)
-                    : problem.getNormalFlowFunction(curr, succ);
-      NormalFunctionCache.insert(std::make_pair(Key, NormalEdgeFlowData(ff)));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ff;
-    }
+    auto Key = combineIds(compressNode(curr), compressNode(succ));
+    return lookupOrConstruct(NormalFlowFunctionCache, Key, [&] {
+      return zeroed(problem.getNormalFlowFunction(curr, succ));
+    });
   }
 
   FlowFunctionPtrType getCallFlowFunction(n_t callStmt, f_t destFun) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Call flow function factory call";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Call Stmt : " << problem.NtoString(callStmt);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(F) Dest Fun : " << problem.FtoString(destFun));
-    auto Key = std::tie(callStmt, destFun);
-    auto SearchCallFlowFunction = CallFlowFunctionCache.find(Key);
-    if (SearchCallFlowFunction != CallFlowFunctionCache.end()) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function fetched from cache";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      INC_COUNTER("Call-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchCallFlowFunction->second;
-    } else {
-      INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff =
-          (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
-                    problem.getCallFlowFunction(callStmt, destFun), zeroValue)
-              : problem.getCallFlowFunction(callStmt, destFun);
-      CallFlowFunctionCache.insert(std::make_pair(Key, ff));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ff;
-    }
+    auto Key = combineIds(compressNode(callStmt), compressFunction(destFun));
+    return lookupOrConstruct(CallFlowFunctionCache, Key, [&] {
+      return zeroed(problem.getCallFlowFunction(callStmt, destFun));
+    });
   }
 
   FlowFunctionPtrType getRetFlowFunction(n_t callSite, f_t calleeFun,
                                          n_t exitStmt, n_t retSite) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Return flow function factory call";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -265,34 +264,16 @@ public:
                   << "(N) Exit Stmt : " << problem.NtoString(exitStmt);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Ret Site  : " << problem.NtoString(retSite));
-    auto Key = std::tie(callSite, calleeFun, exitStmt, retSite);
-    auto SearchReturnFlowFunction = ReturnFlowFunctionCache.find(Key);
-    if (SearchReturnFlowFunction != ReturnFlowFunctionCache.end()) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function fetched from cache";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      INC_COUNTER("Return-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchReturnFlowFunction->second;
-    } else {
-      INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
-                          problem.getRetFlowFunction(callSite, calleeFun,
-                                                     exitStmt, retSite),
-                          zeroValue)
-                    : problem.getRetFlowFunction(callSite, calleeFun, exitStmt,
-                                                 retSite);
-      ReturnFlowFunctionCache.insert(std::make_pair(Key, ff));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ff;
-    }
+    Key4 Key(combineIds(compressNode(callSite), compressFunction(calleeFun)),
+             combineIds(compressNode(exitStmt), compressNode(retSite)));
+    return lookupOrConstruct(ReturnFlowFunctionCache, Key, [&] {
+      return zeroed(
+          problem.getRetFlowFunction(callSite, calleeFun, exitStmt, retSite));
+    });
   }
 
   FlowFunctionPtrType getCallToRetFlowFunction(n_t callSite, n_t retSite,
                                                std::set<f_t> callees) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
             << "Call-to-Return flow function factory call";
@@ -304,34 +285,16 @@ public:
                                                                     : callees) {
           BOOST_LOG_SEV(lg::get(), DEBUG) << "  " << problem.FtoString(callee);
         });
-    auto Key = std::tie(callSite, retSite, callees);
-    auto SearchCallToRetFlowFunction = CallToRetFlowFunctionCache.find(Key);
-    if (SearchCallToRetFlowFunction != CallToRetFlowFunctionCache.end()) {
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function fetched from cache";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      INC_COUNTER("CallToRet-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchCallToRetFlowFunction->second;
-    } else {
-      INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff =
-          (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
-                    problem.getCallToRetFlowFunction(callSite, retSite,
-                                                     callees),
-                    zeroValue)
-              : problem.getCallToRetFlowFunction(callSite, retSite, callees);
-      CallToRetFlowFunctionCache.insert(std::make_pair(Key, ff));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Flow function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ff;
-    }
+    Key4 Key(combineIds(compressNode(callSite), compressNode(retSite)),
+             compressCallees(callees));
+    return lookupOrConstruct(CallToRetFlowFunctionCache, Key, [&] {
+      return zeroed(
+          problem.getCallToRetFlowFunction(callSite, retSite, callees));
+    });
   }
 
   FlowFunctionPtrType getSummaryFlowFunction(n_t callStmt, f_t destFun) {
-    // PAMM_GET_INSTANCE;
-    // INC_COUNTER("Summary-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto Lock = lockIfConcurrent();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Summary flow function factory call";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -345,7 +308,6 @@ public:
 
   EdgeFunctionPtrType getNormalEdgeFunction(n_t curr, d_t currNode, n_t succ,
                                             d_t succNode) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Normal edge function factory call";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -356,47 +318,16 @@ public:
                   << "(N) Succ Inst : " << problem.NtoString(succ);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Succ Node : " << problem.DtoString(succNode));
-
-    EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(curr, succ);
-    auto SearchInnerMap = NormalFunctionCache.find(OuterMapKey);
-    if (SearchInnerMap != NormalFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.EdgeFunctionMap.find(
-          createEdgeFunctionNodeKey(currNode, succNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.EdgeFunctionMap.end()) {
-        INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "Edge function fetched from cache";
-                      BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-        return SearchEdgeFunc->second;
-      }
-      INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
-
-      SearchInnerMap->second.EdgeFunctionMap.insert(
-          createEdgeFunctionNodeKey(currNode, succNode), ef);
-
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ef;
-    }
-    INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-    auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
-
-    NormalFunctionCache.try_emplace(
-        OuterMapKey, NormalEdgeFlowData(InnerEdgeFunctionMapType{std::make_pair(
-                         createEdgeFunctionNodeKey(currNode, succNode), ef)}));
-
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "Edge function constructed";
-                  BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-    return ef;
+    Key4 Key(combineIds(compressNode(curr), compressNode(succ)),
+             combineIds(compressFact(currNode), compressFact(succNode)));
+    return lookupOrConstruct(NormalEdgeFunctionCache, Key, [&] {
+      return problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
+    });
   }
 
   EdgeFunctionPtrType getCallEdgeFunction(n_t callStmt, d_t srcNode,
                                           f_t destinationFunction,
                                           d_t destNode) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG) << "Call edge function factory call";
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -407,30 +338,18 @@ public:
         << "(F) Dest Fun : " << problem.FtoString(destinationFunction);
         BOOST_LOG_SEV(lg::get(), DEBUG)
         << "(D) Dest Node : " << problem.DtoString(destNode));
-    auto Key = std::tie(callStmt, srcNode, destinationFunction, destNode);
-    auto SearchCallEdgeFunction = CallEdgeFunctionCache.find(Key);
-    if (SearchCallEdgeFunction != CallEdgeFunctionCache.end()) {
-      INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function fetched from cache";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return SearchCallEdgeFunction->second;
-    } else {
-      INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getCallEdgeFunction(callStmt, srcNode,
-                                            destinationFunction, destNode);
-      CallEdgeFunctionCache.insert(std::make_pair(Key, ef));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ef;
-    }
+    Key4 Key(combineIds(compressNode(callStmt), compressFact(srcNode)),
+             combineIds(compressFunction(destinationFunction),
+                        compressFact(destNode)));
+    return lookupOrConstruct(CallEdgeFunctionCache, Key, [&] {
+      return problem.getCallEdgeFunction(callStmt, srcNode,
+                                         destinationFunction, destNode);
+    });
   }
 
   EdgeFunctionPtrType getReturnEdgeFunction(n_t callSite, f_t calleeFunction,
                                             n_t exitStmt, d_t exitNode,
                                             n_t reSite, d_t retNode) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Return edge function factory call";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -445,31 +364,20 @@ public:
                   << "(N) Ret Site  : " << problem.NtoString(reSite);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retNode));
-    auto Key =
-        std::tie(callSite, calleeFunction, exitStmt, exitNode, reSite, retNode);
-    auto SearchReturnEdgeFunction = ReturnEdgeFunctionCache.find(Key);
-    if (SearchReturnEdgeFunction != ReturnEdgeFunctionCache.end()) {
-      INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function fetched from cache";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return SearchReturnEdgeFunction->second;
-    } else {
-      INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getReturnEdgeFunction(
-          callSite, calleeFunction, exitStmt, exitNode, reSite, retNode);
-      ReturnEdgeFunctionCache.insert(std::make_pair(Key, ef));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ef;
-    }
+    Key6 Key(
+        Key4(combineIds(compressNode(callSite),
+                        compressFunction(calleeFunction)),
+             combineIds(compressNode(exitStmt), compressFact(exitNode))),
+        combineIds(compressNode(reSite), compressFact(retNode)));
+    return lookupOrConstruct(ReturnEdgeFunctionCache, Key, [&] {
+      return problem.getReturnEdgeFunction(callSite, calleeFunction, exitStmt,
+                                           exitNode, reSite, retNode);
+    });
   }
 
   EdgeFunctionPtrType getCallToRetEdgeFunction(n_t callSite, d_t callNode,
                                                n_t retSite, d_t retSiteNode,
                                                std::set<f_t> callees) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
             << "Call-to-Return edge function factory call";
@@ -485,49 +393,18 @@ public:
                                                                     : callees) {
           BOOST_LOG_SEV(lg::get(), DEBUG) << "  " << problem.FtoString(callee);
         });
-
-    EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(callSite, retSite);
-    auto SearchInnerMap = CallToRetEdgeFunctionCache.find(OuterMapKey);
-    if (SearchInnerMap != CallToRetEdgeFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.find(
-          createEdgeFunctionNodeKey(callNode, retSiteNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.end()) {
-        INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "Edge function fetched from cache";
-                      BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-        return SearchEdgeFunc->second;
-      }
-      INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getNormalEdgeFunction(callSite, callNode, retSite,
-                                              retSiteNode);
-
-      SearchInnerMap->second.insert(
-          createEdgeFunctionNodeKey(callNode, retSiteNode), ef);
-
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ef;
-    }
-
-    INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-    auto ef =
-        problem.getNormalEdgeFunction(callSite, callNode, retSite, retSiteNode);
-
-    CallToRetEdgeFunctionCache.emplace(
-        OuterMapKey,
-        InnerEdgeFunctionMapType{std::make_pair(
-            createEdgeFunctionNodeKey(callNode, retSiteNode), ef)});
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "Edge function constructed";
-                  BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-    return ef;
+    Key6 Key(
+        Key4(combineIds(compressNode(callSite), compressNode(retSite)),
+             combineIds(compressFact(callNode), compressFact(retSiteNode))),
+        compressCallees(callees));
+    return lookupOrConstruct(CallToRetEdgeFunctionCache, Key, [&] {
+      return problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
+                                              retSiteNode, callees);
+    });
   }
 
   EdgeFunctionPtrType getSummaryEdgeFunction(n_t callSite, d_t callNode,
                                              n_t retSite, d_t retSiteNode) {
-    PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Summary edge function factory call";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -539,105 +416,62 @@ public:
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retSiteNode);
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-    auto Key = std::tie(callSite, callNode, retSite, retSiteNode);
-    auto SearchSummaryEdgeFunction = SummaryEdgeFunctionCache.find(Key);
-    if (SearchSummaryEdgeFunction != SummaryEdgeFunctionCache.end()) {
-      INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function fetched from cache";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return SearchSummaryEdgeFunction->second;
-    } else {
-      INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
-                                               retSiteNode);
-      SummaryEdgeFunctionCache.insert(std::make_pair(Key, ef));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                        << "Edge function constructed";
-                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ef;
+    Key4 Key(combineIds(compressNode(callSite), compressFact(callNode)),
+             combineIds(compressNode(retSite), compressFact(retSiteNode)));
+    return lookupOrConstruct(SummaryEdgeFunctionCache, Key, [&] {
+      return problem.getSummaryEdgeFunction(callSite, callNode, retSite,
+                                            retSiteNode);
+    });
+  }
+
+  /**
+   * Adds the hits and misses of each cache since the last export to the PAMM
+   * counters "<cache> Cache Hit" and "<cache> Construction", and sets
+   * "<cache> Cache Size" to the number of cached functions, e.g.
+   * "Normal-EF Cache Hit".
+   */
+  void exportStatistics() {
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      PAMM_GET_INSTANCE;
+      forEachCache([&](const std::string &Name, auto &Cache) {
+        INC_COUNTER(Name + " Cache Hit", Cache.getHits(),
+                    PAMM_SEVERITY_LEVEL::Core);
+        INC_COUNTER(Name + " Construction", Cache.getMisses(),
+                    PAMM_SEVERITY_LEVEL::Core);
+        DEC_COUNTER(Name + " Cache Size", GET_COUNTER(Name + " Cache Size"),
+                    PAMM_SEVERITY_LEVEL::Core);
+        INC_COUNTER(Name + " Cache Size", Cache.size(),
+                    PAMM_SEVERITY_LEVEL::Core);
+        Cache.resetStatistics();
+      });
     }
   }
 
   void print() {
-    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       PAMM_GET_INSTANCE;
+      exportStatistics();
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "=== Flow-Edge-Function Cache Statistics ===");
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Normal-flow function cache hits: "
-                    << GET_COUNTER("Normal-FF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Normal-flow function constructions: "
-                    << GET_COUNTER("Normal-FF Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call-flow function cache hits: "
-                    << GET_COUNTER("Call-FF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call-flow function constructions: "
-                    << GET_COUNTER("Call-FF Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Return-flow function cache hits: "
-                    << GET_COUNTER("Return-FF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Return-flow function constructions: "
-                    << GET_COUNTER("Return-FF Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call-to-Return-flow function cache hits: "
-                    << GET_COUNTER("CallToRet-FF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call-to-Return-flow function constructions: "
-                    << GET_COUNTER("CallToRet-FF Construction"));
-      // LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Summary-flow function
-      // cache hits: "
-      //                        << GET_COUNTER("Summary-FF Cache Hit"));
-      // LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Summary-flow function
-      // constructions: "
-      //                         << GET_COUNTER("Summary-FF Construction"));
+      forEachCache([&](const std::string &Name, auto &) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << Name << " cache: "
+                      << GET_COUNTER(Name + " Cache Hit") << " hits / "
+                      << GET_COUNTER(Name + " Construction")
+                      << " constructions, "
+                      << GET_COUNTER(Name + " Cache Size") << " entries");
+      });
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Total flow function cache hits: "
           << GET_SUM_COUNT({"Normal-FF Cache Hit", "Call-FF Cache Hit",
                             "Return-FF Cache Hit", "CallToRet-FF Cache Hit"}));
-      //"Summary-FF Cache Hit"});
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Total flow function constructions: "
           << GET_SUM_COUNT({"Normal-FF Construction", "Call-FF Construction",
                             "Return-FF Construction",
-                            "CallToRet-FF Construction" /*,
-                "Summary-FF Construction"*/}));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << ' ');
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Normal edge function cache hits: "
-                    << GET_COUNTER("Normal-EF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Normal edge function constructions: "
-                    << GET_COUNTER("Normal-EF Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call edge function cache hits: "
-                    << GET_COUNTER("Call-EF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call edge function constructions: "
-                    << GET_COUNTER("Call-EF Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Return edge function cache hits: "
-                    << GET_COUNTER("Return-EF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Return edge function constructions: "
-                    << GET_COUNTER("Return-EF Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call-to-Return edge function cache hits: "
-                    << GET_COUNTER("CallToRet-EF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Call-to-Return edge function constructions: "
-                    << GET_COUNTER("CallToRet-EF Construction"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Summary edge function cache hits: "
-                    << GET_COUNTER("Summary-EF Cache Hit"));
-      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
-                    << "Summary edge function constructions: "
-                    << GET_COUNTER("Summary-EF Construction"));
+                            "CallToRet-FF Construction"}));
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Total edge function cache hits: "
@@ -656,29 +490,77 @@ public:
     } else {
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
-          << "Cache statistics only recorded on PAMM severity level: Full.");
+          << "Cache statistics only recorded on PAMM severity level: Core.");
     }
   }
 
 private:
-  inline EdgeFuncInstKey createEdgeFunctionInstKey(n_t n1, n_t n2) {
-    uint64_t val = 0;
-    val |= KeyCompressor.getCompressedID(n1);
-    val <<= 32;
-    val |= KeyCompressor.getCompressedID(n2);
-    return val;
+  // calls Handler(name, cache) for each cache
+  template <typename HandlerFn> void forEachCache(HandlerFn Handler) {
+    Handler("Normal-FF", NormalFlowFunctionCache);
+    Handler("Call-FF", CallFlowFunctionCache);
+    Handler("Return-FF", ReturnFlowFunctionCache);
+    Handler("CallToRet-FF", CallToRetFlowFunctionCache);
+    Handler("Normal-EF", NormalEdgeFunctionCache);
+    Handler("Call-EF", CallEdgeFunctionCache);
+    Handler("Return-EF", ReturnEdgeFunctionCache);
+    Handler("CallToRet-EF", CallToRetEdgeFunctionCache);
+    Handler("Summary-EF", SummaryEdgeFunctionCache);
   }
 
-  inline EdgeFuncNodeKey createEdgeFunctionNodeKey(d_t d1, d_t d2) {
-    if constexpr (std::is_base_of_v<llvm::Value, std::remove_pointer_t<d_t>>) {
-      uint64_t val = 0;
-      val |= KeyCompressor.getCompressedID(d1);
-      val <<= 32;
-      val |= KeyCompressor.getCompressedID(d2);
-      return val;
-    } else {
-      return std::make_pair(d1, d2);
+  template <typename CacheT, typename ConstructFn>
+  typename CacheT::mapped_type
+  lookupOrConstruct(CacheT &Cache, const typename CacheT::key_type &Key,
+                    ConstructFn Construct) {
+    return Cache.getOrInsert(Key, [&] {
+      auto Lock = lockIfConcurrent();
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "Function constructed";
+                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+      return Construct();
+    });
+  }
+
+  FlowFunctionPtrType zeroed(FlowFunctionPtrType FF) {
+    if (!autoAddZero) {
+      return FF;
+    }
+    return std::make_shared<ZeroedFlowFunction<d_t, Container>>(std::move(FF),
+                                                                zeroValue);
+  }
+
+  // Returns the ID of Key; the compressor is only locked exclusively if Key
+  // has not been compressed before.
+  template <typename CompressorT, typename KeyT>
+  uint32_t compress(CompressorT &Compressor, const KeyT &Key) {
+    if (!Concurrent) {
+      return Compressor.getCompressedID(Key);
+    }
+    {
+      std::shared_lock<std::shared_mutex> Lock(CompressorMutex);
+      if (auto ID = Compressor.lookupCompressedID(Key)) {
+        return *ID;
+      }
+    }
+    std::unique_lock<std::shared_mutex> Lock(CompressorMutex);
+    return Compressor.getCompressedID(Key);
+  }
+
+  uint32_t compressNode(n_t Node) { return compress(NodeCompressor, Node); }
+
+  uint32_t compressFact(d_t Fact) { return compress(FactCompressor, Fact); }
+
+  uint32_t compressFunction(f_t Fun) {
+    return compress(FunctionCompressor, Fun);
+  }
+
+  uint32_t compressCallees(const std::set<f_t> &Callees) {
+    std::vector<uint32_t> IDs;
+    IDs.reserve(Callees.size());
+    for (f_t Callee : Callees) {
+      IDs.push_back(compressFunction(Callee));
     }
+    std::sort(IDs.begin(), IDs.end());
+    return compress(CalleesCompressor, IDs);
   }
 };
 
@@ -21,8 +21,11 @@
 #include <memory>
 #include <set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "llvm/ADT/ArrayRef.h"
+
 namespace psr {
 
 //===----------------------------------------------------------------------===//
@@ -32,6 +35,11 @@ namespace psr {
 //
 // This class models a flow function for distributive data-flow problems.
 //
+// Container is the type of set computeTargets() returns. As most flow
+// functions generate only a handful of facts from a source fact, analyses may
+// use SmallFlatSet, which stores few facts without allocating, instead of
+// std::set.
+//
 template <typename D, typename Container = std::set<D>> class FlowFunction {
   static_assert(std::is_same<typename Container::value_type, D>::value,
                 "Container values needs to be the same as D");
@@ -57,6 +65,25 @@ public:
   // details.
   //
   virtual container_type computeTargets(D Source) = 0;
+
+  //
+  // This function is called by the solvers for several data-flow facts that
+  // hold before the instruction under analysis in the same context, i.e. that
+  // have been reached from the same fact at the start of the procedure. The
+  // i-th element of the returned vector contains the facts that are generated
+  // from Sources[i]. By default, computeTargets() is called for each fact;
+  // flow functions that need to analyze their instruction for every source
+  // fact may override this function to do that analysis only once.
+  //
+  virtual std::vector<container_type>
+  computeTargetsBatch(llvm::ArrayRef<D> Sources) {
+    std::vector<container_type> Targets;
+    Targets.reserve(Sources.size());
+    for (const D &Source : Sources) {
+      Targets.push_back(computeTargets(Source));
+    }
+    return Targets;
+  }
 };
 
 template <typename D, typename Container = std::set<D>>
@@ -269,7 +296,8 @@ class KillMultiple : public FlowFunction<D, Container> {
 public:
   using typename FlowFunction<D, Container>::container_type;
 
-  KillMultiple(std::set<D> killValues) : killValues(killValues) {}
+  KillMultiple(container_type killValues)
+      : killValues(std::move(killValues)) {}
   virtual ~KillMultiple() = default;
   container_type computeTargets(D source) override {
     if (killValues.find(source) != killValues.end()) {
@@ -292,7 +320,7 @@ public:
   KillAll(const KillAll &k) = delete;
   KillAll &operator=(const KillAll &k) = delete;
   container_type computeTargets(D source) override { return container_type(); }
-  static std::shared_ptr<KillAll<D>> getInstance() {
+  static std::shared_ptr<KillAll> getInstance() {
     static std::shared_ptr<KillAll> instance =
         std::shared_ptr<KillAll>(new KillAll);
     return instance;
@@ -379,6 +407,18 @@ public:
     }
   }
 
+  // Forwards to the delegate, such that its batched implementation is used.
+  std::vector<container_type>
+  computeTargetsBatch(llvm::ArrayRef<D> sources) override {
+    std::vector<container_type> result = delegate->computeTargetsBatch(sources);
+    for (size_t idx = 0; idx < sources.size(); ++idx) {
+      if (sources[idx] == zerovalue) {
+        result[idx].insert(zerovalue);
+      }
+    }
+    return result;
+  }
+
 private:
   FlowFunctionPtrType delegate;
   D zerovalue;
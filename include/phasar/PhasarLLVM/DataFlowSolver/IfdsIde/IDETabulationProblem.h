@@ -17,12 +17,14 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_IDETABULATIONPROBLEM_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_IDETABULATIONPROBLEM_H_
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <set>
 #include <string>
 
 #include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/CheckpointIO.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
@@ -62,6 +64,31 @@ public:
             IRDB, TH, ICF, PT, std::move(EntryPoints)) {}
   ~IDETabulationProblem() override = default;
   virtual EdgeFunctionPtrType allTopFunction() = 0;
+
+  /**
+   * Writes an analysis-specific edge function F to a solver checkpoint, see
+   * IFDSIDESolverConfig::setCheckpointFile(). Edge functions that F is made
+   * of are written using WriteEF. Returns false if F cannot be checkpointed,
+   * which is the default. The solver itself handles EdgeIdentity, AllTop,
+   * AllBottom and allTopFunction().
+   */
+  virtual bool
+  writeEdgeFunction(CheckpointWriter &W, const EdgeFunctionPtrType &F,
+                    const std::function<bool(const EdgeFunctionPtrType &)>
+                        &WriteEF) {
+    return false;
+  }
+
+  /**
+   * Reads an edge function written by writeEdgeFunction(), edge functions
+   * written using WriteEF are read using ReadEF. Returns nullptr if the
+   * checkpoint is corrupt.
+   */
+  virtual EdgeFunctionPtrType
+  readEdgeFunction(CheckpointReader &R,
+                   const std::function<EdgeFunctionPtrType()> &ReadEF) {
+    return nullptr;
+  }
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winconsistent-missing-override"
   virtual void emitTextReport(const SolverResults<n_t, d_t, l_t> &SR,
@@ -18,6 +18,7 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 
 #include <iosfwd>
+#include <string>
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/Utils/EnumFlags.h"
@@ -34,10 +35,30 @@ enum class SolverConfigOptions : uint32_t {
   RecordEdges = 8,
   EmitESG = 16,
   ComputePersistedSummaries = 32,
+  InternEdgeFunctions = 64,
+  LowMemory = 128,
+  ResumeFromCheckpoint = 256,
+  BuildFactIndex = 512,
+  SparsePropagation = 1024,
+  CompressIdentityChains = 2048,
+  BatchFlowFunctions = 4096,
 
   All = ~0u
 };
 
+/// Determines the order in which the IFDS/IDE solvers process pending path
+/// edges.
+enum class WorklistPolicy {
+#define WORKLIST_POLICY_TYPES(NAME, CMDFLAG, TYPE) TYPE,
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistPolicies.def"
+};
+
+std::string toString(const WorklistPolicy &P);
+
+WorklistPolicy toWorklistPolicy(const std::string &S);
+
+std::ostream &operator<<(std::ostream &OS, const WorklistPolicy &P);
+
 struct IFDSIDESolverConfig {
   IFDSIDESolverConfig();
   IFDSIDESolverConfig(SolverConfigOptions Options);
@@ -53,13 +74,91 @@ struct IFDSIDESolverConfig {
   bool recordEdges() const;
   bool emitESG() const;
   bool computePersistedSummaries() const;
+  bool internEdgeFunctions() const;
+  bool lowMemory() const;
+  bool resumeFromCheckpoint() const;
+  bool buildFactIndex() const;
+  bool sparsePropagation() const;
+  bool compressIdentityChains() const;
+  bool batchFlowFunctions() const;
+  const std::string &checkpointFile() const;
+  unsigned checkpointInterval() const;
+  unsigned progressInterval() const;
+  unsigned numHotFunctions() const;
+  const std::string &summaryCacheDirectory() const;
+  WorklistPolicy worklistPolicy() const;
+  unsigned numThreads() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
   void setComputeValues(bool Set = true);
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
+  /// Lets the IDE solver write the end summaries it has computed to the
+  /// summary cache directory once the exploded super-graph has been
+  /// constructed.
   void setComputePersistedSummaries(bool Set = true);
+  /// Lets the IDE solver share equal edge functions and memoize their
+  /// compositions and joins, see EdgeFunctionStore.
+  void setInternEdgeFunctions(bool Set = true);
+  /// Lets the IDE solver release the jump functions of intra-procedural
+  /// statements as soon as no path edge of their function is pending while
+  /// the exploded super-graph is constructed, unless the solver runs
+  /// concurrently or writes checkpoints, and all remaining ones once it has
+  /// been constructed; they are recomputed function by function to compute
+  /// the values.
+  void setLowMemory(bool Set = true);
+  /// Lets the IDE solver restore its state from the checkpoint file, if
+  /// present, instead of starting from the initial seeds.
+  void setResumeFromCheckpoint(bool Set = true);
+  /// Lets the IDE solver and the NativeIFDSSolver build a FactIndex after the
+  /// results have been computed, such that the statements a fact holds at can
+  /// be queried without scanning all results, see
+  /// SolverResults::forEachResultOf().
+  void setBuildFactIndex(bool Set = true);
+  /// Lets the IDE solver and the NativeIFDSSolver propagate data-flow facts
+  /// sparsely: a fact is passed on directly to the next statements that are
+  /// relevant for it, skipping the statements in between, see
+  /// IFDSTabulationProblem::isSparseRelevant(). The results at the skipped
+  /// statements are reconstructed, they are the same as without sparse
+  /// propagation.
+  void setSparsePropagation(bool Set = true);
+  /// Lets the IDE solver and the NativeIFDSSolver collapse the chains of
+  /// statements that are the identity for every fact before constructing the
+  /// exploded super-graph, see IdentityChains and
+  /// IFDSTabulationProblem::isIdentityStmt().
+  void setCompressIdentityChains(bool Set = true);
+  /// Lets the sequential IDE solver apply a normal, call or return flow
+  /// function to all facts that are pending at the same statement for the
+  /// same source fact at once, see FlowFunction::computeTargetsBatch().
+  void setBatchFlowFunctions(bool Set = true);
+  /// Sets the file the IDE solver periodically writes its state to while
+  /// constructing the exploded super-graph; an empty path disables
+  /// checkpointing.
+  void setCheckpointFile(std::string File);
+  /// Sets the minimal number of seconds between two checkpoints; 0 writes a
+  /// checkpoint after every path edge, which is only meant for testing.
+  void setCheckpointInterval(unsigned Seconds);
+  /// Sets the minimal number of seconds between two progress reports of the
+  /// IDE solver and the NativeIFDSSolver; 0 disables them. Progress is only
+  /// reported if PAMM is enabled, see SolverTelemetry.
+  void setProgressInterval(unsigned Seconds);
+  /// Sets the number of functions the IDE solver or the NativeIFDSSolver has
+  /// spent the most work on that are reported once the problem has been
+  /// solved if PAMM is enabled.
+  void setNumHotFunctions(unsigned Num);
+  /// Sets the directory of the IDE solver's summary cache: the end summaries
+  /// of a function that are found there are re-used instead of analyzing the
+  /// function, see computePersistedSummaries(). No values are computed for
+  /// the function's statements in the calling contexts whose summaries are
+  /// re-used, see IDESolver::getFunctionsSummarizedFromCache(); hence, the
+  /// AnalysisController does not emit results while the cache is used. An
+  /// empty path disables the cache.
+  void setSummaryCacheDirectory(std::string Directory);
+  void setWorklistPolicy(WorklistPolicy Policy);
+  /// Sets the number of threads used to construct the exploded super-graph;
+  /// a value of 1 results in the (default) sequential solver.
+  void setNumThreads(unsigned NumThreads);
 
   friend std::ostream &operator<<(std::ostream &OS,
                                   const IFDSIDESolverConfig &SC);
@@ -68,6 +167,13 @@ private:
   SolverConfigOptions Options = SolverConfigOptions::AutoAddZero |
                                 SolverConfigOptions::ComputeValues |
                                 SolverConfigOptions::RecordEdges;
+  WorklistPolicy Policy = WorklistPolicy::LIFO;
+  unsigned NumThreads = 1;
+  std::string CheckpointFile;
+  unsigned CheckpointInterval = 600;
+  unsigned ProgressInterval = 10;
+  unsigned NumHotFunctions = 10;
+  std::string SummaryCacheDirectory;
 };
 
 } // namespace psr
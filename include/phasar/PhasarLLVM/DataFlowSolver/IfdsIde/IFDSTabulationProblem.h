@@ -21,6 +21,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <typeinfo>
 
 #include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
@@ -120,6 +121,50 @@ public:
   }
 
   virtual bool setSoundnessFlag(SoundnessFlag SF) { return false; }
+
+  /**
+   * Returns the name under which the IDE solver caches the end summaries of
+   * this analysis, see IFDSIDESolverConfig::setSummaryCacheDirectory(). The
+   * name must identify the analysis and everything its flow and edge
+   * functions depend on besides the IR, e.g. its configuration. Since the
+   * functions whose summaries are found in the cache are not analyzed, an
+   * analysis that records results while its flow functions are applied must
+   * not be cached, which is indicated by an empty name, the default.
+   */
+  [[nodiscard]] virtual std::string getSummaryCacheName() const { return ""; }
+
+  /**
+   * Returns the name that identifies this analysis in the IDE solver's
+   * checkpoints, see IFDSIDESolverConfig::setCheckpointFile(); a checkpoint
+   * is only restored by the analysis that has written it. Defaults to the
+   * name of the analysis' type. Analyses whose flow and edge functions
+   * depend on their configuration should add it to the name.
+   */
+  [[nodiscard]] virtual std::string getCheckpointName() const {
+    return typeid(*this).name();
+  }
+
+  /**
+   * Returns whether the normal flow function of Stmt, and for IDE analyses
+   * its normal edge functions, may treat Fact other than the identity. If
+   * the solver propagates sparsely, see
+   * IFDSIDESolverConfig::setSparsePropagation(), a fact is passed on across
+   * the statements it is not relevant for to the next statements that are;
+   * call sites and exit statements are always relevant. By default, every
+   * statement is relevant for every fact.
+   */
+  [[nodiscard]] virtual bool isSparseRelevant(n_t Stmt, d_t Fact) const {
+    return true;
+  }
+
+  /**
+   * Returns whether the normal flow function of Stmt, and for IDE analyses
+   * its normal edge functions, are the identity for every fact. The solver
+   * may then collapse chains of such statements, see
+   * IFDSIDESolverConfig::setCompressIdentityChains(). Returns false by
+   * default.
+   */
+  [[nodiscard]] virtual bool isIdentityStmt(n_t Stmt) const { return false; }
 };
 } // namespace psr
 
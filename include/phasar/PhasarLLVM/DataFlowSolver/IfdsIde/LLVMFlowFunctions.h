@@ -14,6 +14,9 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
 #include "phasar/Utils/LLVMShorthands.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Instructions.h"
 
@@ -38,7 +41,12 @@ namespace psr {
  * super-graph.
  * @brief Automatically kills temporary loads that are no longer in use.
  */
-class AutoKillTMPs : public FlowFunction<const llvm::Value *> {
+template <typename Container = std::set<const llvm::Value *>>
+class AutoKillTMPs : public FlowFunction<const llvm::Value *, Container> {
+  using typename FlowFunction<const llvm::Value *, Container>::container_type;
+  using typename FlowFunction<const llvm::Value *,
+                              Container>::FlowFunctionPtrType;
+
 protected:
   FlowFunctionPtrType delegate;
   const llvm::Instruction *inst;
@@ -62,6 +70,31 @@ public:
 //===----------------------------------------------------------------------===//
 // Mapping functions
 
+/**
+ * @brief Returns the allocations of the %struct.__va_list_tag arrays, i.e.
+ *   alloca [1 x %struct.__va_list_tag], align 16
+ * through which the function F accesses its variadic arguments.
+ */
+inline std::vector<const llvm::AllocaInst *>
+getVarArgAllocas(const llvm::Function *F) {
+  std::vector<const llvm::AllocaInst *> Allocas;
+  for (const auto &BB : *F) {
+    for (const auto &I : BB) {
+      if (const auto *Alloc = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+        if (Alloc->getAllocatedType()->isArrayTy() &&
+            Alloc->getAllocatedType()->getArrayNumElements() > 0 &&
+            Alloc->getAllocatedType()->getArrayElementType()->isStructTy() &&
+            Alloc->getAllocatedType()
+                    ->getArrayElementType()
+                    ->getStructName() == "struct.__va_list_tag") {
+          Allocas.push_back(Alloc);
+        }
+      }
+    }
+  }
+  return Allocas;
+}
+
 /**
  * A predicate can be used to specify additional requirements for the
  * propagation.
@@ -165,23 +198,8 @@ public:
               // Over-approximate by trying to add the
               //   alloca [1 x %struct.__va_list_tag], align 16
               // to the results
-              // find the allocated %struct.__va_list_tag and generate it
-              for (const auto &BB : *DestFun) {
-                for (const auto &I : BB) {
-                  if (const auto *Alloc =
-                          llvm::dyn_cast<llvm::AllocaInst>(&I)) {
-                    if (Alloc->getAllocatedType()->isArrayTy() &&
-                        Alloc->getAllocatedType()->getArrayNumElements() > 0 &&
-                        Alloc->getAllocatedType()
-                            ->getArrayElementType()
-                            ->isStructTy() &&
-                        Alloc->getAllocatedType()
-                                ->getArrayElementType()
-                                ->getStructName() == "struct.__va_list_tag") {
-                      Res.insert(Alloc);
-                    }
-                  }
-                }
+              for (const auto *Alloc : getVarArgAllocas(DestFun)) {
+                Res.insert(Alloc);
               }
             } else {
               assert(Idx < Formals.size() &&
@@ -208,6 +226,54 @@ public:
       return {Source};
     }
   }
+
+  // Looks up the positions of the actual parameters and the allocations of
+  // the variadic arguments once for all facts.
+  std::vector<container_type>
+  computeTargetsBatch(llvm::ArrayRef<const llvm::Value *> Sources) override {
+    std::vector<container_type> Targets(Sources.size());
+    // If DestFun is a declaration we cannot follow this call, we thus need to
+    // kill everything
+    if (DestFun->isDeclaration()) {
+      return Targets;
+    }
+    llvm::DenseMap<const llvm::Value *, llvm::SmallVector<unsigned, 1>>
+        ActualIndices;
+    bool MapsVarArgs = false;
+    for (unsigned Idx = 0; Idx < Actuals.size(); ++Idx) {
+      if (Predicate(Actuals[Idx])) {
+        ActualIndices[Actuals[Idx]].push_back(Idx);
+        MapsVarArgs |= DestFun->isVarArg() && Idx >= DestFun->arg_size();
+      }
+    }
+    std::vector<const llvm::AllocaInst *> VarArgAllocas;
+    if (MapsVarArgs) {
+      VarArgAllocas = getVarArgAllocas(DestFun);
+    }
+    for (size_t I = 0; I < Sources.size(); ++I) {
+      if (LLVMZeroValue::getInstance()->isLLVMZeroValue(Sources[I])) {
+        // Pass ZeroValue as is
+        Targets[I].insert(Sources[I]);
+        continue;
+      }
+      auto Search = ActualIndices.find(Sources[I]);
+      if (Search == ActualIndices.end()) {
+        continue;
+      }
+      for (unsigned Idx : Search->second) {
+        if (DestFun->isVarArg() && Idx >= DestFun->arg_size()) {
+          for (const auto *Alloc : VarArgAllocas) {
+            Targets[I].insert(Alloc);
+          }
+        } else {
+          assert(Idx < Formals.size() &&
+                 "Out of bound access to formal parameters!");
+          Targets[I].insert(Formals[Idx]); // corresponding formal
+        }
+      }
+    }
+    return Targets;
+  }
 };
 
 /**
@@ -265,27 +331,12 @@ public:
 
       // Handle C-style varargs functions
       if (CalleeFun->isVarArg()) {
-        const llvm::Instruction *AllocVarArg;
         // Find the allocation of %struct.__va_list_tag
-        for (const auto &BB : *CalleeFun) {
-          for (const auto &I : BB) {
-            if (const auto *Alloc = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
-              if (Alloc->getAllocatedType()->isArrayTy() &&
-                  Alloc->getAllocatedType()->getArrayNumElements() > 0 &&
-                  Alloc->getAllocatedType()
-                      ->getArrayElementType()
-                      ->isStructTy() &&
-                  Alloc->getAllocatedType()
-                          ->getArrayElementType()
-                          ->getStructName() == "struct.__va_list_tag") {
-                AllocVarArg = Alloc;
-                // TODO break out this nested loop earlier (without goto ;-)
-              }
-            }
-          }
-        }
+        auto VarArgAllocas = getVarArgAllocas(CalleeFun);
+        const llvm::Instruction *AllocVarArg =
+            VarArgAllocas.empty() ? nullptr : VarArgAllocas.back();
         // Generate the varargs things by using an over-approximation
-        if (Source == AllocVarArg) {
+        if (AllocVarArg && Source == AllocVarArg) {
           for (unsigned Idx = Formals.size(); Idx < Actuals.size(); ++Idx) {
             Res.insert(Actuals[Idx]);
           }
@@ -308,12 +359,64 @@ public:
       return {Source};
     }
   }
+
+  // Looks up the positions of the formal parameters and the allocation of
+  // the variadic arguments once for all facts.
+  std::vector<container_type>
+  computeTargetsBatch(llvm::ArrayRef<const llvm::Value *> Sources) override {
+    assert(!CalleeFun->isDeclaration() &&
+           "Cannot perform mapping to caller for function declaration");
+    std::vector<container_type> Targets(Sources.size());
+    llvm::DenseMap<const llvm::Value *, llvm::SmallVector<unsigned, 1>>
+        FormalIndices;
+    for (unsigned Idx = 0; Idx < Formals.size(); ++Idx) {
+      if (ParamPredicate(Formals[Idx])) {
+        FormalIndices[Formals[Idx]].push_back(Idx);
+      }
+    }
+    const llvm::Instruction *AllocVarArg = nullptr;
+    if (CalleeFun->isVarArg()) {
+      auto VarArgAllocas = getVarArgAllocas(CalleeFun);
+      AllocVarArg = VarArgAllocas.empty() ? nullptr : VarArgAllocas.back();
+    }
+    const llvm::Value *RetVal =
+        ReturnPredicate(CalleeFun) ? ExitStmt->getReturnValue() : nullptr;
+    for (size_t I = 0; I < Sources.size(); ++I) {
+      const llvm::Value *Source = Sources[I];
+      if (LLVMZeroValue::getInstance()->isLLVMZeroValue(Source)) {
+        // Pass ZeroValue as is
+        Targets[I].insert(Source);
+        continue;
+      }
+      // Generate the varargs things by using an over-approximation
+      if (AllocVarArg && Source == AllocVarArg) {
+        for (unsigned Idx = Formals.size(); Idx < Actuals.size(); ++Idx) {
+          Targets[I].insert(Actuals[Idx]);
+        }
+      }
+      // Map formal parameter into corresponding actual parameter.
+      if (auto Search = FormalIndices.find(Source);
+          Search != FormalIndices.end()) {
+        for (unsigned Idx : Search->second) {
+          Targets[I].insert(Actuals[Idx]); // corresponding actual
+        }
+      }
+      // Collect return value facts
+      if (RetVal && Source == RetVal) {
+        Targets[I].insert(CallSite.getInstruction());
+      }
+    }
+    return Targets;
+  }
 };
 
 //===----------------------------------------------------------------------===//
 // Propagation flow functions
 
-template <typename D> class PropagateLoad : public FlowFunction<D> {
+template <typename D, typename Container = std::set<D>>
+class PropagateLoad : public FlowFunction<D, Container> {
+  using typename FlowFunction<D, Container>::container_type;
+
 protected:
   const llvm::LoadInst *Load;
 
@@ -321,7 +424,7 @@ public:
   PropagateLoad(const llvm::LoadInst *L) : Load(L) {}
   virtual ~PropagateLoad() = default;
 
-  std::set<D> computeTargets(D source) override {
+  container_type computeTargets(D source) override {
     if (source == Load->getPointerOperand()) {
       return {source, Load};
     }
@@ -329,7 +432,10 @@ public:
   }
 };
 
-template <typename D> class PropagateStore : public FlowFunction<D> {
+template <typename D, typename Container = std::set<D>>
+class PropagateStore : public FlowFunction<D, Container> {
+  using typename FlowFunction<D, Container>::container_type;
+
 protected:
   const llvm::StoreInst *Store;
 
@@ -337,7 +443,7 @@ public:
   PropagateStore(const llvm::StoreInst *S) : Store(S) {}
   virtual ~PropagateStore() = default;
 
-  std::set<D> computeTargets(D source) override {
+  container_type computeTargets(D source) override {
     if (Store->getValueOperand() == source) {
       return {source, Store->getPointerOperand()};
     }
@@ -348,7 +454,10 @@ public:
 //===----------------------------------------------------------------------===//
 // Update flow functions
 
-template <typename D> class StrongUpdateStore : public FlowFunction<D> {
+template <typename D, typename Container = std::set<D>>
+class StrongUpdateStore : public FlowFunction<D, Container> {
+  using typename FlowFunction<D, Container>::container_type;
+
 protected:
   const llvm::StoreInst *Store;
   std::function<bool(D)> Predicate;
@@ -358,7 +467,7 @@ public:
       : Store(S), Predicate(P) {}
   virtual ~StrongUpdateStore() = default;
 
-  std::set<D> computeTargets(D source) override {
+  container_type computeTargets(D source) override {
     if (source == Store->getPointerOperand()) {
       return {};
     } else if (Predicate(source)) {
@@ -105,6 +105,9 @@ public:
 
 private:
   std::function<EdgeFactGeneratorTy> edgeFactGen;
+  // indexes the edge facts of all label sets generated by this analysis
+  std::shared_ptr<BitVectorSetIndexer<e_t>> EdgeFactIndexer =
+      std::make_shared<BitVectorSetIndexer<e_t>>();
   static inline const l_t BottomElement = Bottom{};
   static inline const l_t TopElement = Top{};
   // bool GeneratedGlobalVariables = false;
@@ -112,7 +115,7 @@ private:
   inline BitVectorSet<e_t> edgeFactGenToBitVectorSet(n_t curr) {
     if (edgeFactGen) {
       auto Results = edgeFactGen(curr);
-      BitVectorSet<e_t> BVS(Results.begin(), Results.end());
+      BitVectorSet<e_t> BVS(Results.begin(), Results.end(), EdgeFactIndexer);
       return BVS;
     }
     return {};
@@ -513,7 +516,8 @@ public:
     if (edgeFactGen) {
       EdgeFacts = edgeFactGen(curr);
       // fill BitVectorSet
-      UserEdgeFacts = BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end());
+      UserEdgeFacts = BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end(),
+                                        EdgeFactIndexer);
     }
 
     // override at store instructions
@@ -970,8 +974,8 @@ protected:
     if (Rhs == TopElement) {
       return Lhs;
     }
-    auto LhsSet = std::get<BitVectorSet<e_t>>(Lhs);
-    auto RhsSet = std::get<BitVectorSet<e_t>>(Rhs);
+    const auto &LhsSet = std::get<BitVectorSet<e_t>>(Lhs);
+    const auto &RhsSet = std::get<BitVectorSet<e_t>>(Rhs);
     return LhsSet.setUnion(RhsSet);
   }
 
@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -19,6 +20,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionComposer.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+#include "phasar/Utils/SmallFlatSet.h"
 
 namespace llvm {
 class Instruction;
@@ -32,6 +34,7 @@ namespace psr {
 struct IDELinearConstantAnalysisDomain : public LLVMAnalysisDomainDefault {
   // int64_t corresponds to llvm's type of constant integer
   using l_t = int64_t;
+  using jf_storage_t = CompactJumpFunctionStorage;
 };
 
 class LLVMBasedICFG;
@@ -39,7 +42,8 @@ class LLVMTypeHierarchy;
 class LLVMPointsToInfo;
 
 class IDELinearConstantAnalysis
-    : public IDETabulationProblem<IDELinearConstantAnalysisDomain> {
+    : public IDETabulationProblem<IDELinearConstantAnalysisDomain,
+                                  SmallFlatSet<const llvm::Value *>> {
 private:
   // For debug purpose only
   static unsigned CurrGenConstantId;
@@ -48,7 +52,9 @@ private:
 
 public:
   using IDETabProblemType =
-      IDETabulationProblem<IDELinearConstantAnalysisDomain>;
+      IDETabulationProblem<IDELinearConstantAnalysisDomain,
+                           SmallFlatSet<const llvm::Value *>>;
+  using typename IDETabProblemType::container_type;
   using typename IDETabProblemType::d_t;
   using typename IDETabProblemType::f_t;
   using typename IDETabProblemType::i_t;
@@ -101,6 +107,10 @@ public:
 
   bool isZeroValue(d_t d) const override;
 
+  bool isIdentityStmt(n_t Stmt) const override;
+
+  [[nodiscard]] std::string getSummaryCacheName() const override;
+
   // in addition provide specifications for the IDE parts
 
   std::shared_ptr<EdgeFunction<l_t>>
@@ -131,6 +141,16 @@ public:
 
   std::shared_ptr<EdgeFunction<l_t>> allTopFunction() override;
 
+  bool writeEdgeFunction(
+      CheckpointWriter &W, const std::shared_ptr<EdgeFunction<l_t>> &F,
+      const std::function<bool(const std::shared_ptr<EdgeFunction<l_t>> &)>
+          &WriteEF) override;
+
+  std::shared_ptr<EdgeFunction<l_t>> readEdgeFunction(
+      CheckpointReader &R,
+      const std::function<std::shared_ptr<EdgeFunction<l_t>>()> &ReadEF)
+      override;
+
   // Custom EdgeFunction declarations
 
   class LCAEdgeFunctionComposer : public EdgeFunctionComposer<l_t> {
@@ -149,6 +169,7 @@ public:
   class GenConstant : public EdgeFunction<l_t>,
                       public std::enable_shared_from_this<GenConstant> {
   private:
+    friend class IDELinearConstantAnalysis;
     const unsigned GenConstant_Id;
     const l_t IntConst;
 
@@ -165,6 +186,8 @@ public:
 
     bool equal_to(std::shared_ptr<EdgeFunction<l_t>> other) const override;
 
+    [[nodiscard]] size_t hash() const override;
+
     void print(std::ostream &OS, bool isForDebug = false) const override;
   };
 
@@ -192,6 +215,7 @@ public:
   class BinOp : public EdgeFunction<l_t>,
                 public std::enable_shared_from_this<BinOp> {
   private:
+    friend class IDELinearConstantAnalysis;
     const unsigned EdgeFunctionID, Op;
     d_t lop, rop, currNode;
 
@@ -208,6 +232,8 @@ public:
 
     bool equal_to(std::shared_ptr<EdgeFunction<l_t>> other) const override;
 
+    [[nodiscard]] size_t hash() const override;
+
     void print(std::ostream &OS, bool isForDebug = false) const override;
   };
 
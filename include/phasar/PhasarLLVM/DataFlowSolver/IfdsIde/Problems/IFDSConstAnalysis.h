@@ -19,6 +19,7 @@
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+#include "phasar/Utils/SmallFlatSet.h"
 
 // Forward declaration of types for which we only use its pointer or ref type
 namespace llvm {
@@ -44,7 +45,8 @@ class LLVMTypeHierarchy;
  * @brief Computes all possibly mutable memory locations.
  */
 class IFDSConstAnalysis
-    : public IFDSTabulationProblem<LLVMAnalysisDomainDefault> {
+    : public IFDSTabulationProblem<LLVMAnalysisDomainDefault,
+                                   SmallFlatSet<const llvm::Value *>> {
 private:
   // Holds all allocated memory locations, including global variables
   std::set<d_t> AllMemLocs; // FIXME: initialize within the constructor body!
@@ -59,6 +59,8 @@ public:
 
   bool isZeroValue(d_t d) const override;
 
+  [[nodiscard]] std::string getSummaryCacheName() const override;
+
   void printNode(std::ostream &os, n_t n) const override;
 
   void printDataFlowFact(std::ostream &os, d_t d) const override;
@@ -88,6 +88,10 @@ public:
 
   bool isZeroValue(d_t d) const override;
 
+  bool isSparseRelevant(n_t Stmt, d_t Fact) const override;
+
+  bool isIdentityStmt(n_t Stmt) const override;
+
   void printNode(std::ostream &os, n_t n) const override;
 
   void printDataFlowFact(std::ostream &os, d_t d) const override;
@@ -0,0 +1,377 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_COMPACTJUMPFUNCTIONS_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_COMPACTJUMPFUNCTIONS_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
+#include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+#include "phasar/Utils/Interner.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/**
+ * Alternative storage for the jump functions that is interface-compatible
+ * with JumpFunctions.
+ *
+ * Statements and facts are interned to dense 32-bit IDs. Each jump function
+ * is stored exactly once in a flat open-addressing hash map keyed by the IDs
+ * of (sourceVal, target, targetVal), which makes looking up an individual
+ * jump function O(1). The reverse, forward and by-target indices only hold
+ * IDs and are used to enumerate jump functions; their results are
+ * materialized on demand.
+ *
+ * All const member functions only read and may therefore be called
+ * concurrently as long as no jump functions are added or removed.
+ */
+template <typename AnalysisDomainTy, typename Container>
+class CompactJumpFunctions {
+public:
+  using l_t = typename AnalysisDomainTy::l_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+
+  using EdgeFunctionType = EdgeFunction<l_t>;
+  using EdgeFunctionPtrType = std::shared_ptr<EdgeFunctionType>;
+
+  using JumpFunctionVector =
+      llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>;
+
+private:
+  using IdTy = uint32_t;
+  // combineIds(sourceVal, target) and targetVal
+  using KeyTy = std::pair<uint64_t, IdTy>;
+
+  EdgeFunctionPtrType allTop;
+  // a pointer rather than a reference, such that the jump functions can be
+  // assigned
+  const IDETabulationProblem<AnalysisDomainTy, Container> *problem;
+
+protected:
+  Interner<n_t, IdTy> NodeIds;
+  Interner<d_t, IdTy> FactIds;
+  // the primary store holding all non-empty jump functions
+  llvm::DenseMap<KeyTy, EdgeFunctionPtrType> JumpFns;
+  // maps (target, targetVal) to all source values
+  llvm::DenseMap<uint64_t, llvm::SmallVector<IdTy, 2>> ReverseIndex;
+  // maps (sourceVal, target) to all target values
+  llvm::DenseMap<uint64_t, llvm::SmallVector<IdTy, 2>> ForwardIndex;
+  // maps target to all target values that have an entry in ReverseIndex
+  llvm::DenseMap<IdTy, llvm::SmallVector<IdTy, 2>> TargetIndex;
+
+public:
+  CompactJumpFunctions(
+      EdgeFunctionPtrType allTop,
+      const IDETabulationProblem<AnalysisDomainTy, Container> &p)
+      : allTop(std::move(allTop)), problem(&p) {}
+
+  ~CompactJumpFunctions() = default;
+
+  CompactJumpFunctions(const CompactJumpFunctions &JFs) = default;
+  CompactJumpFunctions &operator=(const CompactJumpFunctions &JFs) = default;
+  CompactJumpFunctions(CompactJumpFunctions &&JFs) noexcept = default;
+  CompactJumpFunctions &
+  operator=(CompactJumpFunctions &&JFs) noexcept = default;
+
+  /**
+   * Records a jump function. The source statement is implicit.
+   * @see PathEdge
+   */
+  void addFunction(d_t sourceVal, n_t target, d_t targetVal,
+                   EdgeFunctionPtrType function) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                      << "Start adding new jump function";
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Fact at source : " << problem->DtoString(sourceVal);
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Fact at target : " << problem->DtoString(targetVal);
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Destination    : " << problem->NtoString(target);
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Edge Function  : " << function->str());
+    // we do not store the default function (all-top)
+    if (function->equal_to(allTop)) {
+      return;
+    }
+    IdTy S = FactIds.getOrInsert(sourceVal);
+    IdTy N = NodeIds.getOrInsert(target);
+    IdTy T = FactIds.getOrInsert(targetVal);
+    auto [It, Inserted] =
+        JumpFns.try_emplace(KeyTy(combineIds(S, N), T), function);
+    if (!Inserted) {
+      // it is important that existing values in JumpFunctions are overwritten
+      It->second = std::move(function);
+    } else {
+      auto &Sources = ReverseIndex[combineIds(N, T)];
+      if (Sources.empty()) {
+        TargetIndex[N].push_back(T);
+      }
+      Sources.push_back(S);
+      ForwardIndex[combineIds(S, N)].push_back(T);
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                      << "End adding new jump function";
+                  BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+  }
+
+  /**
+   * Returns the jump function for the given source value, target statement
+   * and target value, or nullptr if there is none, i.e. if it is all-top.
+   */
+  EdgeFunctionPtrType lookup(d_t sourceVal, n_t target, d_t targetVal) const {
+    auto S = FactIds.lookup(sourceVal);
+    auto N = NodeIds.lookup(target);
+    auto T = FactIds.lookup(targetVal);
+    if (!S || !N || !T) {
+      return nullptr;
+    }
+    if (auto Search = JumpFns.find(KeyTy(combineIds(*S, *N), *T));
+        Search != JumpFns.end()) {
+      return Search->second;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Returns, for a given target statement and value all associated
+   * source values, and for each the associated edge function.
+   * The return value is a mapping from source value to function.
+   */
+  std::optional<JumpFunctionVector> reverseLookup(n_t target,
+                                                  d_t targetVal) const {
+    auto N = NodeIds.lookup(target);
+    auto T = FactIds.lookup(targetVal);
+    if (!N || !T) {
+      return std::nullopt;
+    }
+    auto Search = ReverseIndex.find(combineIds(*N, *T));
+    if (Search == ReverseIndex.end()) {
+      return std::nullopt;
+    }
+    JumpFunctionVector Result;
+    Result.reserve(Search->second.size());
+    for (IdTy S : Search->second) {
+      Result.emplace_back(FactIds[S], getFunction(S, *N, *T));
+    }
+    return Result;
+  }
+
+  /**
+   * Returns, for a given source value and target statement all
+   * associated target values, and for each the associated edge function.
+   * The return value is a mapping from target value to function.
+   */
+  std::optional<JumpFunctionVector> forwardLookup(d_t sourceVal,
+                                                  n_t target) const {
+    auto S = FactIds.lookup(sourceVal);
+    auto N = NodeIds.lookup(target);
+    if (!S || !N) {
+      return std::nullopt;
+    }
+    auto Search = ForwardIndex.find(combineIds(*S, *N));
+    if (Search == ForwardIndex.end()) {
+      return std::nullopt;
+    }
+    JumpFunctionVector Result;
+    Result.reserve(Search->second.size());
+    for (IdTy T : Search->second) {
+      Result.emplace_back(FactIds[T], getFunction(*S, *N, T));
+    }
+    return Result;
+  }
+
+  /**
+   * Returns for a given target statement all jump function records with this
+   * target.
+   * The return value is a set of records of the form
+   * (sourceVal,targetVal,edgeFunction).
+   */
+  Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget(n_t target) const {
+    Table<d_t, d_t, EdgeFunctionPtrType> Result;
+    auto N = NodeIds.lookup(target);
+    if (!N) {
+      return Result;
+    }
+    auto Search = TargetIndex.find(*N);
+    if (Search == TargetIndex.end()) {
+      return Result;
+    }
+    for (IdTy T : Search->second) {
+      for (IdTy S : ReverseIndex.find(combineIds(*N, T))->second) {
+        Result.insert(FactIds[S], FactIds[T], getFunction(S, *N, T));
+      }
+    }
+    return Result;
+  }
+
+  /**
+   * Removes a jump function. The source statement is implicit.
+   * @see PathEdge
+   * @return True if the function has actually been removed. False if it was not
+   * there anyway.
+   */
+  bool removeFunction(d_t sourceVal, n_t target, d_t targetVal) {
+    auto S = FactIds.lookup(sourceVal);
+    auto N = NodeIds.lookup(target);
+    auto T = FactIds.lookup(targetVal);
+    if (!S || !N || !T || !JumpFns.erase(KeyTy(combineIds(*S, *N), *T))) {
+      return false;
+    }
+    auto RevIt = ReverseIndex.find(combineIds(*N, *T));
+    eraseId(RevIt->second, *S);
+    if (RevIt->second.empty()) {
+      ReverseIndex.erase(RevIt);
+      auto TgtIt = TargetIndex.find(*N);
+      eraseId(TgtIt->second, *T);
+      if (TgtIt->second.empty()) {
+        TargetIndex.erase(TgtIt);
+      }
+    }
+    auto FwdIt = ForwardIndex.find(combineIds(*S, *N));
+    eraseId(FwdIt->second, *T);
+    if (FwdIt->second.empty()) {
+      ForwardIndex.erase(FwdIt);
+    }
+    return true;
+  }
+
+  /**
+   * Removes all jump functions with the given target statement.
+   * @return The number of jump functions that have been removed.
+   */
+  size_t removeFunctionsAt(n_t target) {
+    auto N = NodeIds.lookup(target);
+    if (!N) {
+      return 0;
+    }
+    auto TgtIt = TargetIndex.find(*N);
+    if (TgtIt == TargetIndex.end()) {
+      return 0;
+    }
+    size_t NumRemoved = 0;
+    for (IdTy T : TgtIt->second) {
+      auto RevIt = ReverseIndex.find(combineIds(*N, T));
+      for (IdTy S : RevIt->second) {
+        JumpFns.erase(KeyTy(combineIds(S, *N), T));
+        auto FwdIt = ForwardIndex.find(combineIds(S, *N));
+        eraseId(FwdIt->second, T);
+        if (FwdIt->second.empty()) {
+          ForwardIndex.erase(FwdIt);
+        }
+        ++NumRemoved;
+      }
+      ReverseIndex.erase(RevIt);
+    }
+    TargetIndex.erase(TgtIt);
+    return NumRemoved;
+  }
+
+  /**
+   * Calls Handler(sourceVal, target, targetVal, function) for each (non-empty)
+   * jump function.
+   */
+  template <typename HandlerFn> void forEachFunction(HandlerFn Handler) const {
+    for (const auto &[N, Targets] : TargetIndex) {
+      for (IdTy T : Targets) {
+        for (IdTy S : ReverseIndex.find(combineIds(N, T))->second) {
+          Handler(FactIds[S], NodeIds[N], FactIds[T], getFunction(S, N, T));
+        }
+      }
+    }
+  }
+
+  /**
+   * Removes all jump functions
+   */
+  void clear() {
+    JumpFns.clear();
+    ReverseIndex.clear();
+    ForwardIndex.clear();
+    TargetIndex.clear();
+    NodeIds.clear();
+    FactIds.clear();
+  }
+
+  /**
+   * Returns the number of (non-empty) jump functions stored.
+   */
+  [[nodiscard]] size_t size() const { return JumpFns.size(); }
+
+  void printJumpFunctions(std::ostream &os) const {
+    os << "\n******************************************************";
+    os << "\n*              Print all Jump Functions              *";
+    os << "\n******************************************************\n";
+    for (const auto &[N, Targets] : TargetIndex) {
+      std::string nLabel = problem->NtoString(NodeIds[N]);
+      os << "\nN: " << nLabel << "\n---" << std::string(nLabel.size(), '-')
+         << '\n';
+      for (IdTy T : Targets) {
+        for (IdTy S : ReverseIndex.find(combineIds(N, T))->second) {
+          os << "D1: " << problem->DtoString(FactIds[S]) << '\n'
+             << "\tD2: " << problem->DtoString(FactIds[T]) << '\n'
+             << "\tEF: " << getFunction(S, N, T)->str() << "\n\n";
+        }
+      }
+    }
+  }
+
+private:
+  const EdgeFunctionPtrType &getFunction(IdTy S, IdTy N, IdTy T) const {
+    auto Search = JumpFns.find(KeyTy(combineIds(S, N), T));
+    assert(Search != JumpFns.end() && "Indices out of sync!");
+    return Search->second;
+  }
+
+  static void eraseId(llvm::SmallVectorImpl<IdTy> &Ids, IdTy Id) {
+    if (auto Find = std::find(Ids.begin(), Ids.end(), Id); Find != Ids.end()) {
+      // order is irrelevant, avoid shifting the remaining elements
+      *Find = Ids.back();
+      Ids.pop_back();
+    }
+  }
+};
+
+// selects the IDESolver's jump function storage, see
+// CompactJumpFunctionStorage
+template <typename AnalysisDomainTy, typename Container, typename = void>
+struct jump_functions {
+  using type = JumpFunctions<AnalysisDomainTy, Container>;
+};
+
+template <typename AnalysisDomainTy, typename Container>
+struct jump_functions<
+    AnalysisDomainTy, Container,
+    std::enable_if_t<std::is_same_v<typename AnalysisDomainTy::jf_storage_t,
+                                    CompactJumpFunctionStorage>>> {
+  using type = CompactJumpFunctions<AnalysisDomainTy, Container>;
+};
+
+template <typename AnalysisDomainTy, typename Container>
+using jump_functions_t =
+    typename jump_functions<AnalysisDomainTy, Container>::type;
+
+} // namespace psr
+
+#endif
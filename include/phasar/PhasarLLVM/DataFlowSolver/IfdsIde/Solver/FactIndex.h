@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FACTINDEX_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FACTINDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include "phasar/Utils/Interner.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/**
+ * A reverse index of a solver's results that maps each fact to the
+ * statements it holds at. The statements of a fact are enumerated in time
+ * proportional to their number, whereas Table::column() has to scan the
+ * results of all statements.
+ *
+ * Statements and facts are interned, see Interner, and the statement IDs of
+ * all facts are stored in a single array: the IDs of the fact with ID i are
+ * found at the indices [Offsets[i], Offsets[i + 1]) and are sorted, such
+ * that the statements of several facts can be intersected or merged
+ * cheaply. The index is a snapshot of the results it has been built from, it
+ * is not updated when they change.
+ */
+template <typename N, typename D> class FactIndex {
+public:
+  template <typename L> explicit FactIndex(const Table<N, D, L> &Results) {
+    // count the statements of each fact, statements are assigned their IDs
+    // in the order of the table's rows
+    std::vector<uint32_t> Cursors;
+    Results.forEachCell([&](N Stmt, D Fact, const L & /*Value*/) {
+      Stmts.getOrInsert(Stmt);
+      uint32_t FactId = Facts.getOrInsert(Fact);
+      if (FactId == Cursors.size()) {
+        Cursors.push_back(0);
+      }
+      ++Cursors[FactId];
+    });
+    Offsets.resize(Facts.size() + 1, 0);
+    for (size_t FactId = 0; FactId < Facts.size(); ++FactId) {
+      Offsets[FactId + 1] = Offsets[FactId] + Cursors[FactId];
+      Cursors[FactId] = Offsets[FactId];
+    }
+    StmtIds.resize(Offsets.back());
+    // the rows are visited in the same order again, hence the statement IDs
+    // of each fact are filled in ascending order and need not be sorted
+    Results.forEachCell([&](N Stmt, D Fact, const L & /*Value*/) {
+      StmtIds[Cursors[*Facts.lookup(Fact)]++] = *Stmts.lookup(Stmt);
+    });
+  }
+
+  /**
+   * Returns the sorted IDs of the statements the given fact holds at, see
+   * getStatement().
+   */
+  [[nodiscard]] llvm::ArrayRef<uint32_t> statementIdsOf(D Fact) const {
+    auto FactId = Facts.lookup(Fact);
+    if (!FactId) {
+      return {};
+    }
+    return llvm::ArrayRef<uint32_t>(StmtIds).slice(
+        Offsets[*FactId], Offsets[*FactId + 1] - Offsets[*FactId]);
+  }
+
+  [[nodiscard]] N getStatement(uint32_t StmtId) const {
+    return Stmts.get(StmtId);
+  }
+
+  /**
+   * Calls Handler(n) for every statement n the given fact holds at.
+   */
+  template <typename HandlerFn>
+  void forEachStatementOf(D Fact, HandlerFn Handler) const {
+    for (uint32_t StmtId : statementIdsOf(Fact)) {
+      Handler(Stmts.get(StmtId));
+    }
+  }
+
+  [[nodiscard]] std::vector<N> statementsOf(D Fact) const {
+    auto Ids = statementIdsOf(Fact);
+    std::vector<N> Result;
+    Result.reserve(Ids.size());
+    for (uint32_t StmtId : Ids) {
+      Result.push_back(Stmts.get(StmtId));
+    }
+    return Result;
+  }
+
+  [[nodiscard]] size_t numStatementsOf(D Fact) const {
+    return statementIdsOf(Fact).size();
+  }
+
+  [[nodiscard]] bool contains(D Fact) const { return Facts.contains(Fact); }
+
+  [[nodiscard]] size_t getNumStatements() const { return Stmts.size(); }
+
+  [[nodiscard]] size_t getNumFacts() const { return Facts.size(); }
+
+  /**
+   * Returns the number of (statement, fact) pairs that are indexed.
+   */
+  [[nodiscard]] size_t size() const { return StmtIds.size(); }
+
+private:
+  Interner<N> Stmts;
+  Interner<D> Facts;
+  std::vector<uint32_t> Offsets;
+  std::vector<uint32_t> StmtIds;
+};
+
+} // namespace psr
+
+#endif
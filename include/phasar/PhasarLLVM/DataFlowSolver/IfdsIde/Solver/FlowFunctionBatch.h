@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FLOWFUNCTIONBATCH_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FLOWFUNCTIONBATCH_H_
+
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+
+namespace psr {
+
+/**
+ * The facts at the target statement of a batch of path edges, see
+ * PathEdgeWorklist::popBatch(), and the targets that the call- and
+ * return-flow functions of that statement compute for them. The solvers
+ * process the edges of a batch at a call or exit statement one by one, but
+ * query the targets of each flow function from the batch, which applies the
+ * flow function to the facts of all edges at once when it is first queried.
+ */
+template <typename N, typename D, typename F, typename Container>
+class FlowFunctionBatch {
+public:
+  void assign(const std::vector<PathEdge<N, D>> &Edges) {
+    clear();
+    Sources.reserve(Edges.size());
+    for (const auto &Edge : Edges) {
+      Sources.push_back(Edge.factAtTarget());
+    }
+  }
+
+  void clear() {
+    Sources.clear();
+    CallTargets.clear();
+    ReturnTargets.clear();
+  }
+
+  [[nodiscard]] bool empty() const { return Sources.empty(); }
+
+  [[nodiscard]] const std::vector<D> &getSources() const { return Sources; }
+
+  /// Returns the targets of the call-flow function into Callee for the fact
+  /// Source of the batch. ComputeBatch maps the facts of the batch to their
+  /// targets, it is called once per callee.
+  template <typename ComputeBatchFn>
+  const Container &getCallTargets(F Callee, D Source,
+                                  ComputeBatchFn ComputeBatch) {
+    return getTargets(CallTargets, Callee, Source, ComputeBatch);
+  }
+
+  /// Returns the targets of the return-flow function from the batch's exit
+  /// statement to RetSite of CallSite for the fact Source of the batch.
+  /// ComputeBatch maps the facts of the batch to their targets, it is called
+  /// once per call and return site.
+  template <typename ComputeBatchFn>
+  const Container &getReturnTargets(N CallSite, N RetSite, D Source,
+                                    ComputeBatchFn ComputeBatch) {
+    return getTargets(ReturnTargets, std::make_pair(CallSite, RetSite), Source,
+                      ComputeBatch);
+  }
+
+private:
+  template <typename KeyT, typename ComputeBatchFn>
+  const Container &getTargets(std::map<std::pair<KeyT, D>, Container> &Targets,
+                              const KeyT &Key, D Source,
+                              ComputeBatchFn ComputeBatch) {
+    if (auto Search = Targets.find({Key, Source}); Search != Targets.end()) {
+      return Search->second;
+    }
+    std::vector<Container> Computed = ComputeBatch(Sources);
+    assert(Computed.size() == Sources.size() &&
+           "Expected the targets of each source fact!");
+    for (size_t I = 0; I < Sources.size(); ++I) {
+      Targets.emplace(std::make_pair(Key, Sources[I]), std::move(Computed[I]));
+    }
+    assert(Targets.count({Key, Source}) && "Source is not part of the batch!");
+    return Targets[{Key, Source}];
+  }
+
+  std::vector<D> Sources;
+  std::map<std::pair<F, D>, Container> CallTargets;
+  std::map<std::pair<std::pair<N, N>, D>, Container> ReturnTargets;
+};
+
+} // namespace psr
+
+#endif
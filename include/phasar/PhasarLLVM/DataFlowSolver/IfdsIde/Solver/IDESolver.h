@@ -17,11 +17,21 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -32,9 +42,26 @@
 
 #include "boost/algorithm/string/trim.hpp"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Value.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 
 #include "phasar/Config/Configuration.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/ICFGOrder.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionStore.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
@@ -42,13 +69,23 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactJumpFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactIndex.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FlowFunctionBatch.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IdentityChains.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JoinHandlingNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LinkedNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverTelemetry.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Utils/DOTGraph.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+#include "phasar/PhasarLLVM/Utils/ResultsExporter.h"
+#include "phasar/Utils/Interner.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
@@ -105,8 +142,9 @@ public:
       : IDEProblem(Problem), ZeroValue(Problem.getZeroValue()),
         ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
         cachedFlowEdgeFunctions(Problem), allTop(Problem.allTopFunction()),
-        jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            allTop, IDEProblem)),
+        jumpFn(
+            std::make_shared<jump_functions_t<AnalysisDomainTy, Container>>(
+                allTop, IDEProblem)),
         initialSeeds(Problem.initialSeeds()) {}
 
   IDESolver(const IDESolver &) = delete;
@@ -166,7 +204,13 @@ public:
     REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Sparse Skipped Stmts", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Collapsed Stmts", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Path Edge Revisits", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("[Calls] getPointsToSet", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Summary-cache hits", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Summary-cache misses", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Summary-cache stores", 0, PAMM_SEVERITY_LEVEL::Core);
     REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
     REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
 
@@ -174,11 +218,61 @@ public:
                       << "IDE solver is solving the specified problem";
                   BOOST_LOG_SEV(lg::get(), INFO)
                   << "Submit initial seeds, construct exploded super graph");
+    if (SolverConfig.internEdgeFunctions() && !EFStore) {
+      EFStore = std::make_unique<EdgeFunctionStore<l_t>>();
+    }
+    // the index of a previous run does not reflect the new results
+    ResultFactIndex.reset();
+    SparseSuccessors.clear();
+    Chains.reset();
+    if (SolverConfig.compressIdentityChains()) {
+      compressIdentityChains();
+    }
+    if (!SolverConfig.summaryCacheDirectory().empty()) {
+      computeSummaryCacheKeys();
+    }
+    LastCheckpoint = std::chrono::steady_clock::now();
+    Telemetry = SolverTelemetry<d_t, f_t>();
     // computations starting here
     START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
     // We start our analysis and construct exploded supergraph
-    submitInitialSeeds();
+    if (SolverConfig.resumeFromCheckpoint() && resumeFromCheckpoint()) {
+      runWorklist();
+    } else {
+      submitInitialSeeds();
+    }
+    if (UpdatedFromCheckpoint) {
+      pruneUnreachableContexts();
+    }
     STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    if (!SummaryCacheKeys.empty()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Summary cache: " << SummaryCacheHits << " hits / "
+                    << SummaryCacheMisses << " misses");
+      if (SolverConfig.computePersistedSummaries()) {
+        storeCachedSummaries();
+      }
+    }
+    LOG_IF_ENABLE(if (EFStore) {
+      BOOST_LOG_SEV(lg::get(), INFO)
+          << "Interned " << EFStore->size() << " edge functions, compose: "
+          << EFStore->getComposeHits() << " hits / "
+          << EFStore->getComposeMisses() << " misses, join: "
+          << EFStore->getJoinHits() << " hits / " << EFStore->getJoinMisses()
+          << " misses";
+    });
+    if (lowMemoryMode()) {
+      releaseIntraProceduralJumpFunctions();
+      // the interned edge functions are released along with the jump
+      // functions, Phase II only interns those of one function at a time
+      if (EFStore) {
+        EFStore->clear();
+      }
+    } else if (SolverConfig.lowMemory()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Emitting the ESG requires all edges, ignore the "
+                       "requested low-memory mode");
+    }
     if (SolverConfig.computeValues()) {
       START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
       // Computing the final values for the edge functions
@@ -187,19 +281,174 @@ public:
           << "Compute the final values according to the edge functions");
       computeValues();
       STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+      if (SolverConfig.buildFactIndex()) {
+        buildFactIndex();
+      }
     }
+    // edge functions are neither composed nor joined once the problem has
+    // been solved, the results do not refer to the store
+    EFStore.reset();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Problem solved");
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       computeAndPrintStatistics();
+      printHottestFunctions();
     }
     if (SolverConfig.emitESG()) {
       emitESGAsDot();
     }
   }
 
+  /**
+   * Writes the state of the exploded super-graph's construction to the given
+   * file: the pending path edges, the jump functions, the end summaries, the
+   * incoming table, the unbalanced return sites and the seeds. Statements and
+   * facts are written using their IDs, see CheckpointWriter; edge functions
+   * that are specific to the analysis are written by
+   * IDETabulationProblem::writeEdgeFunction(). Returns false if the state
+   * cannot be checkpointed, an existing checkpoint is only replaced by a
+   * complete one.
+   *
+   * Note that neither the analysis problem's own state nor the recorded path
+   * edges are part of the checkpoint. The state cannot be checkpointed once
+   * the intra-procedural jump functions have been released in low-memory
+   * mode.
+   */
+  bool saveCheckpoint(const std::string &Path) {
+    if constexpr (!IsCheckpointable<n_t> || !IsCheckpointable<d_t>) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                    << "Only statements and facts that are LLVM values can "
+                       "be checkpointed");
+      return false;
+    } else {
+      if (!IDEProblem.getProjectIRDB()) {
+        return false;
+      }
+      if (JumpFunctionsReleased) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                      << "The intra-procedural jump functions have been "
+                         "released, cannot write a checkpoint");
+        return false;
+      }
+      const std::string TmpPath = Path + ".tmp";
+      bool Written;
+      {
+        std::ofstream OFS(TmpPath, std::ios::binary);
+        Written = OFS && writeCheckpoint(OFS) && OFS.flush();
+      }
+      if (!Written || std::rename(TmpPath.c_str(), Path.c_str()) != 0) {
+        std::remove(TmpPath.c_str());
+        return false;
+      }
+      return true;
+    }
+  }
+
+  /**
+   * Restores the state written by saveCheckpoint() for the same analysis
+   * problem and IR. The IR is re-bound using the values' checkpoint IDs, see
+   * getCheckpointId(). Returns false and leaves the solver unchanged if the
+   * checkpoint cannot be read or has been written for different IR or by
+   * another analysis, see IFDSTabulationProblem::getCheckpointName(). The
+   * pending path edges are processed by solve().
+   */
+  bool loadCheckpoint(const std::string &Path) {
+    if constexpr (!IsCheckpointable<n_t> || !IsCheckpointable<d_t> ||
+                  !IsCheckpointable<f_t>) {
+      return false;
+    } else {
+      std::ifstream IFS(Path, std::ios::binary);
+      if (!IFS || !IDEProblem.getProjectIRDB()) {
+        return false;
+      }
+      CheckpointReader R(IFS, *IDEProblem.getProjectIRDB());
+      return readCheckpoint(R);
+    }
+  }
+
+  /**
+   * Restores the state written by saveCheckpoint() for a previous version of
+   * the IR, such that solve() only re-analyzes the functions that are
+   * affected by the changes. The functions whose hashes differ from the ones
+   * recorded in the checkpoint, see getCheckpointHashes(), are changed; if a
+   * global variable has changed, all functions are. The jump functions, end
+   * summaries and incoming calls of the changed functions and of their
+   * transitive callers are dropped, everything else is retained. solve()
+   * then starts from the initial seeds and re-uses the retained summaries
+   * wherever the changes have not altered the facts that reach a function.
+   *
+   * Several checkpoints can be restored one after another. The summaries
+   * restored first take precedence: a function whose summaries for a
+   * context differ from the ones the solver already holds is changed as
+   * well, e.g. since its callees have been re-analyzed elsewhere. If
+   * External is set, the checkpoint has been written for another part of
+   * the program, e.g. a module whose functions the current IR only
+   * partially contains, see ModuleWiseAnalysis; only the functions that are
+   * defined by both are compared then and global variables are not.
+   *
+   * Returns the functions whose state has been dropped, or std::nullopt and
+   * leaves the solver unchanged if the checkpoint cannot be read. Must be
+   * called before solve().
+   */
+  std::optional<std::set<f_t>>
+  updateFromCheckpoint(const std::string &Path, bool External = false) {
+    if constexpr (!IsCheckpointable<n_t> || !IsCheckpointable<d_t> ||
+                  !IsCheckpointable<f_t>) {
+      return std::nullopt;
+    } else {
+      std::ifstream IFS(Path, std::ios::binary);
+      if (!IFS || !IDEProblem.getProjectIRDB()) {
+        return std::nullopt;
+      }
+      CheckpointReader R(IFS, *IDEProblem.getProjectIRDB(),
+                         /*AllowUnknownValues*/ true);
+      std::set<f_t> Invalidated;
+      if (!readCheckpoint(R, &Invalidated, External)) {
+        return std::nullopt;
+      }
+      UpdatedFromCheckpoint = true;
+      return Invalidated;
+    }
+  }
+
+  /**
+   * Restricts the construction of the exploded super-graph to the given
+   * statements: path edges to any other statement are not propagated and no
+   * values are computed for them. Used by DemandDrivenAnalysis to only
+   * explore the statements that may reach a queried statement. Must be called
+   * before solve().
+   */
+  void restrictToStatements(std::set<n_t> Stmts) {
+    RelevantStmts = std::move(Stmts);
+  }
+
+  /**
+   * Returns the number of path edges that have been propagated, i.e. the
+   * number of times a jump function has been added or changed.
+   */
+  [[nodiscard]] size_t getNumPathEdges() const { return PathEdgeCount; }
+
+  /// Returns the number of jump functions that have been released while the
+  /// exploded super-graph has been constructed in low-memory mode.
+  [[nodiscard]] size_t getNumJumpFunctionsReleasedDuringPhaseI() const {
+    return NumReleasedDuringPhaseI;
+  }
+
+  /**
+   * Returns the functions for which end summaries have been found in the
+   * summary cache, see IFDSIDESolverConfig::setSummaryCacheDirectory(). They
+   * are not analyzed in the calling contexts the summaries belong to, their
+   * results lack the values of these contexts and are empty if they have not
+   * been analyzed in any other context.
+   */
+  [[nodiscard]] const std::set<f_t> &getFunctionsSummarizedFromCache() const {
+    return FunctionsSummarizedFromCache;
+  }
+
   /**
    * Returns the V-type result for the given value at the given statement.
-   * TOP values are never returned.
+   * TOP values are never returned. Statements of functions whose summaries
+   * are taken from the summary cache may lack results, see
+   * getFunctionsSummarizedFromCache().
    */
   [[nodiscard]] virtual l_t resultAt(n_t stmt, d_t value) {
     return valtab.get(stmt, value);
@@ -208,11 +457,15 @@ public:
   /**
    * Returns the resulting environment for the given statement.
    * The artificial zero value can be automatically stripped.
-   * TOP values are never returned.
+   * TOP values are never returned. Statements of functions whose summaries
+   * are taken from the summary cache may lack results, see
+   * getFunctionsSummarizedFromCache().
    */
   [[nodiscard]] virtual std::unordered_map<d_t, l_t>
   resultsAt(n_t stmt, bool stripZero = false) /*TODO const*/ {
-    std::unordered_map<d_t, l_t> result = valtab.row(stmt);
+    // the const row() does not insert an empty row for statements that have
+    // no results
+    std::unordered_map<d_t, l_t> result = std::as_const(valtab).row(stmt);
     if (stripZero) {
       for (auto it = result.begin(); it != result.end();) {
         if (IDEProblem.isZeroValue(it->first)) {
@@ -233,6 +486,14 @@ public:
     IDEProblem.emitGraphicalReport(getSolverResults(), OS);
   }
 
+  /**
+   * Writes the results in the given format to OS while walking them once,
+   * see psr::exportResults().
+   */
+  void exportResults(IOFormat Format, std::ostream &OS = std::cout) {
+    psr::exportResults(IDEProblem, getSolverResults(), Format, OS);
+  }
+
   virtual void dumpResults(std::ostream &OS = std::cout) {
     PAMM_GET_INSTANCE;
     START_TIMER("DFA IDE Result Dumping", PAMM_SEVERITY_LEVEL::Full);
@@ -320,9 +581,36 @@ public:
     }
   }
 
+  /**
+   * Builds the index of the computed values by fact, see FactIndex, which is
+   * used by the SolverResults that are obtained afterwards. Is called by
+   * solve() if IFDSIDESolverConfig::buildFactIndex() is set, but may also be
+   * called once the values have been computed.
+   */
+  const FactIndex<n_t, d_t> &buildFactIndex() {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA Fact Index", PAMM_SEVERITY_LEVEL::Full);
+    ResultFactIndex = std::make_unique<FactIndex<n_t, d_t>>(valtab);
+    STOP_TIMER("DFA Fact Index", PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Indexed " << ResultFactIndex->size() << " results of "
+                  << ResultFactIndex->getNumFacts() << " facts at "
+                  << ResultFactIndex->getNumStatements() << " statements");
+    return *ResultFactIndex;
+  }
+
   SolverResults<n_t, d_t, l_t> getSolverResults() {
-    return SolverResults<n_t, d_t, l_t>(this->valtab,
-                                        IDEProblem.getZeroValue());
+    return SolverResults<n_t, d_t, l_t>(
+        this->valtab, IDEProblem.getZeroValue(), ResultFactIndex.get());
+  }
+
+  /**
+   * Returns the per-function statistics of the last run; they are only
+   * collected if PAMM is enabled, the time spent per function only with
+   * PAMM_FULL.
+   */
+  [[nodiscard]] const SolverTelemetry<d_t, f_t> &getTelemetry() const {
+    return Telemetry;
   }
 
 protected:
@@ -331,36 +619,147 @@ protected:
   d_t ZeroValue;
   const i_t *ICF;
   IFDSIDESolverConfig &SolverConfig;
-  unsigned PathEdgeCount = 0;
+  std::atomic<unsigned> PathEdgeCount = 0;
 
   FlowEdgeFunctionCache<AnalysisDomainTy, Container> cachedFlowEdgeFunctions;
 
+  // only filled if IFDSIDESolverConfig::recordEdges() is set; not interned, as
+  // the edges may be recorded concurrently and outside of the summary lock
   Table<n_t, n_t, std::map<d_t, Container>> computedIntraPathEdges;
 
   Table<n_t, n_t, std::map<d_t, Container>> computedInterPathEdges;
 
   EdgeFunctionPtrType allTop;
 
-  std::shared_ptr<JumpFunctions<AnalysisDomainTy, Container>> jumpFn;
+  // shares equal edge functions and memoizes their compositions and joins if
+  // requested by the solver configuration
+  std::unique_ptr<EdgeFunctionStore<l_t>> EFStore;
+
+  // the analysis domain selects the storage, see CompactJumpFunctions.h; only
+  // CompactJumpFunctions interns the statements and facts, using interners of
+  // its own
+  std::shared_ptr<jump_functions_t<AnalysisDomainTy, Container>> jumpFn;
+
+  // path edges that have been discovered but not yet processed
+  std::unique_ptr<PathEdgeWorklist<n_t, d_t>> Worklist;
+  // only set for WorklistPolicy::ReversePostOrder, see getWorklist()
+  std::unique_ptr<ICFGOrder<n_t, f_t>> Order;
+
+  // only set while the exploded super-graph is constructed in parallel, see
+  // runWorklistConcurrently()
+  std::unique_ptr<WorkStealingPathEdgeWorklist<n_t, d_t>> ConcurrentWorklist;
+
+  // only set while a batch of path edges at a call or exit statement is
+  // processed, see processCallBatch() and processExitBatch()
+  FlowFunctionBatch<n_t, d_t, f_t, container_type> CurrentBatch;
+
+  // guard jumpFn, endsummarytab/incomingtab/unbalancedRetSites and the
+  // recorded path edges, respectively, while running concurrently
+  std::mutex JumpFnMutex;
+  std::mutex SummaryMutex;
+  std::mutex PathEdgeRecordMutex;
+  std::mutex SparseMutex;
 
   std::map<std::tuple<n_t, d_t, n_t, d_t>, std::vector<EdgeFunctionPtrType>>
       intermediateEdgeFunctions;
 
+  // dense IDs of the statements and facts the summary tables (endsummarytab
+  // and incomingtab) are keyed on, see getSummaryKey(); the solver's other
+  // tables do not use them
+  Interner<n_t> NodeIds;
+  Interner<d_t> FactIds;
+
   // stores summaries that were queried before they were computed
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
-  Table<n_t, d_t, Table<n_t, d_t, EdgeFunctionPtrType>> endsummarytab;
+  // maps <sP, d1> to the jump functions for each <eP, d2>
+  llvm::DenseMap<uint64_t, llvm::DenseMap<uint64_t, EdgeFunctionPtrType>>
+      endsummarytab;
 
   // edges going along calls
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
-  Table<n_t, d_t, std::map<n_t, Container>> incomingtab;
+  // maps <sP, d3> to the facts that hold at each call site calling sP
+  llvm::DenseMap<uint64_t, std::map<n_t, Container>> incomingtab;
 
   // stores the return sites (inside callers) to which we have unbalanced
   // returns if SolverConfig.followReturnPastSeeds is enabled
   std::set<n_t> unbalancedRetSites;
 
+  // only set while the jump functions of a single function are recomputed in
+  // low-memory mode, see recomputeJumpFunctions(); the processed path edges
+  // are keyed on getSummaryKey(target, targetVal) and the source value's ID
+  bool Replaying = false;
+  llvm::DenseSet<std::pair<uint64_t, uint32_t>> ReplayedEdges;
+
   std::map<n_t, std::set<d_t>> initialSeeds;
 
+  // if set, only these statements are explored, see restrictToStatements()
+  std::optional<std::set<n_t>> RelevantStmts;
+
+  // the statements a fact is passed on to from a statement when propagating
+  // sparsely, see getSparseSuccessors()
+  std::map<std::pair<n_t, d_t>, std::vector<n_t>> SparseSuccessors;
+
+  // see compressIdentityChains()
+  std::unique_ptr<IdentityChains<n_t, f_t>> Chains;
+
+  // per-function statistics and progress reports, only used if PAMM is
+  // enabled
+  SolverTelemetry<d_t, f_t> Telemetry;
+  std::mutex TelemetryMutex;
+
+  // statements and facts can be checkpointed if they are LLVM values
+  template <typename T>
+  static constexpr bool IsCheckpointable = std::conjunction_v<
+      std::is_pointer<T>,
+      std::is_base_of<llvm::Value, std::remove_cv_t<std::remove_pointer_t<T>>>>;
+
+  static constexpr llvm::StringLiteral CheckpointMagic =
+      "phasar-ide-checkpoint";
+  static constexpr uint64_t CheckpointVersion = 3;
+  // the kinds of edge functions in a checkpoint
+  enum : uint64_t {
+    CheckpointIdentity,
+    CheckpointAllTopFunction,
+    CheckpointAllBottom,
+    CheckpointAllTop,
+    CheckpointCustom
+  };
+  // the clock is only consulted every CheckpointCheckPeriod path edges
+  static constexpr size_t CheckpointCheckPeriod = 1024;
+  size_t EdgesSinceCheckpointCheck = 0;
+  std::chrono::steady_clock::time_point LastCheckpoint;
+  // set if a checkpoint could not be written
+  bool CheckpointsDisabled = false;
+  // set if the state has been restored by updateFromCheckpoint()
+  bool UpdatedFromCheckpoint = false;
+  // set once jump functions have been released in low-memory mode
+  bool JumpFunctionsReleased = false;
+  // the number of pending path edges per function in low-memory mode, see
+  // releaseJumpFunctionsIfDone()
+  llvm::DenseMap<f_t, size_t> PendingEdgesPerFunction;
+  size_t NumReleasedDuringPhaseI = 0;
+
+  static constexpr llvm::StringLiteral SummaryCacheMagic = "phasar-ide-summary";
+  static constexpr uint64_t SummaryCacheVersion = 1;
+  // the keys of the functions whose end summaries may be cached, see
+  // computeSummaryCacheKeys()
+  std::map<f_t, uint64_t> SummaryCacheKeys;
+  // the contexts, keyed by getSummaryKey(), that have been looked up in the
+  // summary cache, and whether their end summaries have been found
+  llvm::DenseMap<uint64_t, bool> CachedContexts;
+  // see getFunctionsSummarizedFromCache()
+  std::set<f_t> FunctionsSummarizedFromCache;
+  size_t SummaryCacheHits = 0;
+  size_t SummaryCacheMisses = 0;
+  // re-binds the cached summaries to the IR, see loadCachedSummaries()
+  std::stringstream SummaryCacheStream;
+  std::unique_ptr<CheckpointReader> SummaryCacheReader;
+
+  // keyed on the statements and facts themselves, as it is handed out to
+  // SolverResults as is
   Table<n_t, d_t, l_t> valtab;
+  // see buildFactIndex()
+  std::unique_ptr<FactIndex<n_t, d_t>> ResultFactIndex;
 
   std::map<std::pair<n_t, d_t>, size_t> fSummaryReuse;
 
@@ -381,8 +780,9 @@ protected:
         SolverConfig(IDEProblem.getIFDSIDESolverConfig()),
         cachedFlowEdgeFunctions(IDEProblem),
         allTop(IDEProblem.allTopFunction()),
-        jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            allTop, IDEProblem)),
+        jumpFn(
+            std::make_shared<jump_functions_t<AnalysisDomainTy, Container>>(
+                allTop, IDEProblem)),
         initialSeeds(IDEProblem.initialSeeds()) {}
 
   /**
@@ -458,7 +858,8 @@ protected:
                 BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Compose: " << sumEdgFnE->str() << " * " << f->str();
                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-            propagate(d1, returnSiteN, d3, f->composeWith(sumEdgFnE), n, false);
+            propagate(d1, returnSiteN, d3,
+                      composeEdgeFunctions(f, sumEdgFnE), n, false);
           }
         }
       } else {
@@ -466,7 +867,7 @@ protected:
         FlowFunctionPtrType function =
             cachedFlowEdgeFunctions.getCallFlowFunction(n, sCalledProcN);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        container_type res = computeCallFlowFunction(function, d1, d2);
+        container_type res = callFlowTargets(function, sCalledProcN, d1, d2);
         ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                          PAMM_SEVERITY_LEVEL::Full);
         // for each callee's start point(s)
@@ -489,14 +890,27 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Create initial self-loop with D: "
                           << IDEProblem.DtoString(d3));
-            propagate(d3, sP, d3, EdgeIdentity<l_t>::getInstance(), n,
-                      false); // line 15
+            // the callee's jump functions are retained when jump functions
+            // are recomputed, see recomputeJumpFunctions(); the callee is not
+            // entered if its end summaries are found in the summary cache
+            if (!Replaying && !loadCachedSummaries(sCalledProcN, sP, d3)) {
+              propagate(d3, sP, d3, EdgeIdentity<l_t>::getInstance(), n,
+                        false); // line 15
+            }
             // register the fact that <sp,d3> has an incoming edge from <n,d2>
             // line 15.1 of Naeem/Lhotak/Rodriguez
-            addIncoming(sP, d3, n, d2);
             // line 15.2, copy to avoid concurrent modification exceptions by
-            // other threads
-            // const std::set<TableCell> endSumm(endSummary(sP, d3));
+            // other threads; both steps must happen atomically, such that a
+            // concurrent processExit() either sees the incoming edge or
+            // provides its end summary here
+            std::set<TableCell> endSumm;
+            {
+              auto Lock = lockIfConcurrent(SummaryMutex);
+              if (!Replaying) {
+                addIncoming(sP, d3, n, d2);
+              }
+              endSumm = endSummary(sP, d3);
+            }
             // std::cout << "ENDSUMM" << std::endl;
             // std::cout << "Size: " << endSumm.size() << std::endl;
             // std::cout << "sP: " << IDEProblem.NtoString(sP)
@@ -508,7 +922,7 @@ protected:
             // <sP,d3>, create new caller-side jump functions to the return
             // sites because we have observed a potentially new incoming
             // edge into <sP,d3>
-            for (const TableCell entry : endSummary(sP, d3)) {
+            for (const TableCell entry : endSumm) {
               n_t eP = entry.getRowKey();
               d_t d4 = entry.getColumnKey();
               EdgeFunctionPtrType fCalleeSummary = entry.getValue();
@@ -557,8 +971,8 @@ protected:
                                     << f4->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG)
                                 << "         (return * calleeSummary * call)");
-                  EdgeFunctionPtrType fPrime =
-                      f4->composeWith(fCalleeSummary)->composeWith(f5);
+                  EdgeFunctionPtrType fPrime = composeEdgeFunctions(
+                      composeEdgeFunctions(f4, fCalleeSummary), f5);
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                                     << "       = " << fPrime->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -569,7 +983,7 @@ protected:
                                     << f->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
                   propagate(d1, retSiteN, d5_restoredCtx,
-                            f->composeWith(fPrime), n, false);
+                            composeEdgeFunctions(f, fPrime), n, false);
                 }
               }
             }
@@ -600,7 +1014,7 @@ protected:
                 .push_back(edgeFnE);
           }
           INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          auto fPrime = f->composeWith(edgeFnE);
+          auto fPrime = composeEdgeFunctions(f, edgeFnE);
           LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                             << "Compose: " << edgeFnE->str() << " * "
                             << f->str() << " = " << fPrime->str();
@@ -611,6 +1025,27 @@ protected:
     }
   }
 
+  /**
+   * Processes the path edges of Edges, which all have the same source fact
+   * and target call statement, like processCall(), but applies each call-flow
+   * function to the facts of all edges at once, see
+   * FlowFunction::computeTargetsBatch().
+   * @param Edges
+   */
+  virtual void
+  processCallBatch(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    if (Edges.size() > 1) {
+      PAMM_GET_INSTANCE;
+      INC_COUNTER("Batched Path Edges", Edges.size(),
+                  PAMM_SEVERITY_LEVEL::Full);
+      CurrentBatch.assign(Edges);
+    }
+    for (const auto &Edge : Edges) {
+      processCall(Edge);
+    }
+    CurrentBatch.clear();
+  }
+
   /**
    * Lines 33-37 of the algorithm.
    * Simply propagate normal, intra-procedural flows.
@@ -632,29 +1067,239 @@ protected:
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
       const container_type res =
           computeNormalFlowFunction(flowFunction, d1, d2);
-      ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
-                       PAMM_SEVERITY_LEVEL::Full);
-      saveEdges(n, fn, d2, res, false);
-      for (d_t d3 : res) {
-        EdgeFunctionPtrType g =
-            cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, fn, d3);
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "Queried Normal Edge Function: " << g->str());
-        EdgeFunctionPtrType fprime = f->composeWith(g);
-        if (SolverConfig.emitESG()) {
-          intermediateEdgeFunctions[std::make_tuple(n, d2, fn, d3)].push_back(
-              g);
+      propagateNormalFlow(d1, n, d2, fn, res, f);
+    }
+  }
+
+  /**
+   * Processes the path edges of Edges, which all have the same source fact
+   * and target statement, like processNormalFlow(), but applies each normal
+   * flow function to the facts of all edges at once, see
+   * FlowFunction::computeTargetsBatch().
+   * @param Edges
+   */
+  virtual void
+  processNormalFlowBatch(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    if (Edges.size() == 1) {
+      processNormalFlow(Edges.front());
+      return;
+    }
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Normal", Edges.size(), PAMM_SEVERITY_LEVEL::Full);
+    INC_COUNTER("Batched Path Edges", Edges.size(), PAMM_SEVERITY_LEVEL::Full);
+    d_t d1 = Edges.front().factAtSource();
+    n_t n = Edges.front().getTarget();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process normal for " << Edges.size()
+                  << " facts at target: " << IDEProblem.NtoString(n));
+    std::vector<d_t> Sources;
+    std::vector<EdgeFunctionPtrType> JumpFunctions;
+    Sources.reserve(Edges.size());
+    JumpFunctions.reserve(Edges.size());
+    for (const auto &Edge : Edges) {
+      Sources.push_back(Edge.factAtTarget());
+      JumpFunctions.push_back(jumpFunction(Edge));
+    }
+    for (const auto fn : ICF->getSuccsOf(n)) {
+      FlowFunctionPtrType flowFunction =
+          cachedFlowEdgeFunctions.getNormalFlowFunction(n, fn);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      const std::vector<container_type> Targets =
+          computeNormalFlowFunctionBatch(flowFunction, d1, Sources);
+      assert(Targets.size() == Sources.size() &&
+             "Expected the targets of each source fact!");
+      for (size_t I = 0; I < Sources.size(); ++I) {
+        propagateNormalFlow(d1, n, Sources[I], fn, Targets[I],
+                            JumpFunctions[I]);
+      }
+    }
+  }
+
+  /**
+   * Propagates the facts res that the normal flow function from n to its
+   * successor fn generates from d2 to fn, where f is the jump function of the
+   * path edge <sP, d1> --> <n, d2>.
+   */
+  void propagateNormalFlow(d_t d1, n_t n, d_t d2, n_t fn,
+                           const container_type &res,
+                           const EdgeFunctionPtrType &f) {
+    PAMM_GET_INSTANCE;
+    ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
+                     PAMM_SEVERITY_LEVEL::Full);
+    saveEdges(n, fn, d2, res, false);
+    for (d_t d3 : res) {
+      EdgeFunctionPtrType g =
+          cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, fn, d3);
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "Queried Normal Edge Function: " << g->str());
+      EdgeFunctionPtrType fprime = composeEdgeFunctions(f, g);
+      if (SolverConfig.emitESG()) {
+        intermediateEdgeFunctions[std::make_tuple(n, d2, fn, d3)].push_back(g);
+      }
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                        << "Compose: " << g->str() << " * " << f->str()
+                        << " = " << fprime->str();
+                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+      INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      if (!SolverConfig.sparsePropagation()) {
+        propagate(d1, Chains ? Chains->getChainEnd(fn) : fn, d3, fprime,
+                  nullptr, false);
+        continue;
+      }
+      // fn is skipped if it is not relevant for d3, its jump function is
+      // recorded nevertheless, see reconstructSkippedValues()
+      if (!isSparseRelevant(fn, d3)) {
+        addSkippedJumpFunction(d1, fn, d3, fprime);
+      }
+      for (n_t Target : getSparseSuccessors(fn, d3)) {
+        propagate(d1, Target, d3, fprime, nullptr, false);
+      }
+    }
+  }
+
+  /**
+   * Joins f into the jump function of the path edge <sP, d1> --> <n, d2>
+   * like propagate(), but does not schedule the edge: n is skipped for d2
+   * when propagating sparsely. The jump function provides the value of d2
+   * at n, from which the values at the statements skipped after n are
+   * reconstructed, see reconstructSkippedValues().
+   */
+  void addSkippedJumpFunction(d_t d1, n_t n, d_t d2,
+                              const EdgeFunctionPtrType &f) {
+    auto Lock = lockIfConcurrent(JumpFnMutex);
+    EdgeFunctionPtrType jumpFnE = jumpFn->lookup(d1, n, d2);
+    if (!jumpFnE) {
+      jumpFnE = allTop;
+    }
+    EdgeFunctionPtrType fPrime = joinEdgeFunctions(jumpFnE, f);
+    if (!equalEdgeFunctions(fPrime, jumpFnE)) {
+      jumpFn->addFunction(d1, n, d2, fPrime);
+    }
+  }
+
+  /**
+   * Sets the values at the statements that have been skipped when
+   * propagating sparsely, see getSparseSuccessors(). A statement that is not
+   * relevant for a fact passes the fact's value on unchanged. Hence, the
+   * value at a skipped statement is the join of the values at all statements
+   * that are not relevant for the fact and reach it through such statements
+   * only. Of these, only the first statement skipped along a normal flow
+   * has a value of its own, see addSkippedJumpFunction().
+   */
+  void reconstructSkippedValues() {
+    // collect first, setVal() inserts into valtab
+    std::vector<std::tuple<n_t, d_t, l_t>> Sources;
+    valtab.forEachCell([&](n_t Stmt, d_t Fact, const l_t &Value) {
+      if (!isSparseRelevant(Stmt, Fact)) {
+        Sources.emplace_back(Stmt, Fact, Value);
+      }
+    });
+    for (const auto &[Source, Fact, Value] : Sources) {
+      std::set<n_t> Visited = {Source};
+      std::vector<n_t> Pending = {Source};
+      while (!Pending.empty()) {
+        n_t Curr = Pending.back();
+        Pending.pop_back();
+        for (n_t Succ : ICF->getSuccsOf(Curr)) {
+          if (isSparseRelevant(Succ, Fact) || !Visited.insert(Succ).second) {
+            continue;
+          }
+          setVal(Succ, Fact, joinValueAt(Succ, Fact, val(Succ, Fact), Value));
+          Pending.push_back(Succ);
         }
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "Compose: " << g->str() << " * " << f->str()
-                          << " = " << fprime->str();
-                      BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-        INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        propagate(d1, fn, d3, fprime, nullptr, false);
       }
     }
   }
 
+  /**
+   * Returns the statements that Fact is passed on to from the statement Succ
+   * when propagating sparsely: Succ itself if it is relevant for Fact, see
+   * IFDSTabulationProblem::isSparseRelevant(), otherwise the first relevant
+   * statements on the paths leaving Succ. The statements in between are
+   * skipped, their flow and edge functions are the identity for Fact. The
+   * statements are memoized, such that the control flow of a function is
+   * walked at most once per statement and fact.
+   */
+  const std::vector<n_t> &getSparseSuccessors(n_t Succ, d_t Fact) {
+    PAMM_GET_INSTANCE;
+    {
+      auto Lock = lockIfConcurrent(SparseMutex);
+      auto Search = SparseSuccessors.find({Succ, Fact});
+      if (Search != SparseSuccessors.end()) {
+        return Search->second;
+      }
+    }
+    std::vector<n_t> Targets;
+    std::set<n_t> Visited = {Succ};
+    std::vector<n_t> Pending = {Succ};
+    size_t NumSkipped = 0;
+    while (!Pending.empty()) {
+      n_t Curr = Pending.back();
+      Pending.pop_back();
+      if (isSparseRelevant(Curr, Fact)) {
+        Targets.push_back(Curr);
+        continue;
+      }
+      ++NumSkipped;
+      for (n_t Next : ICF->getSuccsOf(Curr)) {
+        if (Visited.insert(Next).second) {
+          Pending.push_back(Next);
+        }
+      }
+    }
+    INC_COUNTER("Sparse Skipped Stmts", NumSkipped, PAMM_SEVERITY_LEVEL::Full);
+    auto Lock = lockIfConcurrent(SparseMutex);
+    return SparseSuccessors.try_emplace({Succ, Fact}, std::move(Targets))
+        .first->second;
+  }
+
+  /**
+   * Collapses the chains of statements that are the identity for every fact,
+   * see IdentityChains: a path edge is propagated across a chain in a single
+   * step and the values at its statements are reconstructed from the values
+   * at its last statement, see reconstructCollapsedValues().
+   */
+  void compressIdentityChains() {
+    PAMM_GET_INSTANCE;
+    Chains = std::make_unique<IdentityChains<n_t, f_t>>(
+        *ICF, [this](n_t Stmt) {
+          return isRelevant(Stmt) && IDEProblem.isIdentityStmt(Stmt);
+        });
+    for (f_t Fun : ICF->getAllFunctions()) {
+      Chains->compress(Fun);
+    }
+    INC_COUNTER("Collapsed Stmts", Chains->getNumCollapsed(),
+                PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Collapsed " << Chains->getNumCollapsed()
+                  << " statements into identity chains");
+  }
+
+  /**
+   * Sets the values at the collapsed statements to the values at the last
+   * statement of their chain, which hold at every statement of the chain.
+   */
+  void reconstructCollapsedValues() {
+    Chains->forEachCollapsed([this](n_t Stmt, n_t ChainEnd) {
+      // rows remain valid while other rows are inserted
+      if (const auto &Values = std::as_const(valtab).row(ChainEnd);
+          !Values.empty()) {
+        valtab.row(Stmt) = Values;
+      }
+    });
+  }
+
+  /**
+   * Call sites and exit statements are relevant for every fact, they are
+   * handled by processCall() and processExit(). Statements outside of the
+   * ones the exploded super-graph is restricted to are not skipped either,
+   * such that the fact is dropped there, see propagate().
+   */
+  bool isSparseRelevant(n_t Stmt, d_t Fact) const {
+    return ICF->isCallStmt(Stmt) || ICF->isExitStmt(Stmt) ||
+           !isRelevant(Stmt) || IDEProblem.isSparseRelevant(Stmt, Fact);
+  }
+
   void propagateValueAtStart(const std::pair<n_t, d_t> nAndD, n_t n) {
     PAMM_GET_INSTANCE;
     d_t d = nAndD.second;
@@ -664,7 +1309,9 @@ protected:
       if (!lookupResults) {
         continue;
       }
-      for (auto entry : lookupResults->get()) {
+      const llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>
+          &JumpFns = *lookupResults;
+      for (const auto &entry : JumpFns) {
         d_t dPrime = entry.first;
         EdgeFunctionPtrType fPrime = entry.second;
         n_t sP = n;
@@ -693,97 +1340,1308 @@ protected:
                 .push_back(edgeFn);
           }
         }
-        INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        for (const n_t startPoint : ICF->getStartPointsOf(q)) {
-          INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
-          propagateValue(startPoint, dPrime, edgeFn->computeTarget(val(n, d)));
+        INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        for (const n_t startPoint : ICF->getStartPointsOf(q)) {
+          INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
+          propagateValue(startPoint, dPrime, edgeFn->computeTarget(val(n, d)));
+        }
+      }
+    }
+  }
+
+  void propagateValue(n_t nHashN, d_t nHashD, const l_t &l) {
+    l_t valNHash = val(nHashN, nHashD);
+    l_t lPrime = joinValueAt(nHashN, nHashD, valNHash, l);
+    if (!(lPrime == valNHash)) {
+      setVal(nHashN, nHashD, std::move(lPrime));
+      valuePropagationTask(std::pair<n_t, d_t>(nHashN, nHashD));
+    }
+  }
+
+  l_t val(n_t nHashN, d_t nHashD) {
+    if (valtab.contains(nHashN, nHashD)) {
+      // use the non-inserting lookup, val() is called concurrently in Phase II
+      return std::as_const(valtab).get(nHashN, nHashD);
+    } else {
+      // implicitly initialized to top; see line [1] of Fig. 7 in SRH96 paper
+      return IDEProblem.topElement();
+    }
+  }
+
+  void setVal(n_t nHashN, d_t nHashD, l_t l) {
+    LOG_IF_ENABLE([&]() {
+      BOOST_LOG_SEV(lg::get(), DEBUG)
+          << "Function : " << ICF->getFunctionOf(nHashN)->getName().str();
+      BOOST_LOG_SEV(lg::get(), DEBUG)
+          << "Inst.    : " << IDEProblem.NtoString(nHashN);
+      BOOST_LOG_SEV(lg::get(), DEBUG)
+          << "Fact     : " << IDEProblem.DtoString(nHashD);
+      BOOST_LOG_SEV(lg::get(), DEBUG)
+          << "Value    : " << IDEProblem.LtoString(l);
+      BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
+    }());
+    // TOP is the implicit default value which we do not need to store.
+    // if (l == IDEProblem.topElement()) {
+    // do not store top values
+    // valtab.remove(nHashN, nHashD);
+    // } else {
+    valtab.insert(nHashN, nHashD, std::move(l));
+    // }
+  }
+
+  EdgeFunctionPtrType jumpFunction(const PathEdge<n_t, d_t> edge) {
+    LOG_IF_ENABLE(
+        BOOST_LOG_SEV(lg::get(), DEBUG) << " ";
+        BOOST_LOG_SEV(lg::get(), DEBUG) << "JumpFunctions Forward-Lookup:";
+        BOOST_LOG_SEV(lg::get(), DEBUG)
+        << "   Source D: " << IDEProblem.DtoString(edge.factAtSource());
+        BOOST_LOG_SEV(lg::get(), DEBUG)
+        << "   Target N: " << IDEProblem.NtoString(edge.getTarget());
+        BOOST_LOG_SEV(lg::get(), DEBUG)
+        << "   Target D: " << IDEProblem.DtoString(edge.factAtTarget()));
+
+    auto Lock = lockIfConcurrent(JumpFnMutex);
+    if (auto F = jumpFn->lookup(edge.factAtSource(), edge.getTarget(),
+                                edge.factAtTarget())) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                        << "  => EdgeFn: " << F->str();
+                    BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
+      return F;
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                      << "  => EdgeFn: " << allTop->str();
+                  BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
+    // JumpFn initialized to all-top, see line [2] in SRH96 paper
+    return allTop;
+  }
+
+  void addEndSummary(n_t sP, d_t d1, n_t eP, d_t d2, EdgeFunctionPtrType f) {
+    // note: at this point we don't need to join with a potential previous f
+    // because f is a jump function, which is already properly joined
+    // within propagate(..)
+    endsummarytab[getSummaryKey(sP, d1)][getSummaryKey(eP, d2)] =
+        std::move(f);
+  }
+
+  /**
+   * Returns a compact key for the given statement/fact pair that is used to
+   * key the summary tables. The statement and fact can be retrieved from the
+   * key using NodeIds[highId(Key)] and FactIds[lowId(Key)].
+   */
+  uint64_t getSummaryKey(n_t n, d_t d) {
+    return combineIds(NodeIds.getOrInsert(n), FactIds.getOrInsert(d));
+  }
+
+  /**
+   * Returns the key getSummaryKey() returns for the given statement/fact
+   * pair without interning them, or std::nullopt if either has not been
+   * interned, in which case no summary table contains the pair. Pure lookups
+   * use this, such that they do not grow the interners.
+   */
+  std::optional<uint64_t> lookupSummaryKey(n_t n, d_t d) const {
+    auto NodeId = NodeIds.lookup(n);
+    if (!NodeId) {
+      return std::nullopt;
+    }
+    auto FactId = FactIds.lookup(d);
+    if (!FactId) {
+      return std::nullopt;
+    }
+    return combineIds(*NodeId, *FactId);
+  }
+
+  /**
+   * Returns the worklist of pending path edges. The worklist is created on
+   * first use according to the policy specified in the solver configuration.
+   */
+  PathEdgeWorklist<n_t, d_t> &getWorklist() {
+    if (!Worklist) {
+      if (SolverConfig.worklistPolicy() == WorklistPolicy::ReversePostOrder) {
+        Order = std::make_unique<ICFGOrder<n_t, f_t>>(*ICF);
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << "Ordered the path edges by " << Order->getNumSCCs()
+                      << " call-graph SCCs");
+      }
+      Worklist = makePathEdgeWorklist<n_t, d_t>(
+          SolverConfig.worklistPolicy(),
+          [this](const PathEdge<n_t, d_t> &Edge) {
+            return getPathEdgePriority(Edge);
+          });
+    }
+    return *Worklist;
+  }
+
+  /**
+   * Returns the priority of the given path edge if the solver is configured
+   * to use WorklistPolicy::Priority or WorklistPolicy::ReversePostOrder;
+   * edges with smaller values are processed first. The latter orders the
+   * edges by their target, see ICFGOrder. Otherwise, edges that reach an
+   * exit statement are deferred such that end summaries are applied to the
+   * callers in bulk.
+   */
+  virtual size_t getPathEdgePriority(const PathEdge<n_t, d_t> &Edge) {
+    if (Order) {
+      return Order->getPriority(Edge.getTarget());
+    }
+    return ICF->isExitStmt(Edge.getTarget()) ? 1 : 0;
+  }
+
+  /**
+   * Processes pending path edges until the worklist is empty, i.e. until the
+   * exploded super-graph has been fully constructed.
+   */
+  void runWorklist() {
+    if (SolverConfig.numThreads() > 1) {
+      bool LoggingEnabled = false;
+#ifdef DYNAMIC_LOG
+      LoggingEnabled = boost::log::core::get()->get_logging_enabled();
+#endif
+      if (!SolverConfig.emitESG() && !LoggingEnabled &&
+          SolverConfig.checkpointFile().empty()) {
+        runWorklistConcurrently();
+        return;
+      }
+      // neither the ESG recording nor the logger are thread-safe, checkpoints
+      // require the solver to be paused
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Emitting the ESG, logging and checkpointing require "
+                       "the sequential solver, ignore the requested number "
+                       "of threads");
+    }
+    auto &WL = getWorklist();
+    if (!SolverConfig.batchFlowFunctions()) {
+      while (!WL.empty()) {
+        auto Edge = WL.pop();
+        f_t Fun = ICF->getFunctionOf(Edge.getTarget());
+        pathEdgeProcessingTask(std::move(Edge));
+        releaseJumpFunctionsIfDone(Fun, 1);
+        checkpointIfDue();
+        reportProgressIfDue(WL.size());
+      }
+      return;
+    }
+    // the edges at every kind of statement are batched, see
+    // batchProcessingTask()
+    auto CanBatch = [](n_t) { return true; };
+    std::vector<PathEdge<n_t, d_t>> Batch;
+    while (!WL.empty()) {
+      WL.popBatch(Batch, CanBatch);
+      f_t Fun = ICF->getFunctionOf(Batch.front().getTarget());
+      if (Batch.size() == 1) {
+        pathEdgeProcessingTask(Batch.front());
+      } else {
+        batchProcessingTask(Batch);
+      }
+      releaseJumpFunctionsIfDone(Fun, Batch.size());
+      checkpointIfDue();
+      reportProgressIfDue(WL.size());
+    }
+  }
+
+  /**
+   * Logs the solver's progress if PAMM is enabled and the configured
+   * interval has elapsed since the last report, see SolverTelemetry.
+   */
+  void reportProgressIfDue([[maybe_unused]] size_t WorklistSize) {
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      if (Telemetry.isProgressDue(
+              std::chrono::seconds(SolverConfig.progressInterval()))) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << Telemetry.reportProgress(WorklistSize));
+      }
+    }
+  }
+
+  /**
+   * Logs the functions the solver has spent the most work on.
+   */
+  void printHottestFunctions() {
+    LOG_IF_ENABLE([&]() {
+      std::stringstream Hottest;
+      Telemetry.printHottestFunctions(
+          Hottest, SolverConfig.numHotFunctions(),
+          [this](f_t Fun) { return IDEProblem.FtoString(Fun); });
+      BOOST_LOG_SEV(lg::get(), INFO) << Hottest.str();
+    }());
+  }
+
+  /**
+   * Writes a checkpoint if checkpointing is enabled and the configured
+   * interval has elapsed since the last one. The clock is only consulted
+   * every CheckpointCheckPeriod path edges; an interval of 0 writes a
+   * checkpoint after every path edge.
+   */
+  void checkpointIfDue() {
+    if (SolverConfig.checkpointFile().empty() || CheckpointsDisabled) {
+      return;
+    }
+    if (SolverConfig.checkpointInterval() > 0) {
+      if (++EdgesSinceCheckpointCheck < CheckpointCheckPeriod) {
+        return;
+      }
+      EdgesSinceCheckpointCheck = 0;
+      if (std::chrono::steady_clock::now() - LastCheckpoint <
+          std::chrono::seconds(SolverConfig.checkpointInterval())) {
+        return;
+      }
+    }
+    if (saveCheckpoint(SolverConfig.checkpointFile())) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Wrote checkpoint to '" << SolverConfig.checkpointFile()
+                    << "' after " << PathEdgeCount << " path edges");
+    } else {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                    << "Cannot write checkpoint to '"
+                    << SolverConfig.checkpointFile()
+                    << "', disable checkpointing");
+      CheckpointsDisabled = true;
+    }
+    LastCheckpoint = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Restores the solver's state from the configured checkpoint file. Returns
+   * false if there is no usable checkpoint.
+   */
+  bool resumeFromCheckpoint() {
+    const auto &File = SolverConfig.checkpointFile();
+    if (File.empty() || !loadCheckpoint(File)) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Cannot resume from checkpoint '" << File
+                    << "', start from the initial seeds");
+      return false;
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Resume from checkpoint '" << File << "' with "
+                  << getWorklist().size() << " pending path edges");
+    return true;
+  }
+
+  bool writeCheckpointFact(CheckpointWriter &W, d_t d) {
+    if (IDEProblem.isZeroValue(d)) {
+      W.writeInt(0);
+      return true;
+    }
+    W.writeInt(1);
+    return W.writeValue(d);
+  }
+
+  d_t readCheckpointFact(CheckpointReader &R) {
+    if (R.readInt() == 0) {
+      return ZeroValue;
+    }
+    return readCheckpointValue<d_t>(R);
+  }
+
+  // returns nullptr for values that are unknown to a lenient reader, see
+  // updateFromCheckpoint()
+  template <typename T> static T readCheckpointValue(CheckpointReader &R) {
+    const auto *V =
+        llvm::dyn_cast_or_null<std::remove_cv_t<std::remove_pointer_t<T>>>(
+            R.readValue());
+    if (!V && !R.allowsUnknownValues()) {
+      R.fail();
+    }
+    return V;
+  }
+
+  bool writeCheckpointEdgeFunction(
+      CheckpointWriter &W, const EdgeFunctionPtrType &F,
+      llvm::DenseMap<const EdgeFunction<l_t> *, uint64_t> &Indices) {
+    if (auto Search = Indices.find(F.get()); Search != Indices.end()) {
+      W.writeInt(Search->second + 1);
+      return true;
+    }
+    W.writeInt(0);
+    if (dynamic_cast<EdgeIdentity<l_t> *>(F.get())) {
+      W.writeInt(CheckpointIdentity);
+    } else if (equalEdgeFunctions(F, allTop)) {
+      W.writeInt(CheckpointAllTopFunction);
+    } else if (dynamic_cast<AllBottom<l_t> *>(F.get()) &&
+               F->equal_to(std::make_shared<AllBottom<l_t>>(
+                   IDEProblem.bottomElement()))) {
+      W.writeInt(CheckpointAllBottom);
+    } else if (dynamic_cast<AllTop<l_t> *>(F.get()) &&
+               F->equal_to(
+                   std::make_shared<AllTop<l_t>>(IDEProblem.topElement()))) {
+      W.writeInt(CheckpointAllTop);
+    } else {
+      W.writeInt(CheckpointCustom);
+      if (!IDEProblem.writeEdgeFunction(
+              W, F, [&](const EdgeFunctionPtrType &G) {
+                return writeCheckpointEdgeFunction(W, G, Indices);
+              })) {
+        return false;
+      }
+    }
+    // functions are numbered once completely written, see
+    // readCheckpointEdgeFunction()
+    uint64_t Index = Indices.size();
+    Indices[F.get()] = Index;
+    return true;
+  }
+
+  EdgeFunctionPtrType
+  readCheckpointEdgeFunction(CheckpointReader &R,
+                             std::vector<EdgeFunctionPtrType> &Functions) {
+    if (uint64_t Index = R.readInt(); Index != 0) {
+      if (Index > Functions.size()) {
+        R.fail();
+        return nullptr;
+      }
+      return Functions[Index - 1];
+    }
+    EdgeFunctionPtrType F;
+    switch (R.readInt()) {
+    case CheckpointIdentity:
+      F = EdgeIdentity<l_t>::getInstance();
+      break;
+    case CheckpointAllTopFunction:
+      F = allTop;
+      break;
+    case CheckpointAllBottom:
+      F = std::make_shared<AllBottom<l_t>>(IDEProblem.bottomElement());
+      break;
+    case CheckpointAllTop:
+      F = std::make_shared<AllTop<l_t>>(IDEProblem.topElement());
+      break;
+    case CheckpointCustom:
+      F = IDEProblem.readEdgeFunction(
+          R, [&] { return readCheckpointEdgeFunction(R, Functions); });
+      break;
+    default:
+      R.fail();
+      break;
+    }
+    if (!R.good()) {
+      return nullptr;
+    }
+    if (!F) {
+      // a function that refers to unknown values, see updateFromCheckpoint()
+      if (!R.allowsUnknownValues()) {
+        R.fail();
+        return nullptr;
+      }
+      Functions.push_back(nullptr);
+      return nullptr;
+    }
+    if (EFStore) {
+      F = EFStore->intern(F);
+    }
+    Functions.push_back(F);
+    return F;
+  }
+
+  bool writeCheckpoint(std::ostream &OS) {
+    CheckpointWriter W(OS);
+    llvm::DenseMap<const EdgeFunction<l_t> *, uint64_t> EFIndices;
+    auto WriteEF = [&](const EdgeFunctionPtrType &F) {
+      return writeCheckpointEdgeFunction(W, F, EFIndices);
+    };
+    bool Success = true;
+    W.writeString(CheckpointMagic);
+    W.writeInt(CheckpointVersion);
+    W.writeString(IDEProblem.getCheckpointName());
+    auto Hashes = getCheckpointHashes(*IDEProblem.getProjectIRDB());
+    W.writeInt(Hashes.size());
+    for (const auto &[Id, Hash] : Hashes) {
+      W.writeString(Id);
+      W.writeInt(Hash);
+    }
+    W.writeInt(PathEdgeCount);
+    // every table is written as a sequence of entries that are preceded by 1
+    // and terminated by 0
+    for (const auto &[Node, Facts] : initialSeeds) {
+      W.writeInt(1);
+      Success &= W.writeValue(Node);
+      W.writeInt(Facts.size());
+      for (d_t Fact : Facts) {
+        Success &= writeCheckpointFact(W, Fact);
+      }
+    }
+    W.writeInt(0);
+    for (n_t RetSite : unbalancedRetSites) {
+      W.writeInt(1);
+      Success &= W.writeValue(RetSite);
+    }
+    W.writeInt(0);
+    jumpFn->forEachFunction(
+        [&](d_t SourceVal, n_t Target, d_t TargetVal,
+            const EdgeFunctionPtrType &F) {
+          W.writeInt(1);
+          Success &= writeCheckpointFact(W, SourceVal) &&
+                     W.writeValue(Target) &&
+                     writeCheckpointFact(W, TargetVal) && WriteEF(F);
+        });
+    W.writeInt(0);
+    for (const auto &[StartKey, Summaries] : endsummarytab) {
+      for (const auto &[ExitKey, F] : Summaries) {
+        W.writeInt(1);
+        Success &= W.writeValue(NodeIds[highId(StartKey)]) &&
+                   writeCheckpointFact(W, FactIds[lowId(StartKey)]) &&
+                   W.writeValue(NodeIds[highId(ExitKey)]) &&
+                   writeCheckpointFact(W, FactIds[lowId(ExitKey)]) &&
+                   WriteEF(F);
+      }
+    }
+    W.writeInt(0);
+    for (const auto &[StartKey, Incoming] : incomingtab) {
+      for (const auto &[CallSite, Facts] : Incoming) {
+        for (d_t Fact : Facts) {
+          W.writeInt(1);
+          Success &= W.writeValue(NodeIds[highId(StartKey)]) &&
+                     writeCheckpointFact(W, FactIds[lowId(StartKey)]) &&
+                     W.writeValue(CallSite) && writeCheckpointFact(W, Fact);
+        }
+      }
+    }
+    W.writeInt(0);
+    // readCheckpoint() pushes the pending edges in the order they are
+    // visited, which restores the order they are popped in
+    getWorklist().forEach([&](const PathEdge<n_t, d_t> &Edge) {
+      W.writeInt(1);
+      Success &= writeCheckpointFact(W, Edge.factAtSource()) &&
+                 W.writeValue(Edge.getTarget()) &&
+                 writeCheckpointFact(W, Edge.factAtTarget());
+    });
+    W.writeInt(0);
+    return Success && W.good();
+  }
+
+  /**
+   * Reads a checkpoint written by writeCheckpoint() for the same analysis,
+   * see IFDSTabulationProblem::getCheckpointName(). If Invalidated is null,
+   * the checkpoint must have been written for the current IR. Otherwise, the
+   * state of the functions that are affected by changes of the IR is dropped
+   * and these functions are added to Invalidated, see updateFromCheckpoint().
+   */
+  bool readCheckpoint(CheckpointReader &R,
+                      std::set<f_t> *Invalidated = nullptr,
+                      bool External = false) {
+    if (R.readString() != CheckpointMagic ||
+        R.readInt() != CheckpointVersion) {
+      return false;
+    }
+    if (R.readString() != IDEProblem.getCheckpointName()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "The checkpoint has been written by another analysis");
+      return false;
+    }
+    std::map<std::string, uint64_t> Hashes;
+    for (uint64_t I = R.readInt(); I > 0 && R.good(); --I) {
+      std::string Id = R.readString();
+      Hashes[Id] = R.readInt();
+    }
+    auto CurrentHashes = getCheckpointHashes(*IDEProblem.getProjectIRDB());
+    if (!Invalidated && Hashes != CurrentHashes) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "The checkpoint has been written for different IR");
+      return false;
+    }
+    // the state is read completely before the solver is modified
+    std::vector<EdgeFunctionPtrType> Functions;
+    auto ReadEF = [&] { return readCheckpointEdgeFunction(R, Functions); };
+    auto ReadNode = [&R] { return readCheckpointValue<n_t>(R); };
+    auto ReadFact = [&] { return readCheckpointFact(R); };
+    auto HasNext = [&R] { return R.readInt() != 0 && R.good(); };
+    uint64_t NumPathEdges = R.readInt();
+    std::map<n_t, std::set<d_t>> Seeds;
+    while (HasNext()) {
+      n_t Node = ReadNode();
+      auto &Facts = Seeds[Node];
+      for (uint64_t I = R.readInt(); I > 0 && R.good(); --I) {
+        Facts.insert(ReadFact());
+      }
+    }
+    std::set<n_t> RetSites;
+    while (HasNext()) {
+      RetSites.insert(ReadNode());
+    }
+    std::vector<std::tuple<d_t, n_t, d_t, EdgeFunctionPtrType>> JumpFns;
+    while (HasNext()) {
+      d_t SourceVal = ReadFact();
+      n_t Target = ReadNode();
+      d_t TargetVal = ReadFact();
+      JumpFns.emplace_back(SourceVal, Target, TargetVal, ReadEF());
+    }
+    std::vector<std::tuple<n_t, d_t, n_t, d_t, EdgeFunctionPtrType>> Summaries;
+    while (HasNext()) {
+      n_t StartPoint = ReadNode();
+      d_t d1 = ReadFact();
+      n_t ExitPoint = ReadNode();
+      d_t d2 = ReadFact();
+      Summaries.emplace_back(StartPoint, d1, ExitPoint, d2, ReadEF());
+    }
+    std::vector<std::tuple<n_t, d_t, n_t, d_t>> Incoming;
+    while (HasNext()) {
+      n_t StartPoint = ReadNode();
+      d_t d3 = ReadFact();
+      n_t CallSite = ReadNode();
+      Incoming.emplace_back(StartPoint, d3, CallSite, ReadFact());
+    }
+    std::vector<PathEdge<n_t, d_t>> Pending;
+    while (HasNext()) {
+      d_t SourceVal = ReadFact();
+      n_t Target = ReadNode();
+      Pending.emplace_back(SourceVal, Target, ReadFact());
+    }
+    if (!R.good()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "The checkpoint is corrupt");
+      return false;
+    }
+    // the functions whose state is dropped; empty if the IR is unchanged
+    std::set<f_t> Dropped;
+    if (Invalidated) {
+      std::set<f_t> Changed =
+          getChangedFunctions(Hashes, CurrentHashes, External);
+      addFunctionsWithOtherSummaries(Summaries, Changed);
+      // a retained entry must not refer to unknown values or to the facts of
+      // functions whose state is dropped, otherwise its owner is changed, too
+      auto IsKnown = [&](d_t d) {
+        return d && !Dropped.count(getFunctionOfFact(d));
+      };
+      size_t NumChanged;
+      do {
+        NumChanged = Changed.size();
+        Dropped = addTransitiveCallers(Changed);
+        auto Check = [&](n_t n, std::initializer_list<d_t> Facts,
+                         bool Known) {
+          if (!n || Dropped.count(ICF->getFunctionOf(n))) {
+            return;
+          }
+          for (d_t d : Facts) {
+            Known &= IsKnown(d);
+          }
+          if (!Known) {
+            Changed.insert(ICF->getFunctionOf(n));
+          }
+        };
+        for (const auto &[SourceVal, Target, TargetVal, F] : JumpFns) {
+          Check(Target, {SourceVal, TargetVal}, F != nullptr);
+        }
+        for (const auto &[StartPoint, d1, ExitPoint, d2, F] : Summaries) {
+          Check(StartPoint, {d1, d2}, ExitPoint && F);
+        }
+        for (const auto &[StartPoint, d3, CallSite, d2] : Incoming) {
+          // the state of a callee does not depend on its callers, the
+          // incoming calls of callers that are not part of the IR are
+          // merely dropped
+          if (CallSite) {
+            Check(StartPoint, {d3}, true);
+            Check(CallSite, {d2}, StartPoint != nullptr);
+          }
+        }
+        for (const auto &Edge : Pending) {
+          Check(Edge.getTarget(), {Edge.factAtSource(), Edge.factAtTarget()},
+                true);
+        }
+      } while (Changed.size() != NumChanged);
+      *Invalidated = Dropped;
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << Changed.size() << " functions have changed, drop the "
+                    << "state of " << Dropped.size() << " functions");
+    }
+    auto IsRetained = [&](n_t n) {
+      return n && !Dropped.count(ICF->getFunctionOf(n));
+    };
+    if (!Invalidated) {
+      // the seeds of an updated solver are the problem's current ones
+      PathEdgeCount = NumPathEdges;
+      initialSeeds = std::move(Seeds);
+    }
+    for (n_t RetSite : RetSites) {
+      if (IsRetained(RetSite)) {
+        unbalancedRetSites.insert(RetSite);
+      }
+    }
+    for (auto &[SourceVal, Target, TargetVal, F] : JumpFns) {
+      if (IsRetained(Target)) {
+        jumpFn->addFunction(SourceVal, Target, TargetVal, std::move(F));
+      }
+    }
+    for (auto &[StartPoint, d1, ExitPoint, d2, F] : Summaries) {
+      if (IsRetained(StartPoint)) {
+        addEndSummary(StartPoint, d1, ExitPoint, d2, std::move(F));
+      }
+    }
+    for (const auto &[StartPoint, d3, CallSite, d2] : Incoming) {
+      if (IsRetained(StartPoint) && IsRetained(CallSite)) {
+        addIncoming(StartPoint, d3, CallSite, d2);
+      }
+    }
+    auto &WL = getWorklist();
+    for (auto &Edge : Pending) {
+      if (IsRetained(Edge.getTarget())) {
+        if (releasesJumpFunctionsEarly()) {
+          ++PendingEdgesPerFunction[ICF->getFunctionOf(Edge.getTarget())];
+        }
+        WL.push(std::move(Edge));
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Returns the functions whose hashes differ between a checkpoint and the
+   * current IR, as well as functions whose names are ambiguous. If a global
+   * variable has changed, all functions are changed; added global variables
+   * do not affect unchanged functions.
+   * If anything has changed, the functions that contain indirect calls are
+   * changed as well, since the changes may alter their possible callees.
+   * For an External checkpoint, only the functions that are defined by the
+   * current IR and recorded in the checkpoint are compared.
+   */
+  std::set<f_t>
+  getChangedFunctions(const std::map<std::string, uint64_t> &Hashes,
+                      const std::map<std::string, uint64_t> &CurrentHashes,
+                      bool External = false) {
+    // removed functions and global variables need not be considered, their
+    // callers and users have changed as well
+    std::set<f_t> Changed;
+    bool GlobalChanged = false;
+    for (const auto &[Id, Hash] : CurrentHashes) {
+      auto Search = Hashes.find(Id);
+      if (Search != Hashes.end() && Search->second == Hash) {
+        continue;
+      }
+      const auto *IRDB = IDEProblem.getProjectIRDB();
+      const llvm::Function *F = IRDB->getFunctionDefinition(Id.substr(1));
+      if (External) {
+        // the functions of the other part are merely declared by the
+        // current IR and vice versa
+        if (F && Search != Hashes.end()) {
+          Changed.insert(F);
+        }
+        continue;
+      }
+      if (!F) {
+        F = IRDB->getFunction(Id.substr(1));
+      }
+      if (F) {
+        Changed.insert(F);
+      } else if (Search != Hashes.end()) {
+        // added global variables can only be used by changed functions,
+        // e.g. the ones of another module whose summaries are re-used
+        GlobalChanged = true;
+      }
+    }
+    // the state of equally named functions cannot be re-bound, see
+    // CheckpointReader::readValue()
+    std::map<std::string, std::vector<f_t>> Definitions;
+    for (f_t F : ICF->getAllFunctions()) {
+      if (!F->isDeclaration()) {
+        Definitions[F->getName().str()].push_back(F);
+      }
+    }
+    for (const auto &[Name, Functions] : Definitions) {
+      if (Functions.size() > 1) {
+        Changed.insert(Functions.begin(), Functions.end());
+      }
+    }
+    if (Changed.empty() && !GlobalChanged) {
+      return Changed;
+    }
+    for (f_t F : ICF->getAllFunctions()) {
+      if (GlobalChanged) {
+        Changed.insert(F);
+        continue;
+      }
+      for (n_t CallSite : ICF->getCallsFromWithin(F)) {
+        if (ICF->isIndirectFunctionCall(CallSite)) {
+          Changed.insert(F);
+          break;
+        }
+      }
+    }
+    return Changed;
+  }
+
+  // adds the functions whose checkpointed summaries for a context differ
+  // from the ones the solver already holds for it, see readCheckpoint()
+  void addFunctionsWithOtherSummaries(
+      const std::vector<std::tuple<n_t, d_t, n_t, d_t, EdgeFunctionPtrType>>
+          &Summaries,
+      std::set<f_t> &Changed) {
+    if (endsummarytab.empty()) {
+      return;
+    }
+    std::map<std::pair<n_t, d_t>, std::map<std::pair<n_t, d_t>,
+                                           EdgeFunctionPtrType>>
+        Contexts;
+    for (const auto &[StartPoint, d1, ExitPoint, d2, F] : Summaries) {
+      if (StartPoint && d1) {
+        Contexts[{StartPoint, d1}][{ExitPoint, d2}] = F;
+      }
+    }
+    for (const auto &[Context, ContextSummaries] : Contexts) {
+      auto ContextKey = lookupSummaryKey(Context.first, Context.second);
+      auto Search =
+          ContextKey ? endsummarytab.find(*ContextKey) : endsummarytab.end();
+      if (Search == endsummarytab.end()) {
+        continue;
+      }
+      bool Equal = Search->second.size() == ContextSummaries.size();
+      for (auto It = ContextSummaries.begin();
+           Equal && It != ContextSummaries.end(); ++It) {
+        const auto &[Exit, F] = *It;
+        auto ExitKey = Exit.first && Exit.second
+                           ? lookupSummaryKey(Exit.first, Exit.second)
+                           : std::nullopt;
+        auto Existing =
+            ExitKey ? Search->second.find(*ExitKey) : Search->second.end();
+        Equal = F && Existing != Search->second.end() &&
+                equalEdgeFunctions(F, Existing->second);
+      }
+      if (!Equal) {
+        Changed.insert(ICF->getFunctionOf(Context.first));
+      }
+    }
+  }
+
+  // returns the given functions and all of their transitive callers
+  std::set<f_t> addTransitiveCallers(const std::set<f_t> &Functions) {
+    std::set<f_t> Closure = Functions;
+    std::vector<f_t> WL(Functions.begin(), Functions.end());
+    while (!WL.empty()) {
+      f_t F = WL.back();
+      WL.pop_back();
+      for (n_t CallSite : ICF->getCallersOf(F)) {
+        if (f_t Caller = ICF->getFunctionOf(CallSite);
+            Closure.insert(Caller).second) {
+          WL.push_back(Caller);
+        }
+      }
+    }
+    return Closure;
+  }
+
+  // returns the function a fact belongs to, or nullptr for global facts
+  static f_t getFunctionOfFact(d_t d) {
+    if constexpr (IsCheckpointable<f_t> && IsCheckpointable<d_t>) {
+      if (const auto *I = llvm::dyn_cast<llvm::Instruction>(d)) {
+        return I->getFunction();
+      }
+      if (const auto *A = llvm::dyn_cast<llvm::Argument>(d)) {
+        return A->getParent();
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Removes the jump functions, end summaries and incoming calls of all
+   * contexts, i.e. functions and the facts that hold at their start points,
+   * that are not reachable from the initial seeds. Contexts that have been
+   * restored by updateFromCheckpoint() may have become unreachable due to
+   * changes of their callers.
+   */
+  void pruneUnreachableContexts() {
+    using Context = std::pair<f_t, d_t>;
+    // the facts that hold at the call sites in each context
+    std::map<Context, std::vector<std::pair<n_t, d_t>>> Calls;
+    jumpFn->forEachFunction(
+        [&](d_t d1, n_t n, d_t d2, const EdgeFunctionPtrType &) {
+          if (ICF->isCallStmt(n)) {
+            Calls[{ICF->getFunctionOf(n), d1}].emplace_back(n, d2);
+          }
+        });
+    // the contexts that are entered from each call site and fact
+    std::map<std::pair<n_t, d_t>, std::vector<Context>> Callees;
+    for (const auto &[StartKey, Incoming] : incomingtab) {
+      Context Callee{ICF->getFunctionOf(NodeIds[highId(StartKey)]),
+                     FactIds[lowId(StartKey)]};
+      for (const auto &[CallSite, Facts] : Incoming) {
+        for (d_t d2 : Facts) {
+          Callees[{CallSite, d2}].push_back(Callee);
+        }
+      }
+    }
+    std::set<Context> Reachable;
+    std::vector<Context> WL;
+    auto Reach = [&](const Context &C) {
+      if (Reachable.insert(C).second) {
+        WL.push_back(C);
+      }
+    };
+    for (const auto &[Seed, Facts] : initialSeeds) {
+      Reach({ICF->getFunctionOf(Seed), ZeroValue});
+    }
+    for (n_t RetSite : unbalancedRetSites) {
+      Reach({ICF->getFunctionOf(RetSite), ZeroValue});
+    }
+    while (!WL.empty()) {
+      Context C = WL.back();
+      WL.pop_back();
+      if (auto CallsSearch = Calls.find(C); CallsSearch != Calls.end()) {
+        for (const auto &CallAndFact : CallsSearch->second) {
+          if (auto Search = Callees.find(CallAndFact);
+              Search != Callees.end()) {
+            for (const auto &Callee : Search->second) {
+              Reach(Callee);
+            }
+          }
+        }
+      }
+    }
+    auto IsReachable = [&](uint64_t Key) {
+      return Reachable.count(
+          {ICF->getFunctionOf(NodeIds[highId(Key)]), FactIds[lowId(Key)]});
+    };
+    // the jump functions can only be removed per target statement
+    std::map<n_t, std::vector<std::tuple<d_t, d_t, EdgeFunctionPtrType>>>
+        Retained;
+    std::set<n_t> Pruned;
+    jumpFn->forEachFunction(
+        [&](d_t d1, n_t n, d_t d2, const EdgeFunctionPtrType &F) {
+          if (Reachable.count({ICF->getFunctionOf(n), d1})) {
+            Retained[n].emplace_back(d1, d2, F);
+          } else {
+            Pruned.insert(n);
+          }
+        });
+    size_t NumPruned = 0;
+    for (n_t n : Pruned) {
+      NumPruned += jumpFn->removeFunctionsAt(n);
+      for (auto &[d1, d2, F] : Retained[n]) {
+        jumpFn->addFunction(d1, n, d2, std::move(F));
+        --NumPruned;
+      }
+    }
+    for (auto It = endsummarytab.begin(), End = endsummarytab.end();
+         It != End;) {
+      auto Curr = It++;
+      if (!IsReachable(Curr->first)) {
+        endsummarytab.erase(Curr);
+      }
+    }
+    for (auto It = incomingtab.begin(), End = incomingtab.end(); It != End;) {
+      auto Curr = It++;
+      if (!IsReachable(Curr->first)) {
+        incomingtab.erase(Curr);
+      }
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Pruned " << NumPruned
+                  << " jump functions of unreachable contexts");
+  }
+
+  /**
+   * Computes the keys under which the end summaries of each function are
+   * cached, see IFDSIDESolverConfig::setSummaryCacheDirectory(). Since a
+   * function's summaries depend on the summaries of its callees, its key
+   * combines the analysis' name, see
+   * IFDSTabulationProblem::getSummaryCacheName(), the hashes of the function
+   * and of the global variables it refers to, see getCheckpointHashes(), and
+   * the keys of its callees. Mutually recursive functions share the hashes of
+   * all functions of their strongly connected component of the call graph.
+   * Functions that contain indirect calls, whose callees depend on the
+   * callers, functions with ambiguous names and their transitive callers
+   * cannot be cached.
+   */
+  void computeSummaryCacheKeys() {
+    if constexpr (IsCheckpointable<n_t> && IsCheckpointable<d_t> &&
+                  IsCheckpointable<f_t>) {
+      const std::string Name = IDEProblem.getSummaryCacheName();
+      if (Name.empty() || !IDEProblem.getProjectIRDB()) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                      << "The analysis does not support the summary cache");
+        return;
+      }
+      const auto Hashes = getCheckpointHashes(*IDEProblem.getProjectIRDB());
+      const auto EntryPoints = IDEProblem.getEntryPoints();
+      std::map<std::string, size_t> NumDefinitions;
+      for (f_t F : ICF->getAllFunctions()) {
+        if (!F->isDeclaration()) {
+          ++NumDefinitions[F->getName().str()];
+        }
+      }
+      // returns the contents of F's key that do not depend on its callees,
+      // or std::nullopt if F cannot be cached
+      auto GetLocalKey = [&](f_t F) -> std::optional<std::string> {
+        const std::string Id = getCheckpointId(F);
+        auto HashSearch = Hashes.find(Id);
+        if (Id.empty() || NumDefinitions[F->getName().str()] > 1 ||
+            HashSearch == Hashes.end()) {
+          return std::nullopt;
+        }
+        for (n_t CallSite : ICF->getCallsFromWithin(F)) {
+          if (ICF->isIndirectFunctionCall(CallSite)) {
+            return std::nullopt;
+          }
+        }
+        // analyses treat the entry points differently, e.g. they initialize
+        // the global variables there
+        const bool IsEntryPoint = EntryPoints.count(F->getName().str()) ||
+                                  EntryPoints.count("__ALL__");
+        std::string Key = Id + '=' + llvm::utohexstr(HashSearch->second) +
+                          (IsEntryPoint ? "!" : "");
+        std::set<std::string> Globals;
+        std::vector<const llvm::Value *> WL;
+        llvm::SmallPtrSet<const llvm::Value *, 16> Visited;
+        for (const auto &I : llvm::instructions(F)) {
+          WL.insert(WL.end(), I.value_op_begin(), I.value_op_end());
+        }
+        while (!WL.empty()) {
+          const llvm::Value *V = WL.back();
+          WL.pop_back();
+          if (!Visited.insert(V).second) {
+            continue;
+          }
+          if (const auto *G = llvm::dyn_cast<llvm::GlobalVariable>(V)) {
+            Globals.insert(getCheckpointId(G));
+          } else if (const auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(V)) {
+            WL.insert(WL.end(), CE->value_op_begin(), CE->value_op_end());
+          }
+        }
+        for (const auto &Global : Globals) {
+          auto Search = Hashes.find(Global);
+          Key += ';' + Global + '=' +
+                 llvm::utohexstr(Search != Hashes.end() ? Search->second : 0);
+        }
+        return Key;
+      };
+      // Tarjan's algorithm, which finds every SCC after the ones it calls
+      std::map<f_t, std::pair<size_t, size_t>> IndexAndLowLink;
+      std::vector<f_t> Stack;
+      std::set<f_t> OnStack;
+      std::set<f_t> NotCacheable;
+      std::function<void(f_t)> Visit = [&](f_t F) {
+        const size_t Index = IndexAndLowLink.size();
+        IndexAndLowLink[F] = {Index, Index};
+        Stack.push_back(F);
+        OnStack.insert(F);
+        std::set<f_t> Callees;
+        for (n_t CallSite : ICF->getCallsFromWithin(F)) {
+          for (f_t Callee : ICF->getCalleesOfCallAt(CallSite)) {
+            Callees.insert(Callee);
+          }
+        }
+        for (f_t Callee : Callees) {
+          if (!IndexAndLowLink.count(Callee)) {
+            Visit(Callee);
+            IndexAndLowLink[F].second = std::min(
+                IndexAndLowLink[F].second, IndexAndLowLink[Callee].second);
+          } else if (OnStack.count(Callee)) {
+            IndexAndLowLink[F].second = std::min(IndexAndLowLink[F].second,
+                                                 IndexAndLowLink[Callee].first);
+          }
+        }
+        if (IndexAndLowLink[F].second != Index) {
+          return;
+        }
+        std::vector<f_t> SCC;
+        do {
+          SCC.push_back(Stack.back());
+          Stack.pop_back();
+          OnStack.erase(SCC.back());
+        } while (SCC.back() != F);
+        std::set<std::string> Contents;
+        bool Cacheable = true;
+        for (f_t Member : SCC) {
+          if (auto LocalKey = GetLocalKey(Member)) {
+            Contents.insert(*LocalKey);
+          } else {
+            Cacheable = false;
+          }
+          for (n_t CallSite : ICF->getCallsFromWithin(Member)) {
+            for (f_t Callee : ICF->getCalleesOfCallAt(CallSite)) {
+              if (NotCacheable.count(Callee)) {
+                Cacheable = false;
+              } else if (auto Search = SummaryCacheKeys.find(Callee);
+                         Search != SummaryCacheKeys.end()) {
+                Contents.insert('>' + llvm::utohexstr(Search->second));
+              }
+            }
+          }
+        }
+        if (!Cacheable) {
+          NotCacheable.insert(SCC.begin(), SCC.end());
+          return;
+        }
+        std::string SCCKey = Name;
+        for (const auto &Content : Contents) {
+          SCCKey += '\n' + Content;
+        }
+        const uint64_t SCCHash = llvm::xxHash64(SCCKey);
+        for (f_t Member : SCC) {
+          SummaryCacheKeys[Member] = llvm::xxHash64(
+              llvm::utohexstr(SCCHash) + ':' + getCheckpointId(Member));
+        }
+      };
+      for (f_t F : ICF->getAllFunctions()) {
+        if (!IndexAndLowLink.count(F)) {
+          Visit(F);
         }
       }
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "The summaries of " << SummaryCacheKeys.size()
+                    << " functions may be cached, " << NotCacheable.size()
+                    << " functions cannot be cached");
     }
   }
 
-  void propagateValue(n_t nHashN, d_t nHashD, const l_t &l) {
-    l_t valNHash = val(nHashN, nHashD);
-    l_t lPrime = joinValueAt(nHashN, nHashD, valNHash, l);
-    if (!(lPrime == valNHash)) {
-      setVal(nHashN, nHashD, std::move(lPrime));
-      valuePropagationTask(std::pair<n_t, d_t>(nHashN, nHashD));
+  // returns the file that caches the end summaries of a function with the
+  // given key in the context of fact d, or an empty string if d cannot be
+  // identified
+  std::string getSummaryCacheFile(uint64_t Key, d_t d) {
+    std::string Fact;
+    if (!IDEProblem.isZeroValue(d)) {
+      Fact = getCheckpointId(d);
+      if (Fact.empty()) {
+        return "";
+      }
     }
+    return SolverConfig.summaryCacheDirectory() + "/" +
+           llvm::utohexstr(llvm::xxHash64(llvm::utohexstr(Key) + ':' + Fact)) +
+           ".sum";
   }
 
-  l_t val(n_t nHashN, d_t nHashD) {
-    if (valtab.contains(nHashN, nHashD)) {
-      return valtab.get(nHashN, nHashD);
+  /**
+   * Looks up the end summaries of Callee in the context of the fact d3 that
+   * holds at its start point sP in the summary cache and adds them to the
+   * end summary table. Returns true if they have been found, in which case
+   * Callee is not analyzed in this context; the values of its statements are
+   * therefore not computed.
+   */
+  bool loadCachedSummaries(f_t Callee, n_t sP, d_t d3) {
+    if constexpr (!IsCheckpointable<n_t> || !IsCheckpointable<d_t> ||
+                  !IsCheckpointable<f_t>) {
+      return false;
     } else {
-      // implicitly initialized to top; see line [1] of Fig. 7 in SRH96 paper
-      return IDEProblem.topElement();
+      auto KeySearch = SummaryCacheKeys.find(Callee);
+      if (KeySearch == SummaryCacheKeys.end()) {
+        return false;
+      }
+      PAMM_GET_INSTANCE;
+      auto Lock = lockIfConcurrent(SummaryMutex);
+      const uint64_t Context = getSummaryKey(sP, d3);
+      if (auto Search = CachedContexts.find(Context);
+          Search != CachedContexts.end()) {
+        return Search->second;
+      }
+      // contexts that have been entered before, e.g. the ones restored by
+      // updateFromCheckpoint(), are already being analyzed
+      if (incomingtab.count(Context) || endsummarytab.count(Context)) {
+        return false;
+      }
+      const bool Found = readCachedSummaries(KeySearch->second, sP, d3);
+      CachedContexts[Context] = Found;
+      if (Found) {
+        FunctionsSummarizedFromCache.insert(Callee);
+        ++SummaryCacheHits;
+        INC_COUNTER("Summary-cache hits", 1, PAMM_SEVERITY_LEVEL::Core);
+      } else {
+        ++SummaryCacheMisses;
+        INC_COUNTER("Summary-cache misses", 1, PAMM_SEVERITY_LEVEL::Core);
+      }
+      return Found;
     }
   }
 
-  void setVal(n_t nHashN, d_t nHashD, l_t l) {
-    LOG_IF_ENABLE([&]() {
-      BOOST_LOG_SEV(lg::get(), DEBUG)
-          << "Function : " << ICF->getFunctionOf(nHashN)->getName().str();
-      BOOST_LOG_SEV(lg::get(), DEBUG)
-          << "Inst.    : " << IDEProblem.NtoString(nHashN);
-      BOOST_LOG_SEV(lg::get(), DEBUG)
-          << "Fact     : " << IDEProblem.DtoString(nHashD);
-      BOOST_LOG_SEV(lg::get(), DEBUG)
-          << "Value    : " << IDEProblem.LtoString(l);
-      BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
-    }());
-    // TOP is the implicit default value which we do not need to store.
-    // if (l == IDEProblem.topElement()) {
-    // do not store top values
-    // valtab.remove(nHashN, nHashD);
-    // } else {
-    valtab.insert(nHashN, nHashD, std::move(l));
-    // }
+  bool readCachedSummaries(uint64_t Key, n_t sP, d_t d3) {
+    const std::string File = getSummaryCacheFile(Key, d3);
+    std::ifstream IFS(File, std::ios::binary);
+    if (File.empty() || !IFS) {
+      return false;
+    }
+    // indexing the IR's values is expensive, the reader is therefore re-used
+    if (!SummaryCacheReader) {
+      SummaryCacheReader = std::make_unique<CheckpointReader>(
+          SummaryCacheStream, *IDEProblem.getProjectIRDB());
+    }
+    SummaryCacheStream.str(std::string(std::istreambuf_iterator<char>(IFS),
+                                       std::istreambuf_iterator<char>()));
+    CheckpointReader &R = *SummaryCacheReader;
+    R.reset();
+    if (R.readString() != SummaryCacheMagic ||
+        R.readInt() != SummaryCacheVersion) {
+      return false;
+    }
+    std::vector<EdgeFunctionPtrType> Functions;
+    std::vector<std::tuple<n_t, d_t, EdgeFunctionPtrType>> Summaries;
+    for (uint64_t I = R.readInt(); I > 0 && R.good(); --I) {
+      n_t eP = readCheckpointValue<n_t>(R);
+      d_t d4 = readCheckpointFact(R);
+      Summaries.emplace_back(eP, d4, readCheckpointEdgeFunction(R, Functions));
+    }
+    if (!R.good()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "The cached summaries '" << File << "' are corrupt");
+      return false;
+    }
+    for (auto &[eP, d4, F] : Summaries) {
+      addEndSummary(sP, d3, eP, d4, std::move(F));
+    }
+    return true;
   }
 
-  EdgeFunctionPtrType jumpFunction(const PathEdge<n_t, d_t> edge) {
-    LOG_IF_ENABLE(
-        BOOST_LOG_SEV(lg::get(), DEBUG) << " ";
-        BOOST_LOG_SEV(lg::get(), DEBUG) << "JumpFunctions Forward-Lookup:";
-        BOOST_LOG_SEV(lg::get(), DEBUG)
-        << "   Source D: " << IDEProblem.DtoString(edge.factAtSource());
-        BOOST_LOG_SEV(lg::get(), DEBUG)
-        << "   Target N: " << IDEProblem.NtoString(edge.getTarget());
-        BOOST_LOG_SEV(lg::get(), DEBUG)
-        << "   Target D: " << IDEProblem.DtoString(edge.factAtTarget()));
+  /**
+   * Writes the end summaries of all contexts of cacheable functions that
+   * have been analyzed to the summary cache, see computeSummaryCacheKeys().
+   * Existing entries are never modified since the keys identify their
+   * contents. The summaries of a context are only cached if its facts
+   * belong to its function or are global: the IDs of other functions'
+   * facts are not covered by the key.
+   */
+  void storeCachedSummaries() {
+    if constexpr (IsCheckpointable<n_t> && IsCheckpointable<d_t> &&
+                  IsCheckpointable<f_t>) {
+      PAMM_GET_INSTANCE;
+      if (RelevantStmts) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                      << "The summaries of a restricted exploded super-graph "
+                         "are incomplete and are not cached");
+        return;
+      }
+      if (auto EC = llvm::sys::fs::create_directories(
+              SolverConfig.summaryCacheDirectory())) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                      << "Cannot create the summary cache directory '"
+                      << SolverConfig.summaryCacheDirectory()
+                      << "': " << EC.message());
+        return;
+      }
+      size_t NumStored = 0;
+      // every context that has been called, including the ones that never
+      // return
+      for (const auto &Entry : incomingtab) {
+        const uint64_t Context = Entry.first;
+        if (auto Search = CachedContexts.find(Context);
+            Search != CachedContexts.end() && Search->second) {
+          continue;
+        }
+        n_t sP = NodeIds[highId(Context)];
+        d_t d1 = FactIds[lowId(Context)];
+        f_t F = ICF->getFunctionOf(sP);
+        auto KeySearch = SummaryCacheKeys.find(F);
+        if (KeySearch == SummaryCacheKeys.end()) {
+          continue;
+        }
+        auto IsCacheable = [&](d_t d) {
+          f_t Owner = getFunctionOfFact(d);
+          return IDEProblem.isZeroValue(d) || !Owner || Owner == F;
+        };
+        auto SummariesSearch = endsummarytab.find(Context);
+        bool Cacheable = IsCacheable(d1);
+        if (SummariesSearch != endsummarytab.end()) {
+          for (const auto &[ExitKey, Summary] : SummariesSearch->second) {
+            Cacheable &= IsCacheable(FactIds[lowId(ExitKey)]);
+          }
+        }
+        const std::string File = getSummaryCacheFile(KeySearch->second, d1);
+        if (!Cacheable || File.empty() || llvm::sys::fs::exists(File)) {
+          continue;
+        }
+        const std::string TmpFile = File + ".tmp";
+        bool Written;
+        {
+          std::ofstream OFS(TmpFile, std::ios::binary);
+          CheckpointWriter W(OFS);
+          llvm::DenseMap<const EdgeFunction<l_t> *, uint64_t> EFIndices;
+          W.writeString(SummaryCacheMagic);
+          W.writeInt(SummaryCacheVersion);
+          Written = true;
+          if (SummariesSearch == endsummarytab.end()) {
+            W.writeInt(0);
+          } else {
+            W.writeInt(SummariesSearch->second.size());
+            for (const auto &[ExitKey, Summary] : SummariesSearch->second) {
+              Written &= W.writeValue(NodeIds[highId(ExitKey)]) &&
+                         writeCheckpointFact(W, FactIds[lowId(ExitKey)]) &&
+                         writeCheckpointEdgeFunction(W, Summary, EFIndices);
+            }
+          }
+          Written &= OFS && W.good() && OFS.flush();
+        }
+        // other solvers never see an incomplete entry
+        if (!Written || std::rename(TmpFile.c_str(), File.c_str()) != 0) {
+          std::remove(TmpFile.c_str());
+          continue;
+        }
+        ++NumStored;
+      }
+      INC_COUNTER("Summary-cache stores", NumStored,
+                  PAMM_SEVERITY_LEVEL::Core);
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Cached the summaries of " << NumStored
+                    << " contexts in '" << SolverConfig.summaryCacheDirectory()
+                    << "'");
+    }
+  }
 
-    auto fwdLookupRes =
-        jumpFn->forwardLookup(edge.factAtSource(), edge.getTarget());
-    if (fwdLookupRes) {
-      auto &ref = fwdLookupRes->get();
-      if (auto Find = std::find_if(ref.begin(), ref.end(),
-                                   [edge](const auto &Pair) {
-                                     return edge.factAtTarget() == Pair.first;
-                                   });
-          Find != ref.end()) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "  => EdgeFn: " << Find->second->str();
-                      BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
-        return Find->second;
+  /**
+   * Constructs the exploded super-graph using SolverConfig.numThreads()
+   * worker threads that steal path edges from each other. The solver's tables
+   * are guarded by mutexes and the flow and edge functions are constructed
+   * mutually exclusive. The flow and edge functions are, however, applied
+   * concurrently: they must not modify state shared with other functions
+   * without synchronization. PAMM's counters and histograms are guarded by a
+   * single mutex; at PAMM_SEVERITY_LEVEL::Full, where counters are updated
+   * for every path edge, that mutex serializes the workers to a large extent.
+   */
+  void runWorklistConcurrently() {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Construct exploded super graph using "
+                  << SolverConfig.numThreads() << " threads");
+    ConcurrentWorklist =
+        std::make_unique<WorkStealingPathEdgeWorklist<n_t, d_t>>(
+            SolverConfig.numThreads());
+    cachedFlowEdgeFunctions.setConcurrent();
+    if (EFStore) {
+      EFStore->setConcurrent();
+    }
+    // hand over the edges that have already been discovered
+    auto &WL = getWorklist();
+    while (!WL.empty()) {
+      ConcurrentWorklist->push(WL.pop());
+    }
+    try {
+      ConcurrentWorklist->run([this](PathEdge<n_t, d_t> Edge) {
+        pathEdgeProcessingTask(std::move(Edge));
+      });
+    } catch (...) {
+      cachedFlowEdgeFunctions.setConcurrent(false);
+      if (EFStore) {
+        EFStore->setConcurrent(false);
       }
+      ConcurrentWorklist.reset();
+      throw;
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "  => EdgeFn: " << allTop->str();
-                  BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
-    // JumpFn initialized to all-top, see line [2] in SRH96 paper
-    return allTop;
+    cachedFlowEdgeFunctions.setConcurrent(false);
+    if (EFStore) {
+      EFStore->setConcurrent(false);
+    }
+    ConcurrentWorklist.reset();
   }
 
-  void addEndSummary(n_t sP, d_t d1, n_t eP, d_t d2, EdgeFunctionPtrType f) {
-    // note: at this point we don't need to join with a potential previous f
-    // because f is a jump function, which is already properly joined
-    // within propagate(..)
-    endsummarytab.get(sP, d1).insert(eP, d2, std::move(f));
+  EdgeFunctionPtrType composeEdgeFunctions(const EdgeFunctionPtrType &F,
+                                           const EdgeFunctionPtrType &G) {
+    return EFStore ? EFStore->compose(F, G) : F->composeWith(G);
+  }
+
+  EdgeFunctionPtrType joinEdgeFunctions(const EdgeFunctionPtrType &F,
+                                        const EdgeFunctionPtrType &G) {
+    return EFStore ? EFStore->join(F, G) : F->joinWith(G);
+  }
+
+  bool equalEdgeFunctions(const EdgeFunctionPtrType &F,
+                          const EdgeFunctionPtrType &G) {
+    return EFStore ? EdgeFunctionStore<l_t>::equal(F, G) : F->equal_to(G);
+  }
+
+  std::unique_lock<std::mutex> lockIfConcurrent(std::mutex &Mtx) {
+    return ConcurrentWorklist ? std::unique_lock<std::mutex>(Mtx)
+                              : std::unique_lock<std::mutex>();
   }
 
   // should be made a callable at some point
   void pathEdgeProcessingTask(const PathEdge<n_t, d_t> edge) {
     PAMM_GET_INSTANCE;
+    [[maybe_unused]] std::chrono::steady_clock::time_point Start;
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      Start = std::chrono::steady_clock::now();
+    }
     INC_COUNTER("JumpFn Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -801,7 +2659,8 @@ protected:
         BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
 
     if (!ICF->isCallStmt(edge.getTarget())) {
-      if (ICF->isExitStmt(edge.getTarget())) {
+      // the end summaries are final when jump functions are recomputed
+      if (ICF->isExitStmt(edge.getTarget()) && !Replaying) {
         processExit(edge);
       }
       if (!ICF->getSuccsOf(edge.getTarget()).empty()) {
@@ -810,6 +2669,51 @@ protected:
     } else {
       processCall(edge);
     }
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      if (!Replaying) {
+        auto Time = std::chrono::steady_clock::now() - Start;
+        auto Lock = lockIfConcurrent(TelemetryMutex);
+        Telemetry.recordTime(ICF->getFunctionOf(edge.getTarget()), Time);
+      }
+    }
+  }
+
+  // processes path edges with the same source fact at the same statement,
+  // see pathEdgeProcessingTask()
+  void batchProcessingTask(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    PAMM_GET_INSTANCE;
+    [[maybe_unused]] std::chrono::steady_clock::time_point Start;
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      Start = std::chrono::steady_clock::now();
+    }
+    INC_COUNTER("JumpFn Construction", Edges.size(),
+                PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process " << Edges.size() << " path edges with < D "
+                  << "source: "
+                  << IDEProblem.DtoString(Edges.front().factAtSource())
+                  << " ; N target: "
+                  << IDEProblem.NtoString(Edges.front().getTarget()) << " >");
+    n_t n = Edges.front().getTarget();
+    if (!ICF->isCallStmt(n)) {
+      // the end summaries are final when jump functions are recomputed
+      if (ICF->isExitStmt(n) && !Replaying) {
+        processExitBatch(Edges);
+      }
+      if (!ICF->getSuccsOf(n).empty()) {
+        processNormalFlowBatch(Edges);
+      }
+    } else {
+      processCallBatch(Edges);
+    }
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      if (!Replaying) {
+        auto Time = std::chrono::steady_clock::now() - Start;
+        auto Lock = lockIfConcurrent(TelemetryMutex);
+        Telemetry.recordTime(ICF->getFunctionOf(Edges.front().getTarget()),
+                             Time);
+      }
+    }
   }
 
   // should be made a callable at some point
@@ -850,11 +2754,241 @@ protected:
     }
   }
 
+  /**
+   * Parallel version of valueComputationTask() that uses
+   * SolverConfig.numThreads() threads. The nodes are handed out to the threads
+   * in blocks. Every node is owned by exactly one thread, thus, the values
+   * computed by a thread are stored in its own shard of the value table. The
+   * shards are merged into valtab afterwards. The jump functions and the values
+   * at the start points are only read during this phase.
+   */
+  void valueComputationTaskConcurrently(const std::vector<n_t> &values) {
+    PAMM_GET_INSTANCE;
+    static constexpr size_t BlockSize = 64;
+    const size_t NumThreads =
+        std::min<size_t>(SolverConfig.numThreads(),
+                         (values.size() + BlockSize - 1) / BlockSize);
+    std::atomic<size_t> NextBlock = 0;
+    auto Worker = [&]() {
+      Table<n_t, d_t, l_t> Shard;
+      size_t NumComputations = 0;
+      for (size_t Begin = NextBlock.fetch_add(BlockSize); Begin < values.size();
+           Begin = NextBlock.fetch_add(BlockSize)) {
+        const size_t End = std::min(Begin + BlockSize, values.size());
+        for (size_t I = Begin; I < End; ++I) {
+          n_t n = values[I];
+          for (n_t sP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
+            using TableCell =
+                typename Table<d_t, d_t, EdgeFunctionPtrType>::Cell;
+            for (const TableCell &sourceValTargetValAndFunction :
+                 jumpFn->lookupByTarget(n).cellSet()) {
+              d_t dPrime = sourceValTargetValAndFunction.getRowKey();
+              d_t d = sourceValTargetValAndFunction.getColumnKey();
+              EdgeFunctionPtrType fPrime =
+                  sourceValTargetValAndFunction.getValue();
+              l_t targetVal = val(sP, dPrime);
+              l_t curr = Shard.contains(n, d) ? Shard.get(n, d) : val(n, d);
+              Shard.insert(n, d,
+                           IDEProblem.join(std::move(curr),
+                                           fPrime->computeTarget(
+                                               std::move(targetVal))));
+              ++NumComputations;
+            }
+          }
+        }
+      }
+      return std::make_pair(std::move(Shard), NumComputations);
+    };
+    std::vector<std::future<std::pair<Table<n_t, d_t, l_t>, size_t>>> Futures;
+    Futures.reserve(NumThreads);
+    for (size_t I = 0; I < NumThreads; ++I) {
+      Futures.push_back(std::async(std::launch::async, Worker));
+    }
+    // collect all shards before merging, such that valtab is not modified
+    // while other threads still read from it
+    std::vector<std::pair<Table<n_t, d_t, l_t>, size_t>> Results;
+    Results.reserve(NumThreads);
+    for (auto &Future : Futures) {
+      Results.push_back(Future.get());
+    }
+    for (auto &[Shard, NumComputations] : Results) {
+      for (auto &Cell : Shard.cellVec()) {
+        setVal(Cell.getRowKey(), Cell.getColumnKey(), Cell.getValue());
+      }
+      INC_COUNTER("Value Computation", NumComputations,
+                  PAMM_SEVERITY_LEVEL::Full);
+    }
+  }
+
+  bool isRelevant(n_t n) const {
+    return !RelevantStmts || RelevantStmts->count(n);
+  }
+
+  bool lowMemoryMode() const {
+    // the ESG is emitted from the recorded edges
+    return SolverConfig.lowMemory() && !SolverConfig.emitESG();
+  }
+
+  /**
+   * Returns true if the jump functions of a function are released during
+   * Phase I as soon as none of its path edges is pending, see
+   * releaseJumpFunctionsIfDone(). This requires the sequential solver; a
+   * checkpoint requires all jump functions.
+   */
+  bool releasesJumpFunctionsEarly() const {
+    return lowMemoryMode() && !Replaying && !ConcurrentWorklist &&
+           SolverConfig.checkpointFile().empty();
+  }
+
+  /**
+   * Returns true if the jump functions with the given target are retained in
+   * low-memory mode. These are the jump functions at start points, call sites,
+   * exit statements, seeds and unbalanced return sites: they are required to
+   * apply and complete the end summaries, to propagate the values in Phase
+   * II(i) and to recompute the released jump functions.
+   */
+  bool retainJumpFunctionsAt(n_t n) const {
+    return ICF->isStartPoint(n) || ICF->isCallStmt(n) || ICF->isExitStmt(n) ||
+           initialSeeds.count(n) || unbalancedRetSites.count(n);
+  }
+
+  /**
+   * Releases the jump functions of the given function that are not retained,
+   * see retainJumpFunctionsAt(), once NumProcessed path edges of the function
+   * have been processed and none of its path edges is pending any more. Its
+   * end summaries are complete for now, since they are derived from the
+   * retained jump functions at the exit statements. If a caller or callee
+   * propagates into the function again, the path edges are propagated
+   * starting from the all-top function, which yields the same jump functions
+   * at retained statements as the edge functions are distributive.
+   */
+  void releaseJumpFunctionsIfDone(f_t Fun, size_t NumProcessed) {
+    if (!releasesJumpFunctionsEarly()) {
+      return;
+    }
+    auto Search = PendingEdgesPerFunction.find(Fun);
+    if (Search == PendingEdgesPerFunction.end()) {
+      return;
+    }
+    Search->second -= std::min(Search->second, NumProcessed);
+    if (Search->second) {
+      return;
+    }
+    PendingEdgesPerFunction.erase(Search);
+    for (n_t n : ICF->getAllInstructionsOf(Fun)) {
+      if (!retainJumpFunctionsAt(n)) {
+        NumReleasedDuringPhaseI += jumpFn->removeFunctionsAt(n);
+      }
+    }
+    JumpFunctionsReleased = true;
+  }
+
+  /**
+   * Releases all jump functions that are still held and not retained, see
+   * retainJumpFunctionsAt(), once the exploded super-graph has been
+   * constructed, i.e. once all end summaries are final. Most of them have
+   * been released during Phase I already, see releaseJumpFunctionsIfDone().
+   * The released jump functions are only required to compute the values in
+   * Phase II(ii) and are recomputed one function at a time, see
+   * valueComputationTaskLowMemory().
+   */
+  void releaseIntraProceduralJumpFunctions() {
+    size_t NumReleased = 0;
+    for (n_t n : ICF->allNonCallStartNodes()) {
+      if (!retainJumpFunctionsAt(n)) {
+        NumReleased += jumpFn->removeFunctionsAt(n);
+      }
+    }
+    PendingEdgesPerFunction.shrink_and_clear();
+    // the incoming edges are only required to construct the exploded
+    // super-graph
+    incomingtab.shrink_and_clear();
+    JumpFunctionsReleased = true;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Released " << NumReleasedDuringPhaseI
+                  << " intra-procedural jump functions during and "
+                  << NumReleased << " after the construction of the ESG");
+  }
+
+  /**
+   * Marks the given path edge as processed while jump functions are
+   * recomputed. Returns true if it has not been processed before.
+   */
+  bool markReplayed(d_t sourceVal, n_t target, d_t targetVal) {
+    return ReplayedEdges
+        .insert({getSummaryKey(target, targetVal),
+                 FactIds.getOrInsert(sourceVal)})
+        .second;
+  }
+
+  /**
+   * Recomputes the released jump functions of the given function by
+   * constructing the function's part of the exploded super-graph once more.
+   * The path edges are propagated from the retained jump functions at the
+   * function's start points, seeds and unbalanced return sites. Calls are
+   * summarized using the end summaries; nothing is propagated into callees or
+   * callers.
+   */
+  void recomputeJumpFunctions(f_t Fun) {
+    std::set<n_t> Entries = ICF->getStartPointsOf(Fun);
+    for (const auto &Seed : initialSeeds) {
+      if (ICF->getFunctionOf(Seed.first) == Fun) {
+        Entries.insert(Seed.first);
+      }
+    }
+    for (n_t RetSite : unbalancedRetSites) {
+      if (ICF->getFunctionOf(RetSite) == Fun) {
+        Entries.insert(RetSite);
+      }
+    }
+    Replaying = true;
+    auto &WL = getWorklist();
+    for (n_t Entry : Entries) {
+      for (const auto &Cell : jumpFn->lookupByTarget(Entry).cellVec()) {
+        if (markReplayed(Cell.getRowKey(), Entry, Cell.getColumnKey())) {
+          WL.push(PathEdge<n_t, d_t>(Cell.getRowKey(), Entry,
+                                     Cell.getColumnKey()));
+        }
+      }
+    }
+    while (!WL.empty()) {
+      pathEdgeProcessingTask(WL.pop());
+    }
+    Replaying = false;
+    ReplayedEdges.clear();
+  }
+
+  /**
+   * Low-memory version of valueComputationTask(): the released jump functions
+   * are recomputed for one function at a time, used to compute the values of
+   * the function's statements and released again.
+   */
+  void valueComputationTaskLowMemory(const std::set<n_t> &values) {
+    std::map<f_t, std::vector<n_t>> NodesPerFunction;
+    for (n_t n : values) {
+      NodesPerFunction[ICF->getFunctionOf(n)].push_back(n);
+    }
+    for (const auto &[Fun, Nodes] : NodesPerFunction) {
+      recomputeJumpFunctions(Fun);
+      valueComputationTask(Nodes);
+      for (n_t n : Nodes) {
+        if (!retainJumpFunctionsAt(n)) {
+          jumpFn->removeFunctionsAt(n);
+        }
+      }
+      if (EFStore) {
+        EFStore->clear();
+      }
+    }
+  }
+
   virtual void saveEdges(n_t sourceNode, n_t sinkStmt, d_t sourceVal,
                          const container_type &destVals, bool interP) {
-    if (!SolverConfig.recordEdges()) {
+    // the edges are not recorded in low-memory mode
+    if (!SolverConfig.recordEdges() || lowMemoryMode()) {
       return;
     }
+    auto Lock = lockIfConcurrent(PathEdgeRecordMutex);
     Table<n_t, n_t, std::map<d_t, container_type>> &tgtMap =
         (interP) ? computedInterPathEdges : computedIntraPathEdges;
     tgtMap.get(sourceNode, sinkStmt)[sourceVal].insert(destVals.begin(),
@@ -887,9 +3021,31 @@ protected:
     // Phase II(ii)
     // we create an array of all nodes and then dispatch fractions of this
     // array to multiple threads
-    const std::set<n_t> allNonCallStartNodes = ICF->allNonCallStartNodes();
-    valueComputationTask(
-        {allNonCallStartNodes.begin(), allNonCallStartNodes.end()});
+    std::set<n_t> allNonCallStartNodes = ICF->allNonCallStartNodes();
+    // the values at collapsed statements are reconstructed afterwards
+    if (RelevantStmts || Chains) {
+      for (auto It = allNonCallStartNodes.begin();
+           It != allNonCallStartNodes.end();) {
+        It = isRelevant(*It) && !(Chains && Chains->isCollapsed(*It))
+                 ? std::next(It)
+                 : allNonCallStartNodes.erase(It);
+      }
+    }
+    if (lowMemoryMode()) {
+      valueComputationTaskLowMemory(allNonCallStartNodes);
+    } else if (SolverConfig.numThreads() > 1) {
+      valueComputationTaskConcurrently(
+          {allNonCallStartNodes.begin(), allNonCallStartNodes.end()});
+    } else {
+      valueComputationTask(
+          {allNonCallStartNodes.begin(), allNonCallStartNodes.end()});
+    }
+    if (Chains) {
+      reconstructCollapsedValues();
+    }
+    if (SolverConfig.sparsePropagation()) {
+      reconstructSkippedValues();
+    }
   }
 
   /**
@@ -915,6 +3071,7 @@ protected:
       jumpFn->addFunction(ZeroValue, StartPoint, ZeroValue,
                           EdgeIdentity<l_t>::getInstance());
     }
+    runWorklist();
   }
 
   /**
@@ -941,16 +3098,20 @@ protected:
     const std::set<n_t> startPointsOf =
         ICF->getStartPointsOf(functionThatNeedsSummary);
     std::map<n_t, container_type> inc;
-    for (n_t sP : startPointsOf) {
-      // line 21.1 of Naeem/Lhotak/Rodriguez
-      // register end-summary
-      addEndSummary(sP, d1, n, d2, f);
-      for (auto entry : incoming(d1, sP)) {
-        inc[entry.first] = Container{entry.second};
+    {
+      // counterpart of line 15.1/15.2 in processCall()
+      auto Lock = lockIfConcurrent(SummaryMutex);
+      for (n_t sP : startPointsOf) {
+        // line 21.1 of Naeem/Lhotak/Rodriguez
+        // register end-summary
+        addEndSummary(sP, d1, n, d2, f);
+        for (auto entry : incoming(d1, sP)) {
+          inc[entry.first] = Container{entry.second};
+        }
       }
+      printEndSummaryTab();
+      printIncomingTab();
     }
-    printEndSummaryTab();
-    printIncomingTab();
     // for each incoming call edge already processed
     //(see processCall(..))
     for (auto entry : inc) {
@@ -965,8 +3126,8 @@ protected:
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
         // for each incoming-call value
         for (d_t d4 : entry.second) {
-          const container_type targets =
-              computeReturnFlowFunction(retFunction, d1, d2, c, entry.second);
+          const container_type targets = returnFlowTargets(
+              retFunction, d1, d2, c, retSiteC, entry.second);
           ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
                            PAMM_SEVERITY_LEVEL::Full);
           saveEdges(n, retSiteC, d2, targets, true);
@@ -1001,26 +3162,33 @@ protected:
                               << " * " << f4->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "         (return * function * call)");
-            EdgeFunctionPtrType fPrime = f4->composeWith(f)->composeWith(f5);
+            EdgeFunctionPtrType fPrime =
+                composeEdgeFunctions(composeEdgeFunctions(f4, f), f5);
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "       = " << fPrime->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
             // for each jump function coming into the call, propagate to
             // return site using the composed function
-            auto revLookupResult = jumpFn->reverseLookup(c, d4);
-            if (revLookupResult) {
-              for (auto valAndFunc : revLookupResult->get()) {
-                EdgeFunctionPtrType f3 = valAndFunc.second;
-                if (!f3->equal_to(allTop)) {
-                  d_t d3 = valAndFunc.first;
-                  d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                                    << "Compose: " << fPrime->str() << " * "
-                                    << f3->str();
-                                BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-                  propagate(d3, retSiteC, d5_restoredCtx,
-                            f3->composeWith(fPrime), c, false);
-                }
+            // copy, propagate() may modify the jump functions
+            llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>
+                callerJumpFns;
+            {
+              auto Lock = lockIfConcurrent(JumpFnMutex);
+              if (auto revLookupResult = jumpFn->reverseLookup(c, d4)) {
+                callerJumpFns = *revLookupResult;
+              }
+            }
+            for (const auto &valAndFunc : callerJumpFns) {
+              EdgeFunctionPtrType f3 = valAndFunc.second;
+              if (!equalEdgeFunctions(f3, allTop)) {
+                d_t d3 = valAndFunc.first;
+                d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
+                LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                                  << "Compose: " << fPrime->str() << " * "
+                                  << f3->str();
+                              BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+                propagate(d3, retSiteC, d5_restoredCtx,
+                          composeEdgeFunctions(f3, fPrime), c, false);
               }
             }
           }
@@ -1042,8 +3210,8 @@ protected:
               cachedFlowEdgeFunctions.getRetFlowFunction(
                   c, functionThatNeedsSummary, n, retSiteC);
           INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          const container_type targets = computeReturnFlowFunction(
-              retFunction, d1, d2, c, Container{ZeroValue});
+          const container_type targets = returnFlowTargets(
+              retFunction, d1, d2, c, retSiteC, Container{ZeroValue});
           ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
                            PAMM_SEVERITY_LEVEL::Full);
           saveEdges(n, retSiteC, d2, targets, true);
@@ -1061,8 +3229,10 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "Compose: " << f5->str() << " * " << f->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-            propagteUnbalancedReturnFlow(retSiteC, d5, f->composeWith(f5), c);
+            propagteUnbalancedReturnFlow(retSiteC, d5,
+                                         composeEdgeFunctions(f, f5), c);
             // register for value processing (2nd IDE phase)
+            auto Lock = lockIfConcurrent(SummaryMutex);
             unbalancedRetSites.insert(retSiteC);
           }
         }
@@ -1081,6 +3251,27 @@ protected:
     }
   }
 
+  /**
+   * Processes the path edges of Edges, which all have the same source fact
+   * and target exit statement, like processExit(), but applies each
+   * return-flow function to the facts of all edges at once, see
+   * FlowFunction::computeTargetsBatch().
+   * @param Edges
+   */
+  virtual void
+  processExitBatch(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    if (Edges.size() > 1) {
+      PAMM_GET_INSTANCE;
+      INC_COUNTER("Batched Path Edges", Edges.size(),
+                  PAMM_SEVERITY_LEVEL::Full);
+      CurrentBatch.assign(Edges);
+    }
+    for (const auto &Edge : Edges) {
+      processExit(Edge);
+    }
+    CurrentBatch.clear();
+  }
+
   void propagteUnbalancedReturnFlow(n_t retSiteC, d_t targetVal,
                                     EdgeFunctionPtrType edgeFunction,
                                     n_t relatedCallSite) {
@@ -1127,6 +3318,21 @@ protected:
     return flowFunction->computeTargets(d2);
   }
 
+  /**
+   * Computes the normal flow function for several abstractions at the
+   * current node that share the same start abstraction at once.
+   * @param flowFunction The normal flow function to compute
+   * @param d1 The abstraction at the method's start node
+   * @param d2s The abstractions at the current node
+   * @return The sets of abstractions at the successor node, one per element
+   * of d2s
+   */
+  std::vector<container_type>
+  computeNormalFlowFunctionBatch(const FlowFunctionPtrType &flowFunction,
+                                 d_t d1, const std::vector<d_t> &d2s) {
+    return flowFunction->computeTargetsBatch(d2s);
+  }
+
   /**
    * TODO: comment
    */
@@ -1149,6 +3355,34 @@ protected:
     return callFlowFunction->computeTargets(d2);
   }
 
+  /**
+   * Computes the call flow function for several call-site abstractions that
+   * share the same start abstraction at once.
+   * @param callFlowFunction The call flow function to compute
+   * @param d1 The abstraction at the current method's start node.
+   * @param d2s The abstractions at the call site
+   * @return The sets of caller-side abstractions at the callee's start node,
+   * one per element of d2s
+   */
+  std::vector<container_type>
+  computeCallFlowFunctionBatch(const FlowFunctionPtrType &callFlowFunction,
+                               d_t d1, const std::vector<d_t> &d2s) {
+    return callFlowFunction->computeTargetsBatch(d2s);
+  }
+
+  // Returns the targets of the call flow function into callee for d2, which
+  // are computed for the whole batch if a batch is processed.
+  container_type callFlowTargets(const FlowFunctionPtrType &callFlowFunction,
+                                 f_t callee, d_t d1, d_t d2) {
+    if (CurrentBatch.empty()) {
+      return computeCallFlowFunction(callFlowFunction, d1, d2);
+    }
+    return CurrentBatch.getCallTargets(
+        callee, d2, [&](const std::vector<d_t> &d2s) {
+          return computeCallFlowFunctionBatch(callFlowFunction, d1, d2s);
+        });
+  }
+
   /**
    * Computes the call-to-return flow function for the given call-site
    * abstraction
@@ -1180,6 +3414,39 @@ protected:
     return retFunction->computeTargets(d2);
   }
 
+  /**
+   * Computes the return flow function for several abstractions at the exit
+   * node that share the same start abstraction at once.
+   * @param retFunction The return flow function to compute
+   * @param d1 The abstraction at the beginning of the callee
+   * @param d2s The abstractions at the exit node in the callee
+   * @param callSite The call site
+   * @return The sets of caller-side abstractions at the return site, one per
+   * element of d2s
+   */
+  std::vector<container_type>
+  computeReturnFlowFunctionBatch(const FlowFunctionPtrType &retFunction,
+                                 d_t d1, const std::vector<d_t> &d2s,
+                                 n_t callSite) {
+    return retFunction->computeTargetsBatch(d2s);
+  }
+
+  // Returns the targets of the return flow function to retSite for d2, which
+  // are computed for the whole batch if a batch is processed.
+  container_type returnFlowTargets(const FlowFunctionPtrType &retFunction,
+                                   d_t d1, d_t d2, n_t callSite, n_t retSite,
+                                   const Container &callerSideDs) {
+    if (CurrentBatch.empty()) {
+      return computeReturnFlowFunction(retFunction, d1, d2, callSite,
+                                       callerSideDs);
+    }
+    return CurrentBatch.getReturnTargets(
+        callSite, retSite, d2, [&](const std::vector<d_t> &d2s) {
+          return computeReturnFlowFunctionBatch(retFunction, d1, d2s,
+                                                callSite);
+        });
+  }
+
   /**
    * Propagates the flow further down the exploded super graph, merging any
    * edge function that might already have been computed for targetVal at
@@ -1213,36 +3480,70 @@ protected:
                   << "Edge function : " << f.get()->str()
                   << " (result of previous compose)";
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+    if (!isRelevant(target)) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "PROPAGATE: Target is not relevant!");
+      return;
+    }
 
-    EdgeFunctionPtrType jumpFnE = [&]() {
-      const auto revLookupResult = jumpFn->reverseLookup(target, targetVal);
-      if (revLookupResult) {
-        const auto &JumpFnContainer = revLookupResult->get();
-        const auto Find = std::find_if(
-            JumpFnContainer.begin(), JumpFnContainer.end(),
-            [sourceVal](auto &KVpair) { return KVpair.first == sourceVal; });
-        if (Find != JumpFnContainer.end()) {
-          return Find->second;
-        }
+    PAMM_GET_INSTANCE;
+    EdgeFunctionPtrType fPrime;
+    bool newFunction;
+    // whether the path edge has been propagated before, the edge is revisited
+    // if its jump function changes
+    bool Revisit;
+    {
+      // lookup, join and update must be atomic
+      auto Lock = lockIfConcurrent(JumpFnMutex);
+      EdgeFunctionPtrType jumpFnE =
+          jumpFn->lookup(sourceVal, target, targetVal);
+      Revisit = jumpFnE != nullptr;
+      if (!jumpFnE) {
+        // jump function is initialized to all-top if no entry was found
+        jumpFnE = allTop;
       }
-      // jump function is initialized to all-top if no entry was found
-      return allTop;
-    }();
-    EdgeFunctionPtrType fPrime = jumpFnE->joinWith(f);
-    bool newFunction = !(fPrime->equal_to(jumpFnE));
+      fPrime = joinEdgeFunctions(jumpFnE, f);
+      newFunction = !equalEdgeFunctions(fPrime, jumpFnE);
 
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "Join: " << jumpFnE->str() << " & " << f.get()->str()
-                      << (jumpFnE->equal_to(f) ? " (EF's are equal)" : " ");
-                  BOOST_LOG_SEV(lg::get(), DEBUG)
-                  << "    = " << fPrime->str()
-                  << (newFunction ? " (new jump func)" : " ");
-                  BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                        << "Join: " << jumpFnE->str() << " & "
+                        << f.get()->str()
+                        << (jumpFnE->equal_to(f) ? " (EF's are equal)" : " ");
+                    BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "    = " << fPrime->str()
+                    << (newFunction ? " (new jump func)" : " ");
+                    BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+      if (newFunction) {
+        jumpFn->addFunction(sourceVal, target, targetVal, fPrime);
+      }
+    }
+    if (Replaying) {
+      // the retained jump functions are final already, but the path edges
+      // have to be processed once nevertheless
+      newFunction = markReplayed(sourceVal, target, targetVal) || newFunction;
+    }
     if (newFunction) {
-      jumpFn->addFunction(sourceVal, target, targetVal, fPrime);
       const PathEdge<n_t, d_t> edge(sourceVal, target, targetVal);
-      PathEdgeCount++;
-      pathEdgeProcessingTask(edge);
+      if (!Replaying) {
+        PathEdgeCount++;
+        if (Revisit) {
+          INC_COUNTER("Path Edge Revisits", 1, PAMM_SEVERITY_LEVEL::Full);
+        }
+        if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+          auto Lock = lockIfConcurrent(TelemetryMutex);
+          Telemetry.recordPathEdge(ICF->getFunctionOf(target), targetVal,
+                                   !Revisit);
+        }
+      }
+      // do not descend right away, the edge is processed by runWorklist()
+      if (ConcurrentWorklist) {
+        ConcurrentWorklist->push(edge);
+      } else {
+        getWorklist().push(edge);
+        if (releasesJumpFunctionsEarly()) {
+          ++PendingEdgesPerFunction[ICF->getFunctionOf(target)];
+        }
+      }
 
       LOG_IF_ENABLE(if (!IDEProblem.isZeroValue(targetVal)) {
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -1276,27 +3577,41 @@ protected:
         fSummaryReuse[key] += 1;
       }
     }
-    return endsummarytab.get(sP, d3).cellSet();
+    std::set<typename Table<n_t, d_t, EdgeFunctionPtrType>::Cell> Result;
+    auto Context = lookupSummaryKey(sP, d3);
+    if (auto Search =
+            Context ? endsummarytab.find(*Context) : endsummarytab.end();
+        Search != endsummarytab.end()) {
+      for (const auto &[Key, F] : Search->second) {
+        Result.emplace(NodeIds[highId(Key)], FactIds[lowId(Key)], F);
+      }
+    }
+    return Result;
   }
 
   std::map<n_t, container_type> incoming(d_t d1, n_t sP) {
-    return incomingtab.get(sP, d1);
+    auto Context = lookupSummaryKey(sP, d1);
+    if (auto Search = Context ? incomingtab.find(*Context) : incomingtab.end();
+        Search != incomingtab.end()) {
+      return Search->second;
+    }
+    return {};
   }
 
   void addIncoming(n_t sP, d_t d3, n_t n, d_t d2) {
-    incomingtab.get(sP, d3)[n].insert(d2);
+    incomingtab[getSummaryKey(sP, d3)][n].insert(d2);
   }
 
   void printIncomingTab() const {
 #ifdef DYNAMIC_LOG
     if (boost::log::core::get()->get_logging_enabled()) {
       BOOST_LOG_SEV(lg::get(), DEBUG) << "Start of incomingtab entry";
-      for (auto cell : incomingtab.cellSet()) {
+      for (const auto &[Key, Incoming] : incomingtab) {
         BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "sP: " << IDEProblem.NtoString(cell.getRowKey());
+            << "sP: " << IDEProblem.NtoString(NodeIds[highId(Key)]);
         BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "d3: " << IDEProblem.DtoString(cell.getColumnKey());
-        for (auto entry : cell.getValue()) {
+            << "d3: " << IDEProblem.DtoString(FactIds[lowId(Key)]);
+        for (const auto &entry : Incoming) {
           BOOST_LOG_SEV(lg::get(), DEBUG)
               << "  n: " << IDEProblem.NtoString(entry.first);
           for (auto fact : entry.second) {
@@ -1316,18 +3631,17 @@ protected:
 #ifdef DYNAMIC_LOG
     if (boost::log::core::get()->get_logging_enabled()) {
       BOOST_LOG_SEV(lg::get(), DEBUG) << "Start of endsummarytab entry";
-      for (auto cell : endsummarytab.cellVec()) {
+      for (const auto &[Key, Summaries] : endsummarytab) {
         BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "sP: " << IDEProblem.NtoString(cell.getRowKey());
+            << "sP: " << IDEProblem.NtoString(NodeIds[highId(Key)]);
         BOOST_LOG_SEV(lg::get(), DEBUG)
-            << "d1: " << IDEProblem.DtoString(cell.getColumnKey());
-        for (auto inner_cell : cell.getValue().cellVec()) {
-          BOOST_LOG_SEV(lg::get(), DEBUG)
-              << "  eP: " << IDEProblem.NtoString(inner_cell.getRowKey());
+            << "d1: " << IDEProblem.DtoString(FactIds[lowId(Key)]);
+        for (const auto &[InnerKey, F] : Summaries) {
           BOOST_LOG_SEV(lg::get(), DEBUG)
-              << "  d2: " << IDEProblem.DtoString(inner_cell.getColumnKey());
+              << "  eP: " << IDEProblem.NtoString(NodeIds[highId(InnerKey)]);
           BOOST_LOG_SEV(lg::get(), DEBUG)
-              << "  EF: " << inner_cell.getValue()->str();
+              << "  d2: " << IDEProblem.DtoString(FactIds[lowId(InnerKey)]);
+          BOOST_LOG_SEV(lg::get(), DEBUG) << "  EF: " << F->str();
           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ';
         }
         BOOST_LOG_SEV(lg::get(), DEBUG) << "---------------";
@@ -1500,11 +3814,15 @@ protected:
             // Special case
             if (ProcessSummaryFacts.find(std::make_pair(Edge.second, D2)) !=
                 ProcessSummaryFacts.end()) {
-              std::multiset<d_t> SummaryDMultiSet =
-                  endsummarytab.get(Edge.second, D2).columnKeySet();
-              // remove duplicates from multiset
-              std::set<d_t> SummaryDSet(SummaryDMultiSet.begin(),
-                                        SummaryDMultiSet.end());
+              std::set<d_t> SummaryDSet;
+              auto Context = lookupSummaryKey(Edge.second, D2);
+              if (auto Search = Context ? endsummarytab.find(*Context)
+                                        : endsummarytab.end();
+                  Search != endsummarytab.end()) {
+                for (const auto &Summary : Search->second) {
+                  SummaryDSet.insert(FactIds[lowId(Summary.first)]);
+                }
+              }
               // Process summary just as an intra-procedural edge
               if (SummaryDSet.find(D2) != SummaryDSet.end()) {
                 genFacts += SummaryDSet.size() - 1;
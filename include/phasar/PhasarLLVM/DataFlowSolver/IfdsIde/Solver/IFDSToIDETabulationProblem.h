@@ -65,13 +65,16 @@ public:
   IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem;
 
   IFDSToIDETabulationProblem(
-      IFDSTabulationProblem<AnalysisDomainTy> &IFDSProblem)
-      : IDETabulationProblem<AnalysisDomainExtender<AnalysisDomainTy>>(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &IFDSProblem)
+      : IDETabulationProblem<AnalysisDomainExtender<AnalysisDomainTy>,
+                             Container>(
             IFDSProblem.getProjectIRDB(), IFDSProblem.getTypeHierarchy(),
             IFDSProblem.getICFG(), IFDSProblem.getPointstoInfo(),
             IFDSProblem.getEntryPoints()),
         Problem(IFDSProblem) {
     this->ZeroValue = Problem.createZeroValue();
+    // the solver is configured through the transformed problem
+    this->setIFDSIDESolverConfig(Problem.getIFDSIDESolverConfig());
   }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) override {
@@ -105,6 +108,22 @@ public:
 
   bool isZeroValue(d_t d) const override { return Problem.isZeroValue(d); }
 
+  [[nodiscard]] std::string getSummaryCacheName() const override {
+    return Problem.getSummaryCacheName();
+  }
+
+  [[nodiscard]] std::string getCheckpointName() const override {
+    return Problem.getCheckpointName();
+  }
+
+  [[nodiscard]] bool isSparseRelevant(n_t Stmt, d_t Fact) const override {
+    return Problem.isSparseRelevant(Stmt, Fact);
+  }
+
+  [[nodiscard]] bool isIdentityStmt(n_t Stmt) const override {
+    return Problem.isIdentityStmt(Stmt);
+  }
+
   BinaryDomain topElement() override { return BinaryDomain::TOP; }
 
   BinaryDomain bottomElement() override { return BinaryDomain::BOTTOM; }
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDENTITYCHAINS_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDENTITYCHAINS_H_
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/ControlFlow/CFG.h"
+
+namespace psr {
+
+/**
+ * Collapses the maximal chains of statements of a control-flow graph whose
+ * flow and edge functions are the identity for every fact into single
+ * edges. A chain s_1, ..., s_k consists of such statements, where s_i is the
+ * only successor of s_i-1 and s_i-1 is the only predecessor of s_i; call
+ * sites, start points and exit statements are never part of a chain. A fact
+ * that reaches s_1 can be passed on to s_k right away, and since s_2, ...,
+ * s_k cannot be reached in another way, the same facts and values hold at
+ * all statements of the chain.
+ */
+template <typename N, typename F> class IdentityChains {
+public:
+  /**
+   * IsIdentity(n) must return whether the flow and edge functions of n are
+   * the identity for every fact.
+   */
+  IdentityChains(const CFG<N, F> &CF, std::function<bool(N)> IsIdentity)
+      : CF(CF), IsIdentity(std::move(IsIdentity)) {}
+
+  /**
+   * Collapses the chains of the given function.
+   */
+  void compress(F Fun) {
+    for (N Stmt : CF.getAllInstructionsOf(Fun)) {
+      if (!isCollapsible(Stmt) || !isChainHead(Stmt)) {
+        continue;
+      }
+      std::vector<N> Chain = {Stmt};
+      for (auto Succs = CF.getSuccsOf(Stmt); Succs.size() == 1;
+           Succs = CF.getSuccsOf(Chain.back())) {
+        N Next = Succs.front();
+        if (Next == Stmt || !isCollapsible(Next) ||
+            CF.getPredsOf(Next).size() != 1) {
+          break;
+        }
+        Chain.push_back(Next);
+      }
+      for (size_t Idx = 0; Idx + 1 < Chain.size(); ++Idx) {
+        ChainEnds[Chain[Idx]] = Chain.back();
+      }
+    }
+  }
+
+  /**
+   * Returns the last statement of the chain Stmt belongs to, or Stmt itself
+   * if it has not been collapsed.
+   */
+  [[nodiscard]] N getChainEnd(N Stmt) const {
+    auto Search = ChainEnds.find(Stmt);
+    return Search != ChainEnds.end() ? Search->second : Stmt;
+  }
+
+  /**
+   * Returns whether Stmt belongs to a chain and is not its last statement.
+   */
+  [[nodiscard]] bool isCollapsed(N Stmt) const {
+    return ChainEnds.count(Stmt);
+  }
+
+  /**
+   * Calls Handler(n, e) for every collapsed statement n, where e is the last
+   * statement of its chain.
+   */
+  template <typename HandlerFn> void forEachCollapsed(HandlerFn Handler) const {
+    for (const auto &[Stmt, ChainEnd] : ChainEnds) {
+      Handler(Stmt, ChainEnd);
+    }
+  }
+
+  [[nodiscard]] size_t getNumCollapsed() const { return ChainEnds.size(); }
+
+private:
+  bool isCollapsible(N Stmt) const {
+    return !CF.isCallStmt(Stmt) && !CF.isStartPoint(Stmt) &&
+           !CF.isExitStmt(Stmt) && IsIdentity(Stmt);
+  }
+
+  // a chain starts at a statement that does not continue the chain of its
+  // predecessor
+  bool isChainHead(N Stmt) const {
+    auto Preds = CF.getPredsOf(Stmt);
+    return Preds.size() != 1 || !isCollapsible(Preds.front()) ||
+           CF.getSuccsOf(Preds.front()).size() != 1;
+  }
+
+  const CFG<N, F> &CF;
+  std::function<bool(N)> IsIdentity;
+  // maps the collapsed statements to the last statement of their chain
+  std::unordered_map<N, N> ChainEnds;
+};
+
+} // namespace psr
+
+#endif
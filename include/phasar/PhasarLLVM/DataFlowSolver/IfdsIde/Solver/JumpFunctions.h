@@ -17,6 +17,7 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -134,6 +135,20 @@ public:
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
   }
 
+  /**
+   * Returns the jump function for the given source value, target statement
+   * and target value, or nullptr if there is none, i.e. if it is all-top.
+   */
+  EdgeFunctionPtrType lookup(d_t sourceVal, n_t target, d_t targetVal) const {
+    // the by-target table is hashed on both facts, unlike the lookup vectors
+    if (auto Search = nonEmptyLookupByTargetNode.find(target);
+        Search != nonEmptyLookupByTargetNode.end() &&
+        Search->second.contains(sourceVal, targetVal)) {
+      return Search->second.get(sourceVal, targetVal);
+    }
+    return nullptr;
+  }
+
   /**
    * Returns, for a given target statement and value all associated
    * source values, and for each the associated edge function.
@@ -170,8 +185,13 @@ public:
    * The return value is a set of records of the form
    * (sourceVal,targetVal,edgeFunction).
    */
-  Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget(n_t target) {
-    return nonEmptyLookupByTargetNode[target];
+  Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget(n_t target) const {
+    // does not insert empty entries such that concurrent lookups are safe
+    if (auto Search = nonEmptyLookupByTargetNode.find(target);
+        Search != nonEmptyLookupByTargetNode.end()) {
+      return Search->second;
+    }
+    return {};
   }
 
   /**
@@ -202,6 +222,52 @@ public:
     return nonEmptyLookupByTargetNode.erase(target);
   }
 
+  /**
+   * Removes all jump functions with the given target statement.
+   * @return The number of jump functions that have been removed.
+   */
+  size_t removeFunctionsAt(n_t target) {
+    auto Search = nonEmptyLookupByTargetNode.find(target);
+    if (Search == nonEmptyLookupByTargetNode.end()) {
+      return 0;
+    }
+    size_t NumRemoved = 0;
+    for (const auto &Cell : Search->second.cellVec()) {
+      d_t sourceVal = Cell.getRowKey();
+      d_t targetVal = Cell.getColumnKey();
+      auto &TargetValToFunc = nonEmptyForwardLookup.get(sourceVal, target);
+      TargetValToFunc.erase(
+          std::remove_if(
+              TargetValToFunc.begin(), TargetValToFunc.end(),
+              [targetVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
+                return targetVal == Entry.first;
+              }),
+          TargetValToFunc.end());
+      if (TargetValToFunc.empty()) {
+        nonEmptyForwardLookup.remove(sourceVal, target);
+        if (nonEmptyForwardLookup.row(sourceVal).empty()) {
+          nonEmptyForwardLookup.remove(sourceVal);
+        }
+      }
+      ++NumRemoved;
+    }
+    nonEmptyReverseLookup.remove(target);
+    nonEmptyLookupByTargetNode.erase(Search);
+    return NumRemoved;
+  }
+
+  /**
+   * Calls Handler(sourceVal, target, targetVal, function) for each (non-empty)
+   * jump function.
+   */
+  template <typename HandlerFn> void forEachFunction(HandlerFn Handler) const {
+    for (const auto &[Target, Functions] : nonEmptyLookupByTargetNode) {
+      for (const auto &Cell : Functions.cellVec()) {
+        Handler(Cell.getRowKey(), Target, Cell.getColumnKey(), Cell.getValue());
+      }
+    }
+  }
+
   /**
    * Removes all jump functions
    */
@@ -0,0 +1,977 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_NATIVEIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_NATIVEIFDSSOLVER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/SparseBitVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactIndex.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FlowFunctionBatch.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IdentityChains.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverTelemetry.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+#include "phasar/PhasarLLVM/Utils/ResultsExporter.h"
+#include "phasar/Utils/Interner.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/**
+ * Solves the given IFDSTabulationProblem using the tabulation algorithm by
+ * Reps, Horwitz and Sagiv (1995).
+ *
+ * In contrast to IFDSSolver, which solves IFDS problems as IDE problems over
+ * the BinaryDomain, this solver only tracks reachability in the exploded
+ * super-graph: it never constructs, composes or joins edge functions and does
+ * not run IDE's value computation phase. For each statement n and fact d1
+ * holding at the start point of n's function, the facts d2 with a path edge
+ * <d1> --> <n,d2> are stored as a bit-set over interned fact IDs; the results
+ * are answered directly from these path edges.
+ *
+ * The solver is sequential and keeps all path edges in memory. It supports
+ * neither the options of IFDSIDESolverConfig that IDESolver implements on top
+ * of its jump functions (multiple threads, low-memory mode, checkpoints and
+ * the summary cache) nor emitESG(); see getUnsupportedOption().
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class NativeIFDSSolver {
+public:
+  using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy, Container>;
+  using container_type = typename ProblemTy::container_type;
+  using FlowFunctionPtrType = typename ProblemTy::FlowFunctionPtrType;
+
+  using n_t = typename AnalysisDomainTy::n_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+
+  NativeIFDSSolver(IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : IFDSProblem(Problem), ZeroValue(Problem.getZeroValue()),
+        ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
+        FlowFunctionProvider(makeFlowFunctionProvider(Problem)),
+        CachedFlowFunctions(*FlowFunctionProvider),
+        InitialSeeds(Problem.initialSeeds()) {}
+
+  NativeIFDSSolver(const NativeIFDSSolver &) = delete;
+  NativeIFDSSolver &operator=(const NativeIFDSSolver &) = delete;
+  NativeIFDSSolver(NativeIFDSSolver &&) = delete;
+  NativeIFDSSolver &operator=(NativeIFDSSolver &&) = delete;
+
+  virtual ~NativeIFDSSolver() = default;
+
+  /**
+   * @brief Returns the name of the first option set in Config that this
+   * solver does not support, or an empty string if it supports all of them.
+   * Analyses that are run with such an option must use IFDSSolver instead.
+   */
+  static std::string getUnsupportedOption(const IFDSIDESolverConfig &Config) {
+    if (Config.numThreads() > 1) {
+      return "right-to-ludicrous-speed";
+    }
+    if (Config.lowMemory()) {
+      return "low-memory";
+    }
+    if (!Config.checkpointFile().empty()) {
+      return "checkpoint";
+    }
+    if (Config.resumeFromCheckpoint()) {
+      return "resume";
+    }
+    if (!Config.summaryCacheDirectory().empty()) {
+      return "summary-cache";
+    }
+    return "";
+  }
+
+  /**
+   * @brief Runs the solver on the configured problem. This can take some time.
+   */
+  virtual void solve() {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Sparse Skipped Stmts", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Collapsed Stmts", 0, PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << "Native IFDS solver is solving the specified problem";
+                  BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Submit initial seeds, construct exploded super graph");
+    Telemetry = SolverTelemetry<d_t, f_t>();
+    Chains.reset();
+    if (SolverConfig.compressIdentityChains()) {
+      compressIdentityChains();
+    }
+    START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    submitInitialSeeds();
+    STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    if (Chains) {
+      reconstructCollapsedFacts();
+    }
+    CachedFlowFunctions.exportStatistics();
+    if (SolverConfig.buildFactIndex()) {
+      buildFactIndex();
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << "Problem solved using " << PathEdgeCount
+                      << " path edges";
+                  if (SolverConfig.emitESG()) {
+                    BOOST_LOG_SEV(lg::get(), WARNING)
+                        << "The native IFDS solver cannot emit the ESG";
+                  });
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      printHottestFunctions();
+    }
+  }
+
+  /**
+   * Returns the set of data-flow facts that hold at the given statement.
+   */
+  [[nodiscard]] std::set<d_t> ifdsResultsAt(n_t stmt) const {
+    std::set<d_t> Result;
+    if (auto N = NodeIds.lookup(stmt)) {
+      if (auto Search = FactsAt.find(*N); Search != FactsAt.end()) {
+        for (unsigned D : Search->second) {
+          Result.insert(FactIds[D]);
+        }
+      }
+    }
+    return Result;
+  }
+
+  /**
+   * Returns BinaryDomain::BOTTOM if the given fact holds at the given
+   * statement, BinaryDomain::TOP otherwise, in analogy to IFDSSolver.
+   */
+  [[nodiscard]] BinaryDomain resultAt(n_t stmt, d_t value) const {
+    auto N = NodeIds.lookup(stmt);
+    auto D = FactIds.lookup(value);
+    if (N && D) {
+      if (auto Search = FactsAt.find(*N);
+          Search != FactsAt.end() && Search->second.test(*D)) {
+        return BinaryDomain::BOTTOM;
+      }
+    }
+    return BinaryDomain::TOP;
+  }
+
+  /**
+   * Returns the resulting environment for the given statement in analogy to
+   * IFDSSolver. The artificial zero value can be automatically stripped.
+   */
+  [[nodiscard]] std::unordered_map<d_t, BinaryDomain>
+  resultsAt(n_t stmt, bool stripZero = false) const {
+    std::unordered_map<d_t, BinaryDomain> Result;
+    for (d_t D : ifdsResultsAt(stmt)) {
+      if (!stripZero || !IFDSProblem.isZeroValue(D)) {
+        Result.emplace(D, BinaryDomain::BOTTOM);
+      }
+    }
+    return Result;
+  }
+
+  /**
+   * Builds the index of the results by fact, see FactIndex, which is used by
+   * the SolverResults that are obtained afterwards. Is called by solve() if
+   * IFDSIDESolverConfig::buildFactIndex() is set, see
+   * IDESolver::buildFactIndex().
+   */
+  const FactIndex<n_t, d_t> &buildFactIndex() {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA Fact Index", PAMM_SEVERITY_LEVEL::Full);
+    ResultFactIndex =
+        std::make_unique<FactIndex<n_t, d_t>>(materializeResults());
+    STOP_TIMER("DFA Fact Index", PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Indexed " << ResultFactIndex->size() << " results of "
+                  << ResultFactIndex->getNumFacts() << " facts at "
+                  << ResultFactIndex->getNumStatements() << " statements");
+    return *ResultFactIndex;
+  }
+
+  /**
+   * Returns the results in the format used by the problems' reports. The
+   * results table is only materialized on the first call.
+   */
+  SolverResults<n_t, d_t, BinaryDomain> getSolverResults() {
+    return SolverResults<n_t, d_t, BinaryDomain>(
+        materializeResults(), ZeroValue, ResultFactIndex.get());
+  }
+
+  virtual void emitTextReport(std::ostream &OS = std::cout) {
+    IFDSProblem.emitTextReport(getSolverResults(), OS);
+  }
+
+  virtual void emitGraphicalReport(std::ostream &OS = std::cout) {
+    IFDSProblem.emitGraphicalReport(getSolverResults(), OS);
+  }
+
+  /**
+   * Writes the results in the given format to OS, see psr::exportResults().
+   * Unlike the reports, the export does not materialize the results table
+   * but only the facts of one statement at a time.
+   */
+  void exportResults(IOFormat Format, std::ostream &OS = std::cout) {
+    std::vector<std::pair<d_t, BinaryDomain>> Facts;
+    psr::exportResults(
+        IFDSProblem,
+        [&](const auto &Handler) {
+          for (const auto &[N, FactSet] : FactsAt) {
+            Facts.clear();
+            for (IdTy D : FactSet) {
+              Facts.emplace_back(FactIds[D], BinaryDomain::BOTTOM);
+            }
+            Handler(NodeIds[N], Facts);
+          }
+        },
+        Format, OS);
+  }
+
+  virtual void dumpResults(std::ostream &OS = std::cout) {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA IFDS Result Dumping", PAMM_SEVERITY_LEVEL::Full);
+    OS << "\n***************************************************************\n"
+       << "*               Raw NativeIFDSSolver results                  *\n"
+       << "***************************************************************\n";
+    std::vector<n_t> Nodes;
+    for (const auto &Entry : FactsAt) {
+      Nodes.push_back(NodeIds[Entry.first]);
+    }
+    if (Nodes.empty()) {
+      OS << "No results computed!" << std::endl;
+    } else {
+      llvmValueIDLess llvmIDLess;
+      std::sort(Nodes.begin(), Nodes.end(),
+                [&llvmIDLess](n_t a, n_t b) {
+                  if constexpr (std::is_same_v<n_t,
+                                               const llvm::Instruction *>) {
+                    return llvmIDLess(a, b);
+                  } else {
+                    // If non-LLVM IR is used
+                    return a < b;
+                  }
+                });
+      f_t prevFn = f_t{};
+      for (n_t N : Nodes) {
+        f_t currFn = ICF->getFunctionOf(N);
+        if (prevFn != currFn) {
+          prevFn = currFn;
+          OS << "\n\n============ Results for function '" +
+                    ICF->getFunctionName(currFn) + "' ============\n";
+        }
+        std::string NString = IFDSProblem.NtoString(N);
+        std::string line(NString.size(), '-');
+        OS << "\n\nN: " << NString << "\n---" << line << '\n';
+        for (d_t D : ifdsResultsAt(N)) {
+          OS << "\tD: " << IFDSProblem.DtoString(D) << '\n';
+        }
+      }
+    }
+    OS << '\n';
+    STOP_TIMER("DFA IFDS Result Dumping", PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /**
+   * Restricts the construction of the exploded super-graph to the given
+   * statements, path edges to any other statement are not propagated. See
+   * IDESolver::restrictToStatements().
+   */
+  void restrictToStatements(std::set<n_t> Stmts) {
+    RelevantStmts = std::move(Stmts);
+  }
+
+  /**
+   * Returns the number of path edges in the exploded super-graph.
+   */
+  [[nodiscard]] size_t getNumPathEdges() const { return PathEdgeCount; }
+
+  /**
+   * Returns the per-function statistics of the last run, see
+   * IDESolver::getTelemetry(). Each path edge is counted as a jump function.
+   */
+  [[nodiscard]] const SolverTelemetry<d_t, f_t> &getTelemetry() const {
+    return Telemetry;
+  }
+
+protected:
+  using IdTy = uint32_t;
+  using FactSet = llvm::SparseBitVector<>;
+
+  IFDSTabulationProblem<AnalysisDomainTy, Container> &IFDSProblem;
+  d_t ZeroValue;
+  const i_t *ICF;
+  IFDSIDESolverConfig &SolverConfig;
+
+  // the flow functions are obtained and cached as for IFDSSolver, however,
+  // the edge functions of the transformed problem are never queried
+  std::unique_ptr<
+      IFDSToIDETabulationProblem<AnalysisDomainTy, Container>>
+      FlowFunctionProvider;
+  FlowEdgeFunctionCache<AnalysisDomainExtender<AnalysisDomainTy>, Container>
+      CachedFlowFunctions;
+
+  std::map<n_t, std::set<d_t>> InitialSeeds;
+  // if set, only these statements are explored, see restrictToStatements()
+  std::optional<std::set<n_t>> RelevantStmts;
+
+  Interner<n_t, IdTy> NodeIds;
+  Interner<d_t, IdTy> FactIds;
+
+  // maps <n, d1> to all facts d2 such that there is a path edge
+  // <sP, d1> --> <n, d2> where sP is the start point of n's function
+  llvm::DenseMap<uint64_t, FactSet> PathEdges;
+  // maps n to all facts d2 that hold at n, i.e. the union of all path edge
+  // targets at n
+  llvm::DenseMap<IdTy, FactSet> FactsAt;
+  // maps <c, d2> to all facts d1 such that there is a path edge
+  // <sP, d1> --> <c, d2>; only recorded for call sites c
+  llvm::DenseMap<uint64_t, FactSet> CallSources;
+
+  // maps <sP, d1> to all <eP, d2> such that there is a path edge
+  // <sP, d1> --> <eP, d2>, see CC 2010 paper by Naeem, Lhotak and Rodriguez
+  llvm::DenseMap<uint64_t, llvm::SmallVector<uint64_t, 2>> EndSummaries;
+  // maps <sP, d3> to the facts that hold at each call site calling sP
+  llvm::DenseMap<uint64_t, std::map<n_t, container_type>> Incoming;
+
+  std::unique_ptr<PathEdgeWorklist<n_t, d_t>> Worklist;
+  size_t PathEdgeCount = 0;
+  // only set while a batch of path edges at a call or exit statement is
+  // processed, see processCallBatch() and processExitBatch()
+  FlowFunctionBatch<n_t, d_t, f_t, container_type> CurrentBatch;
+
+  // the statements a fact is passed on to from a statement when propagating
+  // sparsely, see getSparseSuccessors()
+  std::map<std::pair<n_t, d_t>, std::vector<n_t>> SparseSuccessors;
+
+  // see compressIdentityChains()
+  std::unique_ptr<IdentityChains<n_t, f_t>> Chains;
+
+  // per-function statistics and progress reports, only used if PAMM is
+  // enabled
+  SolverTelemetry<d_t, f_t> Telemetry;
+
+  // only materialized on demand, see materializeResults()
+  Table<n_t, d_t, BinaryDomain> ResultsTab;
+  // see buildFactIndex()
+  std::unique_ptr<FactIndex<n_t, d_t>> ResultFactIndex;
+
+  static std::unique_ptr<
+      IFDSToIDETabulationProblem<AnalysisDomainTy, Container>>
+  makeFlowFunctionProvider(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem) {
+    auto Provider = std::make_unique<
+        IFDSToIDETabulationProblem<AnalysisDomainTy, Container>>(Problem);
+    // the cache obtains the autoAddZero option from the provider
+    Provider->setIFDSIDESolverConfig(Problem.getIFDSIDESolverConfig());
+    return Provider;
+  }
+
+  // Returns the results as a table, which is filled from the path edges on
+  // the first call.
+  const Table<n_t, d_t, BinaryDomain> &materializeResults() {
+    if (ResultsTab.empty()) {
+      for (const auto &[N, Facts] : FactsAt) {
+        for (unsigned D : Facts) {
+          ResultsTab.insert(NodeIds[N], FactIds[D], BinaryDomain::BOTTOM);
+        }
+      }
+    }
+    return ResultsTab;
+  }
+
+  uint64_t getKey(n_t n, d_t d) {
+    return combineIds(NodeIds.getOrInsert(n), FactIds.getOrInsert(d));
+  }
+
+  /**
+   * Returns the worklist of pending path edges. The worklist is created on
+   * first use according to the policy specified in the solver configuration.
+   */
+  PathEdgeWorklist<n_t, d_t> &getWorklist() {
+    if (!Worklist) {
+      Worklist = makePathEdgeWorklist<n_t, d_t>(
+          SolverConfig.worklistPolicy(),
+          [this](const PathEdge<n_t, d_t> &Edge) -> size_t {
+            return ICF->isExitStmt(Edge.getTarget()) ? 1 : 0;
+          });
+    }
+    return *Worklist;
+  }
+
+  /**
+   * Records the path edge <sP, sourceVal> --> <target, targetVal> and
+   * schedules it for processing if it has not been seen before.
+   */
+  void propagate(d_t sourceVal, n_t target, d_t targetVal) {
+    if (RelevantStmts && !RelevantStmts->count(target)) {
+      return;
+    }
+    IdTy N = NodeIds.getOrInsert(target);
+    IdTy S = FactIds.getOrInsert(sourceVal);
+    IdTy T = FactIds.getOrInsert(targetVal);
+    if (!PathEdges[combineIds(N, S)].test_and_set(T)) {
+      return;
+    }
+    FactsAt[N].set(T);
+    if (ICF->isCallStmt(target)) {
+      CallSources[combineIds(N, T)].set(S);
+    }
+    ++PathEdgeCount;
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      // a path edge is never revisited, it always is a new jump function
+      Telemetry.recordPathEdge(ICF->getFunctionOf(target), targetVal, true);
+    }
+    getWorklist().push(PathEdge<n_t, d_t>(sourceVal, target, targetVal));
+  }
+
+  void submitInitialSeeds() {
+    PAMM_GET_INSTANCE;
+    for (const auto &[StartPoint, Facts] : InitialSeeds) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "Start point: " << IFDSProblem.NtoString(StartPoint));
+      for (const auto &Fact : Facts) {
+        if (!IFDSProblem.isZeroValue(Fact)) {
+          INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
+        }
+        propagate(ZeroValue, StartPoint, Fact);
+      }
+      // the zero value always holds at the seeds, but is only processed if
+      // it is a seed fact itself (IDESolver adds an identity jump function)
+      IdTy N = NodeIds.getOrInsert(StartPoint);
+      IdTy Z = FactIds.getOrInsert(ZeroValue);
+      PathEdges[combineIds(N, Z)].set(Z);
+      if (ICF->isCallStmt(StartPoint)) {
+        CallSources[combineIds(N, Z)].set(Z);
+      }
+    }
+    auto &WL = getWorklist();
+    if (!SolverConfig.batchFlowFunctions()) {
+      while (!WL.empty()) {
+        pathEdgeProcessingTask(WL.pop());
+        reportProgressIfDue(WL.size());
+      }
+      return;
+    }
+    // see IDESolver::runWorklist()
+    auto CanBatch = [](n_t) { return true; };
+    std::vector<PathEdge<n_t, d_t>> Batch;
+    while (!WL.empty()) {
+      WL.popBatch(Batch, CanBatch);
+      if (Batch.size() == 1) {
+        pathEdgeProcessingTask(Batch.front());
+      } else {
+        batchProcessingTask(Batch);
+      }
+      reportProgressIfDue(WL.size());
+    }
+  }
+
+  /**
+   * Logs the solver's progress if PAMM is enabled and the configured
+   * interval has elapsed since the last report, see
+   * IDESolver::reportProgressIfDue().
+   */
+  void reportProgressIfDue([[maybe_unused]] size_t WorklistSize) {
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      if (Telemetry.isProgressDue(
+              std::chrono::seconds(SolverConfig.progressInterval()))) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << Telemetry.reportProgress(WorklistSize));
+      }
+    }
+  }
+
+  /**
+   * Logs the functions the solver has spent the most work on.
+   */
+  void printHottestFunctions() {
+    LOG_IF_ENABLE([&]() {
+      std::stringstream Hottest;
+      Telemetry.printHottestFunctions(
+          Hottest, SolverConfig.numHotFunctions(),
+          [this](f_t Fun) { return IFDSProblem.FtoString(Fun); });
+      BOOST_LOG_SEV(lg::get(), INFO) << Hottest.str();
+    }());
+  }
+
+  // processes path edges with the same source fact at the same statement,
+  // see pathEdgeProcessingTask()
+  void batchProcessingTask(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    [[maybe_unused]] std::chrono::steady_clock::time_point Start;
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      Start = std::chrono::steady_clock::now();
+    }
+    n_t n = Edges.front().getTarget();
+    if (!ICF->isCallStmt(n)) {
+      if (ICF->isExitStmt(n)) {
+        processExitBatch(Edges);
+      }
+      if (!ICF->getSuccsOf(n).empty()) {
+        processNormalFlowBatch(Edges);
+      }
+    } else {
+      processCallBatch(Edges);
+    }
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      Telemetry.recordTime(ICF->getFunctionOf(n),
+                           std::chrono::steady_clock::now() - Start);
+    }
+  }
+
+  void pathEdgeProcessingTask(const PathEdge<n_t, d_t> &Edge) {
+    [[maybe_unused]] std::chrono::steady_clock::time_point Start;
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      Start = std::chrono::steady_clock::now();
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process path edge: < "
+                  << IFDSProblem.DtoString(Edge.factAtSource()) << " ; "
+                  << IFDSProblem.NtoString(Edge.getTarget()) << " ; "
+                  << IFDSProblem.DtoString(Edge.factAtTarget()) << " >");
+    if (!ICF->isCallStmt(Edge.getTarget())) {
+      if (ICF->isExitStmt(Edge.getTarget())) {
+        processExit(Edge);
+      }
+      if (!ICF->getSuccsOf(Edge.getTarget()).empty()) {
+        processNormalFlow(Edge);
+      }
+    } else {
+      processCall(Edge);
+    }
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      Telemetry.recordTime(ICF->getFunctionOf(Edge.getTarget()),
+                           std::chrono::steady_clock::now() - Start);
+    }
+  }
+
+  /**
+   * Lines 13-20 of the algorithm; processing a call site in the caller's
+   * context. See IDESolver::processCall().
+   */
+  virtual void processCall(const PathEdge<n_t, d_t> &Edge) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Call", 1, PAMM_SEVERITY_LEVEL::Full);
+    d_t d1 = Edge.factAtSource();
+    n_t n = Edge.getTarget();
+    d_t d2 = Edge.factAtTarget();
+    const std::set<n_t> returnSiteNs = ICF->getReturnSitesOfCallAt(n);
+    const std::set<f_t> callees = ICF->getCalleesOfCallAt(n);
+    for (f_t sCalledProcN : callees) {
+      // if a special summary is available, treat this as a normal flow
+      if (FlowFunctionPtrType specialSum =
+              CachedFlowFunctions.getSummaryFlowFunction(n, sCalledProcN)) {
+        INC_COUNTER("SpecialSummary-FF Application", 1,
+                    PAMM_SEVERITY_LEVEL::Full);
+        for (d_t d3 : specialSum->computeTargets(d2)) {
+          for (n_t returnSiteN : returnSiteNs) {
+            propagate(d1, returnSiteN, d3);
+          }
+        }
+        continue;
+      }
+      FlowFunctionPtrType function =
+          CachedFlowFunctions.getCallFlowFunction(n, sCalledProcN);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      const container_type res = callFlowTargets(function, sCalledProcN, d2);
+      // if startPointsOf is empty, the called function is a declaration
+      for (n_t sP : ICF->getStartPointsOf(sCalledProcN)) {
+        for (d_t d3 : res) {
+          // create initial self-loop
+          propagate(d3, sP, d3);
+          // register the fact that <sP,d3> has an incoming edge from <n,d2>
+          uint64_t Key = getKey(sP, d3);
+          Incoming[Key][n].insert(d2);
+          // copy, propagate() may add end summaries
+          auto Search = EndSummaries.find(Key);
+          if (Search == EndSummaries.end()) {
+            continue;
+          }
+          const llvm::SmallVector<uint64_t, 2> EndSumm = Search->second;
+          // apply the already computed summaries <sP,d3> --> <eP,d4>
+          for (uint64_t Summary : EndSumm) {
+            n_t eP = NodeIds[highId(Summary)];
+            d_t d4 = FactIds[lowId(Summary)];
+            for (n_t retSiteN : returnSiteNs) {
+              FlowFunctionPtrType retFunction =
+                  CachedFlowFunctions.getRetFlowFunction(n, sCalledProcN, eP,
+                                                         retSiteN);
+              INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+              for (d_t d5 : retFunction->computeTargets(d4)) {
+                propagate(d1, retSiteN, d5);
+              }
+            }
+          }
+        }
+      }
+    }
+    // process intra-procedural flows along call-to-return flow functions; as
+    // in IDESolver, there are none for call sites without any callees
+    if (callees.empty()) {
+      return;
+    }
+    for (n_t returnSiteN : returnSiteNs) {
+      FlowFunctionPtrType callToReturnFlowFunction =
+          CachedFlowFunctions.getCallToRetFlowFunction(n, returnSiteN,
+                                                       callees);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      for (d_t d3 : callToReturnFlowFunction->computeTargets(d2)) {
+        propagate(d1, returnSiteN, d3);
+      }
+    }
+  }
+
+  /**
+   * Processes path edges that all have the same source fact and target call
+   * statement like processCall(), but applies each call-flow function to the
+   * facts of all edges at once. See IDESolver::processCallBatch().
+   */
+  virtual void
+  processCallBatch(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Batched Path Edges", Edges.size(), PAMM_SEVERITY_LEVEL::Full);
+    CurrentBatch.assign(Edges);
+    for (const auto &Edge : Edges) {
+      processCall(Edge);
+    }
+    CurrentBatch.clear();
+  }
+
+  // Returns the targets of the call-flow function into Callee for d2, which
+  // are computed for the whole batch if a batch is processed.
+  container_type callFlowTargets(const FlowFunctionPtrType &Function,
+                                 f_t Callee, d_t d2) {
+    if (CurrentBatch.empty()) {
+      return Function->computeTargets(d2);
+    }
+    return CurrentBatch.getCallTargets(
+        Callee, d2, [&](const std::vector<d_t> &Sources) {
+          return Function->computeTargetsBatch(Sources);
+        });
+  }
+
+  /**
+   * Lines 33-37 of the algorithm.
+   * Simply propagate normal, intra-procedural flows.
+   */
+  virtual void processNormalFlow(const PathEdge<n_t, d_t> &Edge) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Normal", 1, PAMM_SEVERITY_LEVEL::Full);
+    d_t d1 = Edge.factAtSource();
+    n_t n = Edge.getTarget();
+    d_t d2 = Edge.factAtTarget();
+    for (const auto fn : ICF->getSuccsOf(n)) {
+      FlowFunctionPtrType flowFunction =
+          CachedFlowFunctions.getNormalFlowFunction(n, fn);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      for (d_t d3 : flowFunction->computeTargets(d2)) {
+        propagateNormalFlow(d1, fn, d3);
+      }
+    }
+  }
+
+  /**
+   * Propagates the fact d3 that a normal flow function generates to the
+   * successor fn or, when propagating sparsely, to the next statements
+   * that are relevant for it, see IDESolver::propagateNormalFlow().
+   */
+  void propagateNormalFlow(d_t d1, n_t fn, d_t d3) {
+    if (!SolverConfig.sparsePropagation()) {
+      propagate(d1, Chains ? Chains->getChainEnd(fn) : fn, d3);
+      return;
+    }
+    for (n_t Target : getSparseSuccessors(fn, d3)) {
+      propagate(d1, Target, d3);
+    }
+  }
+
+  /**
+   * Returns the statements that Fact is passed on to from the statement Succ
+   * when propagating sparsely, see IDESolver::getSparseSuccessors(). Fact
+   * holds at the statements in between, as it does at Succ: they are the
+   * identity for it. Since the facts at a statement do not depend on the
+   * source fact, they are recorded once, when the statements are walked.
+   */
+  const std::vector<n_t> &getSparseSuccessors(n_t Succ, d_t Fact) {
+    PAMM_GET_INSTANCE;
+    if (auto Search = SparseSuccessors.find({Succ, Fact});
+        Search != SparseSuccessors.end()) {
+      return Search->second;
+    }
+    std::vector<n_t> Targets;
+    std::set<n_t> Visited = {Succ};
+    std::vector<n_t> Pending = {Succ};
+    size_t NumSkipped = 0;
+    IdTy D = FactIds.getOrInsert(Fact);
+    while (!Pending.empty()) {
+      n_t Curr = Pending.back();
+      Pending.pop_back();
+      if (isSparseRelevant(Curr, Fact)) {
+        Targets.push_back(Curr);
+        continue;
+      }
+      ++NumSkipped;
+      FactsAt[NodeIds.getOrInsert(Curr)].set(D);
+      for (n_t Next : ICF->getSuccsOf(Curr)) {
+        if (Visited.insert(Next).second) {
+          Pending.push_back(Next);
+        }
+      }
+    }
+    INC_COUNTER("Sparse Skipped Stmts", NumSkipped, PAMM_SEVERITY_LEVEL::Full);
+    return SparseSuccessors.try_emplace({Succ, Fact}, std::move(Targets))
+        .first->second;
+  }
+
+  /**
+   * Collapses the chains of statements that are the identity for every fact,
+   * see IDESolver::compressIdentityChains(): a path edge is propagated across
+   * a chain in a single step and the facts at its statements are
+   * reconstructed from the ones at its last statement, see
+   * reconstructCollapsedFacts().
+   */
+  void compressIdentityChains() {
+    PAMM_GET_INSTANCE;
+    Chains = std::make_unique<IdentityChains<n_t, f_t>>(
+        *ICF, [this](n_t Stmt) {
+          return (!RelevantStmts || RelevantStmts->count(Stmt)) &&
+                 IFDSProblem.isIdentityStmt(Stmt);
+        });
+    for (f_t Fun : ICF->getAllFunctions()) {
+      Chains->compress(Fun);
+    }
+    INC_COUNTER("Collapsed Stmts", Chains->getNumCollapsed(),
+                PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Collapsed " << Chains->getNumCollapsed()
+                  << " statements into identity chains");
+  }
+
+  /**
+   * Sets the facts that hold at the collapsed statements to the ones that
+   * hold at the last statement of their chain, which hold at every statement
+   * of the chain.
+   */
+  void reconstructCollapsedFacts() {
+    Chains->forEachCollapsed([this](n_t Stmt, n_t ChainEnd) {
+      auto End = NodeIds.lookup(ChainEnd);
+      if (!End) {
+        return;
+      }
+      if (auto Search = FactsAt.find(*End); Search != FactsAt.end()) {
+        // copy, inserting into FactsAt invalidates the iterator
+        FactSet Facts = Search->second;
+        FactsAt[NodeIds.getOrInsert(Stmt)] = std::move(Facts);
+      }
+    });
+  }
+
+  /**
+   * Call sites and exit statements are relevant for every fact, as are the
+   * statements outside of the ones the exploded super-graph is restricted
+   * to, see IDESolver::isSparseRelevant().
+   */
+  bool isSparseRelevant(n_t Stmt, d_t Fact) const {
+    return ICF->isCallStmt(Stmt) || ICF->isExitStmt(Stmt) ||
+           (RelevantStmts && !RelevantStmts->count(Stmt)) ||
+           IFDSProblem.isSparseRelevant(Stmt, Fact);
+  }
+
+  /**
+   * Processes path edges that all have the same source fact and target
+   * statement like processNormalFlow(), but applies each normal flow function
+   * to the facts of all edges at once. See
+   * IDESolver::processNormalFlowBatch().
+   */
+  virtual void
+  processNormalFlowBatch(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Normal", Edges.size(), PAMM_SEVERITY_LEVEL::Full);
+    INC_COUNTER("Batched Path Edges", Edges.size(), PAMM_SEVERITY_LEVEL::Full);
+    d_t d1 = Edges.front().factAtSource();
+    n_t n = Edges.front().getTarget();
+    std::vector<d_t> Sources;
+    Sources.reserve(Edges.size());
+    for (const auto &Edge : Edges) {
+      Sources.push_back(Edge.factAtTarget());
+    }
+    for (const auto fn : ICF->getSuccsOf(n)) {
+      FlowFunctionPtrType flowFunction =
+          CachedFlowFunctions.getNormalFlowFunction(n, fn);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      for (const auto &Targets : flowFunction->computeTargetsBatch(Sources)) {
+        for (d_t d3 : Targets) {
+          propagateNormalFlow(d1, fn, d3);
+        }
+      }
+    }
+  }
+
+  /**
+   * Processes path edges that all have the same source fact and target exit
+   * statement like processExit(), but applies each return-flow function to
+   * the facts of all edges at once. See IDESolver::processExitBatch().
+   */
+  virtual void
+  processExitBatch(const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Batched Path Edges", Edges.size(), PAMM_SEVERITY_LEVEL::Full);
+    CurrentBatch.assign(Edges);
+    for (const auto &Edge : Edges) {
+      processExit(Edge);
+    }
+    CurrentBatch.clear();
+  }
+
+  // Returns the targets of the return-flow function to RetSite for d2, which
+  // are computed for the whole batch if a batch is processed.
+  container_type returnFlowTargets(const FlowFunctionPtrType &RetFunction,
+                                   n_t CallSite, n_t RetSite, d_t d2) {
+    if (CurrentBatch.empty()) {
+      return RetFunction->computeTargets(d2);
+    }
+    return CurrentBatch.getReturnTargets(
+        CallSite, RetSite, d2, [&](const std::vector<d_t> &Sources) {
+          return RetFunction->computeTargetsBatch(Sources);
+        });
+  }
+
+  /**
+   * Lines 21-32 of the algorithm. See IDESolver::processExit().
+   *
+   * Stores callee-side summaries.
+   * Also, at the side of the caller, propagates intra-procedural flows to
+   * return sites using those newly computed summaries.
+   */
+  virtual void processExit(const PathEdge<n_t, d_t> &Edge) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Exit", 1, PAMM_SEVERITY_LEVEL::Full);
+    n_t n = Edge.getTarget();
+    f_t functionThatNeedsSummary = ICF->getFunctionOf(n);
+    d_t d1 = Edge.factAtSource();
+    d_t d2 = Edge.factAtTarget();
+    std::map<n_t, container_type> inc;
+    for (n_t sP : ICF->getStartPointsOf(functionThatNeedsSummary)) {
+      uint64_t Key = getKey(sP, d1);
+      // register end-summary
+      EndSummaries[Key].push_back(getKey(n, d2));
+      if (auto Search = Incoming.find(Key); Search != Incoming.end()) {
+        for (const auto &entry : Search->second) {
+          inc[entry.first] = entry.second;
+        }
+      }
+    }
+    // for each incoming call edge already processed (see processCall(..))
+    for (const auto &[c, CallerFacts] : inc) {
+      IdTy C = NodeIds.getOrInsert(c);
+      for (n_t retSiteC : ICF->getReturnSitesOfCallAt(c)) {
+        FlowFunctionPtrType retFunction =
+            CachedFlowFunctions.getRetFlowFunction(c, functionThatNeedsSummary,
+                                                   n, retSiteC);
+        INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        const container_type targets =
+            returnFlowTargets(retFunction, c, retSiteC, d2);
+        if (targets.empty()) {
+          continue;
+        }
+        // for each fact d4 at the call site and each d3 with a path edge
+        // <sP',d3> --> <c,d4>, propagate to the return site
+        for (d_t d4 : CallerFacts) {
+          auto Search =
+              CallSources.find(combineIds(C, FactIds.getOrInsert(d4)));
+          if (Search == CallSources.end()) {
+            continue;
+          }
+          // copy, propagate() may add new sources
+          const FactSet Sources = Search->second;
+          for (unsigned d3 : Sources) {
+            for (d_t d5 : targets) {
+              propagate(FactIds[d3], retSiteC, d5);
+            }
+          }
+        }
+      }
+    }
+    // handling for unbalanced problems where we return out of a method with a
+    // fact for which we have no incoming flow; only values that originate
+    // from ZERO are propagated that way
+    if (SolverConfig.followReturnsPastSeeds() && inc.empty() &&
+        IFDSProblem.isZeroValue(d1)) {
+      const std::set<n_t> callers = ICF->getCallersOf(functionThatNeedsSummary);
+      for (n_t c : callers) {
+        for (n_t retSiteC : ICF->getReturnSitesOfCallAt(c)) {
+          FlowFunctionPtrType retFunction =
+              CachedFlowFunctions.getRetFlowFunction(
+                  c, functionThatNeedsSummary, n, retSiteC);
+          INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+          for (d_t d5 : returnFlowTargets(retFunction, c, retSiteC, d2)) {
+            propagate(ZeroValue, retSiteC, d5);
+          }
+        }
+      }
+      // in cases where there are no callers, the return statement would
+      // normally not be processed at all; this might be undesirable if
+      // the flow function has a side effect such as registering a taint
+      if (callers.empty()) {
+        FlowFunctionPtrType retFunction =
+            CachedFlowFunctions.getRetFlowFunction(
+                nullptr, functionThatNeedsSummary, n, nullptr);
+        INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        retFunction->computeTargets(d2);
+      }
+    }
+  }
+};
+
+template <typename Problem>
+NativeIFDSSolver(Problem &)
+    -> NativeIFDSSolver<typename Problem::ProblemAnalysisDomain,
+                        typename Problem::container_type>;
+
+template <typename Problem>
+using NativeIFDSSolver_P =
+    NativeIFDSSolver<typename Problem::ProblemAnalysisDomain,
+                     typename Problem::container_type>;
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,405 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+
+namespace psr {
+
+/**
+ * A worklist of path edges that are still to be processed by the IDESolver.
+ * Instead of processing a newly discovered path edge right away, the solver
+ * pushes it into a worklist and drains that worklist in a loop. The order in
+ * which the edges are popped is determined by the concrete worklist.
+ */
+template <typename N, typename D> class PathEdgeWorklist {
+public:
+  virtual ~PathEdgeWorklist() = default;
+
+  virtual void push(PathEdge<N, D> Edge) = 0;
+
+  /// Removes and returns the next path edge to be processed. The worklist
+  /// must not be empty.
+  virtual PathEdge<N, D> pop() = 0;
+
+  /// Returns the next path edge to be processed without removing it. The
+  /// worklist must not be empty.
+  [[nodiscard]] virtual const PathEdge<N, D> &top() const = 0;
+
+  [[nodiscard]] virtual bool empty() const = 0;
+
+  [[nodiscard]] virtual size_t size() const = 0;
+
+  virtual void clear() = 0;
+
+  /// Calls Fn for every pending path edge without removing it. The edges are
+  /// visited in an order such that pushing them into an empty worklist of the
+  /// same kind in that order restores the order in which they are popped.
+  virtual void
+  forEach(const std::function<void(const PathEdge<N, D> &)> &Fn) const = 0;
+
+  /// Replaces the contents of Batch by the next path edge and all path edges
+  /// directly following it that have the same source fact and target
+  /// statement, such that a flow function can be applied to their facts at
+  /// once. If CanBatch returns false for the target statement of the next
+  /// edge, only that edge is removed. The worklist must not be empty.
+  template <typename CanBatchFn>
+  void popBatch(std::vector<PathEdge<N, D>> &Batch, CanBatchFn CanBatch) {
+    Batch.clear();
+    Batch.push_back(pop());
+    // copies, since pushing to Batch invalidates references into it
+    const N Target = Batch.front().getTarget();
+    const D SourceFact = Batch.front().factAtSource();
+    if (!CanBatch(Target)) {
+      return;
+    }
+    while (!empty() && top().getTarget() == Target &&
+           top().factAtSource() == SourceFact) {
+      Batch.push_back(pop());
+    }
+  }
+};
+
+/// Processes path edges in the order they have been discovered (breadth-first
+/// exploration of the exploded super-graph).
+template <typename N, typename D>
+class FIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::deque<PathEdge<N, D>> Edges;
+
+public:
+  void push(PathEdge<N, D> Edge) override { Edges.push_back(std::move(Edge)); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> Edge = std::move(Edges.front());
+    Edges.pop_front();
+    return Edge;
+  }
+
+  [[nodiscard]] const PathEdge<N, D> &top() const override {
+    return Edges.front();
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+
+  void clear() override { Edges.clear(); }
+
+  void forEach(
+      const std::function<void(const PathEdge<N, D> &)> &Fn) const override {
+    std::for_each(Edges.begin(), Edges.end(), Fn);
+  }
+};
+
+/// Processes the most recently discovered path edge first (depth-first
+/// exploration of the exploded super-graph). This resembles the order of the
+/// former recursive implementation and keeps the worklist small.
+template <typename N, typename D>
+class LIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::vector<PathEdge<N, D>> Edges;
+
+public:
+  void push(PathEdge<N, D> Edge) override { Edges.push_back(std::move(Edge)); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> Edge = std::move(Edges.back());
+    Edges.pop_back();
+    return Edge;
+  }
+
+  [[nodiscard]] const PathEdge<N, D> &top() const override {
+    return Edges.back();
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+
+  void clear() override { Edges.clear(); }
+
+  void forEach(
+      const std::function<void(const PathEdge<N, D> &)> &Fn) const override {
+    std::for_each(Edges.begin(), Edges.end(), Fn);
+  }
+};
+
+/// Processes path edges according to a user-defined priority; edges with a
+/// smaller priority value are processed first. Edges of equal priority are
+/// processed in the order they have been discovered.
+template <typename N, typename D>
+class PriorityPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+public:
+  using PriorityFunctionTy = std::function<size_t(const PathEdge<N, D> &)>;
+
+private:
+  struct Entry {
+    size_t Priority;
+    uint64_t Sequence;
+    PathEdge<N, D> Edge;
+  };
+
+  struct EntryGreater {
+    bool operator()(const Entry &Lhs, const Entry &Rhs) const {
+      return std::tie(Lhs.Priority, Lhs.Sequence) >
+             std::tie(Rhs.Priority, Rhs.Sequence);
+    }
+  };
+
+  PriorityFunctionTy PriorityFunction;
+  // a heap ordered by EntryGreater, see forEach()
+  std::vector<Entry> Edges;
+  uint64_t NextSequence = 0;
+
+public:
+  PriorityPathEdgeWorklist(PriorityFunctionTy PriorityFunction)
+      : PriorityFunction(std::move(PriorityFunction)) {}
+
+  void push(PathEdge<N, D> Edge) override {
+    size_t Priority = PriorityFunction(Edge);
+    Edges.push_back(Entry{Priority, NextSequence++, std::move(Edge)});
+    std::push_heap(Edges.begin(), Edges.end(), EntryGreater());
+  }
+
+  PathEdge<N, D> pop() override {
+    std::pop_heap(Edges.begin(), Edges.end(), EntryGreater());
+    PathEdge<N, D> Edge = std::move(Edges.back().Edge);
+    Edges.pop_back();
+    return Edge;
+  }
+
+  [[nodiscard]] const PathEdge<N, D> &top() const override {
+    return Edges.front().Edge;
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+
+  void clear() override {
+    Edges.clear();
+    NextSequence = 0;
+  }
+
+  void forEach(
+      const std::function<void(const PathEdge<N, D> &)> &Fn) const override {
+    // edges of equal priority are popped in the order they have been pushed
+    std::vector<const Entry *> Ordered;
+    Ordered.reserve(Edges.size());
+    for (const auto &E : Edges) {
+      Ordered.push_back(&E);
+    }
+    std::sort(Ordered.begin(), Ordered.end(),
+              [](const Entry *Lhs, const Entry *Rhs) {
+                return Lhs->Sequence < Rhs->Sequence;
+              });
+    for (const auto *E : Ordered) {
+      Fn(E->Edge);
+    }
+  }
+};
+
+/**
+ * Creates the worklist that corresponds to the given policy. The priority
+ * function is only used for WorklistPolicy::Priority and
+ * WorklistPolicy::ReversePostOrder.
+ */
+template <typename N, typename D>
+std::unique_ptr<PathEdgeWorklist<N, D>> makePathEdgeWorklist(
+    WorklistPolicy Policy,
+    typename PriorityPathEdgeWorklist<N, D>::PriorityFunctionTy Priority =
+        nullptr) {
+  switch (Policy) {
+  case WorklistPolicy::FIFO:
+    return std::make_unique<FIFOPathEdgeWorklist<N, D>>();
+  case WorklistPolicy::Priority:
+  case WorklistPolicy::ReversePostOrder:
+    if (Priority) {
+      return std::make_unique<PriorityPathEdgeWorklist<N, D>>(
+          std::move(Priority));
+    }
+    // without a priority function the priority worklist degenerates to FIFO
+    return std::make_unique<FIFOPathEdgeWorklist<N, D>>();
+  case WorklistPolicy::LIFO:
+  default:
+    return std::make_unique<LIFOPathEdgeWorklist<N, D>>();
+  }
+}
+
+/**
+ * A worklist that is drained by a pool of worker threads. Every worker owns a
+ * queue it pushes newly discovered path edges to and pops from in LIFO order.
+ * Idle workers steal the oldest edges from the other workers' queues. The
+ * worklist is drained once no edge is queued and no edge is being processed
+ * anymore.
+ *
+ * The process function is called concurrently and must therefore only access
+ * shared state in a synchronized manner.
+ */
+template <typename N, typename D> class WorkStealingPathEdgeWorklist {
+public:
+  using ProcessFunctionTy = std::function<void(PathEdge<N, D>)>;
+
+private:
+  struct WorkerQueue {
+    std::mutex Mtx;
+    std::deque<PathEdge<N, D>> Edges;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> Queues;
+  // number of edges that are queued or currently being processed
+  std::atomic<size_t> Pending = 0;
+  std::atomic<bool> Abort = false;
+  std::mutex IdleMtx;
+  std::condition_variable IdleCV;
+
+  // the queue the current thread pushes to; threads that are not part of the
+  // pool (e.g. the one submitting the initial seeds) use the first queue
+  inline static thread_local size_t WorkerId = 0;
+
+  std::optional<PathEdge<N, D>> tryPop(size_t Id) {
+    {
+      auto &Own = *Queues[Id];
+      std::lock_guard<std::mutex> Lock(Own.Mtx);
+      if (!Own.Edges.empty()) {
+        PathEdge<N, D> Edge = std::move(Own.Edges.back());
+        Own.Edges.pop_back();
+        return Edge;
+      }
+    }
+    for (size_t I = 1; I < Queues.size(); ++I) {
+      auto &Victim = *Queues[(Id + I) % Queues.size()];
+      std::lock_guard<std::mutex> Lock(Victim.Mtx);
+      if (!Victim.Edges.empty()) {
+        PathEdge<N, D> Edge = std::move(Victim.Edges.front());
+        Victim.Edges.pop_front();
+        return Edge;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void finished() {
+    if (--Pending == 0) {
+      std::lock_guard<std::mutex> Lock(IdleMtx);
+      IdleCV.notify_all();
+    }
+  }
+
+public:
+  explicit WorkStealingPathEdgeWorklist(unsigned NumThreads) {
+    NumThreads = std::max(NumThreads, 1u);
+    Queues.reserve(NumThreads);
+    for (unsigned I = 0; I < NumThreads; ++I) {
+      Queues.push_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
+  WorkStealingPathEdgeWorklist(const WorkStealingPathEdgeWorklist &) = delete;
+  WorkStealingPathEdgeWorklist &
+  operator=(const WorkStealingPathEdgeWorklist &) = delete;
+
+  ~WorkStealingPathEdgeWorklist() = default;
+
+  [[nodiscard]] size_t getNumThreads() const { return Queues.size(); }
+
+  [[nodiscard]] size_t size() const { return Pending; }
+
+  void push(PathEdge<N, D> Edge) {
+    ++Pending;
+    auto &Own = *Queues[WorkerId % Queues.size()];
+    {
+      std::lock_guard<std::mutex> Lock(Own.Mtx);
+      Own.Edges.push_back(std::move(Edge));
+    }
+    IdleCV.notify_one();
+  }
+
+  /**
+   * Processes all queued path edges as well as all edges pushed during their
+   * processing using getNumThreads() worker threads. Blocks until the
+   * worklist has been drained. If the process function throws, the remaining
+   * edges are discarded and the first exception is rethrown.
+   */
+  void run(const ProcessFunctionTy &Process) {
+    std::exception_ptr FirstException;
+    std::mutex ExceptionMtx;
+    auto Worker = [&](size_t Id) {
+      WorkerId = Id;
+      while (!Abort) {
+        if (auto Edge = tryPop(Id)) {
+          try {
+            Process(std::move(*Edge));
+          } catch (...) {
+            std::lock_guard<std::mutex> Lock(ExceptionMtx);
+            if (!FirstException) {
+              FirstException = std::current_exception();
+            }
+            Abort = true;
+            std::lock_guard<std::mutex> IdleLock(IdleMtx);
+            IdleCV.notify_all();
+          }
+          finished();
+          continue;
+        }
+        std::unique_lock<std::mutex> Lock(IdleMtx);
+        if (Pending == 0) {
+          break;
+        }
+        // an edge may have been pushed between tryPop() and here, therefore
+        // we do not wait indefinitely
+        IdleCV.wait_for(Lock, std::chrono::milliseconds(1));
+      }
+      WorkerId = 0;
+    };
+    std::vector<std::thread> Threads;
+    Threads.reserve(Queues.size() - 1);
+    for (size_t I = 1; I < Queues.size(); ++I) {
+      Threads.emplace_back(Worker, I);
+    }
+    Worker(0);
+    for (auto &Thread : Threads) {
+      Thread.join();
+    }
+    if (Abort) {
+      for (auto &Queue : Queues) {
+        Queue->Edges.clear();
+      }
+      Pending = 0;
+      Abort = false;
+    }
+    if (FirstException) {
+      std::rethrow_exception(FirstException);
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,34 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERCHECKPOINT_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERCHECKPOINT_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/CheckpointIO.h"
+
+namespace psr {
+
+class ProjectIRDB;
+
+/**
+ * Returns a hash of the contents of every function and global variable in
+ * IRDB, keyed by their checkpoint IDs. The hashes are stable across runs and
+ * are used to detect which functions differ between the IR a checkpoint has
+ * been written for and the current IR. Debug information does not contribute
+ * to the hashes.
+ */
+std::map<std::string, uint64_t> getCheckpointHashes(const ProjectIRDB &IRDB);
+
+} // namespace psr
+
+#endif
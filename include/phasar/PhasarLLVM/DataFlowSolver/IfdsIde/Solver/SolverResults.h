@@ -17,41 +17,225 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERRESULTS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERRESULTS_H_
 
-#include <map>
+#include <cstddef>
+#include <iterator>
 #include <set>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactIndex.h"
 #include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
 #include "phasar/Utils/Table.h"
 
 namespace psr {
 
+/**
+ * A view of the results at a single statement that refers to the solver's
+ * result table instead of copying them. If requested, the zero value is
+ * skipped while the results are iterated. The view is invalidated once the
+ * results are modified.
+ */
+template <typename D, typename L> class ResultsView {
+  using RowTy = std::unordered_map<D, L>;
+
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename RowTy::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    iterator() = default;
+
+    reference operator*() const { return *It; }
+    pointer operator->() const { return &*It; }
+
+    iterator &operator++() {
+      ++It;
+      skipZero();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+
+    friend bool operator==(const iterator &Lhs, const iterator &Rhs) {
+      return Lhs.It == Rhs.It;
+    }
+    friend bool operator!=(const iterator &Lhs, const iterator &Rhs) {
+      return !(Lhs == Rhs);
+    }
+
+  private:
+    friend class ResultsView;
+
+    typename RowTy::const_iterator It;
+    typename RowTy::const_iterator End;
+    D ZeroValue{};
+    bool StripZero = false;
+
+    iterator(typename RowTy::const_iterator It,
+             typename RowTy::const_iterator End, D ZeroValue, bool StripZero)
+        : It(It), End(End), ZeroValue(ZeroValue), StripZero(StripZero) {
+      skipZero();
+    }
+
+    // a row contains the zero value at most once
+    void skipZero() {
+      if (StripZero && It != End && It->first == ZeroValue) {
+        ++It;
+      }
+    }
+  };
+
+  using const_iterator = iterator;
+
+  ResultsView(const RowTy &Row, D ZeroValue, bool StripZero)
+      : Row(Row), ZeroValue(ZeroValue), StripZero(StripZero) {}
+
+  [[nodiscard]] iterator begin() const {
+    return iterator(Row.begin(), Row.end(), ZeroValue, StripZero);
+  }
+
+  [[nodiscard]] iterator end() const {
+    return iterator(Row.end(), Row.end(), ZeroValue, StripZero);
+  }
+
+  [[nodiscard]] size_t size() const {
+    return Row.size() - (StripZero && Row.count(ZeroValue) ? 1 : 0);
+  }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  [[nodiscard]] bool contains(D Fact) const {
+    return !(StripZero && Fact == ZeroValue) && Row.count(Fact);
+  }
+
+  /**
+   * Returns the value of the given fact, which must be contained in the
+   * view.
+   */
+  [[nodiscard]] const L &at(D Fact) const { return Row.at(Fact); }
+
+private:
+  const RowTy &Row;
+  D ZeroValue;
+  bool StripZero;
+};
+
 template <typename N, typename D, typename L> class SolverResults {
 private:
-  Table<N, D, L> &results;
+  const Table<N, D, L> &results;
   D zeroValue;
+  const FactIndex<N, D> *factIndex;
 
 public:
-  SolverResults(Table<N, D, L> &res_tab, D zv)
-      : results(res_tab), zeroValue(zv) {}
+  SolverResults(const Table<N, D, L> &res_tab, D zv,
+                const FactIndex<N, D> *fact_index = nullptr)
+      : results(res_tab), zeroValue(zv), factIndex(fact_index) {}
 
-  L resultAt(N stmt, D node) const { return results.get(stmt, node); }
+  L resultAt(N stmt, D node) const {
+    const auto &Row = results.row(stmt);
+    if (auto Search = Row.find(node); Search != Row.end()) {
+      return Search->second;
+    }
+    return L{};
+  }
 
   std::unordered_map<D, L> resultsAt(N stmt, bool stripZero = false) const {
     std::unordered_map<D, L> result = results.row(stmt);
     if (stripZero) {
-      for (auto it = result.begin(); it != result.end();) {
-        if (it->first == zeroValue) {
-          it = result.erase(it);
-        } else {
-          ++it;
-        }
-      }
+      result.erase(zeroValue);
     }
     return result;
   }
 
+  /**
+   * Returns the results at the given statement without copying them, see
+   * ResultsView. Prefer this over resultsAt() when the results are only
+   * inspected.
+   */
+  [[nodiscard]] ResultsView<D, L> resultsViewAt(N stmt,
+                                                bool stripZero = false) const {
+    return ResultsView<D, L>(results.row(stmt), zeroValue, stripZero);
+  }
+
+  /**
+   * Calls Handler(n, d, l) for every fact d that holds at a statement n with
+   * value l, in no particular order. This is cheaper than querying the
+   * results statement by statement if all of them are needed.
+   */
+  template <typename HandlerFn>
+  void forEachResult(HandlerFn Handler, bool stripZero = false) const {
+    results.forEachCell([&](N Stmt, D Fact, const L &Value) {
+      if (!stripZero || Fact != zeroValue) {
+        Handler(Stmt, Fact, Value);
+      }
+    });
+  }
+
+  /**
+   * Calls Handler(n, view) for every statement n that has results, where view
+   * is the ResultsView of n, in no particular order. Statements whose only
+   * result is the stripped zero value are skipped.
+   */
+  template <typename HandlerFn>
+  void forEachStatement(HandlerFn Handler, bool stripZero = false) const {
+    results.forEachRow([&](N Stmt, const std::unordered_map<D, L> &Row) {
+      ResultsView<D, L> View(Row, zeroValue, stripZero);
+      if (!View.empty()) {
+        Handler(Stmt, View);
+      }
+    });
+  }
+
+  /**
+   * Returns true if the per-fact queries are answered by a FactIndex instead
+   * of scanning the results of all statements.
+   */
+  [[nodiscard]] bool hasFactIndex() const { return factIndex != nullptr; }
+
+  /**
+   * Calls Handler(n, l) for every statement n the given fact holds at with
+   * value l. With a fact index, this takes time proportional to the number
+   * of such statements; the statements are then visited in a stable order.
+   */
+  template <typename HandlerFn>
+  void forEachResultOf(D fact, HandlerFn Handler) const {
+    if (factIndex) {
+      factIndex->forEachStatementOf(fact, [&](N Stmt) {
+        Handler(Stmt, results.row(Stmt).at(fact));
+      });
+      return;
+    }
+    results.forEachCell([&](N Stmt, D Fact, const L &Value) {
+      if (Fact == fact) {
+        Handler(Stmt, Value);
+      }
+    });
+  }
+
+  /**
+   * Returns the statements the given fact holds at, see forEachResultOf().
+   */
+  [[nodiscard]] std::vector<N> statementsOf(D fact) const {
+    if (factIndex) {
+      return factIndex->statementsOf(fact);
+    }
+    std::vector<N> Stmts;
+    forEachResultOf(fact, [&Stmts](N Stmt, const L & /*Value*/) {
+      Stmts.push_back(Stmt);
+    });
+    return Stmts;
+  }
+
   // this function only exists for IFDS problems which use BinaryDomain as their
   // value domain L
   template <typename ValueDomain = L,
@@ -59,8 +243,7 @@ public:
                 std::is_same_v<ValueDomain, BinaryDomain>>>
   std::set<D> ifdsResultsAt(N stmt) const {
     std::set<D> KeySet;
-    std::unordered_map<D, BinaryDomain> ResultMap = this->resultsAt(stmt);
-    for (auto FlowFact : ResultMap) {
+    for (const auto &FlowFact : resultsViewAt(stmt)) {
       KeySet.insert(FlowFact.first);
     }
     return KeySet;
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERTELEMETRY_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERTELEMETRY_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// Returns the resident set size of the process in bytes; where it is not
+/// available, the peak resident set size is returned instead, or 0 if
+/// neither can be determined.
+size_t getResidentSetSize();
+
+/**
+ * The work the IDE solver has spent on a single function.
+ */
+template <typename D> struct FunctionTelemetry {
+  /// The number of path edges that have been propagated to statements of the
+  /// function, including the ones whose jump function changed again.
+  size_t PathEdges = 0;
+  /// The number of distinct jump functions of the function.
+  size_t JumpFunctions = 0;
+  /// The facts that have reached statements of the function.
+  std::unordered_set<D> Facts;
+  /// The time spent on processing the path edges of the function; only
+  /// measured with PAMM_FULL.
+  std::chrono::steady_clock::duration Time{0};
+};
+
+/**
+ * Collects per-function statistics while the IDE solver constructs the
+ * exploded super-graph and reports its progress periodically: the number of
+ * processed path edges per second, the size of the worklist and the resident
+ * set size. The solver only uses it if PAMM is enabled.
+ */
+template <typename D, typename F> class SolverTelemetry {
+public:
+  using clock = std::chrono::steady_clock;
+
+  SolverTelemetry() : Start(clock::now()), LastReport(Start) {}
+
+  void recordPathEdge(F Fun, D Fact, bool NewJumpFunction) {
+    auto &Stats = Functions[Fun];
+    ++Stats.PathEdges;
+    if (NewJumpFunction) {
+      ++Stats.JumpFunctions;
+    }
+    Stats.Facts.insert(std::move(Fact));
+    ++NumPathEdges;
+  }
+
+  void recordTime(F Fun, clock::duration Time) { Functions[Fun].Time += Time; }
+
+  /**
+   * Returns whether at least Interval has elapsed since the last progress
+   * report. The clock is only consulted every ProgressCheckPeriod calls.
+   */
+  bool isProgressDue(std::chrono::seconds Interval) {
+    if (Interval.count() == 0 || ++CallsSinceCheck < ProgressCheckPeriod) {
+      return false;
+    }
+    CallsSinceCheck = 0;
+    return clock::now() - LastReport >= Interval;
+  }
+
+  /**
+   * Returns the progress since the last report as a single line and starts a
+   * new reporting period.
+   */
+  std::string reportProgress(size_t WorklistSize) {
+    const auto Now = clock::now();
+    const double Seconds =
+        std::chrono::duration<double>(Now - LastReport).count();
+    const size_t Edges = NumPathEdges - EdgesAtLastReport;
+    std::stringstream Line;
+    Line << "Propagated " << NumPathEdges << " path edges ("
+         << static_cast<size_t>(Seconds > 0 ? Edges / Seconds : 0)
+         << " edges/s), worklist: " << WorklistSize
+         << ", RSS: " << getResidentSetSize() / (1024 * 1024) << " MB";
+    LastReport = Now;
+    EdgesAtLastReport = NumPathEdges;
+    return Line.str();
+  }
+
+  /**
+   * Returns up to Num functions the solver has spent the most work on,
+   * hottest first. Functions are ranked by the time spent on them if it has
+   * been measured and by their number of path edges otherwise.
+   */
+  [[nodiscard]] std::vector<std::pair<F, const FunctionTelemetry<D> *>>
+  getHottestFunctions(size_t Num) const {
+    std::vector<std::pair<F, const FunctionTelemetry<D> *>> Hottest;
+    Hottest.reserve(Functions.size());
+    for (const auto &[Fun, Stats] : Functions) {
+      Hottest.emplace_back(Fun, &Stats);
+    }
+    Num = std::min(Num, Hottest.size());
+    std::partial_sort(Hottest.begin(), Hottest.begin() + Num, Hottest.end(),
+                      [](const auto &Lhs, const auto &Rhs) {
+                        return std::tie(Lhs.second->Time,
+                                        Lhs.second->PathEdges) >
+                               std::tie(Rhs.second->Time,
+                                        Rhs.second->PathEdges);
+                      });
+    Hottest.resize(Num);
+    return Hottest;
+  }
+
+  void
+  printHottestFunctions(std::ostream &OS, size_t Num,
+                        const std::function<std::string(F)> &FtoString) const {
+    OS << "Hottest of " << Functions.size() << " functions after "
+       << std::chrono::duration_cast<std::chrono::seconds>(clock::now() -
+                                                           Start)
+              .count()
+       << " s:\n";
+    size_t Rank = 0;
+    for (const auto &[Fun, Stats] : getHottestFunctions(Num)) {
+      OS << ++Rank << ". " << FtoString(Fun) << ": " << Stats->PathEdges
+         << " path edges, " << Stats->Facts.size() << " facts, "
+         << Stats->JumpFunctions << " jump functions, "
+         << std::chrono::duration_cast<std::chrono::milliseconds>(Stats->Time)
+                .count()
+         << " ms\n";
+    }
+  }
+
+  [[nodiscard]] const FunctionTelemetry<D> *getFunctionTelemetry(F Fun) const {
+    auto Search = Functions.find(Fun);
+    return Search != Functions.end() ? &Search->second : nullptr;
+  }
+
+  [[nodiscard]] size_t getNumPathEdges() const { return NumPathEdges; }
+
+  [[nodiscard]] size_t getNumFunctions() const { return Functions.size(); }
+
+  static constexpr size_t ProgressCheckPeriod = 1024;
+
+private:
+  std::unordered_map<F, FunctionTelemetry<D>> Functions;
+  size_t NumPathEdges = 0;
+  clock::time_point Start;
+  clock::time_point LastReport;
+  size_t EdgesAtLastReport = 0;
+  size_t CallsSinceCheck = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -17,17 +17,22 @@
 #ifndef PHASAR_PHASARLLVM_MONO_SOLVER_INTERMONOSOLVER_H_
 #define PHASAR_PHASARLLVM_MONO_SOLVER_INTERMONOSOLVER_H_
 
-#include <deque>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "phasar/PhasarLLVM/ControlFlow/ICFGOrder.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Contexts/CallStringCTX.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/InterMonoProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/MonoEdgeWorklist.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+#include "phasar/PhasarLLVM/Utils/ResultsExporter.h"
 #include "phasar/Utils/BitVectorSet.h"
 #include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/PAMMMacros.h"
 
 namespace psr {
 
@@ -44,18 +49,41 @@ public:
 
 protected:
   ProblemTy &IMProblem;
-  std::deque<std::pair<n_t, n_t>> Worklist;
+  MonoEdgeWorklist<n_t> Worklist;
   std::unordered_map<
       n_t, std::unordered_map<CallStringCTX<n_t, K>, BitVectorSet<d_t>>>
       Analysis;
   std::unordered_set<f_t> AddedFunctions;
   const i_t *ICF;
+  // indexes the data-flow facts of all sets of this solver, see solve()
+  std::shared_ptr<BitVectorSetIndexer<d_t>> Indexer =
+      std::make_shared<BitVectorSetIndexer<d_t>>();
+
+  // the edges are processed in the order of their source statements, callees
+  // before callers and in reverse post-order within a function, see ICFGOrder
+  std::unique_ptr<ICFGOrder<n_t, f_t>> Order;
+
+  void pushBack(std::pair<n_t, n_t> Edge) {
+    PAMM_GET_INSTANCE;
+    if (Worklist.push(Edge, Order->getPriority(Edge.first))) {
+      INC_COUNTER("Mono Edges Enqueued", 1, PAMM_SEVERITY_LEVEL::Full);
+    } else {
+      INC_COUNTER("Mono Duplicate Edges", 1, PAMM_SEVERITY_LEVEL::Full);
+    }
+  }
+
+  void pushAll(const std::vector<std::pair<n_t, n_t>> &Edges) {
+    for (const auto &Edge : Edges) {
+      pushBack(Edge);
+    }
+  }
 
   void initialize() {
+    Order = std::make_unique<ICFGOrder<n_t, f_t>>(*ICF);
     for (auto &seed : IMProblem.initialSeeds()) {
       std::vector<std::pair<n_t, n_t>> edges =
           ICF->getAllControlFlowEdges(ICF->getFunctionOf(seed.first));
-      Worklist.insert(Worklist.begin(), edges.begin(), edges.end());
+      pushAll(edges);
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &edge : edges) {
@@ -84,7 +112,7 @@ protected:
 
   void printWorkList() {
     std::cout << "CURRENT WORKLIST:" << std::endl;
-    for (auto Entry : Worklist) {
+    for (auto Entry : Worklist.getEnqueuedEdges()) {
       std::cout << llvmIRToString(Entry.first) << " ---> "
                 << llvmIRToString(Entry.second) << std::endl;
     }
@@ -110,12 +138,12 @@ protected:
       AddedFunctions.insert(callee);
       // Add call edge(s)
       for (auto startPoint : ICF->getStartPointsOf(callee)) {
-        Worklist.push_back({src, startPoint});
+        pushBack({src, startPoint});
       }
       // Add intra edges of callee
       std::vector<std::pair<n_t, n_t>> edges =
           ICF->getAllControlFlowEdges(callee);
-      Worklist.insert(Worklist.begin(), edges.begin(), edges.end());
+      pushAll(edges);
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &edge : edges) {
@@ -128,7 +156,7 @@ protected:
       // Add return edge(s)
       for (auto ret : ICF->getExitPointsOf(callee)) {
         for (auto retSite : ICF->getReturnSitesOfCallAt(src)) {
-          Worklist.push_back({ret, retSite});
+          pushBack({ret, retSite});
         }
       }
     }
@@ -139,16 +167,16 @@ protected:
   void addToWorklist(std::pair<n_t, n_t> edge) {
     auto src = edge.first;
     auto dst = edge.second;
-    Worklist.push_back({src, dst});
+    pushBack({src, dst});
     // add intra-procedural edges again
     for (auto nprimeprime : ICF->getSuccsOf(dst)) {
-      Worklist.push_back({dst, nprimeprime});
+      pushBack({dst, nprimeprime});
     }
     // add inter-procedural call edges again
     if (ICF->isCallStmt(dst)) {
       for (auto callee : ICF->getCalleesOfCallAt(dst)) {
         for (auto startPoint : ICF->getStartPointsOf(callee)) {
-          Worklist.push_back({dst, startPoint});
+          pushBack({dst, startPoint});
         }
       }
     }
@@ -156,14 +184,19 @@ protected:
     if (ICF->isExitStmt(dst)) {
       for (auto caller : ICF->getCallersOf(ICF->getFunctionOf(dst))) {
         for (auto nprimeprime : ICF->getSuccsOf(caller)) {
-          Worklist.push_back({dst, nprimeprime});
+          pushBack({dst, nprimeprime});
         }
       }
     }
   }
 
 public:
-  InterMonoSolver(ProblemTy &IMP) : IMProblem(IMP), ICF(IMP.getICFG()) {}
+  InterMonoSolver(ProblemTy &IMP) : IMProblem(IMP), ICF(IMP.getICFG()) {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("Mono Edges Enqueued", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Mono Edges Processed", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Mono Duplicate Edges", 0, PAMM_SEVERITY_LEVEL::Full);
+  }
   InterMonoSolver(const InterMonoSolver &) = delete;
   InterMonoSolver &operator=(const InterMonoSolver &) = delete;
   InterMonoSolver(InterMonoSolver &&) = delete;
@@ -177,10 +210,14 @@ public:
   }
 
   virtual void solve() {
+    // the sets created by the problem while solving index their facts with
+    // the solver's indexer
+    typename BitVectorSetIndexer<d_t>::Scope IndexerScope(Indexer);
+    PAMM_GET_INSTANCE;
     initialize();
     while (!Worklist.empty()) {
-      std::pair<n_t, n_t> edge = Worklist.front();
-      Worklist.pop_front();
+      std::pair<n_t, n_t> edge = Worklist.pop();
+      INC_COUNTER("Mono Edges Processed", 1, PAMM_SEVERITY_LEVEL::Full);
       auto src = edge.first;
       auto dst = edge.second;
       if (ICF->isCallStmt(src)) {
@@ -274,7 +311,7 @@ public:
   }
 
   BitVectorSet<d_t> getResultsAt(n_t n) {
-    BitVectorSet<d_t> Result;
+    BitVectorSet<d_t> Result(Indexer);
     for (auto &[CTX, Facts] : Analysis[n]) {
       Result.insert(Facts);
     }
@@ -307,6 +344,25 @@ public:
   virtual void emitTextReport(std::ostream &OS = std::cout) {}
 
   virtual void emitGraphicalReport(std::ostream &OS = std::cout) {}
+
+  /**
+   * Exports the facts that hold at each statement in any context as JSON or
+   * SARIF, see psr::exportResults().
+   */
+  virtual void exportResults(IOFormat Format, std::ostream &OS = std::cout) {
+    psr::exportResults(
+        IMProblem,
+        [this](const auto &Handler) {
+          for (const auto &[Node, ContextMap] : Analysis) {
+            BitVectorSet<d_t> FlowFacts(Indexer);
+            for (const auto &[Context, ContextFacts] : ContextMap) {
+              FlowFacts.insert(ContextFacts);
+            }
+            Handler(Node, toExportedResults(FlowFacts));
+          }
+        },
+        Format, OS);
+  }
 };
 
 template <typename Problem, unsigned K>
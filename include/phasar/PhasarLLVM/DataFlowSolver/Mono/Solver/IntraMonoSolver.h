@@ -19,11 +19,14 @@
 
 #include <deque>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/IntraMonoProblem.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+#include "phasar/PhasarLLVM/Utils/ResultsExporter.h"
 #include "phasar/Utils/BitVectorSet.h"
 
 namespace psr {
@@ -44,6 +47,9 @@ protected:
   std::deque<std::pair<n_t, n_t>> Worklist;
   std::unordered_map<n_t, BitVectorSet<d_t>> Analysis;
   const c_t *CFG;
+  // indexes the data-flow facts of all sets of this solver, see solve()
+  std::shared_ptr<BitVectorSetIndexer<d_t>> Indexer =
+      std::make_shared<BitVectorSetIndexer<d_t>>();
 
   void initialize() {
     auto EntryPoints = IMProblem.getEntryPoints();
@@ -69,6 +75,9 @@ public:
   IntraMonoSolver(ProblemTy &IMP) : IMProblem(IMP), CFG(IMP.getCFG()) {}
   virtual ~IntraMonoSolver() = default;
   virtual void solve() {
+    // the sets created by the problem while solving index their facts with
+    // the solver's indexer
+    typename BitVectorSetIndexer<d_t>::Scope IndexerScope(Indexer);
     // step 1: Initalization (of Worklist and Analysis)
     initialize();
     // step 2: Iteration (updating Worklist and Analysis)
@@ -116,6 +125,21 @@ public:
   virtual void emitTextReport(std::ostream &OS = std::cout) {}
 
   virtual void emitGraphicalReport(std::ostream &OS = std::cout) {}
+
+  /**
+   * Exports the facts that hold at each statement as JSON or SARIF, see
+   * psr::exportResults().
+   */
+  virtual void exportResults(IOFormat Format, std::ostream &OS = std::cout) {
+    psr::exportResults(
+        IMProblem,
+        [this](const auto &Handler) {
+          for (const auto &[Node, FlowFacts] : Analysis) {
+            Handler(Node, toExportedResults(FlowFacts));
+          }
+        },
+        Format, OS);
+  }
 };
 
 template <typename Problem>
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_MONO_SOLVER_MONOEDGEWORKLIST_H_
+#define PHASAR_PHASARLLVM_MONO_SOLVER_MONOEDGEWORKLIST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+
+namespace psr {
+
+/**
+ * A worklist of control-flow edges that are still to be processed by the
+ * monotone solvers. An edge is contained at most once: pushing an edge that
+ * is already enqueued has no effect, since processing it reads the most
+ * recent data-flow facts at its source anyway. Edges with smaller priorities
+ * are popped first, edges of equal priority in the order they were pushed.
+ */
+template <typename N> class MonoEdgeWorklist {
+public:
+  using EdgeTy = std::pair<N, N>;
+
+  /// Enqueues the given edge with the given priority, returns false if the
+  /// edge is already enqueued.
+  bool push(EdgeTy Edge, uint64_t Priority) {
+    const unsigned Id = getEdgeId(Edge);
+    if (Enqueued.test(Id)) {
+      return false;
+    }
+    Enqueued.set(Id);
+    Heap.emplace_back(Priority, NextSequence++, Id);
+    std::push_heap(Heap.begin(), Heap.end(), std::greater<HeapEntry>());
+    return true;
+  }
+
+  /// Removes and returns the next edge to be processed. The worklist must
+  /// not be empty.
+  EdgeTy pop() {
+    std::pop_heap(Heap.begin(), Heap.end(), std::greater<HeapEntry>());
+    const unsigned Id = std::get<2>(Heap.back());
+    Heap.pop_back();
+    Enqueued.reset(Id);
+    return Edges[Id];
+  }
+
+  [[nodiscard]] bool contains(EdgeTy Edge) const {
+    auto Search = EdgeIds.find(Edge);
+    return Search != EdgeIds.end() && Enqueued.test(Search->second);
+  }
+
+  [[nodiscard]] bool empty() const { return Heap.empty(); }
+
+  [[nodiscard]] size_t size() const { return Heap.size(); }
+
+  /// Returns the number of distinct edges that have ever been enqueued.
+  [[nodiscard]] size_t getNumKnownEdges() const { return Edges.size(); }
+
+  /// Returns the enqueued edges in no particular order.
+  [[nodiscard]] std::vector<EdgeTy> getEnqueuedEdges() const {
+    std::vector<EdgeTy> Result;
+    Result.reserve(Heap.size());
+    for (const auto &Entry : Heap) {
+      Result.push_back(Edges[std::get<2>(Entry)]);
+    }
+    return Result;
+  }
+
+  void clear() {
+    Heap.clear();
+    Enqueued.reset();
+  }
+
+private:
+  // priority, sequence number and dense ID of an enqueued edge
+  using HeapEntry = std::tuple<uint64_t, uint64_t, unsigned>;
+
+  unsigned getEdgeId(EdgeTy Edge) {
+    auto [It, Inserted] = EdgeIds.try_emplace(Edge, Edges.size());
+    if (Inserted) {
+      Edges.push_back(Edge);
+      Enqueued.resize(Edges.size());
+    }
+    return It->second;
+  }
+
+  llvm::DenseMap<EdgeTy, unsigned> EdgeIds;
+  std::vector<EdgeTy> Edges;
+  llvm::BitVector Enqueued;
+  std::vector<HeapEntry> Heap;
+  uint64_t NextSequence = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -249,6 +249,14 @@ public:
     }
   }
 
+  void processNormalFlowBatch(
+      const std::vector<PathEdge<n_t, d_t>> &Edges) override {
+    // the normal PDS rules are added edge by edge
+    for (const auto &Edge : Edges) {
+      processNormalFlow(Edge);
+    }
+  }
+
   void processCall(PathEdge<n_t, d_t> edge) override {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "WPDS::processCall");
     PAMM_GET_INSTANCE;
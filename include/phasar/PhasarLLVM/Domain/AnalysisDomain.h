@@ -72,6 +72,17 @@ struct LLVMAnalysisDomainDefault : public AnalysisDomain {
   using i_t = LLVMBasedICFG;
 };
 
+// Tag type by which an analysis domain selects CompactJumpFunctions as the
+// IDESolver's jump function storage, e.g.
+//
+//   struct MyAnalysisDomain : public LLVMAnalysisDomainDefault {
+//     ...
+//     using jf_storage_t = CompactJumpFunctionStorage;
+//   };
+//
+// Analysis domains that do not declare jf_storage_t use JumpFunctions.
+struct CompactJumpFunctionStorage {};
+
 } // namespace psr
 
 #endif // PHASAR_PHASARLLVM_IFDSIDE_ANALYSISDOMAIN_H_
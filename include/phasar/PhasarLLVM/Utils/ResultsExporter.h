@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_UTILS_RESULTSEXPORTER_H_
+#define PHASAR_PHASARLLVM_UTILS_RESULTSEXPORTER_H_
+
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_os_ostream.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+#include "phasar/Utils/Logger.h"
+
+namespace llvm {
+class Instruction;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * The source location of an IR statement, see LLVMIRToSrc. Line and column
+ * are 0 if the IR does not have debug information.
+ */
+struct ExportedLocation {
+  std::string Id;
+  std::string Function;
+  std::string File;
+  unsigned Line;
+  unsigned Column;
+
+  explicit ExportedLocation(const llvm::Instruction *I);
+
+  /// Writes the location as attributes of the current JSON object.
+  void writeJSON(llvm::json::OStream &J) const;
+
+  /// Writes the location as the "locations" attribute of the current SARIF
+  /// result object.
+  void writeSARIF(llvm::json::OStream &J) const;
+};
+
+/// Returns S as a JSON string, replacing invalid UTF-8 sequences that may
+/// occur in e.g. the IR of string literals.
+llvm::json::Value toJSONString(std::string S);
+
+/// Writes the "tool" attribute of a SARIF run that reports data-flow facts.
+void writeSARIFTool(llvm::json::OStream &J);
+
+// the monotone framework's problems do not have a zero fact
+template <typename ProblemTy, typename D, typename = void>
+struct HasZeroValue : std::false_type {};
+template <typename ProblemTy, typename D>
+struct HasZeroValue<ProblemTy, D,
+                    std::void_t<decltype(std::declval<const ProblemTy &>()
+                                             .isZeroValue(std::declval<D>()))>>
+    : std::true_type {};
+
+/**
+ * Writes the results of a data-flow analysis in the given format, JSON or
+ * SARIF, to OS while walking them once. ForEachStatement(Handler) must call
+ * Handler(n, results) for every statement n, where results is a range of the
+ * (fact, value) pairs at n. The document is written incrementally, such that
+ * no copy of the results is held in memory; source locations are resolved
+ * per statement while it is written. Zero facts are not exported.
+ *
+ * The JSON document holds one entry per statement with the facts that hold
+ * at it and, for IDE analyses, their values. The SARIF log holds a single
+ * run with one result per fact and statement.
+ */
+template <typename ProblemTy, typename ForEachStatementFn>
+void exportResults(const ProblemTy &Problem,
+                   ForEachStatementFn ForEachStatement, IOFormat Format,
+                   std::ostream &OS) {
+  if (Format != IOFormat::JSON && Format != IOFormat::SARIF) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                  << "Cannot export results as '" << Format << "'");
+    return;
+  }
+  llvm::raw_os_ostream ROS(OS);
+  llvm::json::OStream J(ROS);
+  auto IsZeroValue = [&Problem](const auto &Fact) {
+    if constexpr (HasZeroValue<ProblemTy,
+                               std::decay_t<decltype(Fact)>>::value) {
+      return Problem.isZeroValue(Fact);
+    } else {
+      return false;
+    }
+  };
+  // the values of plain IFDS facts are not exported
+  auto WriteJSONFact = [&](const auto &Fact, const auto &Value) {
+    J.attribute("fact", toJSONString(Problem.DtoString(Fact)));
+    if constexpr (!std::is_same_v<std::decay_t<decltype(Value)>,
+                                  BinaryDomain>) {
+      J.attribute("value", toJSONString(Problem.LtoString(Value)));
+    }
+  };
+  auto GetSARIFMessage = [&](const auto &Fact, const auto &Value) {
+    std::string Message = "Fact: " + Problem.DtoString(Fact);
+    if constexpr (!std::is_same_v<std::decay_t<decltype(Value)>,
+                                  BinaryDomain>) {
+      Message += " | Value: " + Problem.LtoString(Value);
+    }
+    return Message;
+  };
+  auto WriteStatement = [&](const auto &Stmt, const auto &Results) {
+    static_assert(std::is_convertible_v<std::decay_t<decltype(Stmt)>,
+                                        const llvm::Instruction *>,
+                  "Only results at LLVM IR statements can be exported!");
+    bool HasFacts = false;
+    for (const auto &Result : Results) {
+      if (!IsZeroValue(Result.first)) {
+        HasFacts = true;
+        break;
+      }
+    }
+    if (!HasFacts) {
+      return;
+    }
+    ExportedLocation Location(Stmt);
+    if (Format == IOFormat::JSON) {
+      J.object([&] {
+        Location.writeJSON(J);
+        J.attribute("statement", toJSONString(Problem.NtoString(Stmt)));
+        J.attributeArray("facts", [&] {
+          for (const auto &Result : Results) {
+            if (!IsZeroValue(Result.first)) {
+              J.object([&] { WriteJSONFact(Result.first, Result.second); });
+            }
+          }
+        });
+      });
+      return;
+    }
+    for (const auto &Result : Results) {
+      if (IsZeroValue(Result.first)) {
+        continue;
+      }
+      auto Message = GetSARIFMessage(Result.first, Result.second);
+      J.object([&] {
+        J.attribute("ruleId", "data-flow-fact");
+        J.attribute("level", "note");
+        J.attributeObject("message", [&] {
+          J.attribute("text", toJSONString(std::move(Message)));
+        });
+        Location.writeSARIF(J);
+      });
+    }
+  };
+  if (Format == IOFormat::JSON) {
+    J.object([&] {
+      J.attributeArray("results",
+                       [&] { ForEachStatement(WriteStatement); });
+    });
+    return;
+  }
+  J.object([&] {
+    J.attribute("$schema", "https://json.schemastore.org/sarif-2.1.0.json");
+    J.attribute("version", "2.1.0");
+    J.attributeArray("runs", [&] {
+      J.object([&] {
+        writeSARIFTool(J);
+        J.attributeArray("results",
+                         [&] { ForEachStatement(WriteStatement); });
+      });
+    });
+  });
+}
+
+/**
+ * Exports the given solver results, see above.
+ */
+template <typename ProblemTy, typename N, typename D, typename L>
+void exportResults(const ProblemTy &Problem, const SolverResults<N, D, L> &SR,
+                   IOFormat Format, std::ostream &OS) {
+  exportResults(
+      Problem,
+      [&SR](const auto &Handler) {
+        SR.forEachStatement(
+            [&Handler](N Stmt, const ResultsView<D, L> &Results) {
+              Handler(Stmt, Results);
+            });
+      },
+      Format, OS);
+}
+
+/**
+ * Returns the facts a monotone framework solver has computed for a statement
+ * as the results exportResults() expects; the facts do not have values.
+ */
+template <typename ContainerTy>
+auto toExportedResults(const ContainerTy &Facts) {
+  std::vector<std::pair<std::decay_t<decltype(*Facts.begin())>, BinaryDomain>>
+      Results;
+  for (const auto &Fact : Facts) {
+    Results.emplace_back(Fact, BinaryDomain::BOTTOM);
+  }
+  return Results;
+}
+
+} // namespace psr
+
+#endif
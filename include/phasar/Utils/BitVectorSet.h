@@ -11,13 +11,25 @@
 #define PHASAR_UTILS_BITVECTORSET_H_
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
-
-#include "boost/bimap.hpp"
-#include "boost/bimap/unordered_set_of.hpp"
-
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/MathExtras.h"
 
 namespace psr {
 namespace internal {
@@ -47,204 +59,321 @@ inline bool isLess(const llvm::BitVector &Lhs, const llvm::BitVector &Rhs) {
 } // namespace internal
 
 /**
- * BitVectorSet implements a set that requires minimal space. Elements are
- * kept in a static map and the set itself only stores a vector of bits which
- * indicate whether elements are contained in the set.
+ * BitVectorSetIndexer assigns dense indices to the elements of BitVectorSets,
+ * such that a set only needs to store the indices of its elements. Each
+ * analysis may use its own indexer, such that the indices of unrelated
+ * analyses neither contend nor accumulate in a single map. Sets that are not
+ * given an indexer explicitly use the indexer installed for the current thread
+ * by a Scope, or a process-wide indexer if there is none. Indexers are
+ * thread-safe; indices are never released.
  *
- * @brief Implements a set that requires minimal space.
+ * @brief Maps the elements of BitVectorSets to dense indices.
  */
-template <typename T> class BitVectorSet {
+template <typename T> class BitVectorSetIndexer {
+public:
+  using IndexTy = unsigned;
+
+  /**
+   * Installs an indexer for the current thread for the lifetime of the scope.
+   */
+  class Scope {
+  public:
+    explicit Scope(std::shared_ptr<BitVectorSetIndexer> Indexer)
+        : Previous(std::exchange(Current, std::move(Indexer))) {}
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    ~Scope() { Current = std::move(Previous); }
+
+  private:
+    std::shared_ptr<BitVectorSetIndexer> Previous;
+  };
+
+  BitVectorSetIndexer() = default;
+  BitVectorSetIndexer(const BitVectorSetIndexer &) = delete;
+  BitVectorSetIndexer &operator=(const BitVectorSetIndexer &) = delete;
+  ~BitVectorSetIndexer() = default;
+
+  /// Returns the index of Value; if Value has no index yet, it is assigned the
+  /// next free one.
+  IndexTy getOrInsertIndex(const T &Value) {
+    {
+      std::shared_lock<std::shared_mutex> Lock(Mutex);
+      if (auto Search = Indices.find(Value); Search != Indices.end()) {
+        return Search->second;
+      }
+    }
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    auto [It, Inserted] =
+        Indices.try_emplace(Value, static_cast<IndexTy>(Values.size()));
+    if (Inserted) {
+      // the nodes of an unordered_map are stable
+      Values.push_back(&It->first);
+    }
+    return It->second;
+  }
+
+  /// Returns the index of Value, or std::nullopt if Value has none.
+  [[nodiscard]] std::optional<IndexTy> findIndex(const T &Value) const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    if (auto Search = Indices.find(Value); Search != Indices.end()) {
+      return Search->second;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] const T &getValue(IndexTy Index) const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    assert(Index < Values.size() && "Unknown index!");
+    return *Values[Index];
+  }
+
+  /// Returns the number of indexed values.
+  [[nodiscard]] size_t size() const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    return Values.size();
+  }
+
+  /// Returns the process-wide indexer.
+  static const std::shared_ptr<BitVectorSetIndexer> &getGlobal() {
+    static const auto Global = std::make_shared<BitVectorSetIndexer>();
+    return Global;
+  }
+
+  /// Returns the indexer installed for the current thread, or the
+  /// process-wide indexer if there is none.
+  static const std::shared_ptr<BitVectorSetIndexer> &getCurrent() {
+    return Current ? Current : getGlobal();
+  }
+
 private:
+  inline static thread_local std::shared_ptr<BitVectorSetIndexer> Current;
+
+  mutable std::shared_mutex Mutex;
   // Using boost::hash<T> causes ambiguity for hash_value():
   //  -<llvm/ADT/Hashing.h>
   //  -<boost/functional/hash/extensions.hpp>
   //  -<boost/graph/adjacency_list.hpp>
-  using bimap_t = boost::bimap<boost::bimaps::unordered_set_of<T, std::hash<T>>,
-                               boost::bimaps::unordered_set_of<size_t>>;
-  inline static bimap_t Position;
-  llvm::BitVector Bits;
+  std::unordered_map<T, IndexTy, std::hash<T>> Indices;
+  std::vector<const T *> Values;
+};
 
-  template <typename D> class BitVectorSetIterator {
-    llvm::BitVector Bits;
+/**
+ * BitVectorSet implements a set that requires minimal space. Elements are
+ * mapped to dense indices by a BitVectorSetIndexer and the set itself only
+ * stores the indices of its elements: sets with few elements of high indices
+ * keep them in a sorted vector, all other sets keep a vector of bits that
+ * indicate whether elements are contained in the set. The bulk set operations
+ * work on whole machine words of these bits.
+ *
+ * A set is bound to an indexer once it contains elements. Combining sets that
+ * are bound to different indexers is supported, but requires re-indexing the
+ * elements of one of them.
+ *
+ * @brief Implements a set that requires minimal space.
+ */
+template <typename T> class BitVectorSet {
+public:
+  using IndexerTy = BitVectorSetIndexer<T>;
+  using IndexTy = typename IndexerTy::IndexTy;
 
+  class const_iterator {
   public:
     using iterator_category = std::forward_iterator_tag;
-    using value_type = D;
+    using value_type = T;
     using difference_type = std::ptrdiff_t;
-    using pointer = D *;
-    using reference = D &;
-    BitVectorSetIterator(D ptr = nullptr) : pos_ptr(ptr) {}
+    using pointer = const T *;
+    using reference = const T &;
 
-    BitVectorSetIterator<D> &operator=(D *Ptr) {
-      pos_ptr = Ptr;
-      return *this;
-    }
-
-    void setBits(const llvm::BitVector &OtherBits) { Bits = OtherBits; }
+    const_iterator() = default;
 
-    bool operator==(const BitVectorSetIterator<D> &OtherIterator) const {
-      return pos_ptr == OtherIterator.getPtr();
+    reference operator*() const {
+      return Set->Indexer->getValue(Set->indexAt(Pos));
     }
 
-    bool operator!=(const BitVectorSetIterator<D> &OtherIterator) const {
-      return !(*this == OtherIterator);
-    }
+    pointer operator->() const { return &**this; }
 
-    BitVectorSetIterator<D> &operator+=(const difference_type &Movement) {
-      for (difference_type i = 0; i < Movement; i++) {
-        pos_ptr++;
-      }
+    const_iterator &operator++() {
+      Pos = Set->nextPos(Pos + 1);
       return *this;
     }
 
-    BitVectorSetIterator<D> &operator++() {
-      do {
-        int NextIdx = Bits.find_next(pos_ptr->first);
-
-        if (NextIdx <= static_cast<int>(pos_ptr->first)) {
-          pos_ptr = Position.right.find(Bits.size());
-          break;
-        }
-
-        pos_ptr = Position.right.find(NextIdx);
-
-        assert(pos_ptr->first < Bits.size() &&
-               "pos_ptr->first index into BitVector out of range");
-      } while (!Bits[pos_ptr->first]);
-
-      return *this;
-    }
-
-    BitVectorSetIterator<D> operator++(int) {
+    const_iterator operator++(int) {
       auto Temp(*this);
       ++*this;
       return Temp;
     }
 
-    BitVectorSetIterator<D> operator+(const difference_type &Movement) {
-      auto OldPtr = pos_ptr;
-      for (difference_type i = 0; i < Movement; i++) {
-        pos_ptr++;
+    const_iterator &operator+=(difference_type Movement) {
+      for (difference_type I = 0; I < Movement; ++I) {
+        ++*this;
       }
-      auto Temp(*this);
-      pos_ptr = OldPtr;
-      return Temp;
+      return *this;
     }
 
-    difference_type operator-(const BitVectorSetIterator<D> &OtherIterator) {
-      return std::distance(OtherIterator.getPtr(), this->getPtr());
+    bool operator==(const const_iterator &Other) const {
+      return Set == Other.Set && Pos == Other.Pos;
     }
 
-    // T& operator*(){return pos_ptr->second;}
-
-    const T &operator*() const { return pos_ptr->second; }
-
-    D *operator->() { return pos_ptr; }
-
-    D getPtr() const { return pos_ptr; }
-
-    // const D* getConstPtr()const{return pos_ptr;}
-
-    // T getPos() {return pos_ptr->first;}
+    bool operator!=(const const_iterator &Other) const {
+      return !(*this == Other);
+    }
 
-    // T getVal() {return pos_ptr->second;}
+  private:
+    friend class BitVectorSet;
 
-    [[nodiscard]] llvm::BitVector getBits() const { return Bits; }
+    const_iterator(const BitVectorSet *Set, size_t Pos) : Set(Set), Pos(Pos) {}
 
-  private:
-    D pos_ptr;
+    const BitVectorSet *Set = nullptr;
+    // the position in Indices if the set is sparse, the index otherwise
+    size_t Pos = 0;
   };
 
-  using iterator = BitVectorSetIterator<typename bimap_t::right_iterator>;
-  using const_iterator =
-      BitVectorSetIterator<typename bimap_t::right_const_iterator>;
+  using iterator = const_iterator;
+  using value_type = T;
+  using size_type = size_t;
 
-public:
   BitVectorSet() = default;
 
-  explicit BitVectorSet(size_t Count) : Bits(Count, false) {}
+  explicit BitVectorSet(std::shared_ptr<IndexerTy> Indexer)
+      : Indexer(std::move(Indexer)) {}
+
+  explicit BitVectorSet(size_t Count) { reserve(Count); }
 
-  BitVectorSet(std::initializer_list<T> IList) {
+  BitVectorSet(std::initializer_list<T> IList,
+               std::shared_ptr<IndexerTy> Indexer = nullptr)
+      : Indexer(std::move(Indexer)) {
     insert(IList.begin(), IList.end());
   }
 
-  template <typename InputIt> BitVectorSet(InputIt First, InputIt Last) {
+  template <typename InputIt>
+  BitVectorSet(InputIt First, InputIt Last,
+               std::shared_ptr<IndexerTy> Indexer = nullptr)
+      : Indexer(std::move(Indexer)) {
     insert(First, Last);
   }
 
+  /// Returns the indexer of the set; null if the set has never contained any
+  /// elements and has not been given an indexer.
+  [[nodiscard]] const std::shared_ptr<IndexerTy> &getIndexer() const {
+    return Indexer;
+  }
+
   BitVectorSet<T> setUnion(const BitVectorSet<T> &Other) const {
-    size_t MaxSize = std::max(Bits.size(), Other.Bits.size());
-    BitVectorSet<T> Res(MaxSize);
-    // temp variable necessary because return type of |= is not const
-    llvm::BitVector Temp = Bits;
-    Res.Bits = Temp |= Other.Bits;
+    BitVectorSet<T> Res(*this);
+    Res.insert(Other);
     return Res;
   }
 
   BitVectorSet<T> setIntersect(const BitVectorSet<T> &Other) const {
-    size_t MaxSize = std::max(Bits.size(), Other.Bits.size());
-    BitVectorSet<T> Res(MaxSize);
-    // temp variable necessary because return type of &= is not const
-    llvm::BitVector Temp = Bits;
-    Res.Bits = Temp &= Other.Bits;
+    BitVectorSet<T> Tmp;
+    const auto &O = withIndexerOf(Other, Tmp);
+    BitVectorSet<T> Res(Indexer ? Indexer : O.Indexer);
+    if (empty() || O.empty()) {
+      return Res;
+    }
+    if (!Dense || !O.Dense) {
+      const auto &Sparse = Dense ? O : *this;
+      const auto &Rest = Dense ? *this : O;
+      for (IndexTy Idx : Sparse.Indices) {
+        if (Rest.test(Idx)) {
+          Res.Indices.push_back(Idx);
+        }
+      }
+      return Res;
+    }
+    Res.Dense = true;
+    Res.Words.resize(std::min(Words.size(), O.Words.size()));
+    for (size_t I = 0, E = Res.Words.size(); I < E; ++I) {
+      Res.Words[I] = Words[I] & O.Words[I];
+    }
+    Res.normalize();
+    return Res;
+  }
+
+  BitVectorSet<T> setDifference(const BitVectorSet<T> &Other) const {
+    BitVectorSet<T> Res(*this);
+    Res.erase(Other);
     return Res;
   }
 
   bool includes(const BitVectorSet<T> &Other) const {
-    // check if Other contains 1's at positions where this does not
-    // Other is longer
-    if (Bits.size() < Other.Bits.size()) {
-      size_t idx = 0;
-      for (; idx < Bits.size(); ++idx) {
-        if (Other.Bits[idx] && !Bits[idx]) {
-          return false;
-        }
-      }
-      // Check if Other's additional bits are non-zero
-      for (; idx < Other.Bits.size(); ++idx) {
-        if (Other.Bits[idx]) {
-          return false;
-        }
-      }
-      // additional zeros are fine
+    BitVectorSet<T> Tmp;
+    const auto &O = withIndexerOf(Other, Tmp);
+    if (O.empty()) {
       return true;
-    } else {
-      // this is longer or they have the same length
-      // check if Other contains 1's at positions where this does not
-      for (size_t idx = 0; idx < Other.Bits.size(); ++idx) {
-        if (Other.Bits[idx] && !Bits[idx]) {
+    }
+    if (!O.Dense) {
+      return std::all_of(O.Indices.begin(), O.Indices.end(),
+                         [this](IndexTy Idx) { return test(Idx); });
+    }
+    if (!Dense) {
+      if (O.size() > size()) {
+        return false;
+      }
+      for (size_t Pos = O.nextPos(0), End = O.endPos(); Pos != End;
+           Pos = O.nextPos(Pos + 1)) {
+        if (!test(Pos)) {
           return false;
         }
       }
       return true;
     }
+    // check if Other contains 1's at positions where this does not
+    uint64_t Missing = 0;
+    const size_t Common = std::min(Words.size(), O.Words.size());
+    for (size_t I = 0; I < Common; ++I) {
+      Missing |= O.Words[I] & ~Words[I];
+    }
+    for (size_t I = Common; I < O.Words.size(); ++I) {
+      Missing |= O.Words[I];
+    }
+    return Missing == 0;
   }
 
   void insert(const T &Data) {
-    auto Search = Position.left.find(Data);
-    // Data already known
-    if (Search != Position.left.end()) {
-      if (Bits.size() <= Search->second) {
-        Bits.resize(Search->second + 1);
-      }
-      Bits[Search->second] = true;
-    } else {
-      // Data unknown
-      size_t Idx = Position.left.size();
-      Position.left.insert(std::make_pair(Data, Position.left.size()));
-      if (Bits.size() <= Position.left.size()) {
-        Bits.resize(Position.left.size());
-      }
-      Bits[Idx] = true;
+    if (!Indexer) {
+      Indexer = IndexerTy::getCurrent();
     }
+    set(Indexer->getOrInsertIndex(Data));
   }
 
   void insert(const BitVectorSet<T> &Other) {
-    if (Other.Bits.size() > Bits.size()) {
-      Bits.resize(Other.Bits.size());
+    if (empty()) {
+      if (!Indexer || Other.Indexer == Indexer || Other.empty()) {
+        auto Own = Indexer;
+        *this = Other;
+        if (!Indexer) {
+          Indexer = std::move(Own);
+        }
+        return;
+      }
+    }
+    BitVectorSet<T> Tmp;
+    const auto &O = withIndexerOf(Other, Tmp);
+    if (O.empty()) {
+      return;
+    }
+    if (!Dense && !O.Dense) {
+      llvm::SmallVector<IndexTy, 4> Merged;
+      Merged.reserve(Indices.size() + O.Indices.size());
+      std::set_union(Indices.begin(), Indices.end(), O.Indices.begin(),
+                     O.Indices.end(), std::back_inserter(Merged));
+      Indices = std::move(Merged);
+      normalize();
+      return;
+    }
+    makeDense();
+    if (!O.Dense) {
+      for (IndexTy Idx : O.Indices) {
+        set(Idx);
+      }
+      return;
+    }
+    if (Words.size() < O.Words.size()) {
+      Words.resize(O.Words.size(), 0);
     }
-    for (size_t idx = 0; idx < Other.Bits.size(); ++idx) {
-      Bits[idx] = (Bits[idx] || Other.Bits[idx]);
+    for (size_t I = 0, E = O.Words.size(); I < E; ++I) {
+      Words[I] |= O.Words[I];
     }
   }
 
@@ -256,93 +385,309 @@ public:
   }
 
   void erase(const T &Data) noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (!(Bits.size() < Search->second - 1)) {
-        Bits[Search->second] = false;
+    if (!Indexer) {
+      return;
+    }
+    if (auto Idx = Indexer->findIndex(Data)) {
+      reset(*Idx);
+    }
+  }
+
+  /// Removes all elements of Other from the set.
+  void erase(const BitVectorSet<T> &Other) {
+    BitVectorSet<T> Tmp;
+    const auto &O = withIndexerOf(Other, Tmp);
+    if (empty() || O.empty()) {
+      return;
+    }
+    if (!Dense) {
+      Indices.erase(std::remove_if(Indices.begin(), Indices.end(),
+                                   [&O](IndexTy Idx) { return O.test(Idx); }),
+                    Indices.end());
+      return;
+    }
+    if (!O.Dense) {
+      for (IndexTy Idx : O.Indices) {
+        reset(Idx);
+      }
+    } else {
+      for (size_t I = 0, E = std::min(Words.size(), O.Words.size()); I < E;
+           ++I) {
+        Words[I] &= ~O.Words[I];
       }
     }
+    normalize();
   }
 
-  void clear() noexcept { Bits.reset(); }
+  void clear() noexcept {
+    Dense = false;
+    Indices.clear();
+    Words.clear();
+  }
 
-  [[nodiscard]] bool empty() const noexcept { return Bits.none(); }
+  [[nodiscard]] bool empty() const noexcept {
+    if (!Dense) {
+      return Indices.empty();
+    }
+    return std::all_of(Words.begin(), Words.end(),
+                       [](uint64_t Word) { return Word == 0; });
+  }
 
-  void reserve(size_t NewCap) { Bits.reserve(NewCap); }
+  void reserve(size_t NewCap) { Indices.reserve(NewCap); }
 
   [[nodiscard]] bool find(const T &Data) const noexcept { return count(Data); }
 
   [[nodiscard]] size_t count(const T &Data) const noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (Bits.size() > Search->second) {
-        return Bits[Search->second];
-      }
+    if (!Indexer) {
+      return 0;
     }
-    return 0;
+    auto Idx = Indexer->findIndex(Data);
+    return Idx && test(*Idx);
   }
 
-  [[nodiscard]] size_t size() const noexcept { return Bits.count(); }
+  [[nodiscard]] size_t size() const noexcept {
+    if (!Dense) {
+      return Indices.size();
+    }
+    size_t Size = 0;
+    for (uint64_t Word : Words) {
+      Size += llvm::countPopulation(Word);
+    }
+    return Size;
+  }
 
   friend bool operator==(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
-    return Lhs.Bits == Rhs.Bits;
+    BitVectorSet Tmp;
+    const auto &R = Lhs.withIndexerOf(Rhs, Tmp);
+    if (Lhs.Dense != R.Dense) {
+      return Lhs.size() == R.size() && Lhs.includes(R);
+    }
+    if (!Lhs.Dense) {
+      return Lhs.Indices == R.Indices;
+    }
+    return compareWords(Lhs.Words, R.Words) == 0;
   }
 
   friend bool operator!=(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
     return !(Lhs == Rhs);
   }
 
+  /// Orders sets like their bit vectors, see internal::isLess(). Sets that
+  /// use different indexers are compared after re-indexing the elements of
+  /// Rhs.
   friend bool operator<(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
-    return internal::isLess(Lhs.Bits, Rhs.Bits);
+    BitVectorSet Tmp;
+    const auto &R = Lhs.withIndexerOf(Rhs, Tmp);
+    if (!Lhs.Dense && !R.Dense) {
+      // the set that contains the highest element not contained in the other
+      // one is greater
+      auto L = Lhs.Indices.rbegin();
+      auto LEnd = Lhs.Indices.rend();
+      auto RIt = R.Indices.rbegin();
+      auto REnd = R.Indices.rend();
+      for (; L != LEnd && RIt != REnd; ++L, ++RIt) {
+        if (*L != *RIt) {
+          return *L < *RIt;
+        }
+      }
+      return L == LEnd && RIt != REnd;
+    }
+    return compareWords(Lhs.toWords(), R.toWords()) < 0;
   }
 
   friend std::ostream &operator<<(std::ostream &OS, const BitVectorSet &B) {
     OS << '<';
-    size_t Idx = 0;
-    for (auto &Position : B.Position.left) {
-      if (Position.second < B.Bits.size() && B.Bits[Position.second]) {
-        ++Idx;
-        OS << Position.first;
-        if (Idx < B.size()) {
-          OS << ", ";
-        }
+    bool First = true;
+    for (const auto &Elem : B) {
+      if (!First) {
+        OS << ", ";
       }
+      First = false;
+      OS << Elem;
     }
     OS << '>';
     return OS;
   }
 
-  [[nodiscard]] iterator begin() {
-    int Index = Bits.find_first();
-    if (Index == -1) {
-      Index = Bits.size();
+  [[nodiscard]] const_iterator begin() const {
+    return const_iterator(this, nextPos(0));
+  }
+
+  [[nodiscard]] const_iterator end() const {
+    return const_iterator(this, endPos());
+  }
+
+private:
+  static constexpr size_t WordBits = 64;
+
+  static size_t wordsFor(size_t NumBits) {
+    return (NumBits + WordBits - 1) / WordBits;
+  }
+
+  // A set is kept sparse as long as its indices need less space than the
+  // bits up to its highest index.
+  static bool preferDense(size_t NumElements, IndexTy MaxIndex) {
+    return wordsFor(size_t(MaxIndex) + 1) * sizeof(uint64_t) <=
+           NumElements * sizeof(IndexTy);
+  }
+
+  // Compares the bit vectors given by Lhs and Rhs starting at the highest
+  // bit; the vector with the highest bit that is not set in the other one is
+  // the greater one.
+  static int compareWords(llvm::ArrayRef<uint64_t> Lhs,
+                          llvm::ArrayRef<uint64_t> Rhs) {
+    for (size_t I = std::max(Lhs.size(), Rhs.size()); I-- > 0;) {
+      uint64_t L = I < Lhs.size() ? Lhs[I] : 0;
+      uint64_t R = I < Rhs.size() ? Rhs[I] : 0;
+      if (L != R) {
+        unsigned Highest = WordBits - 1 - llvm::countLeadingZeros(L ^ R);
+        return (R >> Highest) & 1U ? -1 : 1;
+      }
     }
-    iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
+    return 0;
   }
 
-  [[nodiscard]] iterator end() {
-    iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
+  // Returns Other if it can be combined with this set directly, otherwise a
+  // copy of Other that uses the indexer of this set, which is stored in Tmp.
+  const BitVectorSet &withIndexerOf(const BitVectorSet &Other,
+                                    BitVectorSet &Tmp) const {
+    if (!Indexer || !Other.Indexer || Indexer == Other.Indexer ||
+        Other.empty()) {
+      return Other;
+    }
+    Tmp = BitVectorSet(Indexer);
+    Tmp.insert(Other.begin(), Other.end());
+    return Tmp;
   }
 
-  [[nodiscard]] const_iterator begin() const {
-    int Index = Bits.find_first();
-    if (Index == -1) {
-      Index = Bits.size();
+  [[nodiscard]] bool test(IndexTy Idx) const {
+    if (!Dense) {
+      return std::binary_search(Indices.begin(), Indices.end(), Idx);
     }
-    const_iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
+    return Idx / WordBits < Words.size() &&
+           ((Words[Idx / WordBits] >> (Idx % WordBits)) & 1U);
   }
 
-  [[nodiscard]] const_iterator end() const {
-    const_iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
+  void set(IndexTy Idx) {
+    if (Dense) {
+      if (Idx / WordBits >= Words.size()) {
+        Words.resize(Idx / WordBits + 1, 0);
+      }
+      Words[Idx / WordBits] |= uint64_t(1) << (Idx % WordBits);
+      return;
+    }
+    auto Pos = std::lower_bound(Indices.begin(), Indices.end(), Idx);
+    if (Pos != Indices.end() && *Pos == Idx) {
+      return;
+    }
+    Indices.insert(Pos, Idx);
+    if (preferDense(Indices.size(), Indices.back())) {
+      makeDense();
+    }
+  }
+
+  void reset(IndexTy Idx) {
+    if (Dense) {
+      if (Idx / WordBits < Words.size()) {
+        Words[Idx / WordBits] &= ~(uint64_t(1) << (Idx % WordBits));
+      }
+      return;
+    }
+    auto Pos = std::lower_bound(Indices.begin(), Indices.end(), Idx);
+    if (Pos != Indices.end() && *Pos == Idx) {
+      Indices.erase(Pos);
+    }
   }
+
+  void makeDense() {
+    if (Dense) {
+      return;
+    }
+    Words.assign(Indices.empty() ? 0 : wordsFor(size_t(Indices.back()) + 1),
+                 0);
+    for (IndexTy Idx : Indices) {
+      Words[Idx / WordBits] |= uint64_t(1) << (Idx % WordBits);
+    }
+    Indices.clear();
+    Dense = true;
+  }
+
+  // Drops trailing zero words and chooses the representation that needs
+  // less space.
+  void normalize() {
+    if (!Dense) {
+      if (!Indices.empty() && preferDense(Indices.size(), Indices.back())) {
+        makeDense();
+      }
+      return;
+    }
+    while (!Words.empty() && Words.back() == 0) {
+      Words.pop_back();
+    }
+    if (Words.empty()) {
+      Dense = false;
+      return;
+    }
+    auto MaxIndex = static_cast<IndexTy>(
+        Words.size() * WordBits - 1 - llvm::countLeadingZeros(Words.back()));
+    if (preferDense(size(), MaxIndex)) {
+      return;
+    }
+    for (size_t Pos = nextPos(0), End = endPos(); Pos != End;
+         Pos = nextPos(Pos + 1)) {
+      Indices.push_back(static_cast<IndexTy>(Pos));
+    }
+    Words.clear();
+    Dense = false;
+  }
+
+  [[nodiscard]] llvm::SmallVector<uint64_t, 4> toWords() const {
+    if (Dense) {
+      return llvm::SmallVector<uint64_t, 4>(Words.begin(), Words.end());
+    }
+    llvm::SmallVector<uint64_t, 4> Res(
+        Indices.empty() ? 0 : wordsFor(size_t(Indices.back()) + 1), 0);
+    for (IndexTy Idx : Indices) {
+      Res[Idx / WordBits] |= uint64_t(1) << (Idx % WordBits);
+    }
+    return Res;
+  }
+
+  // Iteration: positions are indices into Indices for sparse sets and the
+  // indices of the elements for dense ones.
+  [[nodiscard]] size_t endPos() const {
+    return Dense ? Words.size() * WordBits : Indices.size();
+  }
+
+  [[nodiscard]] size_t nextPos(size_t From) const {
+    if (!Dense) {
+      return std::min(From, Indices.size());
+    }
+    size_t WordIdx = From / WordBits;
+    if (WordIdx >= Words.size()) {
+      return endPos();
+    }
+    uint64_t Word = Words[WordIdx] & (~uint64_t(0) << (From % WordBits));
+    while (Word == 0) {
+      if (++WordIdx == Words.size()) {
+        return endPos();
+      }
+      Word = Words[WordIdx];
+    }
+    return WordIdx * WordBits + llvm::countTrailingZeros(Word);
+  }
+
+  [[nodiscard]] IndexTy indexAt(size_t Pos) const {
+    return Dense ? static_cast<IndexTy>(Pos) : Indices[Pos];
+  }
+
+  // null until the set contains elements or is given an indexer explicitly
+  std::shared_ptr<IndexerTy> Indexer;
+  bool Dense = false;
+  // the indices of the elements in ascending order, if the set is sparse
+  llvm::SmallVector<IndexTy, 4> Indices;
+  // the bits of the elements, if the set is dense
+  llvm::SmallVector<uint64_t, 1> Words;
 };
 
 } // namespace psr
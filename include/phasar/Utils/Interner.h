@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_INTERNER_H_
+#define PHASAR_UTILS_INTERNER_H_
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace psr {
+
+// Interner maps values to dense integer IDs in the order of their first
+// insertion, i.e. the n-th distinct value is mapped to the ID n - 1. The IDs
+// can be used as indices into flat vectors or bit-sets, or be combined into
+// compact keys (see combineIds()), and can be translated back to the
+// original values in constant time.
+template <typename T, typename IdT = uint32_t> class Interner {
+  static_assert(std::is_unsigned_v<IdT>, "IDs must be unsigned integers");
+
+public:
+  using value_type = T;
+  using id_type = IdT;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  Interner() = default;
+
+  explicit Interner(size_t InitialSize) { reserve(InitialSize); }
+
+  // Returns the ID of Value; Value is assigned a new ID if it has not been
+  // interned before.
+  IdT getOrInsert(const T &Value) {
+    auto [It, Inserted] = Ids.try_emplace(Value, IdT(Values.size()));
+    if (Inserted) {
+      assert(Values.size() < std::numeric_limits<IdT>::max() &&
+             "Too many values for the ID type!");
+      Values.push_back(Value);
+    }
+    return It->second;
+  }
+
+  // Returns the ID of Value if it has been interned before.
+  [[nodiscard]] std::optional<IdT> lookup(const T &Value) const {
+    if (auto Search = Ids.find(Value); Search != Ids.end()) {
+      return Search->second;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] bool contains(const T &Value) const {
+    return Ids.find(Value) != Ids.end();
+  }
+
+  // Returns the value that has been assigned the given ID.
+  [[nodiscard]] const T &get(IdT Id) const {
+    assert(Id < Values.size() && "Unknown ID!");
+    return Values[Id];
+  }
+
+  [[nodiscard]] const T &operator[](IdT Id) const { return get(Id); }
+
+  [[nodiscard]] size_t size() const { return Values.size(); }
+
+  [[nodiscard]] bool empty() const { return Values.empty(); }
+
+  void reserve(size_t Size) {
+    Values.reserve(Size);
+    Ids.reserve(Size);
+  }
+
+  void clear() {
+    Values.clear();
+    Ids.clear();
+  }
+
+  // Iterates over all interned values in the order of their IDs.
+  [[nodiscard]] const_iterator begin() const { return Values.begin(); }
+  [[nodiscard]] const_iterator end() const { return Values.end(); }
+
+private:
+  // pointers, e.g. to LLVM IR, are looked up using llvm::DenseMap
+  using MapTy = std::conditional_t<std::is_pointer_v<T>, llvm::DenseMap<T, IdT>,
+                                   std::unordered_map<T, IdT>>;
+
+  MapTy Ids;
+  std::vector<T> Values;
+};
+
+// Combines two 32-bit IDs into a single 64-bit key, e.g. to key a flat map on
+// a (statement, fact) pair.
+[[nodiscard]] inline uint64_t combineIds(uint32_t Hi, uint32_t Lo) {
+  return (uint64_t(Hi) << 32U) | Lo;
+}
+
+[[nodiscard]] inline uint32_t highId(uint64_t Key) { return Key >> 32U; }
+
+[[nodiscard]] inline uint32_t lowId(uint64_t Key) { return uint32_t(Key); }
+
+} // namespace psr
+
+#endif
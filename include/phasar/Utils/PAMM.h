@@ -19,6 +19,7 @@
 
 #include <chrono>        // high_resolution_clock::time_point, milliseconds
 #include <iosfwd>        // ostream
+#include <mutex>         // mutex
 #include <set>           // set
 #include <string>        // string
 #include <unordered_map> // unordered_map
@@ -64,6 +65,9 @@ private:
   std::unordered_map<std::string,
                      std::unordered_map<std::string, unsigned long>>
       Histogram;
+  // counters and histograms are updated concurrently by the IDE solver's
+  // worker threads
+  std::mutex CounterMutex;
 
 public:
   /// PAMM is used as singleton.
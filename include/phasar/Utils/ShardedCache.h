@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SHARDEDCACHE_H_
+#define PHASAR_UTILS_SHARDEDCACHE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace psr {
+
+// ShardedCache memoizes values keyed by small, e.g. compressed integer, keys
+// in open-addressing hash maps. Its entries are distributed over a fixed
+// number of independently locked shards, such that the cache can be shared
+// by multiple threads that rarely contend if they look up different keys.
+// Locks are only taken once the cache has been made concurrent. The cache
+// counts its hits and misses. Entries are never removed.
+template <typename KeyT, typename ValueT, size_t NumShards = 16>
+class ShardedCache {
+  static_assert(NumShards > 0, "A cache needs at least one shard!");
+
+public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+
+  ShardedCache() = default;
+  ShardedCache(const ShardedCache &) = delete;
+  ShardedCache &operator=(const ShardedCache &) = delete;
+  ShardedCache(ShardedCache &&) = delete;
+  ShardedCache &operator=(ShardedCache &&) = delete;
+  ~ShardedCache() = default;
+
+  // Makes all operations thread-safe; they must not run concurrently with
+  // this call.
+  void setConcurrent(bool Set = true) { Concurrent = Set; }
+
+  // Returns the value cached for Key; if there is none, Construct() is
+  // called, outside of any lock, and its result is cached. If another thread
+  // has cached a value for Key in the meantime, that value is returned
+  // instead.
+  template <typename ConstructFn>
+  ValueT getOrInsert(const KeyT &Key, ConstructFn Construct) {
+    auto &S = getShard(Key);
+    {
+      auto Lock = lockIfConcurrent(S.Mutex);
+      if (auto Search = S.Map.find(Key); Search != S.Map.end()) {
+        Hits.fetch_add(1, std::memory_order_relaxed);
+        return Search->second;
+      }
+    }
+    Misses.fetch_add(1, std::memory_order_relaxed);
+    ValueT Value = Construct();
+    auto Lock = lockIfConcurrent(S.Mutex);
+    return S.Map.try_emplace(Key, std::move(Value)).first->second;
+  }
+
+  // Returns whether a value is cached for Key, not counted as hit or miss.
+  [[nodiscard]] bool contains(const KeyT &Key) {
+    auto &S = getShard(Key);
+    auto Lock = lockIfConcurrent(S.Mutex);
+    return S.Map.count(Key);
+  }
+
+  // Returns the number of cached values.
+  [[nodiscard]] size_t size() {
+    size_t Size = 0;
+    for (auto &S : Shards) {
+      auto Lock = lockIfConcurrent(S.Mutex);
+      Size += S.Map.size();
+    }
+    return Size;
+  }
+
+  [[nodiscard]] size_t getHits() const { return Hits; }
+
+  [[nodiscard]] size_t getMisses() const { return Misses; }
+
+  // Resets the hit and miss counts, but keeps the cached values.
+  void resetStatistics() {
+    Hits = 0;
+    Misses = 0;
+  }
+
+private:
+  struct Shard {
+    std::mutex Mutex;
+    llvm::DenseMap<KeyT, ValueT> Map;
+  };
+
+  Shard &getShard(const KeyT &Key) {
+    if constexpr (NumShards == 1) {
+      return Shards[0];
+    } else {
+      // Fibonacci hashing, such that the shard depends on all bits of the
+      // hash
+      const uint64_t Hash = llvm::DenseMapInfo<KeyT>::getHashValue(Key);
+      return Shards[((Hash * 0x9E3779B97F4A7C15ULL) >> 32U) % NumShards];
+    }
+  }
+
+  std::unique_lock<std::mutex> lockIfConcurrent(std::mutex &Mtx) {
+    return Concurrent ? std::unique_lock<std::mutex>(Mtx)
+                      : std::unique_lock<std::mutex>();
+  }
+
+  std::array<Shard, NumShards> Shards;
+  std::atomic<size_t> Hits = 0;
+  std::atomic<size_t> Misses = 0;
+  bool Concurrent = false;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SMALLFLATSET_H_
+#define PHASAR_UTILS_SMALLFLATSET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "llvm/ADT/SmallVector.h"
+
+namespace psr {
+
+// SmallFlatSet is an ordered set that keeps its elements in a sorted vector
+// with inline storage for N elements, such that small sets, e.g. the facts a
+// flow function generates from a single source fact, neither allocate nor
+// chase pointers. Larger sets spill to the heap and remain sorted, hence
+// lookups are logarithmic and insertions linear in the size of the set. The
+// elements are iterated in the same order as in a std::set with the same
+// comparator. Insertions and erasures invalidate all iterators.
+template <typename T, unsigned N = 4, typename Compare = std::less<T>>
+class SmallFlatSet {
+  using storage_type = llvm::SmallVector<T, N>;
+
+public:
+  using key_type = T;
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using reference = const T &;
+  using const_reference = const T &;
+  using iterator = typename storage_type::const_iterator;
+  using const_iterator = typename storage_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  SmallFlatSet() = default;
+
+  SmallFlatSet(std::initializer_list<T> Init) {
+    insert(Init.begin(), Init.end());
+  }
+
+  template <typename InputIt> SmallFlatSet(InputIt First, InputIt Last) {
+    insert(First, Last);
+  }
+
+  std::pair<iterator, bool> insert(const T &Value) {
+    auto Pos = lowerBound(Value);
+    if (Pos != Elements.end() && !Comp(Value, *Pos)) {
+      return {Pos, false};
+    }
+    // SmallVector only inserts at mutable positions
+    auto MutPos = Elements.begin() + (Pos - Elements.begin());
+    return {Elements.insert(MutPos, Value), true};
+  }
+
+  std::pair<iterator, bool> insert(T &&Value) {
+    auto Pos = lowerBound(Value);
+    if (Pos != Elements.end() && !Comp(Value, *Pos)) {
+      return {Pos, false};
+    }
+    // SmallVector only inserts at mutable positions
+    auto MutPos = Elements.begin() + (Pos - Elements.begin());
+    return {Elements.insert(MutPos, std::move(Value)), true};
+  }
+
+  // The hint is ignored, it only makes the set usable with std::inserter.
+  iterator insert(const_iterator, const T &Value) {
+    return insert(Value).first;
+  }
+
+  template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    const size_t OldSize = Elements.size();
+    Elements.append(First, Last);
+    if (Elements.size() == OldSize) {
+      return;
+    }
+    std::sort(Elements.begin(), Elements.end(), Comp);
+    Elements.erase(std::unique(Elements.begin(), Elements.end(),
+                               [this](const T &Lhs, const T &Rhs) {
+                                 return !Comp(Lhs, Rhs) && !Comp(Rhs, Lhs);
+                               }),
+                   Elements.end());
+  }
+
+  void insert(std::initializer_list<T> Init) {
+    insert(Init.begin(), Init.end());
+  }
+
+  template <typename... ArgsT>
+  std::pair<iterator, bool> emplace(ArgsT &&... Args) {
+    return insert(T(std::forward<ArgsT>(Args)...));
+  }
+
+  size_type erase(const T &Value) {
+    auto Search = find(Value);
+    if (Search == end()) {
+      return 0;
+    }
+    Elements.erase(Search);
+    return 1;
+  }
+
+  iterator erase(const_iterator Pos) { return Elements.erase(Pos); }
+
+  [[nodiscard]] iterator find(const T &Value) const {
+    auto Pos = lowerBound(Value);
+    return Pos != Elements.end() && !Comp(Value, *Pos) ? Pos : end();
+  }
+
+  [[nodiscard]] size_type count(const T &Value) const {
+    return find(Value) != end();
+  }
+
+  [[nodiscard]] iterator lower_bound(const T &Value) const {
+    return lowerBound(Value);
+  }
+
+  void clear() { Elements.clear(); }
+
+  void reserve(size_type Size) { Elements.reserve(Size); }
+
+  [[nodiscard]] iterator begin() const { return Elements.begin(); }
+  [[nodiscard]] iterator end() const { return Elements.end(); }
+  [[nodiscard]] const_iterator cbegin() const { return Elements.begin(); }
+  [[nodiscard]] const_iterator cend() const { return Elements.end(); }
+  [[nodiscard]] reverse_iterator rbegin() const {
+    return reverse_iterator(end());
+  }
+  [[nodiscard]] reverse_iterator rend() const {
+    return reverse_iterator(begin());
+  }
+
+  [[nodiscard]] size_type size() const { return Elements.size(); }
+
+  [[nodiscard]] bool empty() const { return Elements.empty(); }
+
+  // Returns the number of elements that fit into the inline storage.
+  static constexpr unsigned inlineCapacity() { return N; }
+
+  friend bool operator==(const SmallFlatSet &Lhs, const SmallFlatSet &Rhs) {
+    return Lhs.Elements == Rhs.Elements;
+  }
+
+  friend bool operator!=(const SmallFlatSet &Lhs, const SmallFlatSet &Rhs) {
+    return !(Lhs == Rhs);
+  }
+
+  friend bool operator<(const SmallFlatSet &Lhs, const SmallFlatSet &Rhs) {
+    return std::lexicographical_compare(Lhs.begin(), Lhs.end(), Rhs.begin(),
+                                        Rhs.end(), Lhs.Comp);
+  }
+
+private:
+  iterator lowerBound(const T &Value) const {
+    return std::lower_bound(Elements.begin(), Elements.end(), Value, Comp);
+  }
+
+  storage_type Elements;
+  Compare Comp;
+};
+
+} // namespace psr
+
+#endif
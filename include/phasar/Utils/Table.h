@@ -181,6 +181,12 @@ public:
     return table[rowKey][columnKey];
   }
 
+  [[nodiscard]] const V &get(R rowKey, C columnKey) const {
+    // Returns the value corresponding to the given row and column keys; the
+    // mapping must exist.
+    return table.at(rowKey).at(columnKey);
+  }
+
   V remove(R rowKey, C columnKey) {
     // Removes the mapping, if any, associated with the given keys.
     V v = table[rowKey][columnKey];
@@ -195,6 +201,36 @@ public:
     return table[rowKey];
   }
 
+  [[nodiscard]] const std::unordered_map<C, V> &row(R rowKey) const {
+    // Returns a view of all mappings that have the given row key; unlike the
+    // non-const version, no empty row is inserted if there is none.
+    if (auto RowIter = table.find(rowKey); RowIter != table.end()) {
+      return RowIter->second;
+    }
+    static const std::unordered_map<C, V> EmptyRow;
+    return EmptyRow;
+  }
+
+  template <typename HandlerFn> void forEachCell(HandlerFn Handler) const {
+    // Calls Handler(rowKey, columnKey, value) for every mapping without
+    // copying them, unlike cellSet() and cellVec().
+    for (const auto &m1 : table) {
+      for (const auto &m2 : m1.second) {
+        Handler(m1.first, m2.first, m2.second);
+      }
+    }
+  }
+
+  template <typename HandlerFn> void forEachRow(HandlerFn Handler) const {
+    // Calls Handler(rowKey, row) for every non-empty row without copying it,
+    // unlike rowMap().
+    for (const auto &m1 : table) {
+      if (!m1.second.empty()) {
+        Handler(m1.first, m1.second);
+      }
+    }
+  }
+
   [[nodiscard]] std::multiset<R> rowKeySet() const {
     // Returns a set of row keys that have one or more values in the table.
     std::multiset<R> s;
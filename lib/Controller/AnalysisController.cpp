@@ -7,17 +7,26 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
 #include "llvm/Support/ErrorHandling.h"
 
 #include "phasar/Controller/AnalysisController.h"
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/WholeProgramAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEInstInteractionAnalysis.h"
@@ -38,6 +47,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/OpenSSLEVPKDFDescription.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoSolverTest.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoTaintAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/IntraMonoFullConstantPropagation.h"
@@ -46,6 +56,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/IntraMonoSolver.h"
 #include "phasar/PhasarLLVM/Plugins/PluginFactories.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
+#include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Utilities.h"
 
 using namespace std;
@@ -73,19 +84,33 @@ bool needsToEmitPTA(AnalysisControllerEmitterOptions EmitterOptions) {
          (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText);
 }
 
+bool needsToEmitResults(AnalysisControllerEmitterOptions EmitterOptions) {
+  return (EmitterOptions & AnalysisControllerEmitterOptions::EmitTextReport) ||
+         (EmitterOptions &
+          AnalysisControllerEmitterOptions::EmitGraphicalReport) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitRawResults) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::ExportAsJson) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::ExportAsSarif);
+}
+
 AnalysisController::AnalysisController(
     ProjectIRDB &IRDB, std::vector<DataFlowAnalysisKind> DataFlowAnalyses,
     std::vector<std::string> AnalysisConfigs, PointerAnalysisType PTATy,
     CallGraphAnalysisType CGTy, SoundnessFlag SF,
     const std::set<std::string> &EntryPoints, AnalysisStrategy Strategy,
     AnalysisControllerEmitterOptions EmitterOptions,
-    const std::string &ProjectID, const std::string &OutDirectory)
+    const std::string &ProjectID, const std::string &OutDirectory,
+    std::vector<std::string> Queries, std::vector<std::string> IRFiles)
     : IRDB(IRDB), TH(IRDB), PT(IRDB, !needsToEmitPTA(EmitterOptions), PTATy),
-      ICF(IRDB, CGTy, EntryPoints, &TH, &PT),
+      ICF(IRDB, CGTy,
+          Strategy == AnalysisStrategy::ModuleWise ? std::set<std::string>{}
+                                                   : EntryPoints,
+          &TH, &PT),
       DataFlowAnalyses(std::move(DataFlowAnalyses)),
       AnalysisConfigs(std::move(AnalysisConfigs)), EntryPoints(EntryPoints),
       Strategy(Strategy), EmitterOptions(EmitterOptions), ProjectID(ProjectID),
-      OutDirectory(OutDirectory), SF(SF) {
+      OutDirectory(OutDirectory), Queries(std::move(Queries)),
+      IRFiles(std::move(IRFiles)), SF(SF) {
   if (!OutDirectory.empty()) {
     // create directory for results
     ResultDirectory = OutDirectory + "/" + ProjectID + "-" + createTimeStamp();
@@ -96,15 +121,25 @@ AnalysisController::AnalysisController(
 }
 
 void AnalysisController::executeAs(AnalysisStrategy Strategy) {
+  // the IDE solver does not compute the values inside of the functions whose
+  // summaries it takes from the cache, see
+  // IFDSIDESolverConfig::setSummaryCacheDirectory()
+  if (!IFDSIDESolverConfig().summaryCacheDirectory().empty() &&
+      needsToEmitResults(EmitterOptions)) {
+    std::cout << "The results of an analysis that uses the summary cache are "
+                 "incomplete and cannot be emitted, re-run without "
+                 "'--summary-cache' or without emitting the results\n";
+    return;
+  }
   switch (Strategy) {
   case AnalysisStrategy::DemandDriven:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeDemandDriven();
     break;
   case AnalysisStrategy::Incremental:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeIncremental();
     break;
   case AnalysisStrategy::ModuleWise:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeModuleWise();
     break;
   case AnalysisStrategy::Variational:
     llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
@@ -117,11 +152,352 @@ void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   }
 }
 
-void AnalysisController::executeDemandDriven() {}
+template <typename ProblemTy>
+bool AnalysisController::useNativeIFDSSolver() {
+  std::string Unsupported =
+      NativeIFDSSolver_P<ProblemTy>::getUnsupportedOption(
+          IFDSIDESolverConfig());
+  if (Unsupported.empty()) {
+    return true;
+  }
+  std::cout << "The native IFDS solver does not support '--" << Unsupported
+            << "', using the IDE-based IFDS solver instead\n";
+  return false;
+}
+
+template <typename ProblemTy, typename... ArgTys>
+void AnalysisController::executeDemandDrivenIFDSAnalysis(ArgTys &&... Args) {
+  if (useNativeIFDSSolver<ProblemTy>()) {
+    DemandDrivenAnalysis<NativeIFDSSolver_P<ProblemTy>, ProblemTy> DDA(
+        std::forward<ArgTys>(Args)...);
+    executeDemandDrivenAnalysis(DDA);
+    DDA.releaseConfiguration();
+  } else {
+    DemandDrivenAnalysis<IFDSSolver_P<ProblemTy>, ProblemTy> DDA(
+        std::forward<ArgTys>(Args)...);
+    executeDemandDrivenAnalysis(DDA);
+    DDA.releaseConfiguration();
+  }
+}
+
+template <typename ProblemTy, typename... ArgTys>
+void AnalysisController::executeWholeProgramIFDSAnalysis(ArgTys &&... Args) {
+  if (useNativeIFDSSolver<ProblemTy>()) {
+    WholeProgramAnalysis<NativeIFDSSolver_P<ProblemTy>, ProblemTy> WPA(
+        std::forward<ArgTys>(Args)...);
+    WPA.solve();
+    emitRequestedDataFlowResults(WPA);
+    WPA.releaseAllHelperAnalyses();
+  } else {
+    WholeProgramAnalysis<IFDSSolver_P<ProblemTy>, ProblemTy> WPA(
+        std::forward<ArgTys>(Args)...);
+    WPA.solve();
+    emitRequestedDataFlowResults(WPA);
+    WPA.releaseAllHelperAnalyses();
+  }
+}
+
+void AnalysisController::executeDemandDriven() {
+  if (Queries.empty()) {
+    std::cout << "The demand-driven analysis strategy requires at least one "
+                 "query, specify one using '--query'\n";
+    return;
+  }
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (!std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      std::cout << "The demand-driven analysis strategy does not support "
+                   "analysis plugins, yet!\n";
+      continue;
+    }
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      executeDemandDrivenIFDSAnalysis<IFDSUninitializedVariables>(
+          IRDB, EntryPoints, &PT, &ICF, &TH);
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      executeDemandDrivenIFDSAnalysis<IFDSConstAnalysis>(
+          IRDB, EntryPoints, &PT, &ICF, &TH);
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      executeDemandDrivenIFDSAnalysis<IFDSTaintAnalysis>(
+          IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+    } break;
+    case DataFlowAnalysisType::IDETaintAnalysis: {
+      DemandDrivenAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis>
+          DDA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      executeDemandDrivenAnalysis(DDA);
+    } break;
+    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
+      OpenSSLEVPKDFDescription TSDesc;
+      DemandDrivenAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                           IDETypeStateAnalysis>
+          DDA(IRDB, &TSDesc, EntryPoints, &PT, &ICF, &TH);
+      executeDemandDrivenAnalysis(DDA);
+      DDA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      executeDemandDrivenIFDSAnalysis<IFDSTypeAnalysis>(
+          IRDB, EntryPoints, &PT, &ICF, &TH);
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      executeDemandDrivenIFDSAnalysis<IFDSSolverTest>(
+          IRDB, EntryPoints, &PT, &ICF, &TH);
+    } break;
+    case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
+      executeDemandDrivenIFDSAnalysis<IFDSLinearConstantAnalysis>(
+          IRDB, EntryPoints, &PT, &ICF, &TH);
+    } break;
+    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
+      executeDemandDrivenIFDSAnalysis<IFDSFieldSensTaintAnalysis>(
+          IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+    } break;
+    case DataFlowAnalysisType::IDELinearConstantAnalysis: {
+      DemandDrivenAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                           IDELinearConstantAnalysis>
+          DDA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      executeDemandDrivenAnalysis(DDA);
+    } break;
+    case DataFlowAnalysisType::IDESolverTest: {
+      DemandDrivenAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest> DDA(
+          IRDB, EntryPoints, &PT, &ICF, &TH);
+      executeDemandDrivenAnalysis(DDA);
+    } break;
+    case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
+      DemandDrivenAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
+                           IDEInstInteractionAnalysis>
+          DDA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      executeDemandDrivenAnalysis(DDA);
+    } break;
+    default:
+      std::cout << "The demand-driven analysis strategy only supports IFDS "
+                   "and IDE analyses!\n";
+      break;
+    }
+  }
+}
 
-void AnalysisController::executeIncremental() {}
+void AnalysisController::executeIncremental() {
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (!std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      std::cout << "The incremental analysis strategy does not support "
+                   "analysis plugins, yet!\n";
+      continue;
+    }
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    // the state of the previous run is persisted by the IDE solver, the IFDS
+    // analyses are therefore solved as IDE problems
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                                IFDSUninitializedVariables>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSConstAnalysis>,
+                                IFDSConstAnalysis>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSTaintAnalysis>,
+                                IFDSTaintAnalysis>
+          IUA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+      IUA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDETaintAnalysis: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
+      OpenSSLEVPKDFDescription TSDesc;
+      IncrementalUpdateAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                                IDETypeStateAnalysis>
+          IUA(IRDB, &TSDesc, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+      IUA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSTypeAnalysis>,
+                                IFDSTypeAnalysis>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
+                                IFDSLinearConstantAnalysis>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
+                                IFDSFieldSensTaintAnalysis>
+          IUA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+      IUA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDELinearConstantAnalysis: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                                IDELinearConstantAnalysis>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDESolverTest: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
+                                IDEInstInteractionAnalysis>
+          IUA(IRDB, EntryPoints, &PT, &ICF, &TH);
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    default:
+      std::cout << "The incremental analysis strategy only supports IFDS and "
+                   "IDE analyses!\n";
+      break;
+    }
+  }
+}
 
-void AnalysisController::executeModuleWise() {}
+void AnalysisController::executeModuleWise() {
+  // the units of modules are loaded from their IR files one at a time, the
+  // IRDB need not contain them; if it does, they must not have been linked,
+  // see ProjectIRDB::linkForWPA()
+  if (IRFiles.empty()) {
+    for (const auto *M : IRDB.getAllModules()) {
+      IRFiles.push_back(M->getModuleIdentifier());
+    }
+  }
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (!std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      std::cout << "The module-wise analysis strategy does not support "
+                   "analysis plugins, yet!\n";
+      continue;
+    }
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    // the summaries are persisted by the IDE solver, the IFDS analyses are
+    // therefore solved as IDE problems
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                         IFDSUninitializedVariables>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSConstAnalysis>, IFDSConstAnalysis>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSTaintAnalysis>, IFDSTaintAnalysis>
+          MWA(IRFiles, AnalysisConfigPath, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+      MWA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDETaintAnalysis: {
+      ModuleWiseAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
+      OpenSSLEVPKDFDescription TSDesc;
+      ModuleWiseAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                         IDETypeStateAnalysis>
+          MWA(IRFiles, &TSDesc, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+      MWA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSTypeAnalysis>, IFDSTypeAnalysis>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
+                         IFDSLinearConstantAnalysis>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
+                         IFDSFieldSensTaintAnalysis>
+          MWA(IRFiles, AnalysisConfigPath, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+      MWA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDELinearConstantAnalysis: {
+      ModuleWiseAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                         IDELinearConstantAnalysis>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IDESolverTest: {
+      ModuleWiseAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
+      ModuleWiseAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
+                         IDEInstInteractionAnalysis>
+          MWA(IRFiles, EntryPoints);
+      executeModuleWiseAnalysis(MWA);
+    } break;
+    default:
+      std::cout << "The module-wise analysis strategy only supports IFDS and "
+                   "IDE analyses!\n";
+      break;
+    }
+  }
+}
 
 void AnalysisController::executeVariational() {}
 
@@ -134,22 +510,16 @@ void AnalysisController::executeWholeProgram() {
       auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
       switch (DataFlowAnalysis) {
       case DataFlowAnalysisType::IFDSUninitializedVariables: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
-                             IFDSUninitializedVariables>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
+        executeWholeProgramIFDSAnalysis<IFDSUninitializedVariables>(
+            IRDB, EntryPoints, &PT, &ICF, &TH);
       } break;
       case DataFlowAnalysisType::IFDSConstAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSConstAnalysis>, IFDSConstAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
+        executeWholeProgramIFDSAnalysis<IFDSConstAnalysis>(
+            IRDB, EntryPoints, &PT, &ICF, &TH);
       } break;
       case DataFlowAnalysisType::IFDSTaintAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSTaintAnalysis>, IFDSTaintAnalysis>
+        WholeProgramAnalysis<NativeIFDSSolver_P<IFDSTaintAnalysis>,
+                             IFDSTaintAnalysis>
             WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
       } break;
       case DataFlowAnalysisType::IDETaintAnalysis: {
@@ -170,34 +540,20 @@ void AnalysisController::executeWholeProgram() {
         WPA.releaseConfiguration();
       } break;
       case DataFlowAnalysisType::IFDSTypeAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSTypeAnalysis>, IFDSTypeAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
+        executeWholeProgramIFDSAnalysis<IFDSTypeAnalysis>(
+            IRDB, EntryPoints, &PT, &ICF, &TH);
       } break;
       case DataFlowAnalysisType::IFDSSolverTest: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest> WPA(
+        executeWholeProgramIFDSAnalysis<IFDSSolverTest>(
             IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
-                             IFDSLinearConstantAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
+        executeWholeProgramIFDSAnalysis<IFDSLinearConstantAnalysis>(
+            IRDB, EntryPoints, &PT, &ICF, &TH);
       } break;
       case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
-                             IFDSFieldSensTaintAnalysis>
-            WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
+        executeWholeProgramIFDSAnalysis<IFDSFieldSensTaintAnalysis>(
+            IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
       } break;
       case DataFlowAnalysisType::IDELinearConstantAnalysis: {
         WholeProgramAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
@@ -262,10 +618,16 @@ void AnalysisController::executeWholeProgram() {
                    _DataFlowAnalysis)) {
       auto Problem = std::get<IFDSPluginConstructor>(_DataFlowAnalysis)(
           &IRDB, &TH, &ICF, &PT, EntryPoints);
-      IFDSSolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
-          *Problem);
-      Solver.solve();
-      emitRequestedDataFlowResults(Solver);
+      using ProblemTy = std::remove_reference<decltype(*Problem)>::type;
+      if (useNativeIFDSSolver<ProblemTy>()) {
+        NativeIFDSSolver_P<ProblemTy> Solver(*Problem);
+        Solver.solve();
+        emitRequestedDataFlowResults(Solver);
+      } else {
+        IFDSSolver_P<ProblemTy> Solver(*Problem);
+        Solver.solve();
+        emitRequestedDataFlowResults(Solver);
+      }
     } else if (std::holds_alternative<IDEPluginConstructor>(
                    _DataFlowAnalysis)) {
       auto Problem = std::get<IDEPluginConstructor>(_DataFlowAnalysis)(
@@ -295,6 +657,54 @@ void AnalysisController::executeWholeProgram() {
   }
 }
 
+std::vector<std::pair<const llvm::Instruction *, const llvm::Value *>>
+AnalysisController::getDemandDrivenQueries() {
+  // queries are given as '<statement-id>' or '<statement-id>:<fact-id>',
+  // facts are identified by the IDs that getMetaDataID() assigns to them
+  auto GetValue = [this](const std::string &Id) -> const llvm::Value * {
+    if (!Id.empty() && std::all_of(Id.begin(), Id.end(), [](unsigned char C) {
+          return std::isdigit(C);
+        })) {
+      if (const auto *I = IRDB.getInstruction(std::stoull(Id))) {
+        return I;
+      }
+    }
+    for (const auto *M : IRDB.getAllModules()) {
+      for (const auto &G : M->globals()) {
+        if (getMetaDataID(&G) == Id) {
+          return &G;
+        }
+      }
+      for (const auto &F : *M) {
+        for (const auto &A : F.args()) {
+          if (getMetaDataID(&A) == Id) {
+            return &A;
+          }
+        }
+      }
+    }
+    return nullptr;
+  };
+  std::vector<std::pair<const llvm::Instruction *, const llvm::Value *>>
+      Result;
+  for (const auto &Query : Queries) {
+    auto Sep = Query.find(':');
+    const auto *Stmt = llvm::dyn_cast_or_null<llvm::Instruction>(
+        GetValue(Query.substr(0, Sep)));
+    const llvm::Value *Fact = nullptr;
+    if (Sep != std::string::npos) {
+      Fact = GetValue(Query.substr(Sep + 1));
+    }
+    if (!Stmt || (Sep != std::string::npos && !Fact)) {
+      std::cout << "Ignore query '" << Query
+                << "', no such statement or fact!\n";
+      continue;
+    }
+    Result.emplace_back(Stmt, Fact);
+  }
+  return Result;
+}
+
 void AnalysisController::emitRequestedHelperAnalysisResults() {
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitIR) {
     if (!ResultDirectory.empty()) {
@@ -144,7 +144,14 @@ void ProjectIRDB::linkForWPA() {
   // all modules.
   if (Modules.size() > 1) {
     llvm::Module *MainMod = getModuleDefiningFunction("main");
-    assert(MainMod && "could not find main function");
+    // only the definitions that are needed by a program's main function are
+    // linked, whereas libraries, which do not define main, are linked
+    // completely
+    unsigned LinkerFlags = llvm::Linker::LinkOnlyNeeded;
+    if (!MainMod) {
+      MainMod = Modules.begin()->second.get();
+      LinkerFlags = llvm::Linker::None;
+    }
     for (auto &[File, Module] : Modules) {
       // we do not want to link a module with itself!
       if (MainMod != Module.get()) {
@@ -168,7 +175,7 @@ void ProjectIRDB::linkForWPA() {
         }
         // now we can safely perform the linking
         if (llvm::Linker::linkModules(*MainMod, std::move(TmpMod),
-                                      llvm::Linker::LinkOnlyNeeded)) {
+                                      LinkerFlags)) {
           llvm::report_fatal_error(
               "Error: trying to link modules into single WPA module failed!");
         }
@@ -0,0 +1,268 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem/path.hpp"
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalAlias.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Linker/Linker.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+// the symbols a module defines and the ones it uses from other modules
+struct ModuleSymbols {
+  std::vector<std::string> Defined;
+  std::vector<std::string> Used;
+  std::vector<std::string> Exported;
+};
+
+ModuleSymbols getModuleSymbols(const std::string &File) {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Diag;
+  // function bodies of bitcode files are not needed and not materialized
+  std::unique_ptr<llvm::Module> M =
+      llvm::getLazyIRFileModule(File, Diag, Context);
+  if (!M) {
+    Diag.print(File.c_str(), llvm::errs());
+    throw std::runtime_error(File + " could not be parsed correctly");
+  }
+  ModuleSymbols Symbols;
+  auto Add = [&Symbols](const llvm::GlobalValue &G) {
+    if (!G.hasName() || G.hasLocalLinkage()) {
+      return;
+    }
+    if (G.isDeclaration()) {
+      Symbols.Used.push_back(G.getName().str());
+    } else {
+      Symbols.Defined.push_back(G.getName().str());
+    }
+  };
+  for (const auto &F : *M) {
+    if (!F.isIntrinsic()) {
+      Add(F);
+    }
+    // linkonce and weak definitions, e.g. of inline functions, are defined
+    // by every module that uses them
+    if (!F.isDeclaration() && F.hasExternalLinkage()) {
+      Symbols.Exported.push_back(F.getName().str());
+    }
+  }
+  for (const auto &G : M->globals()) {
+    Add(G);
+  }
+  for (const auto &A : M->aliases()) {
+    Add(A);
+  }
+  return Symbols;
+}
+
+// Tarjan's algorithm, which finds the strongly connected components of the
+// module dependency graph in reverse topological order, i.e. every component
+// is found after the ones it depends on
+class ModuleDependencySCCs {
+  const std::vector<std::vector<size_t>> &Successors;
+  std::vector<size_t> Indices;
+  std::vector<size_t> LowLinks;
+  std::vector<bool> OnStack;
+  std::vector<size_t> Stack;
+  size_t NextIndex = 1;
+
+  void visit(size_t V) {
+    Indices[V] = LowLinks[V] = NextIndex++;
+    Stack.push_back(V);
+    OnStack[V] = true;
+    for (size_t W : Successors[V]) {
+      if (Indices[W] == 0) {
+        visit(W);
+        LowLinks[V] = std::min(LowLinks[V], LowLinks[W]);
+      } else if (OnStack[W]) {
+        LowLinks[V] = std::min(LowLinks[V], Indices[W]);
+      }
+    }
+    if (LowLinks[V] == Indices[V]) {
+      auto &SCC = SCCs.emplace_back();
+      size_t W;
+      do {
+        W = Stack.back();
+        Stack.pop_back();
+        OnStack[W] = false;
+        SCC.push_back(W);
+      } while (W != V);
+      std::sort(SCC.begin(), SCC.end());
+    }
+  }
+
+public:
+  std::vector<std::vector<size_t>> SCCs;
+
+  explicit ModuleDependencySCCs(
+      const std::vector<std::vector<size_t>> &Successors)
+      : Successors(Successors), Indices(Successors.size(), 0),
+        LowLinks(Successors.size(), 0), OnStack(Successors.size(), false) {
+    for (size_t V = 0; V < Successors.size(); ++V) {
+      if (Indices[V] == 0) {
+        visit(V);
+      }
+    }
+  }
+};
+
+std::string getUnitName(const std::vector<std::string> &IRFiles) {
+  std::string Name = boost::filesystem::path(IRFiles.front()).stem().string();
+  if (IRFiles.size() > 1) {
+    Name += '+' + std::to_string(IRFiles.size() - 1);
+  }
+  std::string Paths;
+  for (const auto &File : IRFiles) {
+    Paths += boost::filesystem::absolute(File).string() + '\n';
+  }
+  // files of the same name may reside in different directories
+  return Name + '-' + llvm::utohexstr(llvm::xxHash64(Paths));
+}
+
+} // namespace
+
+std::vector<ModuleWiseUnit>
+getModuleWiseUnits(const std::vector<std::string> &IRFiles) {
+  std::vector<std::string> Files = IRFiles;
+  std::sort(Files.begin(), Files.end());
+  Files.erase(std::unique(Files.begin(), Files.end()), Files.end());
+  std::vector<ModuleSymbols> Symbols;
+  std::map<std::string, std::vector<size_t>> Definitions;
+  for (size_t Idx = 0; Idx < Files.size(); ++Idx) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Scan module dependencies of " << Files[Idx]);
+    Symbols.push_back(getModuleSymbols(Files[Idx]));
+    for (const auto &Name : Symbols.back().Defined) {
+      Definitions[Name].push_back(Idx);
+    }
+  }
+  std::vector<std::vector<size_t>> Successors(Files.size());
+  for (size_t Idx = 0; Idx < Files.size(); ++Idx) {
+    for (const auto &Name : Symbols[Idx].Used) {
+      if (auto Search = Definitions.find(Name); Search != Definitions.end()) {
+        Successors[Idx].insert(Successors[Idx].end(), Search->second.begin(),
+                               Search->second.end());
+      }
+    }
+    std::sort(Successors[Idx].begin(), Successors[Idx].end());
+    Successors[Idx].erase(
+        std::unique(Successors[Idx].begin(), Successors[Idx].end()),
+        Successors[Idx].end());
+  }
+  ModuleDependencySCCs SCCs(Successors);
+  std::vector<size_t> UnitOfModule(Files.size());
+  std::vector<ModuleWiseUnit> Units;
+  for (const auto &SCC : SCCs.SCCs) {
+    auto &Unit = Units.emplace_back();
+    for (size_t Idx : SCC) {
+      UnitOfModule[Idx] = Units.size() - 1;
+      Unit.IRFiles.push_back(Files[Idx]);
+      Unit.ExportedFunctions.insert(Symbols[Idx].Exported.begin(),
+                                    Symbols[Idx].Exported.end());
+    }
+    // the units the component depends on have been found before
+    for (size_t Idx : SCC) {
+      for (size_t Succ : Successors[Idx]) {
+        size_t Dependency = UnitOfModule[Succ];
+        if (Dependency != Units.size() - 1) {
+          Unit.Dependencies.insert(Dependency);
+          Unit.Dependencies.insert(Units[Dependency].Dependencies.begin(),
+                                   Units[Dependency].Dependencies.end());
+        }
+      }
+    }
+    Unit.Name = getUnitName(Unit.IRFiles);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Unit '" << Unit.Name << "' consists of "
+                  << Unit.IRFiles.size() << " modules and depends on "
+                  << Unit.Dependencies.size() << " units");
+  }
+  return Units;
+}
+
+std::unique_ptr<ProjectIRDB>
+loadModuleWiseUnitIR(const ModuleWiseUnit &Unit,
+                     const std::vector<ModuleWiseUnit> &Units) {
+  // the IRDB takes ownership of the context, see ProjectIRDB::insertModule()
+  auto Context = std::make_unique<llvm::LLVMContext>();
+  auto Load = [&Context](const std::string &File) {
+    llvm::SMDiagnostic Diag;
+    std::unique_ptr<llvm::Module> M = llvm::parseIRFile(File, Diag, *Context);
+    if (!M) {
+      Diag.print(File.c_str(), llvm::errs());
+      throw std::runtime_error(File + " could not be parsed correctly");
+    }
+    return M;
+  };
+  std::unique_ptr<llvm::Module> UnitModule;
+  for (const auto &File : Unit.IRFiles) {
+    auto M = Load(File);
+    if (!UnitModule) {
+      UnitModule = std::move(M);
+    } else if (llvm::Linker::linkModules(*UnitModule, std::move(M))) {
+      throw std::runtime_error("Cannot link " + File + " into unit '" +
+                               Unit.Name + "'");
+    }
+  }
+  // The dependencies are linked starting with the ones that are closest to
+  // the unit, such that the functions their linked definitions use are
+  // declared by the time the units that define them are linked. Linking only
+  // the needed definitions pulls in the functions they call in turn.
+  for (auto It = Unit.Dependencies.rbegin(); It != Unit.Dependencies.rend();
+       ++It) {
+    std::unique_ptr<llvm::Module> Definitions;
+    for (const auto &File : Units[*It].IRFiles) {
+      auto M = Load(File);
+      if (!Definitions) {
+        Definitions = std::move(M);
+      } else if (llvm::Linker::linkModules(*Definitions, std::move(M))) {
+        throw std::runtime_error("Cannot link " + File + " into unit '" +
+                                 Units[*It].Name + "'");
+      }
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Link the callees of unit '" << Units[*It].Name
+                  << "' into unit '" << Unit.Name << "'");
+    if (llvm::Linker::linkModules(*UnitModule, std::move(Definitions),
+                                  llvm::Linker::LinkOnlyNeeded)) {
+      throw std::runtime_error("Cannot link the callees of unit '" +
+                               Units[*It].Name + "' into unit '" +
+                               Unit.Name + "'");
+    }
+  }
+  Context.release();
+  return std::make_unique<ProjectIRDB>(
+      std::vector<llvm::Module *>{UnitModule.release()},
+      IRDBOptions::WPA | IRDBOptions::OWNS);
+}
+
+} // namespace psr
@@ -0,0 +1,227 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <istream>
+#include <ostream>
+
+#include "llvm/ADT/StringSet.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/CheckpointIO.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+// strings longer than this are considered to be corrupt
+static constexpr uint64_t MaxStringLength = 1U << 20U;
+
+static std::string getInstructionId(const llvm::Function *F, uint64_t Pos) {
+  return '@' + F->getName().str() + '#' + std::to_string(Pos);
+}
+
+std::string getCheckpointId(const llvm::Value *V) {
+  if (V == LLVMZeroValue::getInstance()) {
+    return "";
+  }
+  if (llvm::isa<llvm::Function>(V) || llvm::isa<llvm::GlobalVariable>(V)) {
+    return V->hasName() ? '@' + V->getName().str() : "";
+  }
+  if (const auto *A = llvm::dyn_cast<llvm::Argument>(V)) {
+    if (A->getParent()->hasName()) {
+      return '@' + A->getParent()->getName().str() + '%' +
+             std::to_string(A->getArgNo());
+    }
+  } else if (const auto *I = llvm::dyn_cast<llvm::Instruction>(V)) {
+    const auto *F = I->getFunction();
+    if (F && F->hasName()) {
+      uint64_t Pos = 0;
+      for (const auto &J : llvm::instructions(F)) {
+        if (&J == I) {
+          return getInstructionId(F, Pos);
+        }
+        ++Pos;
+      }
+    }
+  }
+  return "";
+}
+
+CheckpointWriter::CheckpointWriter(std::ostream &OS) : OS(OS) {}
+
+void CheckpointWriter::writeInt(uint64_t Val) {
+  while (Val >= 0x80) {
+    OS.put(static_cast<char>((Val & 0x7F) | 0x80));
+    Val >>= 7U;
+  }
+  OS.put(static_cast<char>(Val));
+}
+
+void CheckpointWriter::writeSignedInt(int64_t Val) {
+  // zig-zag encoding such that small negative values remain small
+  writeInt((static_cast<uint64_t>(Val) << 1U) ^
+           static_cast<uint64_t>(Val >> 63));
+}
+
+void CheckpointWriter::writeString(llvm::StringRef Str) {
+  writeInt(Str.size());
+  OS.write(Str.data(), Str.size());
+}
+
+std::string CheckpointWriter::getId(const llvm::Value *V) {
+  const auto *I = llvm::dyn_cast<llvm::Instruction>(V);
+  if (!I || !I->getFunction() || !I->getFunction()->hasName()) {
+    return getCheckpointId(V);
+  }
+  // number all instructions of the function at once
+  if (!InstructionNumbers.count(I)) {
+    uint64_t Pos = 0;
+    for (const auto &J : llvm::instructions(I->getFunction())) {
+      InstructionNumbers[&J] = Pos++;
+    }
+  }
+  return getInstructionId(I->getFunction(), InstructionNumbers[I]);
+}
+
+bool CheckpointWriter::writeValue(const llvm::Value *V) {
+  if (auto Search = ValueIndices.find(V); Search != ValueIndices.end()) {
+    writeInt(Search->second + 1);
+    return true;
+  }
+  std::string Id = getId(V);
+  if (Id.empty()) {
+    return false;
+  }
+  writeInt(0);
+  writeString(Id);
+  uint64_t Index = ValueIndices.size();
+  ValueIndices[V] = Index;
+  return true;
+}
+
+bool CheckpointWriter::good() const { return OS.good(); }
+
+CheckpointReader::CheckpointReader(std::istream &IS, const ProjectIRDB &IRDB,
+                                   bool AllowUnknownValues)
+    : IS(IS), AllowUnknownValues(AllowUnknownValues) {
+  llvm::StringSet<> Ambiguous;
+  auto Add = [&](std::string Id, const llvm::Value *V) {
+    if (!ValuesById.try_emplace(Id, V).second) {
+      Ambiguous.insert(Id);
+    }
+  };
+  for (const auto *M : IRDB.getAllModules()) {
+    for (const auto &G : M->globals()) {
+      Add(getCheckpointId(&G), &G);
+    }
+    for (const auto &F : *M) {
+      if (!F.hasName()) {
+        continue;
+      }
+      Add(getCheckpointId(&F), &F);
+      for (const auto &A : F.args()) {
+        Add(getCheckpointId(&A), &A);
+      }
+      uint64_t Pos = 0;
+      for (const auto &I : llvm::instructions(F)) {
+        Add(getInstructionId(&F, Pos++), &I);
+      }
+    }
+  }
+  for (const auto &Id : Ambiguous) {
+    ValuesById.erase(Id.getKey());
+  }
+  // values without an ID cannot be referenced by a checkpoint
+  ValuesById.erase("");
+}
+
+uint64_t CheckpointReader::readInt() {
+  uint64_t Val = 0;
+  for (unsigned Shift = 0; Shift < 64 && !Failed; Shift += 7) {
+    int Byte = IS.get();
+    if (Byte == std::istream::traits_type::eof()) {
+      break;
+    }
+    Val |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+    if (!(Byte & 0x80)) {
+      return Val;
+    }
+  }
+  fail();
+  return 0;
+}
+
+int64_t CheckpointReader::readSignedInt() {
+  uint64_t Val = readInt();
+  return static_cast<int64_t>(Val >> 1U) ^ -static_cast<int64_t>(Val & 1U);
+}
+
+std::string CheckpointReader::readString() {
+  uint64_t Length = readInt();
+  if (Failed || Length > MaxStringLength) {
+    fail();
+    return "";
+  }
+  std::string Str(Length, '\0');
+  if (!IS.read(Str.data(), Length)) {
+    fail();
+    return "";
+  }
+  return Str;
+}
+
+const llvm::Value *CheckpointReader::readValue() {
+  uint64_t Index = readInt();
+  if (Failed) {
+    return nullptr;
+  }
+  if (Index != 0) {
+    if (Index > Values.size()) {
+      fail();
+      return nullptr;
+    }
+    return Values[Index - 1];
+  }
+  std::string Id = readString();
+  if (Failed) {
+    return nullptr;
+  }
+  auto Search = ValuesById.find(Id);
+  if (Search == ValuesById.end()) {
+    if (!AllowUnknownValues) {
+      fail();
+      return nullptr;
+    }
+    // keep the indices in sync with the writer's
+    Values.push_back(nullptr);
+    return nullptr;
+  }
+  Values.push_back(Search->second);
+  return Search->second;
+}
+
+bool CheckpointReader::good() const { return !Failed; }
+
+void CheckpointReader::fail() { Failed = true; }
+
+void CheckpointReader::reset() {
+  IS.clear();
+  Values.clear();
+  Failed = false;
+}
+
+} // namespace psr
@@ -7,7 +7,13 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "llvm/ADT/StringSwitch.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 
@@ -16,10 +22,98 @@ using namespace psr;
 
 namespace psr {
 
+std::string toString(const WorklistPolicy &P) {
+  switch (P) {
+  default:
+#define WORKLIST_POLICY_TYPES(NAME, CMDFLAG, TYPE)                             \
+  case WorklistPolicy::TYPE:                                                   \
+    return NAME;                                                               \
+    break;
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistPolicies.def"
+  }
+}
+
+WorklistPolicy toWorklistPolicy(const std::string &S) {
+  WorklistPolicy Type = llvm::StringSwitch<WorklistPolicy>(S)
+#define WORKLIST_POLICY_TYPES(NAME, CMDFLAG, TYPE)                             \
+  .Case(NAME, WorklistPolicy::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistPolicies.def"
+                            .Default(WorklistPolicy::None);
+  if (Type == WorklistPolicy::None) {
+    Type = llvm::StringSwitch<WorklistPolicy>(S)
+#define WORKLIST_POLICY_TYPES(NAME, CMDFLAG, TYPE)                             \
+  .Case(CMDFLAG, WorklistPolicy::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistPolicies.def"
+               .Default(WorklistPolicy::None);
+  }
+  return Type;
+}
+
+std::ostream &operator<<(std::ostream &OS, const WorklistPolicy &P) {
+  return OS << toString(P);
+}
+
 IFDSIDESolverConfig::IFDSIDESolverConfig() {
   setFlag(
       Options, SolverConfigOptions::EmitESG,
       PhasarConfig::getPhasarConfig().VariablesMap().count("emit-esg-as-dot"));
+  setFlag(Options, SolverConfigOptions::InternEdgeFunctions,
+          PhasarConfig::getPhasarConfig().VariablesMap().count(
+              "intern-edge-functions"));
+  setFlag(Options, SolverConfigOptions::LowMemory,
+          PhasarConfig::getPhasarConfig().VariablesMap().count("low-memory"));
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count("worklist-policy")) {
+    auto Requested = toWorklistPolicy(PhasarConfig::getPhasarConfig()
+                                          .VariablesMap()["worklist-policy"]
+                                          .as<std::string>());
+    if (Requested != WorklistPolicy::None) {
+      Policy = Requested;
+    }
+  }
+  setFlag(Options, SolverConfigOptions::ResumeFromCheckpoint,
+          PhasarConfig::getPhasarConfig().VariablesMap().count("resume"));
+  setFlag(Options, SolverConfigOptions::BuildFactIndex,
+          PhasarConfig::getPhasarConfig().VariablesMap().count("fact-index"));
+  setFlag(Options, SolverConfigOptions::SparsePropagation,
+          PhasarConfig::getPhasarConfig().VariablesMap().count("sparse"));
+  setFlag(Options, SolverConfigOptions::CompressIdentityChains,
+          PhasarConfig::getPhasarConfig().VariablesMap().count(
+              "compress-identity-chains"));
+  setFlag(Options, SolverConfigOptions::BatchFlowFunctions,
+          PhasarConfig::getPhasarConfig().VariablesMap().count(
+              "batch-flow-functions"));
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count("checkpoint")) {
+    CheckpointFile = PhasarConfig::getPhasarConfig()
+                         .VariablesMap()["checkpoint"]
+                         .as<std::string>();
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "checkpoint-interval")) {
+    CheckpointInterval = PhasarConfig::getPhasarConfig()
+                             .VariablesMap()["checkpoint-interval"]
+                             .as<unsigned>();
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "progress-interval")) {
+    ProgressInterval = PhasarConfig::getPhasarConfig()
+                           .VariablesMap()["progress-interval"]
+                           .as<unsigned>();
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count("hot-functions")) {
+    NumHotFunctions = PhasarConfig::getPhasarConfig()
+                          .VariablesMap()["hot-functions"]
+                          .as<unsigned>();
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count("summary-cache")) {
+    SummaryCacheDirectory = PhasarConfig::getPhasarConfig()
+                                .VariablesMap()["summary-cache"]
+                                .as<std::string>();
+    setFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
+  }
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "right-to-ludicrous-speed")) {
+    NumThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
 }
 IFDSIDESolverConfig::IFDSIDESolverConfig(SolverConfigOptions Options)
     : Options(Options) {}
@@ -42,6 +136,44 @@ bool IFDSIDESolverConfig::emitESG() const {
 bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
+bool IFDSIDESolverConfig::internEdgeFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::InternEdgeFunctions);
+}
+bool IFDSIDESolverConfig::lowMemory() const {
+  return hasFlag(Options, SolverConfigOptions::LowMemory);
+}
+bool IFDSIDESolverConfig::resumeFromCheckpoint() const {
+  return hasFlag(Options, SolverConfigOptions::ResumeFromCheckpoint);
+}
+bool IFDSIDESolverConfig::buildFactIndex() const {
+  return hasFlag(Options, SolverConfigOptions::BuildFactIndex);
+}
+bool IFDSIDESolverConfig::sparsePropagation() const {
+  return hasFlag(Options, SolverConfigOptions::SparsePropagation);
+}
+bool IFDSIDESolverConfig::compressIdentityChains() const {
+  return hasFlag(Options, SolverConfigOptions::CompressIdentityChains);
+}
+bool IFDSIDESolverConfig::batchFlowFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::BatchFlowFunctions);
+}
+const std::string &IFDSIDESolverConfig::checkpointFile() const {
+  return CheckpointFile;
+}
+unsigned IFDSIDESolverConfig::checkpointInterval() const {
+  return CheckpointInterval;
+}
+unsigned IFDSIDESolverConfig::progressInterval() const {
+  return ProgressInterval;
+}
+unsigned IFDSIDESolverConfig::numHotFunctions() const {
+  return NumHotFunctions;
+}
+const std::string &IFDSIDESolverConfig::summaryCacheDirectory() const {
+  return SummaryCacheDirectory;
+}
+WorklistPolicy IFDSIDESolverConfig::worklistPolicy() const { return Policy; }
+unsigned IFDSIDESolverConfig::numThreads() const { return NumThreads; }
 
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
@@ -61,6 +193,48 @@ void IFDSIDESolverConfig::setEmitESG(bool Set) {
 void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
+void IFDSIDESolverConfig::setInternEdgeFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::InternEdgeFunctions, Set);
+}
+void IFDSIDESolverConfig::setLowMemory(bool Set) {
+  setFlag(Options, SolverConfigOptions::LowMemory, Set);
+}
+void IFDSIDESolverConfig::setResumeFromCheckpoint(bool Set) {
+  setFlag(Options, SolverConfigOptions::ResumeFromCheckpoint, Set);
+}
+void IFDSIDESolverConfig::setBuildFactIndex(bool Set) {
+  setFlag(Options, SolverConfigOptions::BuildFactIndex, Set);
+}
+void IFDSIDESolverConfig::setSparsePropagation(bool Set) {
+  setFlag(Options, SolverConfigOptions::SparsePropagation, Set);
+}
+void IFDSIDESolverConfig::setCompressIdentityChains(bool Set) {
+  setFlag(Options, SolverConfigOptions::CompressIdentityChains, Set);
+}
+void IFDSIDESolverConfig::setBatchFlowFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::BatchFlowFunctions, Set);
+}
+void IFDSIDESolverConfig::setCheckpointFile(std::string File) {
+  CheckpointFile = std::move(File);
+}
+void IFDSIDESolverConfig::setCheckpointInterval(unsigned Seconds) {
+  CheckpointInterval = Seconds;
+}
+void IFDSIDESolverConfig::setProgressInterval(unsigned Seconds) {
+  ProgressInterval = Seconds;
+}
+void IFDSIDESolverConfig::setNumHotFunctions(unsigned Num) {
+  NumHotFunctions = Num;
+}
+void IFDSIDESolverConfig::setSummaryCacheDirectory(std::string Directory) {
+  SummaryCacheDirectory = std::move(Directory);
+}
+void IFDSIDESolverConfig::setWorklistPolicy(WorklistPolicy Policy) {
+  this->Policy = Policy;
+}
+void IFDSIDESolverConfig::setNumThreads(unsigned NumThreads) {
+  this->NumThreads = std::max(1u, NumThreads);
+}
 
 ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
   return OS << "IFDSIDESolverConfig:\n"
@@ -71,7 +245,23 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
-            << "\temitESG: " << SC.emitESG();
+            << "\temitESG: " << SC.emitESG() << "\n"
+            << "\tinternEdgeFunctions: " << SC.internEdgeFunctions() << "\n"
+            << "\tlowMemory: " << SC.lowMemory() << "\n"
+            << "\tresumeFromCheckpoint: " << SC.resumeFromCheckpoint() << "\n"
+            << "\tbuildFactIndex: " << SC.buildFactIndex() << "\n"
+            << "\tsparsePropagation: " << SC.sparsePropagation() << "\n"
+            << "\tcompressIdentityChains: " << SC.compressIdentityChains()
+            << "\n"
+            << "\tbatchFlowFunctions: " << SC.batchFlowFunctions() << "\n"
+            << "\tcheckpointFile: " << SC.checkpointFile() << "\n"
+            << "\tcheckpointInterval: " << SC.checkpointInterval() << "\n"
+            << "\tprogressInterval: " << SC.progressInterval() << "\n"
+            << "\tnumHotFunctions: " << SC.numHotFunctions() << "\n"
+            << "\tsummaryCacheDirectory: " << SC.summaryCacheDirectory()
+            << "\n"
+            << "\tworklistPolicy: " << SC.worklistPolicy() << "\n"
+            << "\tnumThreads: " << SC.numThreads();
 }
 
 } // namespace psr
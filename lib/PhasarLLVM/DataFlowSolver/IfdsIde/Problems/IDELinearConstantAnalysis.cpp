@@ -7,7 +7,7 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
-// #include <functional>
+#include <functional>
 #include <limits>
 #include <utility>
 
@@ -69,8 +69,8 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
     IDELinearConstantAnalysis::n_t Curr, IDELinearConstantAnalysis::n_t Succ) {
   if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(Curr)) {
     if (Alloca->getAllocatedType()->isIntegerTy()) {
-      return make_shared<Gen<IDELinearConstantAnalysis::d_t>>(Alloca,
-                                                              getZeroValue());
+      return make_shared<Gen<IDELinearConstantAnalysis::d_t, container_type>>(
+          Alloca, getZeroValue());
     }
   }
   // Check store instructions. Store instructions override previous value
@@ -80,14 +80,16 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
     IDELinearConstantAnalysis::d_t ValueOp = Store->getValueOperand();
     // Case I: Storing a constant integer.
     if (llvm::isa<llvm::ConstantInt>(ValueOp)) {
-      return make_shared<StrongUpdateStore<IDELinearConstantAnalysis::d_t>>(
+      return make_shared<
+          StrongUpdateStore<IDELinearConstantAnalysis::d_t, container_type>>(
           Store, [this](IDELinearConstantAnalysis::d_t Source) {
             return Source == getZeroValue();
           });
     }
     // Case II: Storing an integer typed value.
     if (ValueOp->getType()->isIntegerTy()) {
-      return make_shared<StrongUpdateStore<IDELinearConstantAnalysis::d_t>>(
+      return make_shared<
+          StrongUpdateStore<IDELinearConstantAnalysis::d_t, container_type>>(
           Store, [Store](IDELinearConstantAnalysis::d_t Source) {
             return Source == Store->getValueOperand();
           });
@@ -97,7 +99,8 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
   if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr)) {
     // only consider i32 load
     if (Load->getPointerOperandType()->getPointerElementType()->isIntegerTy()) {
-      return make_shared<GenIf<IDELinearConstantAnalysis::d_t>>(
+      return make_shared<
+          GenIf<IDELinearConstantAnalysis::d_t, container_type>>(
           Load, [Load](IDELinearConstantAnalysis::d_t Source) {
             return Source == Load->getPointerOperand();
           });
@@ -107,7 +110,7 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
   if (llvm::isa<llvm::BinaryOperator>(Curr)) {
     auto *Lop = Curr->getOperand(0);
     auto *Rop = Curr->getOperand(1);
-    return make_shared<GenIf<IDELinearConstantAnalysis::d_t>>(
+    return make_shared<GenIf<IDELinearConstantAnalysis::d_t, container_type>>(
         Curr, [this, Lop, Rop](IDELinearConstantAnalysis::d_t Source) {
           return (Lop == Source && llvm::isa<llvm::ConstantInt>(Rop)) ||
                  (Rop == Source && llvm::isa<llvm::ConstantInt>(Lop)) ||
@@ -116,7 +119,8 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
                   !llvm::isa<llvm::ConstantInt>(Rop));
         });
   }
-  return Identity<IDELinearConstantAnalysis::d_t>::getInstance();
+  return Identity<IDELinearConstantAnalysis::d_t,
+                  container_type>::getInstance();
 }
 
 IDELinearConstantAnalysis::FlowFunctionPtrType
@@ -126,7 +130,8 @@ IDELinearConstantAnalysis::getCallFlowFunction(
   // Map the actual parameters into the formal parameters
   if (llvm::isa<llvm::CallInst>(CallStmt) ||
       llvm::isa<llvm::InvokeInst>(CallStmt)) {
-    struct LCAFF : FlowFunction<const llvm::Value *> {
+    struct LCAFF : FlowFunction<IDELinearConstantAnalysis::d_t,
+                                IDELinearConstantAnalysis::container_type> {
       vector<const llvm::Value *> Actuals;
       vector<const llvm::Value *> Formals;
       const llvm::Function *DestFun;
@@ -142,9 +147,9 @@ IDELinearConstantAnalysis::getCallFlowFunction(
           Formals.push_back(getNthFunctionArgument(DestFun, Idx));
         }
       }
-      set<IDELinearConstantAnalysis::d_t>
+      container_type
       computeTargets(IDELinearConstantAnalysis::d_t Source) override {
-        set<IDELinearConstantAnalysis::d_t> Res;
+        container_type Res;
         for (unsigned Idx = 0; Idx < Actuals.size(); ++Idx) {
           if (Source == Actuals[Idx]) {
             // Check for C-style varargs: idx >= destFun->arg_size()
@@ -193,7 +198,8 @@ IDELinearConstantAnalysis::getCallFlowFunction(
     return make_shared<LCAFF>(llvm::ImmutableCallSite(CallStmt), DestFun);
   }
   // Pass everything else as identity
-  return Identity<IDELinearConstantAnalysis::d_t>::getInstance();
+  return Identity<IDELinearConstantAnalysis::d_t,
+                  container_type>::getInstance();
 }
 
 IDELinearConstantAnalysis::FlowFunctionPtrType
@@ -206,15 +212,16 @@ IDELinearConstantAnalysis::getRetFlowFunction(
   if (CallSite->getType()->isIntegerTy()) {
     const auto *Return = llvm::dyn_cast<llvm::ReturnInst>(ExitStmt);
     auto *ReturnValue = Return->getReturnValue();
-    struct LCAFF : FlowFunction<IDELinearConstantAnalysis::d_t> {
+    struct LCAFF : FlowFunction<IDELinearConstantAnalysis::d_t,
+                                IDELinearConstantAnalysis::container_type> {
       IDELinearConstantAnalysis::n_t CallSite;
       IDELinearConstantAnalysis::d_t ReturnValue;
       LCAFF(IDELinearConstantAnalysis::n_t CS,
             IDELinearConstantAnalysis::d_t RetVal)
           : CallSite(CS), ReturnValue(RetVal) {}
-      set<IDELinearConstantAnalysis::d_t>
+      container_type
       computeTargets(IDELinearConstantAnalysis::d_t Source) override {
-        set<IDELinearConstantAnalysis::d_t> Res;
+        container_type Res;
         // Collect return value fact
         if (Source == ReturnValue) {
           Res.insert(CallSite);
@@ -234,7 +241,7 @@ IDELinearConstantAnalysis::getRetFlowFunction(
     return make_shared<LCAFF>(CallSite, ReturnValue);
   }
   // All other facts except GlobalVariables are killed at this point
-  return make_shared<KillIf<IDELinearConstantAnalysis::d_t>>(
+  return make_shared<KillIf<IDELinearConstantAnalysis::d_t, container_type>>(
       [](IDELinearConstantAnalysis::d_t Source) {
         return !llvm::isa<llvm::GlobalVariable>(Source);
       });
@@ -246,16 +253,19 @@ IDELinearConstantAnalysis::getCallToRetFlowFunction(
     IDELinearConstantAnalysis::n_t RetSite, set<f_t> Callees) {
   for (const auto *Callee : Callees) {
     if (!ICF->getStartPointsOf(Callee).empty()) {
-      return make_shared<KillIf<IDELinearConstantAnalysis::d_t>>(
+      return make_shared<
+          KillIf<IDELinearConstantAnalysis::d_t, container_type>>(
           [this](IDELinearConstantAnalysis::d_t Source) {
             return !isZeroValue(Source) &&
                    llvm::isa<llvm::GlobalVariable>(Source);
           });
     } else {
-      return Identity<IDELinearConstantAnalysis::d_t>::getInstance();
+      return Identity<IDELinearConstantAnalysis::d_t,
+                      container_type>::getInstance();
     }
   }
-  return Identity<IDELinearConstantAnalysis::d_t>::getInstance();
+  return Identity<IDELinearConstantAnalysis::d_t,
+                  container_type>::getInstance();
 }
 
 IDELinearConstantAnalysis::FlowFunctionPtrType
@@ -319,6 +329,20 @@ bool IDELinearConstantAnalysis::isZeroValue(
   return LLVMZeroValue::getInstance()->isLLVMZeroValue(D);
 }
 
+bool IDELinearConstantAnalysis::isIdentityStmt(
+    IDELinearConstantAnalysis::n_t Stmt) const {
+  // see getNormalFlowFunction() and getNormalEdgeFunction(), the zero value
+  // is mapped to bottom by every statement and stays bottom
+  return !llvm::isa<llvm::AllocaInst>(Stmt) &&
+         !llvm::isa<llvm::StoreInst>(Stmt) &&
+         !llvm::isa<llvm::LoadInst>(Stmt) &&
+         !llvm::isa<llvm::BinaryOperator>(Stmt);
+}
+
+std::string IDELinearConstantAnalysis::getSummaryCacheName() const {
+  return "IDELinearConstantAnalysis";
+}
+
 // In addition provide specifications for the IDE parts
 
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
@@ -492,6 +516,118 @@ IDELinearConstantAnalysis::allTopFunction() {
   return make_shared<AllTop<IDELinearConstantAnalysis::l_t>>(TOP);
 }
 
+namespace {
+
+// the kinds of LCA edge functions in a solver checkpoint
+enum : uint64_t { LCAGenConstant, LCAIdentityFn, LCABinOp, LCAComposer };
+
+// the kinds of BinOp operands in a solver checkpoint
+enum : uint64_t { LCAZeroOperand, LCAConstantOperand, LCAValueOperand };
+
+bool writeBinOpOperand(CheckpointWriter &W, const llvm::Value *V) {
+  if (LLVMZeroValue::getInstance()->isLLVMZeroValue(V)) {
+    W.writeInt(LCAZeroOperand);
+    return true;
+  }
+  if (const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(V)) {
+    W.writeInt(LCAConstantOperand);
+    W.writeInt(CI->getBitWidth());
+    W.writeSignedInt(CI->getSExtValue());
+    return true;
+  }
+  W.writeInt(LCAValueOperand);
+  return W.writeValue(V);
+}
+
+const llvm::Value *readBinOpOperand(CheckpointReader &R,
+                                    llvm::LLVMContext &Ctx) {
+  switch (R.readInt()) {
+  case LCAZeroOperand:
+    return LLVMZeroValue::getInstance();
+  case LCAConstantOperand: {
+    auto BitWidth = R.readInt();
+    auto Val = R.readSignedInt();
+    if (!R.good() || BitWidth == 0 || BitWidth > 64) {
+      break;
+    }
+    return llvm::ConstantInt::get(
+        llvm::IntegerType::get(Ctx, static_cast<unsigned>(BitWidth)), Val,
+        true);
+  }
+  case LCAValueOperand:
+    return R.readValue();
+  default:
+    break;
+  }
+  R.fail();
+  return nullptr;
+}
+
+} // namespace
+
+bool IDELinearConstantAnalysis::writeEdgeFunction(
+    CheckpointWriter &W, const shared_ptr<EdgeFunction<l_t>> &F,
+    const std::function<bool(const shared_ptr<EdgeFunction<l_t>> &)>
+        &WriteEF) {
+  if (auto *GC = dynamic_cast<GenConstant *>(F.get())) {
+    W.writeInt(LCAGenConstant);
+    W.writeSignedInt(GC->IntConst);
+    return true;
+  }
+  if (dynamic_cast<LCAIdentity *>(F.get())) {
+    W.writeInt(LCAIdentityFn);
+    return true;
+  }
+  if (auto *BO = dynamic_cast<BinOp *>(F.get())) {
+    W.writeInt(LCABinOp);
+    W.writeInt(BO->Op);
+    return writeBinOpOperand(W, BO->lop) && writeBinOpOperand(W, BO->rop) &&
+           writeBinOpOperand(W, BO->currNode);
+  }
+  if (auto *EFC = dynamic_cast<LCAEdgeFunctionComposer *>(F.get())) {
+    W.writeInt(LCAComposer);
+    return WriteEF(EFC->getFirst()) && WriteEF(EFC->getSecond());
+  }
+  return false;
+}
+
+shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
+IDELinearConstantAnalysis::readEdgeFunction(
+    CheckpointReader &R,
+    const std::function<shared_ptr<EdgeFunction<l_t>>()> &ReadEF) {
+  switch (R.readInt()) {
+  case LCAGenConstant:
+    return make_shared<GenConstant>(R.readSignedInt());
+  case LCAIdentityFn:
+    return make_shared<LCAIdentity>();
+  case LCABinOp: {
+    if (IRDB->getAllModules().empty()) {
+      return nullptr;
+    }
+    auto &Ctx = (*IRDB->getAllModules().begin())->getContext();
+    auto Op = static_cast<unsigned>(R.readInt());
+    const auto *Lop = readBinOpOperand(R, Ctx);
+    const auto *Rop = readBinOpOperand(R, Ctx);
+    const auto *CurrNode = readBinOpOperand(R, Ctx);
+    // the operands may be unknown if the IR has changed
+    if (!R.good() || !Lop || !Rop || !CurrNode) {
+      return nullptr;
+    }
+    return make_shared<BinOp>(Op, Lop, Rop, CurrNode);
+  }
+  case LCAComposer: {
+    auto First = ReadEF();
+    auto Second = ReadEF();
+    if (!First || !Second) {
+      return nullptr;
+    }
+    return make_shared<LCAEdgeFunctionComposer>(First, Second);
+  }
+  default:
+    return nullptr;
+  }
+}
+
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
 IDELinearConstantAnalysis::LCAEdgeFunctionComposer::composeWith(
     shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>> SecondFunction) {
@@ -577,6 +713,10 @@ bool IDELinearConstantAnalysis::GenConstant::equal_to(
   return this == Other.get();
 }
 
+size_t IDELinearConstantAnalysis::GenConstant::hash() const {
+  return std::hash<IDELinearConstantAnalysis::l_t>()(IntConst);
+}
+
 void IDELinearConstantAnalysis::GenConstant::print(ostream &OS,
                                                    bool IsForDebug) const {
   OS << IntConst << " (EF:" << GenConstant_Id << ')';
@@ -703,6 +843,11 @@ bool IDELinearConstantAnalysis::BinOp::equal_to(
   return this == Other.get();
 }
 
+size_t IDELinearConstantAnalysis::BinOp::hash() const {
+  return (std::hash<unsigned>()(Op) * 31 + std::hash<d_t>()(lop)) * 31 +
+         std::hash<d_t>()(rop);
+}
+
 void IDELinearConstantAnalysis::BinOp::print(ostream &OS,
                                              bool IsForDebug) const {
   if (const auto *LIC = llvm::dyn_cast<llvm::ConstantInt>(lop)) {
@@ -831,16 +976,20 @@ void IDELinearConstantAnalysis::emitTextReport(
       OS << "\nFunction: " << FName << "\n----------"
          << std::string(FName.size(), '-') << '\n';
       for (const auto *Stmt : ICF->getAllInstructionsOf(F)) {
-        auto Results = SR.resultsAt(Stmt, true);
-        stripBottomResults(Results);
-        if (!Results.empty()) {
-          OS << "At IR statement: " << NtoString(Stmt) << '\n';
-          for (auto Res : Results) {
-            if (Res.second != IDELinearConstantAnalysis::BOTTOM) {
-              OS << "   Fact: " << DtoString(Res.first)
-                 << "\n  Value: " << LtoString(Res.second) << '\n';
-            }
+        // the statement is only printed if it has non-bottom results
+        bool HasResults = false;
+        for (const auto &Res : SR.resultsViewAt(Stmt, true)) {
+          if (Res.second == IDELinearConstantAnalysis::BOTTOM) {
+            continue;
+          }
+          if (!HasResults) {
+            OS << "At IR statement: " << NtoString(Stmt) << '\n';
+            HasResults = true;
           }
+          OS << "   Fact: " << DtoString(Res.first)
+             << "\n  Value: " << LtoString(Res.second) << '\n';
+        }
+        if (HasResults) {
           OS << '\n';
         }
       }
@@ -912,18 +1061,17 @@ IDELinearConstantAnalysis::getLCAResults(
         FResults.erase(Lnr);
       } else {
         // check results of succ(stmt)
-        std::unordered_map<d_t, l_t> Results;
-        if (ICF->isExitStmt(Stmt)) {
-          Results = SR.resultsAt(Stmt, true);
-        } else {
+        const auto *ResultStmt = Stmt;
+        if (!ICF->isExitStmt(Stmt)) {
           // It's not a terminator inst, hence it has only a single successor
-          const auto *Succ = ICF->getSuccsOf(Stmt)[0];
-          std::cout << "Succ stmt: " << NtoString(Succ) << '\n';
-          Results = SR.resultsAt(Succ, true);
+          ResultStmt = ICF->getSuccsOf(Stmt)[0];
+          std::cout << "Succ stmt: " << NtoString(ResultStmt) << '\n';
         }
-        stripBottomResults(Results);
         std::set<std::string> ValidVarsAtStmt;
-        for (auto Res : Results) {
+        for (const auto &Res : SR.resultsViewAt(ResultStmt, true)) {
+          if (Res.second == IDELinearConstantAnalysis::BOTTOM) {
+            continue;
+          }
           auto VarName = getVarNameFromIR(Res.first);
           std::cout << "  D: " << DtoString(Res.first)
                     << " | V: " << LtoString(Res.second)
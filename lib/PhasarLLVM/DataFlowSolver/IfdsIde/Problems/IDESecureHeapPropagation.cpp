@@ -203,11 +203,11 @@ void IDESecureHeapPropagation::emitTextReport(
     Os << "\nFunction: " << FName << "\n----------"
        << std::string(FName.size(), '-') << '\n';
     for (const auto *Stmt : ICF->getAllInstructionsOf(F)) {
-      auto Results = SR.resultsAt(Stmt, true);
+      auto Results = SR.resultsViewAt(Stmt, true);
 
       if (!Results.empty()) {
         Os << "At IR statement: " << NtoString(Stmt) << '\n';
-        for (auto Res : Results) {
+        for (const auto &Res : Results) {
 
           Os << "   Fact: " << DtoString(Res.first)
              << "\n  Value: " << LtoString(Res.second) << '\n';
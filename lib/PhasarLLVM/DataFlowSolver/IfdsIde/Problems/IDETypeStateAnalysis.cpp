@@ -755,10 +755,10 @@ void IDETypeStateAnalysis::emitTextReport(
     OS << '\n' << getFunctionNameFromIR(F) << '\n';
     for (const auto &BB : *F) {
       for (const auto &I : BB) {
-        auto Results = SR.resultsAt(&I, true);
+        auto Results = SR.resultsViewAt(&I, true);
         if (ICF->isExitStmt(&I)) {
           OS << "\nAt exit stmt: " << NtoString(&I) << '\n';
-          for (auto Res : Results) {
+          for (const auto &Res : Results) {
             if (const auto *Alloca =
                     llvm::dyn_cast<llvm::AllocaInst>(Res.first)) {
               if (Res.second == TSD.error()) {
@@ -766,11 +766,10 @@ void IDETypeStateAnalysis::emitTextReport(
                    << DtoString(Res.first) << '\n';
                 for (const auto *Pred : ICF->getPredsOf(&I)) {
                   OS << "\nPredecessor: " << NtoString(Pred) << '\n';
-                  auto PredResults = SR.resultsAt(Pred, true);
-                  for (auto Res : PredResults) {
-                    if (Res.first == Alloca) {
-                      OS << "Pred State: " << LtoString(Res.second) << '\n';
-                    }
+                  auto PredResults = SR.resultsViewAt(Pred, true);
+                  if (PredResults.contains(Alloca)) {
+                    OS << "Pred State: " << LtoString(PredResults.at(Alloca))
+                       << '\n';
                   }
                 }
                 OS << "============================\n";
@@ -785,7 +784,7 @@ void IDETypeStateAnalysis::emitTextReport(
             }
           }
         } else {
-          for (auto Res : Results) {
+          for (const auto &Res : Results) {
             if (const auto *Alloca =
                     llvm::dyn_cast<llvm::AllocaInst>(Res.first)) {
               if (Res.second == TSD.error()) {
@@ -794,11 +793,10 @@ void IDETypeStateAnalysis::emitTextReport(
                    << "\nAt IR Inst: " << NtoString(&I) << '\n';
                 for (const auto *Pred : ICF->getPredsOf(&I)) {
                   OS << "\nPredecessor: " << NtoString(Pred) << '\n';
-                  auto PredResults = SR.resultsAt(Pred, true);
-                  for (auto Res : PredResults) {
-                    if (Res.first == Alloca) {
-                      OS << "Pred State: " << LtoString(Res.second) << '\n';
-                    }
+                  auto PredResults = SR.resultsViewAt(Pred, true);
+                  if (PredResults.contains(Alloca)) {
+                    OS << "Pred State: " << LtoString(PredResults.at(Alloca))
+                       << '\n';
                   }
                 }
                 OS << "============================\n";
@@ -77,7 +77,8 @@ IFDSConstAnalysis::getNormalFlowFunction(IFDSConstAnalysis::n_t Curr,
             LOG_IF_ENABLE(
                 BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Store Instruction sets up or updates vtable - ignored!");
-            return Identity<IFDSConstAnalysis::d_t>::getInstance();
+            return Identity<IFDSConstAnalysis::d_t,
+                            container_type>::getInstance();
           }
         }
         CFInst->deleteValue();
@@ -102,12 +103,11 @@ IFDSConstAnalysis::getNormalFlowFunction(IFDSConstAnalysis::n_t Curr,
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Compute context-relevant points-to "
                          "information for the pointer operand.");
-        return make_shared<
-            GenAll<IFDSConstAnalysis::d_t>>(/*pointsToSet*/
-                                            getContextRelevantPointsToSet(
-                                                PointsToSet,
-                                                Curr->getFunction()),
-                                            getZeroValue());
+        auto ToGenerate =
+            getContextRelevantPointsToSet(PointsToSet, Curr->getFunction());
+        return make_shared<GenAll<IFDSConstAnalysis::d_t, container_type>>(
+            container_type(ToGenerate.begin(), ToGenerate.end()),
+            getZeroValue());
       }
     }
     // If neither the pointer operand nor one of its alias is initialized,
@@ -120,7 +120,7 @@ IFDSConstAnalysis::getNormalFlowFunction(IFDSConstAnalysis::n_t Curr,
   } /* end store instruction */
 
   // Pass everything else as identity
-  return Identity<IFDSConstAnalysis::d_t>::getInstance();
+  return Identity<IFDSConstAnalysis::d_t, container_type>::getInstance();
 }
 
 IFDSConstAnalysis::FlowFunctionPtrType
@@ -130,7 +130,7 @@ IFDSConstAnalysis::getCallFlowFunction(IFDSConstAnalysis::n_t CallStmt,
   if (llvm::isa<llvm::MemIntrinsic>(CallStmt)) {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "Call statement is a LLVM MemIntrinsic!");
-    return KillAll<IFDSConstAnalysis::d_t>::getInstance();
+    return KillAll<IFDSConstAnalysis::d_t, container_type>::getInstance();
   }
   // Check if its a Call Instruction or an Invoke Instruction. If so, we
   // need to map all actual parameters into formal parameters.
@@ -141,7 +141,7 @@ IFDSConstAnalysis::getCallFlowFunction(IFDSConstAnalysis::n_t CallStmt,
                   << "Call statement: " << llvmIRToString(CallStmt));
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "Destination method: " << DestFun->getName().str());
-    return make_shared<MapFactsToCallee<>>(
+    return make_shared<MapFactsToCallee<container_type>>(
         llvm::ImmutableCallSite(CallStmt), DestFun,
         [](IFDSConstAnalysis::d_t Actual) {
           return Actual->getType()->isPointerTy();
@@ -149,7 +149,7 @@ IFDSConstAnalysis::getCallFlowFunction(IFDSConstAnalysis::n_t CallStmt,
   } /* end call/invoke instruction */
 
   // Pass everything else as identity
-  return Identity<IFDSConstAnalysis::d_t>::getInstance();
+  return Identity<IFDSConstAnalysis::d_t, container_type>::getInstance();
 }
 
 IFDSConstAnalysis::FlowFunctionPtrType IFDSConstAnalysis::getRetFlowFunction(
@@ -157,7 +157,7 @@ IFDSConstAnalysis::FlowFunctionPtrType IFDSConstAnalysis::getRetFlowFunction(
     IFDSConstAnalysis::n_t ExitStmt, IFDSConstAnalysis::n_t RetSite) {
   // return KillAll<IFDSConstAnalysis::d_t>::getInstance();
   // Map formal parameter back to the actual parameter in the caller.
-  return make_shared<MapFactsToCaller<>>(
+  return make_shared<MapFactsToCaller<container_type>>(
       llvm::ImmutableCallSite(CallSite), CalleeFun, ExitStmt,
       [](IFDSConstAnalysis::d_t Formal) {
         return Formal->getType()->isPointerTy();
@@ -184,12 +184,11 @@ IFDSConstAnalysis::getCallToRetFlowFunction(
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Compute context-relevant points-to "
                          "information of the pointer operand.");
-        return make_shared<
-            GenAll<IFDSConstAnalysis::d_t>>(/*pointsToSet*/
-                                            getContextRelevantPointsToSet(
-                                                PointsToSet,
-                                                CallSite->getFunction()),
-                                            getZeroValue());
+        auto ToGenerate =
+            getContextRelevantPointsToSet(PointsToSet, CallSite->getFunction());
+        return make_shared<GenAll<IFDSConstAnalysis::d_t, container_type>>(
+            container_type(ToGenerate.begin(), ToGenerate.end()),
+            getZeroValue());
       }
     }
     markAsInitialized(PointerOp);
@@ -198,7 +197,7 @@ IFDSConstAnalysis::getCallToRetFlowFunction(
   }
 
   // Pass everything else as identity
-  return Identity<IFDSConstAnalysis::d_t>::getInstance();
+  return Identity<IFDSConstAnalysis::d_t, container_type>::getInstance();
 }
 
 IFDSConstAnalysis::FlowFunctionPtrType
@@ -316,7 +315,7 @@ void IFDSConstAnalysis::emitTextReport(
   // 1) Remove all mutable memory locations
   for (const auto *F : ICF->getAllFunctions()) {
     for (const auto *Exit : ICF->getExitPointsOf(F)) {
-      std::set<const llvm::Value *> Facts = SR.ifdsResultsAt(Exit);
+      auto Facts = SR.resultsViewAt(Exit);
       // Empty facts means the exit statement is part of a not
       // analyzed function, thus remove all memory locations of that function
       if (Facts.empty()) {
@@ -332,7 +331,7 @@ void IFDSConstAnalysis::emitTextReport(
           }
         }
       } else {
-        for (const auto *Fact : Facts) {
+        for (const auto &[Fact, Value] : Facts) {
           if (isAllocaInstOrHeapAllocaFunction(Fact) ||
               llvm::isa<llvm::GlobalValue>(Fact)) {
             // remove memory locations that are mutable, i.e. are valid facts
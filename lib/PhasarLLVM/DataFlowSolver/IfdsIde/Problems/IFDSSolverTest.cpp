@@ -88,6 +88,10 @@ bool IFDSSolverTest::isZeroValue(IFDSSolverTest::d_t D) const {
   return LLVMZeroValue::getInstance()->isLLVMZeroValue(D);
 }
 
+std::string IFDSSolverTest::getSummaryCacheName() const {
+  return "IFDSSolverTest";
+}
+
 void IFDSSolverTest::printNode(ostream &OS, IFDSSolverTest::n_t N) const {
   OS << llvmIRToString(N);
 }
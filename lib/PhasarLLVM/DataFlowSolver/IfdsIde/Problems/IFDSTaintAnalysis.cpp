@@ -270,6 +270,29 @@ bool IFDSTaintAnalysis::isZeroValue(IFDSTaintAnalysis::d_t D) const {
   return LLVMZeroValue::getInstance()->isLLVMZeroValue(D);
 }
 
+bool IFDSTaintAnalysis::isSparseRelevant(IFDSTaintAnalysis::n_t Stmt,
+                                         IFDSTaintAnalysis::d_t Fact) const {
+  // Only the stores, loads and address computations that use the fact are
+  // not the identity for it, see getNormalFlowFunction()
+  if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Stmt)) {
+    return Store->getValueOperand() == Fact ||
+           Store->getPointerOperand() == Fact;
+  }
+  if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Stmt)) {
+    return Load->getPointerOperand() == Fact;
+  }
+  if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(Stmt)) {
+    return GEP->getPointerOperand() == Fact;
+  }
+  return false;
+}
+
+bool IFDSTaintAnalysis::isIdentityStmt(IFDSTaintAnalysis::n_t Stmt) const {
+  return !llvm::isa<llvm::StoreInst>(Stmt) &&
+         !llvm::isa<llvm::LoadInst>(Stmt) &&
+         !llvm::isa<llvm::GetElementPtrInst>(Stmt);
+}
+
 void IFDSTaintAnalysis::printNode(ostream &OS, IFDSTaintAnalysis::n_t N) const {
   OS << llvmIRToString(N);
 }
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+static uint64_t hashString(llvm::StringRef Str) {
+  // FNV-1a, which, in contrast to std::hash, is stable across runs
+  uint64_t Hash = 14695981039346656037ULL;
+  for (char C : Str) {
+    Hash = (Hash ^ static_cast<unsigned char>(C)) * 1099511628211ULL;
+  }
+  return Hash;
+}
+
+// prints V without its metadata attachments, which are printed last and
+// refer to module-wide metadata slots that change with other functions
+static void printWithoutMetadata(const llvm::Value &V,
+                                 llvm::ModuleSlotTracker &MST,
+                                 llvm::raw_ostream &OS) {
+  std::string Buffer;
+  llvm::raw_string_ostream BOS(Buffer);
+  V.print(BOS, MST);
+  OS << llvm::StringRef(BOS.str()).split(", !").first << '\n';
+}
+
+static uint64_t hashFunction(const llvm::Function &F,
+                             llvm::ModuleSlotTracker &MST) {
+  std::string Buffer;
+  llvm::raw_string_ostream OS(Buffer);
+  F.getFunctionType()->print(OS);
+  OS << ' ' << static_cast<unsigned>(F.getLinkage()) << '\n';
+  MST.incorporateFunction(F);
+  for (const auto &BB : F) {
+    BB.printAsOperand(OS, false, MST);
+    OS << ":\n";
+    for (const auto &I : BB) {
+      if (!llvm::isa<llvm::DbgInfoIntrinsic>(I)) {
+        printWithoutMetadata(I, MST, OS);
+      }
+    }
+  }
+  return hashString(OS.str());
+}
+
+std::map<std::string, uint64_t> getCheckpointHashes(const ProjectIRDB &IRDB) {
+  std::map<std::string, uint64_t> Hashes;
+  for (const auto *M : IRDB.getAllModules()) {
+    llvm::ModuleSlotTracker MST(M, false);
+    for (const auto &G : M->globals()) {
+      if (G.hasName()) {
+        std::string Buffer;
+        llvm::raw_string_ostream OS(Buffer);
+        printWithoutMetadata(G, MST, OS);
+        // equally named values of different modules are ambiguous anyway
+        Hashes['@' + G.getName().str()] += hashString(OS.str());
+      }
+    }
+    for (const auto &F : *M) {
+      if (F.hasName()) {
+        Hashes['@' + F.getName().str()] += hashFunction(F, MST);
+      }
+    }
+  }
+  return Hashes;
+}
+
+} // namespace psr
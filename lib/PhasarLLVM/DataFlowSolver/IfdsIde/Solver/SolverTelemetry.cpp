@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <fstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverTelemetry.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+size_t getResidentSetSize() {
+#ifdef __linux__
+  // the second field is the number of resident pages
+  ifstream Statm("/proc/self/statm");
+  size_t Pages;
+  size_t ResidentPages;
+  if (Statm >> Pages >> ResidentPages) {
+    return ResidentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  struct rusage Usage;
+  if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<size_t>(Usage.ru_maxrss);
+#else
+  // in kilobytes
+  return static_cast<size_t>(Usage.ru_maxrss) * 1024;
+#endif
+}
+
+} // namespace psr
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <string>
+#include <utility>
+
+#include "llvm/IR/Instruction.h"
+#include "llvm/Support/JSON.h"
+
+#include "phasar/PhasarLLVM/Utils/ResultsExporter.h"
+#include "phasar/Utils/LLVMIRToSrc.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+ExportedLocation::ExportedLocation(const llvm::Instruction *I)
+    : Id(getMetaDataID(I)), Function(getFunctionNameFromIR(I)),
+      File(getFilePathFromIR(I)), Line(getLineFromIR(I)),
+      Column(getColumnFromIR(I)) {}
+
+void ExportedLocation::writeJSON(llvm::json::OStream &J) const {
+  J.attribute("id", toJSONString(Id));
+  J.attribute("function", toJSONString(Function));
+  J.attribute("file", toJSONString(File));
+  J.attribute("line", Line);
+  J.attribute("column", Column);
+}
+
+void ExportedLocation::writeSARIF(llvm::json::OStream &J) const {
+  J.attributeArray("locations", [&] {
+    J.object([&] {
+      if (!File.empty()) {
+        J.attributeObject("physicalLocation", [&] {
+          J.attributeObject("artifactLocation",
+                            [&] { J.attribute("uri", toJSONString(File)); });
+          // SARIF lines and columns start at 1
+          if (Line > 0) {
+            J.attributeObject("region", [&] {
+              J.attribute("startLine", Line);
+              if (Column > 0) {
+                J.attribute("startColumn", Column);
+              }
+            });
+          }
+        });
+      }
+      J.attributeArray("logicalLocations", [&] {
+        J.object([&] {
+          J.attribute("fullyQualifiedName", toJSONString(Function));
+          J.attribute("kind", "function");
+        });
+      });
+      // the IR statement, such that results without debug information can
+      // still be told apart
+      J.attributeObject("properties",
+                        [&] { J.attribute("psr.id", toJSONString(Id)); });
+    });
+  });
+}
+
+llvm::json::Value toJSONString(std::string S) {
+  if (llvm::json::isUTF8(S)) {
+    return llvm::json::Value(std::move(S));
+  }
+  return llvm::json::Value(llvm::json::fixUTF8(S));
+}
+
+void writeSARIFTool(llvm::json::OStream &J) {
+  J.attributeObject("tool", [&] {
+    J.attributeObject("driver", [&] {
+      J.attribute("name", "PhASAR");
+      J.attribute("informationUri", "https://phasar.org");
+      J.attributeArray("rules", [&] {
+        J.object([&] {
+          J.attribute("id", "data-flow-fact");
+          J.attributeObject("shortDescription", [&] {
+            J.attribute("text",
+                        "A data-flow fact that holds at a program statement");
+          });
+        });
+      });
+    });
+  });
+}
+
+} // namespace psr
@@ -17,6 +17,7 @@
 #include <cassert>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 
 #include "boost/filesystem.hpp"
@@ -134,6 +135,7 @@ std::string PAMM::getPrintableDuration(unsigned long Duration) {
 }
 
 void PAMM::regCounter(const std::string &CounterId, unsigned IntialValue) {
+  std::lock_guard<std::mutex> Lock(CounterMutex);
   bool ValidCounterId = !Counter.count(CounterId);
   assert(ValidCounterId && "regCounter failed due to an invalid counter id");
   if (ValidCounterId) {
@@ -142,6 +144,7 @@ void PAMM::regCounter(const std::string &CounterId, unsigned IntialValue) {
 }
 
 void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
+  std::lock_guard<std::mutex> Lock(CounterMutex);
   bool ValidCounterId = Counter.count(CounterId);
   assert(ValidCounterId && "incCounter failed due to an invalid counter id");
   if (ValidCounterId) {
@@ -150,6 +153,7 @@ void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
 }
 
 void PAMM::decCounter(const std::string &CounterId, unsigned CValue) {
+  std::lock_guard<std::mutex> Lock(CounterMutex);
   bool ValidCounterId = Counter.count(CounterId);
   assert(ValidCounterId && "decCounter failed due to an invalid counter id");
   if (ValidCounterId) {
@@ -158,6 +162,7 @@ void PAMM::decCounter(const std::string &CounterId, unsigned CValue) {
 }
 
 int PAMM::getCounter(const std::string &CounterId) {
+  std::lock_guard<std::mutex> Lock(CounterMutex);
   bool ValidCounterId = Counter.count(CounterId);
   assert(ValidCounterId && "getCounter failed due to an invalid counter id");
   if (ValidCounterId) {
@@ -181,6 +186,7 @@ int PAMM::getSumCount(const std::set<std::string> &CounterIds) {
 }
 
 void PAMM::regHistogram(const std::string &HistogramId) {
+  std::lock_guard<std::mutex> Lock(CounterMutex);
   bool ValidHid = !Histogram.count(HistogramId);
   assert(ValidHid && "failed to register new histogram due to an invalid id");
   if (ValidHid) {
@@ -192,6 +198,7 @@ void PAMM::regHistogram(const std::string &HistogramId) {
 void PAMM::addToHistogram(const std::string &HistogramId,
                           const std::string &DataPointId,
                           unsigned long DataPointValue) {
+  std::lock_guard<std::mutex> Lock(CounterMutex);
   bool ValidHistoId = Histogram.count(HistogramId);
   assert(ValidHistoId &&
          "adding data point to histogram failed due to invalid id");
@@ -347,6 +354,7 @@ void PAMM::reset() {
   RunningTimer.clear();
   StoppedTimer.clear();
   RepeatingTimer.clear();
+  std::lock_guard<std::mutex> Lock(CounterMutex);
   Counter.clear();
   Histogram.clear();
 }
@@ -20,9 +20,11 @@
 #include "boost/filesystem.hpp"
 #include "phasar/Config/Configuration.h"
 #include "phasar/Controller/AnalysisController.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 #include "phasar/PhasarLLVM/Plugins/AnalysisPluginController.h"
 #include "phasar/PhasarLLVM/Plugins/PluginFactories.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/SoundnessFlag.h"
 
@@ -64,8 +66,11 @@ void validateParamModule(const std::vector<std::string> &Modules) {
 }
 
 void validateParamExport(const std::string &Export) {
-  throw boost::program_options::error_with_option_name(
-      "Parameter not supported, yet.");
+  auto Format = toIOFormat(Export);
+  if (Format != IOFormat::JSON && Format != IOFormat::SARIF) {
+    throw boost::program_options::error_with_option_name(
+        "Invalid export format '" + Export + "'!");
+  }
 }
 
 void validateParamOutput(const std::string &Output) {
@@ -102,6 +107,13 @@ void validateParamAnalysisStrategy(const std::string &Strategy) {
   }
 }
 
+void validateParamWorklistPolicy(const std::string &Policy) {
+  if (toWorklistPolicy(Policy) == WorklistPolicy::None) {
+    throw boost::program_options::error_with_option_name(
+        "Invalid worklist policy '" + Policy + "'!");
+  }
+}
+
 void validateParamPointerAnalysis(const std::string &Analysis) {
   if (toPointerAnalysisType(Analysis) == PointerAnalysisType::Invalid) {
     throw boost::program_options::error_with_option_name(
@@ -178,18 +190,33 @@ int main(int Argc, const char **Argv) {
       ("entry-points,E", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing(), "Set the entry point(s) to be used")
 			("data-flow-analysis,D", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()/*->notifier(&validateParamDataFlowAnalysis)*/, "Set the analysis to be run")
 			("analysis-strategy", boost::program_options::value<std::string>()->default_value("WPA")->notifier(&validateParamAnalysisStrategy))
+      ("query", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing(), "Set the statement(s) to be queried by the demand-driven analysis strategy (DD), given as '<statement-id>' or '<statement-id>:<fact-id>'")
+      ("worklist-policy", boost::program_options::value<std::string>()->notifier(&validateParamWorklistPolicy)->default_value("LIFO"), "Set the order in which the IFDS/IDE solver processes path edges (FIFO, LIFO, Priority, ReversePostOrder)")
+      ("intern-edge-functions", "Share equal edge functions and memoize their compositions and joins in the IDE solver")
+      ("low-memory", "Release intra-procedural jump functions once no path edge of their function is pending and recompute them per function to compute the values")
+      ("checkpoint", boost::program_options::value<std::string>(), "Periodically write the IDE solver's state to the given file, the incremental analysis strategy (INC) re-uses the state of the previous run from it")
+      ("checkpoint-interval", boost::program_options::value<unsigned>()->default_value(600), "Set the minimal number of seconds between two checkpoints")
+      ("progress-interval", boost::program_options::value<unsigned>()->default_value(10), "Set the minimal number of seconds between two progress reports of the IDE and IFDS solvers, 0 disables them (requires PAMM)")
+      ("hot-functions", boost::program_options::value<unsigned>()->default_value(10), "Set the number of functions the IDE and IFDS solvers have spent the most work on to be reported (requires PAMM)")
+      ("resume", "Resume the IDE solver from the checkpoint file if it exists")
+      ("summary-cache", boost::program_options::value<std::string>(), "Re-use the procedure summaries of shared functions cached in the given directory and add the ones computed by the IDE solver; the results lack the values inside functions in the contexts whose summaries are re-used and cannot be emitted")
+      ("fact-index", "Index the results of the IFDS/IDE solver by data-flow fact, such that the statements a fact holds at can be queried efficiently")
+      ("sparse", "Propagate data-flow facts in the IFDS/IDE solver only between the statements that are relevant for them, if supported by the analysis")
+      ("compress-identity-chains", "Collapse the chains of statements that do not affect any data-flow fact before running the IFDS/IDE solver, if supported by the analysis")
+      ("batch-flow-functions", "Apply each normal, call and return flow function to all data-flow facts pending at the same statement at once in the sequential IDE solver")
+      ("summary-dir", boost::program_options::value<std::string>(), "Persist the procedure summaries of the module-wise analysis strategy (MWA) in the given directory and re-use them in subsequent runs")
       ("analysis-config", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()->notifier(&validateParamAnalysisConfig), "Set the analysis's configuration (if required)")
       ("pointer-analysis,P", boost::program_options::value<std::string>()->notifier(&validateParamPointerAnalysis)->default_value("CFLAnders"), "Set the points-to analysis to be used (CFLSteens, CFLAnders)")
       ("call-graph-analysis,C", boost::program_options::value<std::string>()->notifier(&validateParamCallGraphAnalysis)->default_value("OTF"), "Set the call-graph algorithm to be used (NORESOLVE, CHA, RTA, DTA, VTA, OTF)")
       ("soundiness-flag", boost::program_options::value<std::string>()->notifier(&validateSoundnessFlag)->default_value("SOUNDY"), "Set the soundiness level to be used (SOUND,SOUNDY,UNSOUND)")
 			("classhierarchy-analysis,H", "Class-hierarchy analysis")
 			("statistical-analysis,S", "Statistics")
-			("mwa,M", "Enable Modulewise-program analysis mode")
+			("mwa,M", "Enable Modulewise-program analysis mode, same as '--analysis-strategy MWA'")
 			("printedgerec,R", "Print exploded-super-graph edge recorder")
       #ifdef DYNAMIC_LOG
       ("log,L", "Enable logging")
       #endif
-      ("export,E", boost::program_options::value<std::string>()->notifier(&validateParamExport), "Export mode (JSON, SARIF) (Not implemented yet!)")
+      ("export", boost::program_options::value<std::string>()->notifier(&validateParamExport), "Export the solver results in the given format (JSON, SARIF)")
       ("project-id,I", boost::program_options::value<std::string>()->default_value("default-phasar-project"), "Project id used for output")
       ("out,O", boost::program_options::value<std::string>()->notifier(&validateParamOutput)->default_value(""), "Output directory; if specified all results are written to the output directory instead of stdout")
       ("emit-ir", "Emit preprocessed and annotated IR of analysis target")
@@ -289,14 +316,22 @@ int main(int Argc, const char **Argv) {
   } else {
     Strategy = AnalysisStrategy::WholeProgram;
   }
+  if (PhasarConfig::VariablesMap().count("mwa")) {
+    Strategy = AnalysisStrategy::ModuleWise;
+  }
   if (!PhasarConfig::VariablesMap().count("module")) {
     std::cout << "At least on LLVM target module is required!\n"
                  "Specify a LLVM target module or re-run with '--help'\n";
     return 0;
   }
-  // setup IRDB as source code manager
-  ProjectIRDB IRDB(
-      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>());
+  // setup IRDB as source code manager, the module-wise analysis strategy
+  // loads the modules of each unit on its own and leaves it empty
+  const auto IRFiles =
+      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>();
+  ProjectIRDB IRDB(Strategy == AnalysisStrategy::ModuleWise
+                       ? std::vector<std::string>{}
+                       : IRFiles,
+                   IRDBOptions::WPA | IRDBOptions::OWNS);
 
   // store enabled data-flow analyses
   std::vector<DataFlowAnalysisKind> DataFlowAnalyses;
@@ -364,8 +399,12 @@ int main(int Argc, const char **Argv) {
   SoundnessFlag SF = toSoundnessFlag(
       PhasarConfig::VariablesMap()["soundiness-flag"].as<std::string>());
   // setup the emitter options to display the computed analysis results
+  // the results of an analysis that uses the summary cache are incomplete
+  // and are only emitted on request, which the controller refuses
   AnalysisControllerEmitterOptions EmitterOptions =
-      AnalysisControllerEmitterOptions::EmitTextReport;
+      PhasarConfig::VariablesMap().count("summary-cache")
+          ? AnalysisControllerEmitterOptions::None
+          : AnalysisControllerEmitterOptions::EmitTextReport;
   if (PhasarConfig::VariablesMap().count("emit-ir")) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitIR;
   }
@@ -408,6 +447,13 @@ int main(int Argc, const char **Argv) {
   if (PhasarConfig::VariablesMap().count("emit-pta-as-json")) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitPTAAsJson;
   }
+  if (PhasarConfig::VariablesMap().count("export")) {
+    auto Format =
+        toIOFormat(PhasarConfig::VariablesMap()["export"].as<std::string>());
+    EmitterOptions |= (Format == IOFormat::SARIF)
+                          ? AnalysisControllerEmitterOptions::ExportAsSarif
+                          : AnalysisControllerEmitterOptions::ExportAsJson;
+  }
   // setup output directory
   std::string OutDirectory;
   if (PhasarConfig::VariablesMap().count("out")) {
@@ -418,8 +464,14 @@ int main(int Argc, const char **Argv) {
   if (PhasarConfig::VariablesMap().count("project-id")) {
     ProjectID = PhasarConfig::VariablesMap()["project-id"].as<std::string>();
   }
+  // setup queries for the demand-driven analysis strategy
+  std::vector<std::string> Queries;
+  if (PhasarConfig::VariablesMap().count("query")) {
+    Queries =
+        PhasarConfig::VariablesMap()["query"].as<std::vector<std::string>>();
+  }
   AnalysisController Controller(IRDB, DataFlowAnalyses, AnalysisConfigs, PTATy,
                                 CGTy, SF, EntryPoints, Strategy, EmitterOptions,
-                                ProjectID, OutDirectory);
+                                ProjectID, OutDirectory, Queries, IRFiles);
   return 0;
 }
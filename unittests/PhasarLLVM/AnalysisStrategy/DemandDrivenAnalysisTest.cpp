@@ -0,0 +1,139 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class DemandDrivenAnalysisTest : public ::testing::Test {
+protected:
+  const std::set<std::string> EntryPoints = {"main"};
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void initialize(const std::string &IRFile) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{unittest::PathToLLTestFiles + IRFile},
+        IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           EntryPoints, TH.get(), PT.get());
+  }
+
+  // Solves the problem for the whole program and answers a single query for
+  // each instruction using a fresh demand-driven analysis; the results at the
+  // queried instruction must be the same.
+  template <typename Solver, typename ProblemDescription>
+  void compareWithWholeProgram(const std::string &IRFile) {
+    initialize(IRFile);
+    ProblemDescription Problem(IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+                               EntryPoints);
+    Solver WPASolver(Problem);
+    WPASolver.solve();
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        DemandDrivenAnalysis<Solver, ProblemDescription> DDA(*IRDB,
+                                                             EntryPoints);
+        DDA.addQuery(&I);
+        DDA.solve();
+        EXPECT_EQ(WPASolver.resultsAt(&I, true), DDA.resultsAt(&I))
+            << "Results differ at " << llvmIRToString(&I);
+      }
+    }
+  }
+}; // Test Fixture
+
+TEST_F(DemandDrivenAnalysisTest, LinearConstantBasic) {
+  compareWithWholeProgram<IDESolver_P<IDELinearConstantAnalysis>,
+                          IDELinearConstantAnalysis>(
+      "linear_constant/basic_04_cpp_dbg.ll");
+}
+
+TEST_F(DemandDrivenAnalysisTest, LinearConstantCalls) {
+  compareWithWholeProgram<IDESolver_P<IDELinearConstantAnalysis>,
+                          IDELinearConstantAnalysis>(
+      "linear_constant/call_08_cpp_dbg.ll");
+}
+
+TEST_F(DemandDrivenAnalysisTest, LinearConstantGlobals) {
+  compareWithWholeProgram<IDESolver_P<IDELinearConstantAnalysis>,
+                          IDELinearConstantAnalysis>(
+      "linear_constant/global_05_cpp_dbg.ll");
+}
+
+TEST_F(DemandDrivenAnalysisTest, LinearConstantRecursion) {
+  compareWithWholeProgram<IDESolver_P<IDELinearConstantAnalysis>,
+                          IDELinearConstantAnalysis>(
+      "linear_constant/recursion_02_cpp_dbg.ll");
+}
+
+TEST_F(DemandDrivenAnalysisTest, UninitializedVariables) {
+  compareWithWholeProgram<NativeIFDSSolver_P<IFDSUninitializedVariables>,
+                          IFDSUninitializedVariables>(
+      "uninitialized_variables/callsite_cpp_dbg.ll");
+}
+
+TEST_F(DemandDrivenAnalysisTest, ExploresOnDemand) {
+  initialize("linear_constant/call_08_cpp_dbg.ll");
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const llvm::Instruction *First = &Main->front().front();
+  const llvm::Instruction *Last = &Main->back().back();
+  DemandDrivenAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                       IDELinearConstantAnalysis>
+      DDA(*IRDB, EntryPoints);
+  DDA.addQuery(First);
+  DDA.solve();
+  // nothing can flow into main's first instruction
+  EXPECT_EQ(std::set<const llvm::Instruction *>{First},
+            DDA.getRelevantStatements());
+  // querying another statement extends the explored part of the program
+  IDELinearConstantAnalysis Problem(IRDB.get(), TH.get(), ICFG.get(),
+                                    PT.get(), EntryPoints);
+  IDESolver_P<IDELinearConstantAnalysis> WPASolver(Problem);
+  WPASolver.solve();
+  EXPECT_EQ(WPASolver.resultsAt(Last, true), DDA.resultsAt(Last));
+  EXPECT_TRUE(DDA.getRelevantStatements().count(First));
+  EXPECT_TRUE(DDA.getRelevantStatements().count(Last));
+  for (const auto &[Fact, Value] : WPASolver.resultsAt(Last, true)) {
+    EXPECT_TRUE(DDA.holds(Last, Fact));
+  }
+  EXPECT_FALSE(DDA.holds(First, Last));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "boost/filesystem/operations.hpp"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class IncrementalUpdateAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  using Analysis = IncrementalUpdateAnalysis<
+      IDESolver_P<IDELinearConstantAnalysis>, IDELinearConstantAnalysis>;
+
+  std::string StateFile;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    StateFile = (boost::filesystem::temp_directory_path() /
+                 boost::filesystem::unique_path("phasar-%%%%-%%%%.ckpt"))
+                    .string();
+  }
+
+  void TearDown() override { boost::filesystem::remove(StateFile); }
+
+  // Loads the IR from scratch, such that every run re-binds the persisted
+  // state as if the analysis had been restarted. If ChangedFunction is given,
+  // the first occurrence of the constant Val in it is incremented.
+  std::unique_ptr<ProjectIRDB> loadIR(const std::string &IRFile,
+                                      const std::string &ChangedFunction = "",
+                                      int64_t Val = 0) {
+    ValueAnnotationPass::resetValueID();
+    auto IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+    if (!ChangedFunction.empty()) {
+      auto *F = IRDB->getModuleDefiningFunction(ChangedFunction)
+                    ->getFunction(ChangedFunction);
+      for (auto &I : llvm::instructions(F)) {
+        for (unsigned Idx = 0; Idx < I.getNumOperands(); ++Idx) {
+          const auto *CI =
+              llvm::dyn_cast<llvm::ConstantInt>(I.getOperand(Idx));
+          if (CI && CI->getSExtValue() == Val) {
+            I.setOperand(Idx, llvm::ConstantInt::get(CI->getType(), Val + 1));
+            return IRDB;
+          }
+        }
+      }
+      ADD_FAILURE() << "The constant " << Val << " does not occur in "
+                    << ChangedFunction;
+    }
+    return IRDB;
+  }
+
+  // Returns the results of all instructions keyed on the instructions' and
+  // facts' IDs such that results for different ProjectIRDBs can be compared.
+  template <typename SolverTy>
+  static std::map<std::string, std::map<std::string, int64_t>>
+  getResults(ProjectIRDB &IRDB, SolverTy &Solver) {
+    std::map<std::string, std::map<std::string, int64_t>> Results;
+    for (const auto *F : IRDB.getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        auto &InstResults = Results[getCheckpointId(&I)];
+        for (const auto &[Fact, Value] : Solver.resultsAt(&I)) {
+          InstResults[getCheckpointId(Fact)] = Value;
+        }
+      }
+    }
+    return Results;
+  }
+
+  // Analyzes the unchanged IR to persist its state, re-analyzes the changed
+  // IR incrementally and compares the results with the ones of a
+  // from-scratch analysis. Returns the names of the re-analyzed functions.
+  std::set<std::string> checkUpdate(const std::string &IRFile,
+                                    const std::string &ChangedFunction = "",
+                                    int64_t Val = 0) {
+    {
+      auto IRDB = loadIR(IRFile);
+      Analysis IUA(*IRDB, EntryPoints);
+      IUA.setStateFile(StateFile);
+      IUA.solve();
+      // there is no state to start from
+      EXPECT_FALSE(IUA.getInvalidatedFunctions().has_value());
+    }
+    auto ReferenceIRDB = loadIR(IRFile, ChangedFunction, Val);
+    LLVMTypeHierarchy TH(*ReferenceIRDB);
+    LLVMPointsToSet PT(*ReferenceIRDB);
+    LLVMBasedICFG ICFG(*ReferenceIRDB, CallGraphAnalysisType::OTF,
+                       EntryPoints, &TH, &PT);
+    IDELinearConstantAnalysis Problem(ReferenceIRDB.get(), &TH, &ICFG, &PT,
+                                      EntryPoints);
+    IDESolver_P<IDELinearConstantAnalysis> Reference(Problem);
+    Reference.solve();
+
+    auto IRDB = loadIR(IRFile, ChangedFunction, Val);
+    Analysis IUA(*IRDB, EntryPoints);
+    IUA.setStateFile(StateFile);
+    IUA.solve();
+    EXPECT_EQ(getResults(*ReferenceIRDB, Reference), getResults(*IRDB, IUA));
+    std::set<std::string> Invalidated;
+    if (IUA.getInvalidatedFunctions()) {
+      for (const auto *F : *IUA.getInvalidatedFunctions()) {
+        Invalidated.insert(F->getName().str());
+      }
+    }
+    return Invalidated;
+  }
+}; // Test Fixture
+
+TEST_F(IncrementalUpdateAnalysisTest, Unchanged) {
+  EXPECT_EQ(std::set<std::string>{}, checkUpdate("call_07_cpp_dbg.ll"));
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, ChangedCaller) {
+  // the summaries of increment() are re-used
+  EXPECT_EQ(std::set<std::string>{"main"},
+            checkUpdate("call_07_cpp_dbg.ll", "main", 42));
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, ChangedCallee) {
+  EXPECT_EQ((std::set<std::string>{"_Z3foov", "main"}),
+            checkUpdate("call_03_cpp_dbg.ll", "_Z3foov", 42));
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, ChangedRecursion) {
+  EXPECT_EQ(std::set<std::string>{"main"},
+            checkUpdate("recursion_02_cpp_dbg.ll", "main", 5));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,175 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "boost/filesystem/operations.hpp"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class ModuleWiseAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "module_wise/module_wise_1/";
+  const std::set<std::string> EntryPoints = {"main"};
+  const std::vector<std::string> IRFiles = getIRFiles("module_wise_1");
+
+  using Analysis = ModuleWiseAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                                      IDELinearConstantAnalysis>;
+  using ResultsTy = std::map<std::string, std::map<std::string, int64_t>>;
+
+  std::string SummaryDirectory;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    SummaryDirectory = (boost::filesystem::temp_directory_path() /
+                        boost::filesystem::unique_path("phasar-%%%%-%%%%"))
+                           .string();
+  }
+
+  void TearDown() override { boost::filesystem::remove_all(SummaryDirectory); }
+
+  // the IR files of main.cpp, src1.cpp and src2.cpp in the given directory
+  static std::vector<std::string> getIRFiles(const std::string &Directory) {
+    const std::string Path =
+        unittest::PathToLLTestFiles + "module_wise/" + Directory + "/";
+    return {Path + "main_cpp.ll", Path + "src1_cpp.ll", Path + "src2_cpp.ll"};
+  }
+
+  // Returns the results of all instructions keyed on the instructions' and
+  // facts' IDs such that results for different ProjectIRDBs can be compared.
+  template <typename SolverTy>
+  static ResultsTy getResults(ProjectIRDB &IRDB, SolverTy &Solver) {
+    ResultsTy Results;
+    for (const auto *F : IRDB.getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        auto &InstResults = Results[getCheckpointId(&I)];
+        for (const auto &[Fact, Value] : Solver.resultsAt(&I)) {
+          InstResults[getCheckpointId(Fact)] = Value;
+        }
+      }
+    }
+    return Results;
+  }
+
+  ResultsTy solveWholeProgram(const std::vector<std::string> &IRFiles) {
+    ProjectIRDB IRDB(IRFiles, IRDBOptions::WPA);
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    IDELinearConstantAnalysis Problem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+    IDESolver_P<IDELinearConstantAnalysis> Solver(Problem);
+    Solver.solve();
+    return getResults(IRDB, Solver);
+  }
+
+  // Returns the results of the unit that contains the main function, which
+  // covers every function of every unit.
+  ResultsTy solveModuleWise(Analysis &MWA) {
+    ResultsTy Results;
+    MWA.solve([&](const ModuleWiseUnit &Unit, ProjectIRDB &IRDB,
+                  IDESolver_P<IDELinearConstantAnalysis> &Solver) {
+      if (Unit.ExportedFunctions.count("main")) {
+        Results = getResults(IRDB, Solver);
+      }
+    });
+    return Results;
+  }
+}; // Test Fixture
+
+TEST_F(ModuleWiseAnalysisTest, DependencyOrder) {
+  auto Units = getModuleWiseUnits(IRFiles);
+  ASSERT_EQ(3U, Units.size());
+  // main uses the functions of both other modules, which are independent
+  EXPECT_EQ(std::vector<std::string>{PathToLlFiles + "main_cpp.ll"},
+            Units[2].IRFiles);
+  EXPECT_EQ((std::set<size_t>{0, 1}), Units[2].Dependencies);
+  EXPECT_TRUE(Units[0].Dependencies.empty());
+  EXPECT_TRUE(Units[1].Dependencies.empty());
+  EXPECT_EQ(std::set<std::string>{"main"}, Units[2].ExportedFunctions);
+  std::set<std::string> Names;
+  for (const auto &Unit : Units) {
+    Names.insert(Unit.Name);
+  }
+  EXPECT_EQ(3U, Names.size());
+}
+
+TEST_F(ModuleWiseAnalysisTest, LoadsUnitAndCallees) {
+  auto Units = getModuleWiseUnits(IRFiles);
+  ASSERT_EQ(3U, Units.size());
+  auto IRDB = loadModuleWiseUnitIR(Units[2], Units);
+  EXPECT_EQ(1U, IRDB->getNumberOfModules());
+  for (const auto *Name :
+       {"main", "_Z14generate_taintv", "_Z14do_computationi", "_Z8sanitizei",
+        "_Z10leak_tainti"}) {
+    EXPECT_NE(nullptr, IRDB->getFunctionDefinition(Name)) << Name;
+  }
+  // the dependencies are analyzed without the modules that use them
+  auto DependencyIRDB = loadModuleWiseUnitIR(Units[0], Units);
+  EXPECT_EQ(nullptr, DependencyIRDB->getFunction("main"));
+}
+
+TEST_F(ModuleWiseAnalysisTest, LoadsTransitiveCallees) {
+  // main calls foo, which calls boo of the same module
+  auto Files = getIRFiles("module_wise_6");
+  auto Units = getModuleWiseUnits(Files);
+  ASSERT_EQ(3U, Units.size());
+  auto IRDB = loadModuleWiseUnitIR(Units[2], Units);
+  for (const auto *Name :
+       {"main", "_Z3incRi", "_Z3fooRi", "_Z3barRi", "_Z3booRi"}) {
+    EXPECT_NE(nullptr, IRDB->getFunctionDefinition(Name)) << Name;
+  }
+}
+
+TEST_F(ModuleWiseAnalysisTest, SameResultsAsWholeProgram) {
+  Analysis MWA(IRFiles, EntryPoints);
+  auto Results = solveModuleWise(MWA);
+  EXPECT_EQ(3U, MWA.getNumAnalyzedUnits());
+  EXPECT_EQ(solveWholeProgram(IRFiles), Results);
+}
+
+TEST_F(ModuleWiseAnalysisTest, SameResultsAsWholeProgramTransitive) {
+  auto Files = getIRFiles("module_wise_6");
+  Analysis MWA(Files, EntryPoints);
+  auto Results = solveModuleWise(MWA);
+  EXPECT_EQ(3U, MWA.getNumAnalyzedUnits());
+  EXPECT_EQ(solveWholeProgram(Files), Results);
+}
+
+TEST_F(ModuleWiseAnalysisTest, ReusesPersistedSummaries) {
+  auto Expected = solveWholeProgram(IRFiles);
+  for (unsigned Run = 0; Run < 2; ++Run) {
+    Analysis MWA(IRFiles, EntryPoints);
+    MWA.setSummaryDirectory(SummaryDirectory);
+    EXPECT_EQ(Expected, solveModuleWise(MWA));
+    for (const auto &Unit : getModuleWiseUnits(IRFiles)) {
+      EXPECT_TRUE(boost::filesystem::exists(
+          boost::filesystem::path(SummaryDirectory) / (Unit.Name + ".ckpt")));
+    }
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
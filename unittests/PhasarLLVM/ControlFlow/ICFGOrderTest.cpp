@@ -0,0 +1,125 @@
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/ICFGOrder.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+using OrderTy = ICFGOrder<const llvm::Instruction *, const llvm::Function *>;
+
+/* ============== TEST FIXTURE ============== */
+class ICFGOrderTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void initialize(const std::string &IRFile) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           EntryPoints, TH.get(), PT.get());
+  }
+}; // Test Fixture
+
+TEST_F(ICFGOrderTest, CalleesFirst) {
+  initialize("call_11_cpp_dbg.ll");
+  OrderTy Order(*ICFG);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  const auto *Foo = IRDB->getFunctionDefinition("_Z3fooi");
+  const auto *Bar = IRDB->getFunctionDefinition("_Z3bari");
+  EXPECT_LT(Order.getSCCRank(Bar), Order.getSCCRank(Foo));
+  EXPECT_LT(Order.getSCCRank(Foo), Order.getSCCRank(Main));
+  // all statements of a callee come before the ones of its callers
+  EXPECT_LT(Order.getPriority(&Bar->back().back()),
+            Order.getPriority(&Foo->front().front()));
+  EXPECT_LT(Order.getPriority(&Foo->back().back()),
+            Order.getPriority(&Main->front().front()));
+}
+
+TEST_F(ICFGOrderTest, Recursion) {
+  initialize("recursion_02_cpp_dbg.ll");
+  OrderTy Order(*ICFG);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  const auto *Fac = IRDB->getFunctionDefinition("_Z3facj");
+  EXPECT_NE(OrderTy::Unknown, Order.getSCCRank(Fac));
+  EXPECT_LT(Order.getSCCRank(Fac), Order.getSCCRank(Main));
+}
+
+TEST_F(ICFGOrderTest, ReversePostOrder) {
+  initialize("while_03_cpp_dbg.ll");
+  OrderTy Order(*ICFG);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  std::set<size_t> Indices;
+  size_t NumRetreatingEdges = 0;
+  for (const auto &I : llvm::instructions(Main)) {
+    Indices.insert(Order.getRPOIndex(&I));
+    for (const auto *Succ : ICFG->getSuccsOf(&I)) {
+      if (Order.getRPOIndex(Succ) <= Order.getRPOIndex(&I)) {
+        ++NumRetreatingEdges;
+      }
+    }
+  }
+  EXPECT_EQ(0U, Order.getRPOIndex(&Main->front().front()));
+  EXPECT_EQ(Main->getInstructionCount(), Indices.size());
+  EXPECT_EQ(Main->getInstructionCount() - 1, *Indices.rbegin());
+  // only the back edge of the loop leads to an earlier statement
+  EXPECT_EQ(1U, NumRetreatingEdges);
+}
+
+TEST_F(ICFGOrderTest, SolveInReversePostOrder) {
+  for (const auto *IRFile : {"call_11_cpp_dbg.ll", "recursion_02_cpp_dbg.ll",
+                             "while_03_cpp_dbg.ll"}) {
+    initialize(IRFile);
+    IDELinearConstantAnalysis DefaultProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                             PT.get(), EntryPoints);
+    IDELinearConstantAnalysis OrderedProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                             PT.get(), EntryPoints);
+    OrderedProblem.getIFDSIDESolverConfig().setWorklistPolicy(
+        WorklistPolicy::ReversePostOrder);
+    IDESolver DefaultSolver(DefaultProblem);
+    DefaultSolver.solve();
+    IDESolver OrderedSolver(OrderedProblem);
+    OrderedSolver.solve();
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        EXPECT_EQ(DefaultSolver.resultsAt(&I), OrderedSolver.resultsAt(&I))
+            << "Results differ at " << llvmIRToString(&I);
+      }
+    }
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactJumpFunctions.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+struct DefaultLCADomain : public LLVMAnalysisDomainDefault {
+  using l_t = int64_t;
+};
+
+// the linear constant analysis opts in, such that the IDESolver tests of the
+// analysis run on the compact storage
+static_assert(
+    std::is_same_v<jump_functions_t<IDELinearConstantAnalysisDomain,
+                                    std::set<const llvm::Value *>>,
+                   CompactJumpFunctions<IDELinearConstantAnalysisDomain,
+                                        std::set<const llvm::Value *>>>);
+static_assert(
+    std::is_same_v<jump_functions_t<DefaultLCADomain,
+                                    std::set<const llvm::Value *>>,
+                   JumpFunctions<DefaultLCADomain,
+                                 std::set<const llvm::Value *>>>);
+
+/* ============== TEST FIXTURE ============== */
+class CompactJumpFunctionsTest : public ::testing::Test {
+protected:
+  using JumpFunctionsTy =
+      CompactJumpFunctions<IDELinearConstantAnalysisDomain,
+                           IDELinearConstantAnalysis::container_type>;
+  using EdgeFunctionPtrType = JumpFunctionsTy::EdgeFunctionPtrType;
+
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+  std::unique_ptr<IDELinearConstantAnalysis> Problem;
+  std::vector<const llvm::Instruction *> Insts;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + "basic_01_cpp_dbg.ll"},
+        IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           EntryPoints, TH.get(), PT.get());
+    Problem = std::make_unique<IDELinearConstantAnalysis>(
+        IRDB.get(), TH.get(), ICFG.get(), PT.get(), EntryPoints);
+    for (const auto &I :
+         llvm::instructions(IRDB->getFunctionDefinition("main"))) {
+      Insts.push_back(&I);
+    }
+    ASSERT_GE(Insts.size(), 4U);
+  }
+}; // Test Fixture
+
+TEST_F(CompactJumpFunctionsTest, LookupAndOverwrite) {
+  JumpFunctionsTy JFs(Problem->allTopFunction(), *Problem);
+  EdgeFunctionPtrType Id = EdgeIdentity<int64_t>::getInstance();
+  EdgeFunctionPtrType Bot = std::make_shared<AllBottom<int64_t>>(
+      IDELinearConstantAnalysis::BOTTOM);
+  auto Zero = Problem->getZeroValue();
+  // all-top functions are never stored
+  JFs.addFunction(Zero, Insts[0], Zero, Problem->allTopFunction());
+  EXPECT_EQ(0U, JFs.size());
+  EXPECT_EQ(nullptr, JFs.lookup(Zero, Insts[0], Zero));
+  JFs.addFunction(Zero, Insts[0], Insts[1], Id);
+  EXPECT_EQ(Id, JFs.lookup(Zero, Insts[0], Insts[1]));
+  EXPECT_EQ(nullptr, JFs.lookup(Insts[1], Insts[0], Zero));
+  // existing jump functions are overwritten
+  JFs.addFunction(Zero, Insts[0], Insts[1], Bot);
+  EXPECT_EQ(Bot, JFs.lookup(Zero, Insts[0], Insts[1]));
+  EXPECT_EQ(1U, JFs.size());
+}
+
+TEST_F(CompactJumpFunctionsTest, Indices) {
+  JumpFunctionsTy JFs(Problem->allTopFunction(), *Problem);
+  EdgeFunctionPtrType Id = EdgeIdentity<int64_t>::getInstance();
+  auto Zero = Problem->getZeroValue();
+  JFs.addFunction(Zero, Insts[0], Insts[1], Id);
+  JFs.addFunction(Insts[2], Insts[0], Insts[1], Id);
+  JFs.addFunction(Zero, Insts[0], Insts[3], Id);
+  JFs.addFunction(Zero, Insts[1], Insts[3], Id);
+
+  auto Rev = JFs.reverseLookup(Insts[0], Insts[1]);
+  ASSERT_TRUE(Rev.has_value());
+  std::set<const llvm::Value *> Sources;
+  for (const auto &Entry : *Rev) {
+    Sources.insert(Entry.first);
+  }
+  EXPECT_EQ((std::set<const llvm::Value *>{Zero, Insts[2]}), Sources);
+  EXPECT_FALSE(JFs.reverseLookup(Insts[0], Zero).has_value());
+
+  auto Fwd = JFs.forwardLookup(Zero, Insts[0]);
+  ASSERT_TRUE(Fwd.has_value());
+  std::set<const llvm::Value *> Targets;
+  for (const auto &Entry : *Fwd) {
+    Targets.insert(Entry.first);
+  }
+  EXPECT_EQ((std::set<const llvm::Value *>{Insts[1], Insts[3]}), Targets);
+
+  auto ByTarget = JFs.lookupByTarget(Insts[0]);
+  EXPECT_EQ(3U, ByTarget.cellVec().size());
+  EXPECT_TRUE(ByTarget.contains(Insts[2], Insts[1]));
+  EXPECT_TRUE(JFs.lookupByTarget(Insts[2]).empty());
+}
+
+TEST_F(CompactJumpFunctionsTest, Remove) {
+  JumpFunctionsTy JFs(Problem->allTopFunction(), *Problem);
+  EdgeFunctionPtrType Id = EdgeIdentity<int64_t>::getInstance();
+  auto Zero = Problem->getZeroValue();
+  JFs.addFunction(Zero, Insts[0], Insts[1], Id);
+  JFs.addFunction(Insts[2], Insts[0], Insts[1], Id);
+  EXPECT_TRUE(JFs.removeFunction(Zero, Insts[0], Insts[1]));
+  EXPECT_FALSE(JFs.removeFunction(Zero, Insts[0], Insts[1]));
+  EXPECT_EQ(nullptr, JFs.lookup(Zero, Insts[0], Insts[1]));
+  EXPECT_FALSE(JFs.forwardLookup(Zero, Insts[0]).has_value());
+  ASSERT_TRUE(JFs.reverseLookup(Insts[0], Insts[1]).has_value());
+  EXPECT_EQ(1U, JFs.reverseLookup(Insts[0], Insts[1])->size());
+  EXPECT_TRUE(JFs.removeFunction(Insts[2], Insts[0], Insts[1]));
+  EXPECT_TRUE(JFs.lookupByTarget(Insts[0]).empty());
+  EXPECT_EQ(0U, JFs.size());
+}
+
+TEST_F(CompactJumpFunctionsTest, RemoveAtTarget) {
+  JumpFunctionsTy JFs(Problem->allTopFunction(), *Problem);
+  EdgeFunctionPtrType Id = EdgeIdentity<int64_t>::getInstance();
+  auto Zero = Problem->getZeroValue();
+  JFs.addFunction(Zero, Insts[0], Insts[1], Id);
+  JFs.addFunction(Insts[2], Insts[0], Insts[1], Id);
+  JFs.addFunction(Zero, Insts[1], Insts[3], Id);
+  EXPECT_EQ(2U, JFs.removeFunctionsAt(Insts[0]));
+  EXPECT_EQ(0U, JFs.removeFunctionsAt(Insts[0]));
+  EXPECT_TRUE(JFs.lookupByTarget(Insts[0]).empty());
+  EXPECT_FALSE(JFs.forwardLookup(Zero, Insts[0]).has_value());
+  EXPECT_FALSE(JFs.reverseLookup(Insts[0], Insts[1]).has_value());
+  EXPECT_EQ(Id, JFs.lookup(Zero, Insts[1], Insts[3]));
+  EXPECT_EQ(1U, JFs.size());
+}
+
+TEST_F(CompactJumpFunctionsTest, CopyAndAssign) {
+  JumpFunctionsTy JFs(Problem->allTopFunction(), *Problem);
+  EdgeFunctionPtrType Id = EdgeIdentity<int64_t>::getInstance();
+  auto Zero = Problem->getZeroValue();
+  JFs.addFunction(Zero, Insts[0], Insts[1], Id);
+  JumpFunctionsTy Copy(JFs);
+  JFs.removeFunctionsAt(Insts[0]);
+  EXPECT_EQ(Id, Copy.lookup(Zero, Insts[0], Insts[1]));
+  JFs = Copy;
+  EXPECT_EQ(Id, JFs.lookup(Zero, Insts[0], Insts[1]));
+  Copy.clear();
+  EXPECT_EQ(1U, JFs.size());
+  Copy = std::move(JFs);
+  EXPECT_EQ(Id, Copy.lookup(Zero, Insts[0], Insts[1]));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
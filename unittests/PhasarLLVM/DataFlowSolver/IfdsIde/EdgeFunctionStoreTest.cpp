@@ -0,0 +1,116 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionStore.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <memory>
+
+using namespace psr;
+
+static unsigned NumCompositions = 0;
+
+struct AddConstEF : EdgeFunction<int>,
+                    std::enable_shared_from_this<AddConstEF> {
+  const int C;
+
+  AddConstEF(int C) : C(C) {}
+  int computeTarget(int Source) override { return Source + C; }
+  std::shared_ptr<EdgeFunction<int>>
+  composeWith(std::shared_ptr<EdgeFunction<int>> SecondFunction) override {
+    ++NumCompositions;
+    if (auto *Add = dynamic_cast<AddConstEF *>(SecondFunction.get())) {
+      return std::make_shared<AddConstEF>(C + Add->C);
+    }
+    return std::make_shared<AllBottom<int>>(-1);
+  }
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> OtherFunction) override {
+    if (OtherFunction->equal_to(this->shared_from_this())) {
+      return this->shared_from_this();
+    }
+    return std::make_shared<AllBottom<int>>(-1);
+  }
+  bool equal_to(std::shared_ptr<EdgeFunction<int>> Other) const override {
+    if (auto *Add = dynamic_cast<AddConstEF *>(Other.get())) {
+      return Add->C == C;
+    }
+    return false;
+  }
+  [[nodiscard]] size_t hash() const override { return std::hash<int>()(C); }
+};
+
+TEST(EdgeFunctionStoreTest, Intern) {
+  EdgeFunctionStore<int> Store;
+  auto Add1 = std::make_shared<AddConstEF>(1);
+  auto OtherAdd1 = std::make_shared<AddConstEF>(1);
+  auto Add2 = std::make_shared<AddConstEF>(2);
+  EXPECT_EQ(Add1, Store.intern(Add1));
+  EXPECT_EQ(Add1, Store.intern(OtherAdd1));
+  EXPECT_EQ(Add2, Store.intern(Add2));
+  EXPECT_EQ(2U, Store.size());
+  // edge functions that only hash their type are interned as well
+  auto Bot = std::make_shared<AllBottom<int>>(-1);
+  auto OtherBot = std::make_shared<AllBottom<int>>(-1);
+  EXPECT_EQ(Bot, Store.intern(Bot));
+  EXPECT_EQ(Bot, Store.intern(OtherBot));
+  EXPECT_NE(Bot, Store.intern(std::make_shared<AllBottom<int>>(-2)));
+  EXPECT_EQ(4U, Store.size());
+  EXPECT_TRUE(EdgeFunctionStore<int>::equal(Add1, OtherAdd1));
+  EXPECT_FALSE(EdgeFunctionStore<int>::equal(Add1, Add2));
+  Store.clear();
+  EXPECT_EQ(0U, Store.size());
+  EXPECT_EQ(OtherAdd1, Store.intern(OtherAdd1));
+}
+
+TEST(EdgeFunctionStoreTest, MemoizedCompose) {
+  EdgeFunctionStore<int> Store;
+  NumCompositions = 0;
+  auto Add1 = std::make_shared<AddConstEF>(1);
+  auto Add2 = std::make_shared<AddConstEF>(2);
+  auto Add3 = Store.compose(Add1, Add2);
+  EXPECT_EQ(4, Add3->computeTarget(1));
+  // equal operands are interned first and hit the cache
+  EXPECT_EQ(Add3, Store.compose(std::make_shared<AddConstEF>(1), Add2));
+  EXPECT_EQ(1U, NumCompositions);
+  EXPECT_EQ(1U, Store.getComposeHits());
+  EXPECT_EQ(1U, Store.getComposeMisses());
+  // results are interned, too
+  EXPECT_EQ(Add3, Store.compose(Add2, Add1));
+  EXPECT_EQ(Add3, Store.intern(std::make_shared<AddConstEF>(3)));
+  EXPECT_EQ(2U, NumCompositions);
+}
+
+TEST(EdgeFunctionStoreTest, BoundedMemo) {
+  // a single slot, every new pair evicts the previous one
+  EdgeFunctionStore<int> Store(1);
+  NumCompositions = 0;
+  auto Add1 = std::make_shared<AddConstEF>(1);
+  auto Add2 = std::make_shared<AddConstEF>(2);
+  auto Add3 = Store.compose(Add1, Add2);
+  auto Add4 = Store.compose(Add2, Add2);
+  EXPECT_EQ(Add3, Store.compose(Add1, Add2));
+  EXPECT_EQ(3U, NumCompositions);
+  EXPECT_EQ(Add3, Store.compose(Add1, Add2));
+  EXPECT_EQ(3U, NumCompositions);
+  EXPECT_EQ(4, Add4->computeTarget(0));
+}
+
+TEST(EdgeFunctionStoreTest, MemoizedJoin) {
+  EdgeFunctionStore<int> Store;
+  auto Add1 = std::make_shared<AddConstEF>(1);
+  auto Add2 = std::make_shared<AddConstEF>(2);
+  auto Bot = Store.join(Add1, Add2);
+  EXPECT_TRUE(Bot->equal_to(std::make_shared<AllBottom<int>>(-1)));
+  EXPECT_EQ(Bot, Store.join(Add1, Add2));
+  EXPECT_EQ(Bot, Store.join(Add2, Add1));
+  EXPECT_EQ(Add1, Store.join(Add1, std::make_shared<AddConstEF>(1)));
+  EXPECT_EQ(1U, Store.getJoinHits());
+  EXPECT_EQ(3U, Store.getJoinMisses());
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IdentityChains.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class IdentityChainsTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void initialize(const std::string &IRFile) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           EntryPoints, TH.get(), PT.get());
+  }
+
+  // Solves the linear constant analysis with and without collapsing identity
+  // chains and compares the values computed for all instructions.
+  void compareWithDefaultMode(const std::string &IRFile) {
+    initialize(IRFile);
+    IDELinearConstantAnalysis DefaultProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                             PT.get(), EntryPoints);
+    IDELinearConstantAnalysis CompressedProblem(IRDB.get(), TH.get(),
+                                                ICFG.get(), PT.get(),
+                                                EntryPoints);
+    CompressedProblem.getIFDSIDESolverConfig().setCompressIdentityChains();
+    IDESolver DefaultSolver(DefaultProblem);
+    DefaultSolver.solve();
+    IDESolver CompressedSolver(CompressedProblem);
+    CompressedSolver.solve();
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        EXPECT_EQ(DefaultSolver.resultsAt(&I), CompressedSolver.resultsAt(&I))
+            << "Results differ at " << llvmIRToString(&I);
+      }
+    }
+  }
+}; // Test Fixture
+
+TEST_F(IdentityChainsTest, CollapseChains) {
+  initialize("branch_03_cpp_dbg.ll");
+  IDELinearConstantAnalysis Problem(IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+                                    EntryPoints);
+  IdentityChains<const llvm::Instruction *, const llvm::Function *> Chains(
+      *ICFG, [&Problem](const llvm::Instruction *I) {
+        return Problem.isIdentityStmt(I);
+      });
+  Chains.compress(IRDB->getFunctionDefinition("main"));
+  ASSERT_GT(Chains.getNumCollapsed(), 0U);
+  Chains.forEachCollapsed(
+      [&](const llvm::Instruction *I, const llvm::Instruction *ChainEnd) {
+        EXPECT_TRUE(Chains.isCollapsed(I));
+        EXPECT_FALSE(Chains.isCollapsed(ChainEnd));
+        EXPECT_NE(I, ChainEnd);
+        EXPECT_TRUE(Problem.isIdentityStmt(I));
+        EXPECT_FALSE(ICFG->isCallStmt(I));
+        // the last statement of a chain is only reached through the chain
+        ASSERT_EQ(1U, ICFG->getPredsOf(ChainEnd).size());
+        EXPECT_EQ(ChainEnd, Chains.getChainEnd(ICFG->getPredsOf(ChainEnd)[0]));
+      });
+  const auto *Ret = &IRDB->getFunctionDefinition("main")->back().back();
+  EXPECT_FALSE(Chains.isCollapsed(Ret));
+  EXPECT_EQ(Ret, Chains.getChainEnd(Ret));
+}
+
+TEST_F(IdentityChainsTest, Basic) {
+  compareWithDefaultMode("basic_04_cpp_dbg.ll");
+}
+
+TEST_F(IdentityChainsTest, Branch) {
+  compareWithDefaultMode("branch_03_cpp_dbg.ll");
+}
+
+TEST_F(IdentityChainsTest, Calls) {
+  compareWithDefaultMode("call_08_cpp_dbg.ll");
+}
+
+TEST_F(IdentityChainsTest, Globals) {
+  compareWithDefaultMode("global_05_cpp_dbg.ll");
+}
+
+TEST_F(IdentityChainsTest, Loop) {
+  compareWithDefaultMode("while_03_cpp_dbg.ll");
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class LLVMFlowFunctionsTest : public ::testing::Test {
+protected:
+  using FlowFunctionTy = FlowFunction<const llvm::Value *>;
+
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "uninitialized_variables/";
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+
+  void initialize(const std::string &IRFile) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+  }
+
+  // the zero value and all arguments and instructions of Caller and Callee,
+  // i.e. facts that are mapped as well as facts that are not
+  static std::vector<const llvm::Value *>
+  getSources(const llvm::Function *Caller, const llvm::Function *Callee) {
+    std::vector<const llvm::Value *> Sources = {
+        LLVMZeroValue::getInstance()};
+    for (const auto *Fun : {Caller, Callee}) {
+      for (const auto &Arg : Fun->args()) {
+        Sources.push_back(&Arg);
+      }
+      for (const auto &I : llvm::instructions(Fun)) {
+        Sources.push_back(&I);
+      }
+    }
+    return Sources;
+  }
+
+  // Checks that the batched flow function computes the same targets as the
+  // scalar one, returns the number of targets that are no source.
+  static size_t compareWithComputeTargets(
+      FlowFunctionTy &FF, const std::vector<const llvm::Value *> &Sources) {
+    auto Targets = FF.computeTargetsBatch(Sources);
+    EXPECT_EQ(Sources.size(), Targets.size());
+    size_t Mapped = 0;
+    for (size_t I = 0; I < Sources.size() && I < Targets.size(); ++I) {
+      EXPECT_EQ(FF.computeTargets(Sources[I]), Targets[I])
+          << "Targets differ for " << llvmIRToString(Sources[I]);
+      Mapped += Targets[I].size() - Targets[I].count(Sources[I]);
+    }
+    return Mapped;
+  }
+
+  // Compares the call- and return-flow functions of all calls to defined
+  // functions, returns the number of mapped facts.
+  size_t compareCallAndReturnFlows() {
+    size_t Mapped = 0;
+    for (const auto *Caller : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(Caller)) {
+        llvm::ImmutableCallSite CS(&I);
+        if (!CS || !CS.getCalledFunction() ||
+            CS.getCalledFunction()->isDeclaration()) {
+          continue;
+        }
+        const auto *Callee = CS.getCalledFunction();
+        auto Sources = getSources(Caller, Callee);
+        MapFactsToCallee<> ToCallee(CS, Callee);
+        Mapped += compareWithComputeTargets(ToCallee, Sources);
+        // only maps facts that are no constants
+        MapFactsToCallee<> ToCalleePred(CS, Callee, [](const llvm::Value *V) {
+          return !llvm::isa<llvm::Constant>(V);
+        });
+        compareWithComputeTargets(ToCalleePred, Sources);
+        // the solvers obtain flow functions that automatically add the zero
+        // value
+        ZeroedFlowFunction<const llvm::Value *> Zeroed(
+            std::make_shared<MapFactsToCallee<>>(CS, Callee),
+            LLVMZeroValue::getInstance());
+        compareWithComputeTargets(Zeroed, Sources);
+        for (const auto &Exit : llvm::instructions(Callee)) {
+          if (!llvm::isa<llvm::ReturnInst>(Exit)) {
+            continue;
+          }
+          MapFactsToCaller<> ToCaller(CS, Callee, &Exit);
+          Mapped += compareWithComputeTargets(ToCaller, Sources);
+          MapFactsToCaller<> ToCallerPred(
+              CS, Callee, &Exit,
+              [](const llvm::Value *V) { return llvm::isa<llvm::Argument>(V); },
+              [](const llvm::Function *) { return false; });
+          compareWithComputeTargets(ToCallerPred, Sources);
+        }
+      }
+    }
+    return Mapped;
+  }
+}; // Test Fixture
+
+TEST_F(LLVMFlowFunctionsTest, BatchedCallAndReturnFlows) {
+  initialize("growing_example_cpp_dbg.ll");
+  // function(j, 12) maps j to x and the returned value to k
+  EXPECT_GT(compareCallAndReturnFlows(), 0U);
+}
+
+TEST_F(LLVMFlowFunctionsTest, BatchedCallAndReturnFlowsVirtualCall) {
+  initialize("virtual_call_cpp_dbg.ll");
+  compareCallAndReturnFlows();
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
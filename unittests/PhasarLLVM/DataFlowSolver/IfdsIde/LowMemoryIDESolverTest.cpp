@@ -0,0 +1,113 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class LowMemoryIDESolverTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  // Solves the linear constant analysis with and without the low-memory mode
+  // and compares the values computed for all instructions. The low-memory
+  // mode must release jump functions while the ESG is constructed already.
+  // If InternEdgeFunctions is set, the low-memory mode interns the edge
+  // functions, which are released along with the jump functions.
+  void compareWithDefaultMode(const std::string &IRFile,
+                              bool InternEdgeFunctions = false) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           EntryPoints, TH.get(), PT.get());
+    IDELinearConstantAnalysis DefaultProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                             PT.get(), EntryPoints);
+    IDELinearConstantAnalysis LowMemoryProblem(IRDB.get(), TH.get(),
+                                               ICFG.get(), PT.get(),
+                                               EntryPoints);
+    LowMemoryProblem.getIFDSIDESolverConfig().setLowMemory(true);
+    LowMemoryProblem.getIFDSIDESolverConfig().setInternEdgeFunctions(
+        InternEdgeFunctions);
+    IDESolver DefaultSolver(DefaultProblem);
+    DefaultSolver.solve();
+    IDESolver LowMemorySolver(LowMemoryProblem);
+    LowMemorySolver.solve();
+    EXPECT_GT(LowMemorySolver.getNumJumpFunctionsReleasedDuringPhaseI(), 0U);
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        EXPECT_EQ(DefaultSolver.resultsAt(&I), LowMemorySolver.resultsAt(&I))
+            << "Results differ at " << llvmIRToString(&I);
+      }
+    }
+  }
+}; // Test Fixture
+
+TEST_F(LowMemoryIDESolverTest, Basic) {
+  compareWithDefaultMode("basic_04_cpp_dbg.ll");
+}
+
+TEST_F(LowMemoryIDESolverTest, Branch) {
+  compareWithDefaultMode("branch_03_cpp_dbg.ll");
+}
+
+TEST_F(LowMemoryIDESolverTest, Calls) {
+  compareWithDefaultMode("call_08_cpp_dbg.ll");
+}
+
+TEST_F(LowMemoryIDESolverTest, Globals) {
+  compareWithDefaultMode("global_05_cpp_dbg.ll");
+}
+
+TEST_F(LowMemoryIDESolverTest, Recursion) {
+  compareWithDefaultMode("recursion_02_cpp_dbg.ll");
+}
+
+TEST_F(LowMemoryIDESolverTest, Loop) {
+  compareWithDefaultMode("while_03_cpp_dbg.ll");
+}
+
+TEST_F(LowMemoryIDESolverTest, InternedCalls) {
+  compareWithDefaultMode("call_08_cpp_dbg.ll", true);
+}
+
+TEST_F(LowMemoryIDESolverTest, InternedRecursion) {
+  compareWithDefaultMode("recursion_02_cpp_dbg.ll", true);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
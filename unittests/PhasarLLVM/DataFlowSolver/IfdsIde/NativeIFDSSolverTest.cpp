@@ -0,0 +1,188 @@
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class NativeIFDSSolverTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "uninitialized_variables/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void initialize(const std::string &IRFile) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           EntryPoints, TH.get(), PT.get());
+  }
+
+  // Solves the uninitialized variables analysis using both, the IDE-based
+  // IFDSSolver and the NativeIFDSSolver, and compares their results. Either
+  // solver optionally applies its normal flow functions in batches.
+  void compareWithIFDSSolver(const std::string &IRFile,
+                             bool BatchIDEBased = false,
+                             bool BatchNative = false) {
+    initialize(IRFile);
+    IFDSUninitializedVariables IDEBasedProblem(IRDB.get(), TH.get(),
+                                               ICFG.get(), PT.get(),
+                                               EntryPoints);
+    IFDSUninitializedVariables NativeProblem(IRDB.get(), TH.get(), ICFG.get(),
+                                             PT.get(), EntryPoints);
+    IDEBasedProblem.getIFDSIDESolverConfig().setBatchFlowFunctions(
+        BatchIDEBased);
+    NativeProblem.getIFDSIDESolverConfig().setBatchFlowFunctions(BatchNative);
+    IFDSSolver IDEBasedSolver(IDEBasedProblem);
+    IDEBasedSolver.solve();
+    NativeIFDSSolver Solver(NativeProblem);
+    Solver.solve();
+    EXPECT_GT(Solver.getNumPathEdges(), 0U);
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        EXPECT_EQ(IDEBasedSolver.ifdsResultsAt(&I), Solver.ifdsResultsAt(&I))
+            << "Results differ at " << llvmIRToString(&I);
+      }
+    }
+    EXPECT_EQ(IDEBasedProblem.getAllUndefUses(),
+              NativeProblem.getAllUndefUses());
+  }
+}; // Test Fixture
+
+TEST_F(NativeIFDSSolverTest, AllUninit) {
+  compareWithIFDSSolver("all_uninit_cpp_dbg.ll");
+}
+
+TEST_F(NativeIFDSSolverTest, BinopUninit) {
+  compareWithIFDSSolver("binop_uninit_cpp_dbg.ll");
+}
+
+TEST_F(NativeIFDSSolverTest, CallNoRet) {
+  compareWithIFDSSolver("callnoret_c_dbg.ll");
+}
+
+TEST_F(NativeIFDSSolverTest, GrowingExample) {
+  compareWithIFDSSolver("growing_example_cpp_dbg.ll");
+}
+
+TEST_F(NativeIFDSSolverTest, Recursion) {
+  compareWithIFDSSolver("recursion_cpp_dbg.ll");
+}
+
+TEST_F(NativeIFDSSolverTest, ReturnUninit) {
+  compareWithIFDSSolver("return_uninit_cpp_dbg.ll");
+}
+
+TEST_F(NativeIFDSSolverTest, VirtualCall) {
+  compareWithIFDSSolver("virtual_call_cpp_dbg.ll");
+}
+
+TEST_F(NativeIFDSSolverTest, BatchFlowFunctions) {
+  compareWithIFDSSolver("growing_example_cpp_dbg.ll", true, false);
+  compareWithIFDSSolver("growing_example_cpp_dbg.ll", false, true);
+  compareWithIFDSSolver("virtual_call_cpp_dbg.ll", true, false);
+  compareWithIFDSSolver("virtual_call_cpp_dbg.ll", false, true);
+}
+
+TEST_F(NativeIFDSSolverTest, ResultAccessors) {
+  initialize("growing_example_cpp_dbg.ll");
+  IFDSUninitializedVariables Problem(IRDB.get(), TH.get(), ICFG.get(),
+                                     PT.get(), EntryPoints);
+  NativeIFDSSolver Solver(Problem);
+  Solver.solve();
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *Ret = &Main->back().back();
+  auto Facts = Solver.ifdsResultsAt(Ret);
+  EXPECT_TRUE(Facts.count(Problem.getZeroValue()));
+  for (const auto *D : Facts) {
+    EXPECT_EQ(BinaryDomain::BOTTOM, Solver.resultAt(Ret, D));
+  }
+  auto Results = Solver.resultsAt(Ret, true);
+  EXPECT_EQ(Facts.size() - 1, Results.size());
+  EXPECT_FALSE(Results.count(Problem.getZeroValue()));
+  EXPECT_EQ(Facts.size(), Solver.getSolverResults().resultsAt(Ret).size());
+}
+
+TEST_F(NativeIFDSSolverTest, FactIndex) {
+  initialize("growing_example_cpp_dbg.ll");
+  IFDSUninitializedVariables Problem(IRDB.get(), TH.get(), ICFG.get(),
+                                     PT.get(), EntryPoints);
+  Problem.getIFDSIDESolverConfig().setBuildFactIndex();
+  NativeIFDSSolver Solver(Problem);
+  Solver.solve();
+  auto Results = Solver.getSolverResults();
+  ASSERT_TRUE(Results.hasFactIndex());
+  // the index answers the same statements as the path edges
+  std::map<const llvm::Value *, std::set<const llvm::Instruction *>> Expected;
+  for (const auto *F : IRDB->getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      for (const auto *D : Solver.ifdsResultsAt(&I)) {
+        Expected[D].insert(&I);
+      }
+    }
+  }
+  ASSERT_FALSE(Expected.empty());
+  for (const auto &[D, Stmts] : Expected) {
+    auto Indexed = Results.statementsOf(D);
+    EXPECT_EQ(Stmts.size(), Indexed.size());
+    EXPECT_EQ(Stmts,
+              std::set<const llvm::Instruction *>(Indexed.begin(),
+                                                  Indexed.end()));
+  }
+}
+
+TEST_F(NativeIFDSSolverTest, Telemetry) {
+  initialize("growing_example_cpp_dbg.ll");
+  IFDSUninitializedVariables Problem(IRDB.get(), TH.get(), ICFG.get(),
+                                     PT.get(), EntryPoints);
+  NativeIFDSSolver Solver(Problem);
+  Solver.solve();
+  // the statistics are only collected if PAMM is enabled
+  if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+    EXPECT_EQ(Solver.getNumPathEdges(),
+              Solver.getTelemetry().getNumPathEdges());
+    const auto *Main = IRDB->getFunctionDefinition("main");
+    ASSERT_NE(nullptr, Solver.getTelemetry().getFunctionTelemetry(Main));
+  } else {
+    EXPECT_EQ(0U, Solver.getTelemetry().getNumPathEdges());
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
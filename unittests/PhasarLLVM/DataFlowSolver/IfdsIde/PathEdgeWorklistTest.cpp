@@ -0,0 +1,179 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace psr;
+
+using TestEdge = PathEdge<int, int>;
+
+static std::vector<int> drainTargets(PathEdgeWorklist<int, int> &WL) {
+  std::vector<int> Targets;
+  while (!WL.empty()) {
+    Targets.push_back(WL.pop().getTarget());
+  }
+  return Targets;
+}
+
+TEST(PathEdgeWorklistTest, FIFOOrder) {
+  auto WL = makePathEdgeWorklist<int, int>(WorklistPolicy::FIFO);
+  for (int I = 1; I <= 4; ++I) {
+    WL->push(TestEdge(0, I, 0));
+  }
+  EXPECT_EQ(4U, WL->size());
+  std::vector<int> Expected = {1, 2, 3, 4};
+  EXPECT_EQ(Expected, drainTargets(*WL));
+  EXPECT_TRUE(WL->empty());
+}
+
+TEST(PathEdgeWorklistTest, LIFOOrder) {
+  auto WL = makePathEdgeWorklist<int, int>(WorklistPolicy::LIFO);
+  for (int I = 1; I <= 4; ++I) {
+    WL->push(TestEdge(0, I, 0));
+  }
+  std::vector<int> Expected = {4, 3, 2, 1};
+  EXPECT_EQ(Expected, drainTargets(*WL));
+}
+
+TEST(PathEdgeWorklistTest, PriorityOrder) {
+  // even targets first, ties are resolved in insertion order
+  auto WL = makePathEdgeWorklist<int, int>(
+      WorklistPolicy::Priority,
+      [](const TestEdge &Edge) -> size_t { return Edge.getTarget() % 2; });
+  for (int I = 1; I <= 6; ++I) {
+    WL->push(TestEdge(0, I, 0));
+  }
+  std::vector<int> Expected = {2, 4, 6, 1, 3, 5};
+  EXPECT_EQ(Expected, drainTargets(*WL));
+}
+
+TEST(PathEdgeWorklistTest, InterleavedPushAndPop) {
+  auto WL = makePathEdgeWorklist<int, int>(WorklistPolicy::FIFO);
+  WL->push(TestEdge(1, 10, 2));
+  auto Edge = WL->pop();
+  EXPECT_EQ(1, Edge.factAtSource());
+  EXPECT_EQ(10, Edge.getTarget());
+  EXPECT_EQ(2, Edge.factAtTarget());
+  WL->push(TestEdge(0, 11, 0));
+  WL->push(TestEdge(0, 12, 0));
+  WL->clear();
+  EXPECT_TRUE(WL->empty());
+  EXPECT_EQ(0U, WL->size());
+}
+
+TEST(PathEdgeWorklistTest, PopBatch) {
+  auto WL = makePathEdgeWorklist<int, int>(WorklistPolicy::LIFO);
+  WL->push(TestEdge(1, 20, 5));
+  WL->push(TestEdge(0, 10, 4));
+  WL->push(TestEdge(0, 10, 3));
+  WL->push(TestEdge(1, 10, 2));
+  WL->push(TestEdge(1, 10, 1));
+  EXPECT_EQ(1, WL->top().factAtTarget());
+  EXPECT_EQ(5U, WL->size());
+  auto CanBatch = [](int Target) { return Target != 20; };
+  std::vector<TestEdge> Batch;
+  std::vector<std::vector<int>> Facts;
+  while (!WL->empty()) {
+    WL->popBatch(Batch, CanBatch);
+    Facts.emplace_back();
+    for (const auto &Edge : Batch) {
+      EXPECT_EQ(Batch.front().factAtSource(), Edge.factAtSource());
+      EXPECT_EQ(Batch.front().getTarget(), Edge.getTarget());
+      Facts.back().push_back(Edge.factAtTarget());
+    }
+  }
+  std::vector<std::vector<int>> Expected = {{1, 2}, {3, 4}, {5}};
+  EXPECT_EQ(Expected, Facts);
+  // edges whose target cannot be batched are popped one by one
+  WL->push(TestEdge(1, 20, 7));
+  WL->push(TestEdge(1, 20, 6));
+  WL->popBatch(Batch, CanBatch);
+  EXPECT_EQ(1U, Batch.size());
+  EXPECT_EQ(1U, WL->size());
+}
+
+TEST(PathEdgeWorklistTest, PopLargeBatch) {
+  // the batch outgrows its capacity while it is filled
+  for (auto Policy : {WorklistPolicy::FIFO, WorklistPolicy::LIFO}) {
+    auto WL = makePathEdgeWorklist<int, int>(Policy);
+    for (int Fact = 0; Fact < 9; ++Fact) {
+      WL->push(TestEdge(1, 10, Fact));
+    }
+    WL->push(TestEdge(2, 10, 9));
+    std::vector<TestEdge> Batch;
+    if (Policy == WorklistPolicy::LIFO) {
+      WL->popBatch(Batch, [](int) { return true; });
+      EXPECT_EQ(1U, Batch.size());
+    }
+    WL->popBatch(Batch, [](int) { return true; });
+    ASSERT_EQ(9U, Batch.size());
+    for (const auto &Edge : Batch) {
+      EXPECT_EQ(1, Edge.factAtSource());
+      EXPECT_EQ(10, Edge.getTarget());
+    }
+    EXPECT_EQ(Policy == WorklistPolicy::LIFO ? 0U : 1U, WL->size());
+  }
+}
+
+TEST(PathEdgeWorklistTest, ForEachRestoresOrder) {
+  auto Priority = [](const TestEdge &Edge) -> size_t {
+    return Edge.getTarget() % 3;
+  };
+  for (auto Policy : {WorklistPolicy::FIFO, WorklistPolicy::LIFO,
+                      WorklistPolicy::Priority}) {
+    auto WL = makePathEdgeWorklist<int, int>(Policy, Priority);
+    auto Restored = makePathEdgeWorklist<int, int>(Policy, Priority);
+    for (int I = 1; I <= 8; ++I) {
+      WL->push(TestEdge(0, I, 0));
+    }
+    WL->pop();
+    WL->forEach([&](const TestEdge &Edge) { Restored->push(Edge); });
+    EXPECT_EQ(7U, WL->size());
+    EXPECT_EQ(drainTargets(*WL), drainTargets(*Restored));
+  }
+}
+
+TEST(PathEdgeWorklistTest, WorkStealingProcessesAllEdges) {
+  // every edge with target N > 0 discovers two edges with target N - 1
+  WorkStealingPathEdgeWorklist<int, int> WL(4);
+  std::atomic<unsigned> Processed = 0;
+  WL.push(TestEdge(0, 10, 0));
+  WL.run([&](TestEdge Edge) {
+    ++Processed;
+    if (Edge.getTarget() > 0) {
+      WL.push(TestEdge(0, Edge.getTarget() - 1, 0));
+      WL.push(TestEdge(0, Edge.getTarget() - 1, 0));
+    }
+  });
+  EXPECT_EQ((1U << 11U) - 1, Processed);
+  EXPECT_EQ(0U, WL.size());
+}
+
+TEST(PathEdgeWorklistTest, WorkStealingRethrows) {
+  WorkStealingPathEdgeWorklist<int, int> WL(2);
+  for (int I = 0; I < 16; ++I) {
+    WL.push(TestEdge(0, I, 0));
+  }
+  auto Process = [](TestEdge Edge) {
+    if (Edge.getTarget() == 7) {
+      throw std::runtime_error("failed");
+    }
+  };
+  EXPECT_THROW(WL.run(Process), std::runtime_error);
+  EXPECT_EQ(0U, WL.size());
+  // the worklist is usable afterwards
+  unsigned Processed = 0;
+  WL.push(TestEdge(0, 1, 0));
+  WL.run([&](TestEdge) { ++Processed; });
+  EXPECT_EQ(1U, Processed);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,11 +2,14 @@
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "gtest/gtest.h"
 
+#include "llvm/IR/InstIterator.h"
+
 #include "TestConfig.h"
 
 using namespace std;
@@ -70,6 +73,66 @@ protected:
     }
     EXPECT_EQ(FoundLeaks, GroundTruth);
   }
+
+  // Solves the problem with and without sparse propagation, using both the
+  // IDE-based and the native IFDS solver. Each run must find the given
+  // leaks, the sparse runs with fewer path edges, and each sparse run the
+  // same facts at every instruction as the respective dense run.
+  void compareSparseResults(map<int, set<string>> &GroundTruth) {
+    auto &SolverConfig = TaintProblem->getIFDSIDESolverConfig();
+    IFDSSolver_P<IFDSTaintAnalysis> DenseSolver(*TaintProblem);
+    DenseSolver.solve();
+    compareResults(GroundTruth);
+    TaintProblem->Leaks.clear();
+    NativeIFDSSolver_P<IFDSTaintAnalysis> DenseNativeSolver(*TaintProblem);
+    DenseNativeSolver.solve();
+    compareResults(GroundTruth);
+    TaintProblem->Leaks.clear();
+    SolverConfig.setSparsePropagation();
+    IFDSSolver_P<IFDSTaintAnalysis> SparseSolver(*TaintProblem);
+    SparseSolver.solve();
+    compareResults(GroundTruth);
+    TaintProblem->Leaks.clear();
+    NativeIFDSSolver_P<IFDSTaintAnalysis> SparseNativeSolver(*TaintProblem);
+    SparseNativeSolver.solve();
+    compareResults(GroundTruth);
+    EXPECT_LT(SparseSolver.getNumPathEdges(), DenseSolver.getNumPathEdges());
+    EXPECT_LT(SparseNativeSolver.getNumPathEdges(),
+              DenseNativeSolver.getNumPathEdges());
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        EXPECT_EQ(DenseSolver.ifdsResultsAt(&I), SparseSolver.ifdsResultsAt(&I))
+            << "Results differ at " << llvmIRToString(&I);
+        EXPECT_EQ(DenseNativeSolver.ifdsResultsAt(&I),
+                  SparseNativeSolver.ifdsResultsAt(&I))
+            << "Native results differ at " << llvmIRToString(&I);
+      }
+    }
+  }
+
+  // Solves the problem with and without collapsing identity chains using the
+  // native IFDS solver. Both runs must find the given leaks and the same
+  // facts at every instruction.
+  void compareCompressedResults(map<int, set<string>> &GroundTruth) {
+    auto &SolverConfig = TaintProblem->getIFDSIDESolverConfig();
+    NativeIFDSSolver_P<IFDSTaintAnalysis> DefaultSolver(*TaintProblem);
+    DefaultSolver.solve();
+    compareResults(GroundTruth);
+    TaintProblem->Leaks.clear();
+    SolverConfig.setCompressIdentityChains();
+    NativeIFDSSolver_P<IFDSTaintAnalysis> CompressedSolver(*TaintProblem);
+    CompressedSolver.solve();
+    compareResults(GroundTruth);
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        EXPECT_EQ(DefaultSolver.ifdsResultsAt(&I),
+                  CompressedSolver.ifdsResultsAt(&I))
+            << "Results differ at " << llvmIRToString(&I);
+      }
+    }
+    EXPECT_LT(CompressedSolver.getNumPathEdges(),
+              DefaultSolver.getNumPathEdges());
+  }
 }; // Test Fixture
 
 TEST_F(IFDSTaintAnalysisTest, TaintTest_01) {
@@ -136,6 +199,43 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_06) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_03_Sparse) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_03_cpp_dbg.ll"});
+  map<int, set<string>> GroundTruth;
+  GroundTruth[18] = set<string>{"17"};
+  compareSparseResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_Sparse) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  map<int, set<string>> GroundTruth;
+  GroundTruth[19] = set<string>{"18"};
+  GroundTruth[24] = set<string>{"23"};
+  compareSparseResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_05_Sparse) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  map<int, set<string>> GroundTruth;
+  GroundTruth[22] = set<string>{"21"};
+  compareSparseResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_03_Compressed) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_03_cpp_dbg.ll"});
+  map<int, set<string>> GroundTruth;
+  GroundTruth[18] = set<string>{"17"};
+  compareCompressedResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_Compressed) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  map<int, set<string>> GroundTruth;
+  GroundTruth[19] = set<string>{"18"};
+  GroundTruth[24] = set<string>{"23"};
+  compareCompressedResults(GroundTruth);
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
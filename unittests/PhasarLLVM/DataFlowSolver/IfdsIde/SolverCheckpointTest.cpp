@@ -0,0 +1,270 @@
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "boost/filesystem/operations.hpp"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDESolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+// Aborts the construction of the exploded super-graph once the given number
+// of normal path edges has been processed, as if the analysis had crashed.
+class InterruptedSolver : public IDESolver_P<IDELinearConstantAnalysis> {
+public:
+  InterruptedSolver(IDELinearConstantAnalysis &Problem, size_t Limit)
+      : IDESolver_P<IDELinearConstantAnalysis>(Problem), Limit(Limit) {}
+
+  size_t getNumNormalEdges() const { return NumNormalEdges; }
+
+protected:
+  void processNormalFlow(const PathEdge<n_t, d_t> Edge) override {
+    if (NumNormalEdges++ == Limit) {
+      throw std::runtime_error("interrupted");
+    }
+    IDESolver_P<IDELinearConstantAnalysis>::processNormalFlow(Edge);
+  }
+
+private:
+  size_t Limit;
+  size_t NumNormalEdges = 0;
+};
+
+/* ============== TEST FIXTURE ============== */
+class SolverCheckpointTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  // everything required to solve the linear constant analysis, the IR is
+  // loaded from scratch for every run such that resuming from a checkpoint
+  // re-binds the IR as if the analysis had been restarted
+  struct Run {
+    std::unique_ptr<ProjectIRDB> IRDB;
+    std::unique_ptr<LLVMTypeHierarchy> TH;
+    std::unique_ptr<LLVMPointsToSet> PT;
+    std::unique_ptr<LLVMBasedICFG> ICFG;
+    std::unique_ptr<IDELinearConstantAnalysis> Problem;
+    std::unique_ptr<IDESolver_P<IDELinearConstantAnalysis>> Solver;
+  };
+
+  std::string CheckpointFile;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    CheckpointFile = (boost::filesystem::temp_directory_path() /
+                      boost::filesystem::unique_path("phasar-%%%%-%%%%.ckpt"))
+                         .string();
+  }
+
+  void TearDown() override { boost::filesystem::remove(CheckpointFile); }
+
+  std::unique_ptr<Run> createRun(const std::string &IRFile) {
+    ValueAnnotationPass::resetValueID();
+    auto R = std::make_unique<Run>();
+    R->IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + IRFile}, IRDBOptions::WPA);
+    R->TH = std::make_unique<LLVMTypeHierarchy>(*R->IRDB);
+    R->PT = std::make_unique<LLVMPointsToSet>(*R->IRDB);
+    R->ICFG = std::make_unique<LLVMBasedICFG>(*R->IRDB,
+                                              CallGraphAnalysisType::OTF,
+                                              EntryPoints, R->TH.get(),
+                                              R->PT.get());
+    R->Problem = std::make_unique<IDELinearConstantAnalysis>(
+        R->IRDB.get(), R->TH.get(), R->ICFG.get(), R->PT.get(), EntryPoints);
+    R->Problem->getIFDSIDESolverConfig().setCheckpointFile(CheckpointFile);
+    return R;
+  }
+
+  void createSolver(Run &R) {
+    R.Solver =
+        std::make_unique<IDESolver_P<IDELinearConstantAnalysis>>(*R.Problem);
+  }
+
+  // Returns the results of all instructions keyed on the instructions' and
+  // facts' IDs such that results for different ProjectIRDBs can be compared.
+  static std::map<std::string, std::map<std::string, int64_t>>
+  getResults(Run &R) {
+    std::map<std::string, std::map<std::string, int64_t>> Results;
+    for (const auto *F : R.IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        auto &InstResults = Results[getCheckpointId(&I)];
+        for (const auto &[Fact, Value] : R.Solver->resultsAt(&I)) {
+          InstResults[getCheckpointId(Fact)] = Value;
+        }
+      }
+    }
+    return Results;
+  }
+
+  // Constructs the exploded super-graph, checkpoints it and resumes from the
+  // checkpoint for freshly loaded IR. The values computed from the restored
+  // state must equal the ones of an uninterrupted run.
+  void checkResume(const std::string &IRFile) {
+    auto Reference = createRun(IRFile);
+    createSolver(*Reference);
+    Reference->Solver->solve();
+
+    auto Interrupted = createRun(IRFile);
+    Interrupted->Problem->getIFDSIDESolverConfig().setComputeValues(false);
+    createSolver(*Interrupted);
+    Interrupted->Solver->solve();
+    ASSERT_TRUE(Interrupted->Solver->saveCheckpoint(CheckpointFile));
+
+    auto Resumed = createRun(IRFile);
+    {
+      IDESolver_P<IDELinearConstantAnalysis> Probe(*Resumed->Problem);
+      ASSERT_TRUE(Probe.loadCheckpoint(CheckpointFile));
+    }
+    Resumed->Problem->getIFDSIDESolverConfig().setResumeFromCheckpoint();
+    createSolver(*Resumed);
+    Resumed->Solver->solve();
+    EXPECT_EQ(getResults(*Reference), getResults(*Resumed));
+  }
+
+  // Writes a checkpoint after every path edge, aborts the construction of
+  // the exploded super-graph halfway and resumes from the last checkpoint
+  // for freshly loaded IR. The values must equal the ones of an
+  // uninterrupted run.
+  void checkResumeInterrupted(const std::string &IRFile) {
+    auto Reference = createRun(IRFile);
+    auto *ReferenceSolver = createCountingSolver(*Reference);
+    ReferenceSolver->solve();
+    ASSERT_GT(ReferenceSolver->getNumNormalEdges(), 1U);
+
+    auto Interrupted = createRun(IRFile);
+    Interrupted->Problem->getIFDSIDESolverConfig().setCheckpointInterval(0);
+    InterruptedSolver Aborted(*Interrupted->Problem,
+                              ReferenceSolver->getNumNormalEdges() / 2);
+    EXPECT_THROW(Aborted.solve(), std::runtime_error);
+
+    // only the edges that were pending at the last checkpoint are processed
+    auto Resumed = createRun(IRFile);
+    Resumed->Problem->getIFDSIDESolverConfig().setResumeFromCheckpoint();
+    auto *ResumedSolver = createCountingSolver(*Resumed);
+    ResumedSolver->solve();
+    EXPECT_GT(ResumedSolver->getNumNormalEdges(), 0U);
+    EXPECT_LT(ResumedSolver->getNumNormalEdges(),
+              ReferenceSolver->getNumNormalEdges());
+    EXPECT_EQ(getResults(*Reference), getResults(*Resumed));
+  }
+
+  static InterruptedSolver *createCountingSolver(Run &R) {
+    auto Solver = std::make_unique<InterruptedSolver>(
+        *R.Problem, std::numeric_limits<size_t>::max());
+    auto *Result = Solver.get();
+    R.Solver = std::move(Solver);
+    return Result;
+  }
+}; // Test Fixture
+
+TEST_F(SolverCheckpointTest, Primitives) {
+  auto R = createRun("basic_01_cpp_dbg.ll");
+  const auto *Main = R->IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const llvm::Instruction *Inst = &Main->front().front();
+  std::stringstream SS;
+  CheckpointWriter W(SS);
+  W.writeInt(0);
+  W.writeInt(300);
+  W.writeSignedInt(-42);
+  W.writeString("phasar");
+  EXPECT_TRUE(W.writeValue(Main));
+  EXPECT_TRUE(W.writeValue(Inst));
+  EXPECT_TRUE(W.writeValue(Main));
+  EXPECT_FALSE(W.writeValue(LLVMZeroValue::getInstance()));
+  CheckpointReader Rd(SS, *R->IRDB);
+  EXPECT_EQ(0U, Rd.readInt());
+  EXPECT_EQ(300U, Rd.readInt());
+  EXPECT_EQ(-42, Rd.readSignedInt());
+  EXPECT_EQ("phasar", Rd.readString());
+  EXPECT_EQ(Main, Rd.readValue());
+  EXPECT_EQ(Inst, Rd.readValue());
+  EXPECT_EQ(Main, Rd.readValue());
+  EXPECT_TRUE(Rd.good());
+  // reading past the end fails
+  Rd.readInt();
+  EXPECT_FALSE(Rd.good());
+}
+
+TEST_F(SolverCheckpointTest, ResumeBasic) {
+  checkResume("basic_04_cpp_dbg.ll");
+}
+
+TEST_F(SolverCheckpointTest, ResumeCalls) { checkResume("call_08_cpp_dbg.ll"); }
+
+TEST_F(SolverCheckpointTest, ResumeGlobals) {
+  checkResume("global_05_cpp_dbg.ll");
+}
+
+TEST_F(SolverCheckpointTest, ResumeRecursion) {
+  checkResume("recursion_02_cpp_dbg.ll");
+}
+
+TEST_F(SolverCheckpointTest, ResumeInterruptedBasic) {
+  checkResumeInterrupted("basic_04_cpp_dbg.ll");
+}
+
+TEST_F(SolverCheckpointTest, ResumeInterruptedCalls) {
+  checkResumeInterrupted("call_08_cpp_dbg.ll");
+}
+
+TEST_F(SolverCheckpointTest, ResumeInterruptedRecursion) {
+  checkResumeInterrupted("recursion_02_cpp_dbg.ll");
+}
+
+TEST_F(SolverCheckpointTest, RejectDifferentIR) {
+  auto Written = createRun("basic_04_cpp_dbg.ll");
+  createSolver(*Written);
+  Written->Solver->solve();
+  ASSERT_TRUE(Written->Solver->saveCheckpoint(CheckpointFile));
+  auto Other = createRun("call_08_cpp_dbg.ll");
+  createSolver(*Other);
+  EXPECT_FALSE(Other->Solver->loadCheckpoint(CheckpointFile));
+  EXPECT_FALSE(Other->Solver->loadCheckpoint(CheckpointFile + ".missing"));
+}
+
+TEST_F(SolverCheckpointTest, RejectDifferentAnalysis) {
+  auto Written = createRun("basic_04_cpp_dbg.ll");
+  createSolver(*Written);
+  Written->Solver->solve();
+  ASSERT_TRUE(Written->Solver->saveCheckpoint(CheckpointFile));
+  auto Other = createRun("basic_04_cpp_dbg.ll");
+  IDESolverTest OtherProblem(Other->IRDB.get(), Other->TH.get(),
+                             Other->ICFG.get(), Other->PT.get(), EntryPoints);
+  IDESolver_P<IDESolverTest> OtherSolver(OtherProblem);
+  EXPECT_FALSE(OtherSolver.loadCheckpoint(CheckpointFile));
+  EXPECT_FALSE(OtherSolver.updateFromCheckpoint(CheckpointFile).has_value());
+  createSolver(*Other);
+  EXPECT_TRUE(Other->Solver->loadCheckpoint(CheckpointFile));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
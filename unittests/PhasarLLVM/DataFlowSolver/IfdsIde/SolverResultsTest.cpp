@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactIndex.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/Utils/Table.h"
+
+using namespace psr;
+
+// statements and facts are plain integers, the zero value is 0
+class SolverResultsTest : public ::testing::Test {
+protected:
+  Table<int, int, int> Results;
+
+  void SetUp() override {
+    Results.insert(1, 0, 10);
+    Results.insert(1, 1, 11);
+    Results.insert(1, 2, 12);
+    Results.insert(2, 0, 20);
+    Results.insert(3, 3, 33);
+  }
+};
+
+TEST_F(SolverResultsTest, ResultsView) {
+  SolverResults<int, int, int> SR(Results, 0);
+  std::map<int, int> Facts;
+  for (const auto &[Fact, Value] : SR.resultsViewAt(1)) {
+    Facts[Fact] = Value;
+  }
+  EXPECT_EQ((std::map<int, int>{{0, 10}, {1, 11}, {2, 12}}), Facts);
+  EXPECT_EQ(3U, SR.resultsViewAt(1).size());
+  EXPECT_TRUE(SR.resultsViewAt(1).contains(0));
+  EXPECT_EQ(12, SR.resultsViewAt(1).at(2));
+}
+
+TEST_F(SolverResultsTest, ResultsViewStripsZero) {
+  SolverResults<int, int, int> SR(Results, 0);
+  std::map<int, int> Facts;
+  for (const auto &[Fact, Value] : SR.resultsViewAt(1, true)) {
+    Facts[Fact] = Value;
+  }
+  EXPECT_EQ((std::map<int, int>{{1, 11}, {2, 12}}), Facts);
+  EXPECT_EQ(2U, SR.resultsViewAt(1, true).size());
+  EXPECT_FALSE(SR.resultsViewAt(1, true).contains(0));
+  // a statement that only holds the zero value has no results
+  EXPECT_TRUE(SR.resultsViewAt(2, true).empty());
+  EXPECT_EQ(SR.resultsViewAt(2, true).begin(), SR.resultsViewAt(2, true).end());
+  EXPECT_EQ(1U, SR.resultsViewAt(3, true).size());
+}
+
+TEST_F(SolverResultsTest, QueriesDoNotInsertRows) {
+  const SolverResults<int, int, int> SR(Results, 0);
+  EXPECT_TRUE(SR.resultsViewAt(42).empty());
+  EXPECT_TRUE(SR.resultsAt(42).empty());
+  EXPECT_EQ(0, SR.resultAt(42, 1));
+  EXPECT_EQ(0, SR.resultAt(1, 42));
+  EXPECT_FALSE(Results.containsRow(42));
+  EXPECT_EQ(3U, Results.rowKeySet().size());
+}
+
+TEST_F(SolverResultsTest, ForEachResult) {
+  SolverResults<int, int, int> SR(Results, 0);
+  std::set<std::tuple<int, int, int>> Cells;
+  SR.forEachResult([&Cells](int Stmt, int Fact, int Value) {
+    Cells.emplace(Stmt, Fact, Value);
+  });
+  EXPECT_EQ(5U, Cells.size());
+  Cells.clear();
+  SR.forEachResult(
+      [&Cells](int Stmt, int Fact, int Value) {
+        Cells.emplace(Stmt, Fact, Value);
+      },
+      true);
+  EXPECT_EQ((std::set<std::tuple<int, int, int>>{
+                {1, 1, 11}, {1, 2, 12}, {3, 3, 33}}),
+            Cells);
+}
+
+TEST_F(SolverResultsTest, FactIndex) {
+  Results.insert(4, 1, 41);
+  Results.insert(5, 1, 51);
+  FactIndex<int, int> Index(Results);
+  EXPECT_EQ(7U, Index.size());
+  EXPECT_EQ(4U, Index.getNumFacts());
+  EXPECT_EQ(5U, Index.getNumStatements());
+  EXPECT_EQ(3U, Index.numStatementsOf(1));
+  EXPECT_EQ(2U, Index.numStatementsOf(0));
+  EXPECT_FALSE(Index.contains(42));
+  EXPECT_TRUE(Index.statementsOf(42).empty());
+  auto Stmts = Index.statementsOf(1);
+  EXPECT_EQ((std::multiset<int>{1, 4, 5}),
+            std::multiset<int>(Stmts.begin(), Stmts.end()));
+  // the statement IDs of a fact are sorted
+  auto Ids = Index.statementIdsOf(1);
+  EXPECT_TRUE(std::is_sorted(Ids.begin(), Ids.end()));
+  for (uint32_t Id : Ids) {
+    EXPECT_TRUE(Results.contains(Index.getStatement(Id), 1));
+  }
+}
+
+TEST_F(SolverResultsTest, ForEachResultOf) {
+  Results.insert(4, 1, 41);
+  FactIndex<int, int> Index(Results);
+  // the answers with and without an index are the same
+  for (const FactIndex<int, int> *IndexPtr :
+       std::vector<const FactIndex<int, int> *>{nullptr, &Index}) {
+    SolverResults<int, int, int> SR(Results, 0, IndexPtr);
+    EXPECT_EQ(IndexPtr != nullptr, SR.hasFactIndex());
+    std::set<std::pair<int, int>> Found;
+    SR.forEachResultOf(
+        1, [&Found](int Stmt, int Value) { Found.emplace(Stmt, Value); });
+    EXPECT_EQ((std::set<std::pair<int, int>>{{1, 11}, {4, 41}}), Found);
+    auto Stmts = SR.statementsOf(0);
+    EXPECT_EQ((std::set<int>{1, 2}), std::set<int>(Stmts.begin(), Stmts.end()));
+    EXPECT_TRUE(SR.statementsOf(42).empty());
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverTelemetry.h"
+
+using namespace psr;
+
+TEST(SolverTelemetryTest, RecordPathEdges) {
+  SolverTelemetry<int, std::string> Telemetry;
+  Telemetry.recordPathEdge("main", 0, true);
+  Telemetry.recordPathEdge("main", 1, true);
+  // the jump function of a known path edge changed
+  Telemetry.recordPathEdge("main", 1, false);
+  Telemetry.recordPathEdge("foo", 1, true);
+  EXPECT_EQ(4U, Telemetry.getNumPathEdges());
+  EXPECT_EQ(2U, Telemetry.getNumFunctions());
+  const auto *Main = Telemetry.getFunctionTelemetry("main");
+  ASSERT_NE(nullptr, Main);
+  EXPECT_EQ(3U, Main->PathEdges);
+  EXPECT_EQ(2U, Main->JumpFunctions);
+  EXPECT_EQ(2U, Main->Facts.size());
+  EXPECT_EQ(nullptr, Telemetry.getFunctionTelemetry("bar"));
+}
+
+TEST(SolverTelemetryTest, HottestFunctions) {
+  SolverTelemetry<int, std::string> Telemetry;
+  for (int Fact = 0; Fact < 3; ++Fact) {
+    Telemetry.recordPathEdge("foo", Fact, true);
+  }
+  Telemetry.recordPathEdge("bar", 0, true);
+  Telemetry.recordPathEdge("main", 0, true);
+  Telemetry.recordPathEdge("main", 1, true);
+  auto Hottest = Telemetry.getHottestFunctions(2);
+  ASSERT_EQ(2U, Hottest.size());
+  EXPECT_EQ("foo", Hottest[0].first);
+  EXPECT_EQ("main", Hottest[1].first);
+  // the time spent takes precedence over the number of path edges
+  Telemetry.recordTime("bar", std::chrono::milliseconds(5));
+  Hottest = Telemetry.getHottestFunctions(10);
+  ASSERT_EQ(3U, Hottest.size());
+  EXPECT_EQ("bar", Hottest[0].first);
+  EXPECT_EQ("foo", Hottest[1].first);
+  std::stringstream Out;
+  Telemetry.printHottestFunctions(Out, 1,
+                                  [](const std::string &Fun) { return Fun; });
+  EXPECT_NE(std::string::npos,
+            Out.str().find("1. bar: 1 path edges, 1 facts, 1 jump functions, "
+                           "5 ms"));
+  EXPECT_EQ(std::string::npos, Out.str().find("foo"));
+}
+
+TEST(SolverTelemetryTest, Progress) {
+  SolverTelemetry<int, std::string> Telemetry;
+  Telemetry.recordPathEdge("main", 0, true);
+  // progress reports are disabled
+  for (size_t I = 0; I < 2 * Telemetry.ProgressCheckPeriod; ++I) {
+    EXPECT_FALSE(Telemetry.isProgressDue(std::chrono::seconds(0)));
+  }
+  auto Line = Telemetry.reportProgress(42);
+  EXPECT_NE(std::string::npos, Line.find("Propagated 1 path edges"));
+  EXPECT_NE(std::string::npos, Line.find("worklist: 42"));
+  EXPECT_NE(std::string::npos, Line.find("RSS: "));
+}
+
+TEST(SolverTelemetryTest, ResidentSetSize) {
+  EXPECT_GT(getResidentSetSize(), 0U);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "boost/filesystem/operations.hpp"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class SummaryCacheTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  using ResultsTy = std::map<std::string, std::map<std::string, int64_t>>;
+
+  std::string CacheDirectory;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    CacheDirectory = (boost::filesystem::temp_directory_path() /
+                      boost::filesystem::unique_path("phasar-%%%%-%%%%"))
+                         .string();
+  }
+
+  void TearDown() override { boost::filesystem::remove_all(CacheDirectory); }
+
+  size_t getNumCachedSummaries() const {
+    if (!boost::filesystem::exists(CacheDirectory)) {
+      return 0;
+    }
+    return std::distance(boost::filesystem::directory_iterator(CacheDirectory),
+                         boost::filesystem::directory_iterator());
+  }
+
+  // Solves the IR, which is loaded from scratch for every run, using the
+  // summary cache if UseCache is set. If ChangedFunction is given, the first
+  // occurrence of the constant Val in it is incremented. Returns the results
+  // of the given function keyed on the instructions' and facts' IDs. The
+  // names of the functions summarized from the cache are added to Cached.
+  ResultsTy solve(const std::string &IRFile, bool UseCache,
+                  const std::string &ChangedFunction = "", int64_t Val = 0,
+                  const std::string &ResultsOf = "main",
+                  std::set<std::string> *Cached = nullptr) {
+    ValueAnnotationPass::resetValueID();
+    ProjectIRDB IRDB(std::vector<std::string>{PathToLlFiles + IRFile},
+                     IRDBOptions::WPA);
+    if (!ChangedFunction.empty()) {
+      changeConstant(IRDB, ChangedFunction, Val);
+    }
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    IDELinearConstantAnalysis Problem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+    if (UseCache) {
+      Problem.getIFDSIDESolverConfig().setSummaryCacheDirectory(
+          CacheDirectory);
+      Problem.getIFDSIDESolverConfig().setComputePersistedSummaries();
+    }
+    IDESolver_P<IDELinearConstantAnalysis> Solver(Problem);
+    Solver.solve();
+    if (Cached) {
+      for (const auto *F : Solver.getFunctionsSummarizedFromCache()) {
+        Cached->insert(F->getName().str());
+      }
+    }
+    ResultsTy Results;
+    for (const auto &I : llvm::instructions(IRDB.getFunction(ResultsOf))) {
+      auto &InstResults = Results[getCheckpointId(&I)];
+      for (const auto &[Fact, Value] : Solver.resultsAt(&I)) {
+        InstResults[getCheckpointId(Fact)] = Value;
+      }
+    }
+    return Results;
+  }
+
+  static void changeConstant(ProjectIRDB &IRDB, const std::string &FName,
+                             int64_t Val) {
+    auto *F = IRDB.getModuleDefiningFunction(FName)->getFunction(FName);
+    for (auto &I : llvm::instructions(F)) {
+      for (unsigned Idx = 0; Idx < I.getNumOperands(); ++Idx) {
+        const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(I.getOperand(Idx));
+        if (CI && CI->getSExtValue() == Val) {
+          I.setOperand(Idx, llvm::ConstantInt::get(CI->getType(), Val + 1));
+          return;
+        }
+      }
+    }
+    ADD_FAILURE() << "The constant " << Val << " does not occur in " << FName;
+  }
+
+  // Solves the IR with a cold and a warm cache, both must yield the results
+  // of an uncached run for the main function; the values of the functions
+  // whose summaries are found in the cache are not computed.
+  void checkCache(const std::string &IRFile) {
+    auto Expected = solve(IRFile, false);
+    EXPECT_EQ(0U, getNumCachedSummaries());
+    EXPECT_EQ(Expected, solve(IRFile, true));
+    size_t NumCached = getNumCachedSummaries();
+    EXPECT_GT(NumCached, 0U);
+    EXPECT_EQ(Expected, solve(IRFile, true));
+    // the cached summaries are re-used, not re-computed
+    EXPECT_EQ(NumCached, getNumCachedSummaries());
+  }
+}; // Test Fixture
+
+TEST_F(SummaryCacheTest, HandleCall) {
+  checkCache("call_07_cpp_dbg.ll");
+  // increment() is not analyzed once its summaries are cached, which the
+  // solver reports
+  std::set<std::string> Cached;
+  EXPECT_NE(solve("call_07_cpp_dbg.ll", false, "", 0, "_Z9incrementi"),
+            solve("call_07_cpp_dbg.ll", true, "", 0, "_Z9incrementi",
+                  &Cached));
+  EXPECT_EQ(std::set<std::string>{"_Z9incrementi"}, Cached);
+}
+
+TEST_F(SummaryCacheTest, HandleNestedCalls) {
+  checkCache("call_11_cpp_dbg.ll");
+}
+
+TEST_F(SummaryCacheTest, HandleRecursion) {
+  checkCache("recursion_02_cpp_dbg.ll");
+}
+
+TEST_F(SummaryCacheTest, HandleGlobals) {
+  checkCache("global_08_cpp_dbg.ll");
+}
+
+TEST_F(SummaryCacheTest, ChangedCalleeIsReanalyzed) {
+  solve("call_03_cpp_dbg.ll", true);
+  EXPECT_EQ(solve("call_03_cpp_dbg.ll", false, "_Z3foov", 42),
+            solve("call_03_cpp_dbg.ll", true, "_Z3foov", 42));
+}
+
+TEST_F(SummaryCacheTest, UncachedAnalysisIsNotCached) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB(
+      std::vector<std::string>{PathToLlFiles + "call_07_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH, &PT);
+  IFDSUninitializedVariables Problem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+  Problem.getIFDSIDESolverConfig().setSummaryCacheDirectory(CacheDirectory);
+  Problem.getIFDSIDESolverConfig().setComputePersistedSummaries();
+  IFDSSolver_P<IFDSUninitializedVariables> Solver(Problem);
+  Solver.solve();
+  EXPECT_EQ(0U, getNumCachedSummaries());
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
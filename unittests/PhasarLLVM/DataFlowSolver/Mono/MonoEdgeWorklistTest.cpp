@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/MonoEdgeWorklist.h"
+
+using namespace psr;
+
+TEST(MonoEdgeWorklistTest, Deduplication) {
+  MonoEdgeWorklist<int> Worklist;
+  EXPECT_TRUE(Worklist.empty());
+  EXPECT_TRUE(Worklist.push({1, 2}, 0));
+  EXPECT_TRUE(Worklist.push({2, 3}, 0));
+  EXPECT_FALSE(Worklist.push({1, 2}, 0));
+  // the priority of an enqueued edge does not change either
+  EXPECT_FALSE(Worklist.push({2, 3}, 5));
+  EXPECT_EQ(2U, Worklist.size());
+  EXPECT_TRUE(Worklist.contains({1, 2}));
+  EXPECT_FALSE(Worklist.contains({3, 4}));
+  EXPECT_EQ(std::make_pair(1, 2), Worklist.pop());
+  EXPECT_FALSE(Worklist.contains({1, 2}));
+  // a processed edge can be enqueued again
+  EXPECT_TRUE(Worklist.push({1, 2}, 0));
+  EXPECT_EQ(2U, Worklist.size());
+  EXPECT_EQ(2U, Worklist.getNumKnownEdges());
+  auto Enqueued = Worklist.getEnqueuedEdges();
+  std::sort(Enqueued.begin(), Enqueued.end());
+  EXPECT_EQ((std::vector<std::pair<int, int>>{{1, 2}, {2, 3}}), Enqueued);
+  Worklist.clear();
+  EXPECT_TRUE(Worklist.empty());
+  EXPECT_TRUE(Worklist.push({2, 3}, 0));
+}
+
+TEST(MonoEdgeWorklistTest, Order) {
+  MonoEdgeWorklist<int> Worklist;
+  Worklist.push({7, 8}, 2);
+  Worklist.push({3, 4}, 1);
+  Worklist.push({5, 6}, 2);
+  Worklist.push({1, 2}, 0);
+  Worklist.push({9, 10}, 1);
+  std::vector<std::pair<int, int>> Popped;
+  while (!Worklist.empty()) {
+    Popped.push_back(Worklist.pop());
+  }
+  // edges of equal priority are popped in the order they were pushed
+  EXPECT_EQ((std::vector<std::pair<int, int>>{
+                {1, 2}, {3, 4}, {9, 10}, {7, 8}, {5, 6}}),
+            Popped);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/Support/JSON.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/IntraMonoSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/IOFormat.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class ResultsExporterTest : public ::testing::Test {
+protected:
+  const std::set<std::string> EntryPoints = {"main"};
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  // Exports the results of the linear constant analysis of basic_01, which
+  // assigns 13 to a variable.
+  llvm::json::Value exportLCA(IOFormat Format) {
+    ProjectIRDB IRDB(std::vector<std::string>{unittest::PathToLLTestFiles +
+                                              "linear_constant/"
+                                              "basic_01_cpp_dbg.ll"},
+                     IRDBOptions::WPA);
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    IDELinearConstantAnalysis Problem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+    IDESolver_P<IDELinearConstantAnalysis> Solver(Problem);
+    Solver.solve();
+    std::stringstream Out;
+    Solver.exportResults(Format, Out);
+    auto Document = llvm::json::parse(Out.str());
+    if (!Document) {
+      ADD_FAILURE() << "The exported results are no valid JSON: "
+                    << llvm::toString(Document.takeError());
+      return nullptr;
+    }
+    return std::move(*Document);
+  }
+}; // Test Fixture
+
+TEST_F(ResultsExporterTest, ExportJSON) {
+  auto Document = exportLCA(IOFormat::JSON);
+  const auto *Results = Document.getAsObject()->getArray("results");
+  ASSERT_NE(nullptr, Results);
+  ASSERT_FALSE(Results->empty());
+  bool Found = false;
+  for (const auto &Result : *Results) {
+    const auto *Stmt = Result.getAsObject();
+    EXPECT_EQ(llvm::Optional<llvm::StringRef>("main"),
+              Stmt->getString("function"));
+    EXPECT_TRUE(Stmt->getString("id").hasValue());
+    EXPECT_TRUE(Stmt->getString("statement").hasValue());
+    const auto *Facts = Stmt->getArray("facts");
+    ASSERT_NE(nullptr, Facts);
+    // statements with only the zero fact are not exported
+    EXPECT_FALSE(Facts->empty());
+    for (const auto &Fact : *Facts) {
+      EXPECT_TRUE(Fact.getAsObject()->getString("fact").hasValue());
+      if (Fact.getAsObject()->getString("value") ==
+          llvm::Optional<llvm::StringRef>("13")) {
+        Found = true;
+        // the IR has debug information
+        EXPECT_GT(Stmt->getInteger("line").getValueOr(0), 0);
+      }
+    }
+  }
+  EXPECT_TRUE(Found);
+}
+
+TEST_F(ResultsExporterTest, ExportSARIF) {
+  auto Document = exportLCA(IOFormat::SARIF);
+  const auto *Log = Document.getAsObject();
+  EXPECT_EQ(llvm::Optional<llvm::StringRef>("2.1.0"),
+            Log->getString("version"));
+  const auto *Runs = Log->getArray("runs");
+  ASSERT_NE(nullptr, Runs);
+  ASSERT_EQ(1U, Runs->size());
+  const auto *Run = Runs->front().getAsObject();
+  EXPECT_NE(nullptr, Run->getObject("tool"));
+  const auto *Results = Run->getArray("results");
+  ASSERT_NE(nullptr, Results);
+  ASSERT_FALSE(Results->empty());
+  for (const auto &Result : *Results) {
+    const auto *Obj = Result.getAsObject();
+    EXPECT_EQ(llvm::Optional<llvm::StringRef>("data-flow-fact"),
+              Obj->getString("ruleId"));
+    EXPECT_TRUE(Obj->getObject("message")->getString("text").hasValue());
+    const auto *Locations = Obj->getArray("locations");
+    ASSERT_NE(nullptr, Locations);
+    ASSERT_EQ(1U, Locations->size());
+    const auto *Physical =
+        Locations->front().getAsObject()->getObject("physicalLocation");
+    ASSERT_NE(nullptr, Physical);
+    EXPECT_NE(nullptr, Physical->getObject("artifactLocation"));
+  }
+}
+
+TEST_F(ResultsExporterTest, ExportIFDS) {
+  ProjectIRDB IRDB(std::vector<std::string>{unittest::PathToLLTestFiles +
+                                            "uninitialized_variables/"
+                                            "all_uninit_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH, &PT);
+  IFDSUninitializedVariables Problem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+  NativeIFDSSolver_P<IFDSUninitializedVariables> Solver(Problem);
+  Solver.solve();
+  std::stringstream Out;
+  Solver.exportResults(IOFormat::JSON, Out);
+  auto Document = llvm::json::parse(Out.str());
+  ASSERT_TRUE(bool(Document)) << llvm::toString(Document.takeError());
+  const auto *Results = Document->getAsObject()->getArray("results");
+  ASSERT_NE(nullptr, Results);
+  ASSERT_FALSE(Results->empty());
+  for (const auto &Result : *Results) {
+    for (const auto &Fact : *Result.getAsObject()->getArray("facts")) {
+      // IFDS facts do not have values
+      EXPECT_EQ(nullptr, Fact.getAsObject()->get("value"));
+    }
+  }
+}
+
+TEST_F(ResultsExporterTest, ExportMono) {
+  ProjectIRDB IRDB(std::vector<std::string>{unittest::PathToLLTestFiles +
+                                            "linear_constant/"
+                                            "basic_01_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedCFG CFG;
+  // the facts are the stores that precede a statement
+  IntraMonoSolverTest Problem(&IRDB, &TH, &CFG, &PT, EntryPoints);
+  IntraMonoSolver_P<IntraMonoSolverTest> Solver(Problem);
+  Solver.solve();
+  std::stringstream Out;
+  Solver.exportResults(IOFormat::JSON, Out);
+  auto Document = llvm::json::parse(Out.str());
+  ASSERT_TRUE(bool(Document)) << llvm::toString(Document.takeError());
+  const auto *Results = Document->getAsObject()->getArray("results");
+  ASSERT_NE(nullptr, Results);
+  ASSERT_FALSE(Results->empty());
+  for (const auto &Result : *Results) {
+    const auto *Facts = Result.getAsObject()->getArray("facts");
+    ASSERT_NE(nullptr, Facts);
+    EXPECT_FALSE(Facts->empty());
+    for (const auto &Fact : *Facts) {
+      EXPECT_TRUE(Fact.getAsObject()->getString("fact").hasValue());
+      EXPECT_EQ(nullptr, Fact.getAsObject()->get("value"));
+    }
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -5,8 +5,12 @@
 #include "llvm/ADT/BitVector.h"
 
 #include <iostream>
+#include <memory>
 #include <set>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace psr;
 using namespace std;
@@ -396,6 +400,107 @@ TEST(BitVectorSet, lessThan) {
   EXPECT_FALSE(A < A);
 }
 
+TEST(BitVectorSet, setDifference) {
+  BitVectorSet<int> A({1, 2, 3, 4, 5, 6});
+  BitVectorSet<int> B({5, 6, 42});
+
+  EXPECT_EQ(A.setDifference(B), BitVectorSet<int>({1, 2, 3, 4}));
+  EXPECT_EQ(B.setDifference(A), BitVectorSet<int>({42}));
+  EXPECT_TRUE(A.setDifference(A).empty());
+  EXPECT_EQ(A.setDifference(BitVectorSet<int>()), A);
+
+  A.erase(B);
+  EXPECT_EQ(A, BitVectorSet<int>({1, 2, 3, 4}));
+}
+
+TEST(BitVectorSet, sparseAndDense) {
+  auto Indexer = std::make_shared<BitVectorSetIndexer<int>>();
+  // assign high indices to the elements of Sparse
+  for (int I = 0; I < 1000; ++I) {
+    Indexer->getOrInsertIndex(I);
+  }
+  BitVectorSet<int> Sparse({990, 10, 999}, Indexer);
+  BitVectorSet<int> Dense(Indexer);
+  for (int I = 0; I < 100; ++I) {
+    Dense.insert(I);
+  }
+  EXPECT_EQ(Sparse.size(), 3U);
+  EXPECT_EQ(Dense.size(), 100U);
+  std::vector<int> Elems(Sparse.begin(), Sparse.end());
+  EXPECT_EQ(Elems, std::vector<int>({10, 990, 999}));
+
+  auto Union = Sparse.setUnion(Dense);
+  EXPECT_EQ(Union.size(), 102U);
+  EXPECT_TRUE(Union.includes(Sparse));
+  EXPECT_TRUE(Union.includes(Dense));
+  EXPECT_FALSE(Dense.includes(Union));
+  EXPECT_EQ(Sparse.setIntersect(Dense), BitVectorSet<int>({10}, Indexer));
+  EXPECT_EQ(Dense.setIntersect(Sparse), BitVectorSet<int>({10}, Indexer));
+  EXPECT_EQ(Union.setDifference(Dense), BitVectorSet<int>({990, 999}, Indexer));
+  EXPECT_EQ(Union.setDifference(Sparse).size(), 99U);
+  EXPECT_TRUE(Dense < Union);
+  EXPECT_FALSE(Union < Dense);
+  EXPECT_TRUE(Dense < Sparse);
+
+  // equal sets may use different representations
+  BitVectorSet<int> SmallDense({10, 11, 12, 13}, Indexer);
+  SmallDense.erase(11);
+  SmallDense.erase(12);
+  SmallDense.erase(13);
+  EXPECT_EQ(SmallDense, BitVectorSet<int>({10}, Indexer));
+  EXPECT_FALSE(SmallDense < BitVectorSet<int>({10}, Indexer));
+}
+
+TEST(BitVectorSet, indexers) {
+  auto First = std::make_shared<BitVectorSetIndexer<std::string>>();
+  auto Second = std::make_shared<BitVectorSetIndexer<std::string>>();
+  BitVectorSet<std::string> A({"a", "b"}, First);
+  BitVectorSet<std::string> B({"c", "b"}, Second);
+  EXPECT_EQ(First->size(), 2U);
+  EXPECT_EQ(Second->size(), 2U);
+  EXPECT_EQ(A.getIndexer(), First);
+  // sets of different indexers can still be combined
+  EXPECT_EQ(A.setUnion(B), BitVectorSet<std::string>({"a", "b", "c"}));
+  EXPECT_EQ(A.setIntersect(B), BitVectorSet<std::string>({"b"}, Second));
+  EXPECT_TRUE(A.setUnion(B).includes(B));
+  // sets are bound to the indexer of the current scope once they contain
+  // elements
+  {
+    BitVectorSetIndexer<std::string>::Scope IndexerScope(Second);
+    BitVectorSet<std::string> C;
+    EXPECT_EQ(C.getIndexer(), nullptr);
+    C.insert("d");
+    EXPECT_EQ(C.getIndexer(), Second);
+    EXPECT_EQ(Second->size(), 3U);
+  }
+  BitVectorSet<std::string> D({"d"});
+  EXPECT_EQ(D.getIndexer(), BitVectorSetIndexer<std::string>::getGlobal());
+  // an empty set adopts the indexer of the set inserted into it
+  BitVectorSet<std::string> E;
+  E.insert(A);
+  EXPECT_EQ(E.getIndexer(), First);
+  EXPECT_EQ(E, A);
+}
+
+TEST(BitVectorSet, concurrentIndexer) {
+  auto Indexer = std::make_shared<BitVectorSetIndexer<int>>();
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < 4; ++T) {
+    Threads.emplace_back([&Indexer, T] {
+      BitVectorSetIndexer<int>::Scope IndexerScope(Indexer);
+      BitVectorSet<int> S;
+      for (int I = 0; I < 1000; ++I) {
+        S.insert((I * (T + 1)) % 1000);
+      }
+      EXPECT_EQ(S.getIndexer(), Indexer);
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  EXPECT_EQ(Indexer->size(), 1000U);
+}
+
 //===----------------------------------------------------------------------===//
 // llvm::BitVector
 
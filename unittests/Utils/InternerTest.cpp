@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#include "phasar/Utils/Interner.h"
+
+using namespace psr;
+
+TEST(Interner, denseIds) {
+  Interner<std::string> I;
+  EXPECT_TRUE(I.empty());
+  EXPECT_EQ(I.getOrInsert("foo"), 0U);
+  EXPECT_EQ(I.getOrInsert("bar"), 1U);
+  EXPECT_EQ(I.getOrInsert("foo"), 0U);
+  EXPECT_EQ(I.getOrInsert("baz"), 2U);
+  EXPECT_EQ(I.size(), 3U);
+  EXPECT_EQ(I.get(1), "bar");
+  EXPECT_EQ(I[2], "baz");
+}
+
+TEST(Interner, lookup) {
+  Interner<std::string> I;
+  I.getOrInsert("foo");
+  EXPECT_TRUE(I.contains("foo"));
+  EXPECT_FALSE(I.contains("bar"));
+  EXPECT_EQ(I.lookup("foo"), std::optional<uint32_t>(0));
+  EXPECT_EQ(I.lookup("bar"), std::nullopt);
+  // lookup() does not intern
+  EXPECT_EQ(I.size(), 1U);
+}
+
+TEST(Interner, pointers) {
+  int A = 0;
+  int B = 0;
+  Interner<const int *> I;
+  EXPECT_EQ(I.getOrInsert(&B), 0U);
+  EXPECT_EQ(I.getOrInsert(&A), 1U);
+  EXPECT_EQ(I.getOrInsert(&B), 0U);
+  EXPECT_EQ(I.get(1), &A);
+  std::vector<const int *> Values(I.begin(), I.end());
+  std::vector<const int *> Expected = {&B, &A};
+  EXPECT_EQ(Values, Expected);
+}
+
+TEST(Interner, combineIds) {
+  uint64_t Key = combineIds(42, 13);
+  EXPECT_EQ(highId(Key), 42U);
+  EXPECT_EQ(lowId(Key), 13U);
+  EXPECT_NE(combineIds(1, 2), combineIds(2, 1));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "phasar/Utils/ShardedCache.h"
+
+using namespace psr;
+
+TEST(ShardedCache, hitsAndMisses) {
+  ShardedCache<uint64_t, std::string> C;
+  unsigned Constructions = 0;
+  auto Construct = [&Constructions] {
+    ++Constructions;
+    return std::string("foo");
+  };
+  EXPECT_EQ(C.getOrInsert(42, Construct), "foo");
+  EXPECT_EQ(C.getOrInsert(42, Construct), "foo");
+  EXPECT_EQ(C.getOrInsert(13, [] { return std::string("bar"); }), "bar");
+  EXPECT_EQ(Constructions, 1U);
+  EXPECT_EQ(C.getHits(), 1U);
+  EXPECT_EQ(C.getMisses(), 2U);
+  EXPECT_EQ(C.size(), 2U);
+  EXPECT_TRUE(C.contains(13));
+  EXPECT_FALSE(C.contains(7));
+  C.resetStatistics();
+  EXPECT_EQ(C.getHits(), 0U);
+  EXPECT_EQ(C.getMisses(), 0U);
+  // the cached values are kept
+  EXPECT_EQ(C.size(), 2U);
+}
+
+TEST(ShardedCache, compositeKeys) {
+  ShardedCache<std::pair<uint64_t, uint64_t>, int> C;
+  EXPECT_EQ(C.getOrInsert({1, 2}, [] { return 12; }), 12);
+  EXPECT_EQ(C.getOrInsert({2, 1}, [] { return 21; }), 21);
+  EXPECT_EQ(C.getOrInsert({1, 2}, [] { return 0; }), 12);
+  EXPECT_EQ(C.size(), 2U);
+}
+
+TEST(ShardedCache, concurrent) {
+  ShardedCache<uint64_t, uint64_t> C;
+  C.setConcurrent();
+  constexpr uint64_t NumKeys = 1000;
+  std::atomic<unsigned> Mismatches = 0;
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T < 4; ++T) {
+    Threads.emplace_back([&C, &Mismatches] {
+      for (uint64_t Key = 0; Key < NumKeys; ++Key) {
+        if (C.getOrInsert(Key, [Key] { return 2 * Key; }) != 2 * Key) {
+          ++Mismatches;
+        }
+      }
+    });
+  }
+  for (auto &T : Threads) {
+    T.join();
+  }
+  EXPECT_EQ(Mismatches, 0U);
+  EXPECT_EQ(C.size(), NumKeys);
+  EXPECT_EQ(C.getHits() + C.getMisses(), 4 * NumKeys);
+  EXPECT_GE(C.getMisses(), NumKeys);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
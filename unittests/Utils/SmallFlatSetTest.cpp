@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/Utils/SmallFlatSet.h"
+
+using namespace psr;
+
+TEST(SmallFlatSet, insertAndLookup) {
+  SmallFlatSet<int> S;
+  EXPECT_TRUE(S.empty());
+  EXPECT_TRUE(S.insert(3).second);
+  EXPECT_TRUE(S.insert(1).second);
+  EXPECT_FALSE(S.insert(3).second);
+  EXPECT_TRUE(S.insert(2).second);
+  EXPECT_EQ(S.size(), 3U);
+  EXPECT_EQ(S.count(2), 1U);
+  EXPECT_EQ(S.count(4), 0U);
+  EXPECT_NE(S.find(1), S.end());
+  EXPECT_EQ(S.find(0), S.end());
+  EXPECT_EQ(std::vector<int>(S.begin(), S.end()), std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(S.erase(2), 1U);
+  EXPECT_EQ(S.erase(2), 0U);
+  EXPECT_EQ(S, SmallFlatSet<int>({3, 1}));
+}
+
+TEST(SmallFlatSet, spillsToHeap) {
+  SmallFlatSet<int, 2> S = {5, 4};
+  std::set<int> Expected = {5, 4};
+  for (int I = 20; I > 0; I -= 3) {
+    S.insert(I);
+    Expected.insert(I);
+  }
+  EXPECT_GT(S.size(), (SmallFlatSet<int, 2>::inlineCapacity()));
+  EXPECT_TRUE(std::equal(S.begin(), S.end(), Expected.begin(), Expected.end()));
+}
+
+TEST(SmallFlatSet, insertRange) {
+  SmallFlatSet<std::string> S = {"b"};
+  std::vector<std::string> Range = {"d", "a", "b", "c", "a"};
+  S.insert(Range.begin(), Range.end());
+  EXPECT_EQ(std::vector<std::string>(S.begin(), S.end()),
+            std::vector<std::string>({"a", "b", "c", "d"}));
+  SmallFlatSet<std::string> Copy;
+  std::copy(S.rbegin(), S.rend(), std::inserter(Copy, Copy.end()));
+  EXPECT_EQ(S, Copy);
+  EXPECT_FALSE(S < Copy);
+  Copy.erase(Copy.begin());
+  EXPECT_TRUE(S < Copy);
+  S.clear();
+  EXPECT_TRUE(S.empty());
+}
+
+TEST(SmallFlatSet, asFlowFunctionContainer) {
+  using ContainerTy = SmallFlatSet<int>;
+  Gen<int, ContainerTy> GenFF(42, 0);
+  EXPECT_EQ(GenFF.computeTargets(0), ContainerTy({0, 42}));
+  EXPECT_EQ(GenFF.computeTargets(1), ContainerTy({1}));
+  KillMultiple<int, ContainerTy> KillFF({1, 2});
+  EXPECT_TRUE(KillFF.computeTargets(2).empty());
+  EXPECT_EQ(KillFF.computeTargets(3), ContainerTy({3}));
+  auto KillAllFF = KillAll<int, ContainerTy>::getInstance();
+  EXPECT_TRUE(KillAllFF->computeTargets(3).empty());
+  GenIf<int, ContainerTy> GenIfFF(ContainerTy({7, 8}),
+                                  [](int Source) { return Source == 1; });
+  EXPECT_EQ(GenIfFF.computeTargets(1), ContainerTy({1, 7, 8}));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}